@@ -0,0 +1,595 @@
+/* bench.c -- Micro-benchmarks for color ramps, solar position,
+   transitions and gamma adjustment methods
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/* Results are printed as tab separated lines of benchmark name,
+   parameter, iterations, nanoseconds per operation and allocations
+   per operation ("-" if allocations can not be counted). */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+
+#ifdef ENABLE_NLS
+# include <libintl.h>
+# define _(s) gettext(s)
+#else
+# define _(s) s
+#endif
+
+#include "redshift.h"
+#include "colorramp.h"
+#include "solar.h"
+#include "transition.h"
+
+#include "gamma-dummy.h"
+
+#ifdef ENABLE_WAYLAND
+# include "gamma-wayland.h"
+#endif
+
+#ifdef ENABLE_DRM
+# include "gamma-drm.h"
+#endif
+
+#ifdef ENABLE_RANDR
+# include "gamma-randr.h"
+#endif
+
+#ifdef ENABLE_VIDMODE
+# include "gamma-vidmode.h"
+#endif
+
+#ifdef ENABLE_QUARTZ
+# include "gamma-quartz.h"
+#endif
+
+#ifdef ENABLE_WINGDI
+# include "gamma-w32gdi.h"
+#endif
+
+/* Largest ramp size benchmarked. */
+#define BENCH_RAMP_MAX  4096
+
+/* Start of the year of timestamps used for solar benchmarks. */
+#define BENCH_YEAR_START  1767225600.0 /* 2026-01-01 00:00 UTC */
+#define BENCH_YEAR_LENGTH  (365*86400.0)
+
+/* Values computed by each call of the batched solar functions. */
+#define BENCH_SOLAR_BATCH  1440
+
+
+/* Count allocations by wrapping the allocator. Only possible with
+   glibc, which exports the functions behind malloc. */
+#ifdef __GLIBC__
+# define BENCH_COUNT_ALLOCS  1
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+static unsigned long alloc_count = 0;
+
+void *
+malloc(size_t size)
+{
+	alloc_count += 1;
+	return __libc_malloc(size);
+}
+
+void *
+calloc(size_t nmemb, size_t size)
+{
+	alloc_count += 1;
+	return __libc_calloc(nmemb, size);
+}
+
+void *
+realloc(void *ptr, size_t size)
+{
+	alloc_count += 1;
+	return __libc_realloc(ptr, size);
+}
+#else
+static unsigned long alloc_count = 0;
+#endif
+
+
+typedef void bench_func(void *data, long iterations);
+
+/* Minimum time to run each benchmark (seconds). */
+static double min_time = 0.2;
+
+static double
+get_monotonic_time(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1000000000.0;
+}
+
+/* Run benchmark with a doubling number of iterations until it takes
+   at least the minimum time, then print the result. If QUIET is
+   non-zero stdout is discarded while the benchmark runs. */
+static void
+run_bench(const char *name, int param, bench_func *func, void *data,
+	  int quiet)
+{
+	long iterations = 1;
+	double elapsed;
+	unsigned long allocs;
+
+	int saved_stdout = -1;
+	if (quiet) {
+		fflush(stdout);
+		saved_stdout = dup(STDOUT_FILENO);
+		int null_fd = open("/dev/null", O_WRONLY);
+		if (saved_stdout >= 0 && null_fd >= 0) {
+			dup2(null_fd, STDOUT_FILENO);
+		}
+		if (null_fd >= 0) close(null_fd);
+	}
+
+	while (1) {
+		unsigned long start_allocs = alloc_count;
+		double start = get_monotonic_time();
+		func(data, iterations);
+		elapsed = get_monotonic_time() - start;
+		allocs = alloc_count - start_allocs;
+
+		if (elapsed >= min_time || iterations >= (1L << 30)) break;
+		iterations *= 2;
+	}
+
+	if (saved_stdout >= 0) {
+		fflush(stdout);
+		dup2(saved_stdout, STDOUT_FILENO);
+		close(saved_stdout);
+	}
+
+	printf("%s\t%d\t%ld\t%.1f\t", name, param, iterations,
+	       elapsed*1e9/iterations);
+#ifdef BENCH_COUNT_ALLOCS
+	printf("%.3f\n", (double)allocs/iterations);
+#else
+	printf("-\n");
+#endif
+}
+
+
+/* Color ramp benchmarks */
+typedef struct {
+	int size;
+	/* Use the same setting for every call. */
+	int same_setting;
+	/* Change the gamma on every call so no ramps can be derived
+	   from earlier ones. */
+	int vary_gamma;
+	uint16_t pure[3*BENCH_RAMP_MAX];
+	uint16_t ramps[3*BENCH_RAMP_MAX];
+	float pure_float[3*BENCH_RAMP_MAX];
+	float ramps_float[3*BENCH_RAMP_MAX];
+} ramp_bench_t;
+
+static void
+bench_setting(int i, color_setting_t *setting)
+{
+	setting->temperature = 3000 + i % 3000;
+	setting->gamma[0] = 0.9;
+	setting->gamma[1] = 1.0;
+	setting->gamma[2] = 1.1;
+	setting->brightness = 0.8;
+}
+
+static void
+bench_colorramp_fill(void *data, long iterations)
+{
+	ramp_bench_t *b = data;
+	int size = b->size;
+	for (long i = 0; i < iterations; i++) {
+		color_setting_t setting;
+		bench_setting(b->same_setting ? 0 : i, &setting);
+		if (b->vary_gamma) setting.gamma[0] += (i % 1000)*0.0001;
+		memcpy(b->ramps, b->pure, 3*size*sizeof(uint16_t));
+		colorramp_fill(&b->ramps[0*size], &b->ramps[1*size],
+			       &b->ramps[2*size], size, &setting);
+	}
+}
+
+static void
+bench_colorramp_fill_float(void *data, long iterations)
+{
+	ramp_bench_t *b = data;
+	int size = b->size;
+	for (long i = 0; i < iterations; i++) {
+		color_setting_t setting;
+		bench_setting(b->same_setting ? 0 : i, &setting);
+		memcpy(b->ramps_float, b->pure_float, 3*size*sizeof(float));
+		colorramp_fill_float(&b->ramps_float[0*size],
+				     &b->ramps_float[1*size],
+				     &b->ramps_float[2*size], size, &setting);
+	}
+}
+
+static void
+init_ramp_bench(ramp_bench_t *b, int size)
+{
+	b->size = size;
+	for (int i = 0; i < size; i++) {
+		uint16_t value = (double)i/size * (UINT16_MAX+1);
+		float value_float = (double)i/size;
+		for (int c = 0; c < 3; c++) {
+			b->pure[c*size+i] = value;
+			b->pure_float[c*size+i] = value_float;
+		}
+	}
+}
+
+
+/* Solar position benchmarks. Timestamps step through a year. */
+typedef struct {
+	double lat;
+	double lon;
+	double result;
+	solar_cache_t cache;
+	double table[SOLAR_TIME_MAX];
+	double batch[BENCH_SOLAR_BATCH*SOLAR_TIME_MAX];
+} solar_bench_t;
+
+static double
+bench_timestamp(long i, long iterations)
+{
+	return BENCH_YEAR_START + i*(BENCH_YEAR_LENGTH/iterations);
+}
+
+static void
+bench_solar_elevation(void *data, long iterations)
+{
+	solar_bench_t *b = data;
+	for (long i = 0; i < iterations; i++) {
+		b->result += solar_elevation(bench_timestamp(i, iterations),
+					     b->lat, b->lon);
+	}
+}
+
+static void
+bench_solar_cache_elevation(void *data, long iterations)
+{
+	solar_bench_t *b = data;
+	solar_cache_init(&b->cache);
+	for (long i = 0; i < iterations; i++) {
+		b->result += solar_cache_elevation(
+			&b->cache, bench_timestamp(i, iterations),
+			b->lat, b->lon);
+	}
+}
+
+static void
+bench_solar_table_fill(void *data, long iterations)
+{
+	solar_bench_t *b = data;
+	for (long i = 0; i < iterations; i++) {
+		solar_table_fill(bench_timestamp(i, iterations),
+				 b->lat, b->lon, b->table);
+		b->result += b->table[SOLAR_TIME_NOON];
+	}
+}
+
+static void
+bench_solar_elevation_many(void *data, long iterations)
+{
+	solar_bench_t *b = data;
+	double step = BENCH_YEAR_LENGTH/iterations;
+	for (long i = 0; i < iterations; i += BENCH_SOLAR_BATCH) {
+		int count = iterations - i < BENCH_SOLAR_BATCH ?
+			iterations - i : BENCH_SOLAR_BATCH;
+		solar_elevation_many(bench_timestamp(i, iterations), step,
+				     count, b->lat, b->lon, b->batch);
+		b->result += b->batch[0];
+	}
+}
+
+static void
+bench_solar_table_fill_many(void *data, long iterations)
+{
+	solar_bench_t *b = data;
+	for (long i = 0; i < iterations; i += BENCH_SOLAR_BATCH) {
+		int days = iterations - i < BENCH_SOLAR_BATCH ?
+			iterations - i : BENCH_SOLAR_BATCH;
+		solar_table_fill_many(BENCH_YEAR_START + i*86400.0, days,
+				      b->lat, b->lon, b->batch);
+		b->result += b->batch[SOLAR_TIME_NOON];
+	}
+}
+
+
+/* Transition benchmark. The progress steps through a transition. */
+typedef struct {
+	transition_scheme_t scheme;
+	double result;
+} transition_bench_t;
+
+static void
+bench_interpolate_transition_scheme(void *data, long iterations)
+{
+	transition_bench_t *b = data;
+	for (long i = 0; i < iterations; i++) {
+		color_setting_t setting;
+		interpolate_transition_scheme(
+			&b->scheme, (double)i/iterations, &setting);
+		b->result += setting.brightness;
+	}
+}
+
+static void
+init_transition_bench(transition_bench_t *b)
+{
+	bench_setting(0, &b->scheme.night);
+	b->scheme.night.temperature = 3500;
+	bench_setting(0, &b->scheme.day);
+	b->scheme.day.temperature = 6500;
+	b->scheme.day.brightness = 1.0;
+	b->result = 0;
+}
+
+
+/* Gamma method benchmark */
+typedef struct {
+	const gamma_method_t *method;
+	gamma_state_t *state;
+} method_bench_t;
+
+static void
+bench_set_temperature(void *data, long iterations)
+{
+	method_bench_t *b = data;
+	for (long i = 0; i < iterations; i++) {
+		color_setting_t setting;
+		bench_setting(i, &setting);
+		int r = b->method->set_temperature(b->state, &setting, 0);
+		if (r < 0) {
+			fputs(_("Temperature adjustment failed.\n"), stderr);
+			exit(EXIT_FAILURE);
+		}
+	}
+}
+
+/* Apply method options given as "key=value" separated by colons. */
+static int
+set_method_options(const gamma_method_t *method, gamma_state_t *state,
+		   char *args)
+{
+	while (args != NULL) {
+		char *next = strchr(args, ':');
+		if (next != NULL) *(next++) = '\0';
+
+		char *value = strchr(args, '=');
+		if (value == NULL) {
+			fprintf(stderr, _("Failed to parse option `%s'.\n"),
+				args);
+			return -1;
+		}
+		*(value++) = '\0';
+
+		int r = method->set_option(state, args, value);
+		if (r < 0) return -1;
+
+		args = next;
+	}
+
+	return 0;
+}
+
+/* Time set_temperature of method. */
+static int
+bench_method(const gamma_method_t *method, char *args, int quiet)
+{
+	method_bench_t b = { method, NULL };
+
+	int r = method->init(&b.state);
+	if (r < 0) {
+		fprintf(stderr, _("Initialization of %s failed.\n"),
+			method->name);
+		return -1;
+	}
+
+	r = set_method_options(method, b.state, args);
+	if (r < 0) {
+		method->free(b.state);
+		return -1;
+	}
+
+	r = method->start(b.state);
+	if (r < 0) {
+		fprintf(stderr, _("Failed to start adjustment method %s.\n"),
+			method->name);
+		method->free(b.state);
+		return -1;
+	}
+
+	char name[64];
+	snprintf(name, sizeof(name), "set_temperature:%s", method->name);
+
+	run_bench(name, 0, bench_set_temperature, &b, quiet);
+
+	method->restore(b.state);
+	method->free(b.state);
+
+	return 0;
+}
+
+
+static void
+print_help(const char *program_name)
+{
+	printf(_("Usage: %s -[hk:m:t:]\n"), program_name);
+	fputs("\n", stdout);
+	fputs(_("  -h\t\tDisplay this help message\n"
+		"  -k KERNEL\tColor ramp kernel to use (reference, sse2,"
+		" avx2, neon)\n"
+		"  -m METHOD\tAlso time a gamma adjustment method, with"
+		" options\n"
+		"  \t\tas in `-m randr:screen=0'\n"
+		"  -t SECONDS\tMinimum time per benchmark\n"), stdout);
+}
+
+int
+main(int argc, char *argv[])
+{
+	const gamma_method_t gamma_methods[] = {
+#ifdef ENABLE_WAYLAND
+		wayland_gamma_method,
+#endif
+#ifdef ENABLE_DRM
+		drm_gamma_method,
+#endif
+#ifdef ENABLE_RANDR
+		randr_gamma_method,
+#endif
+#ifdef ENABLE_VIDMODE
+		vidmode_gamma_method,
+#endif
+#ifdef ENABLE_QUARTZ
+		quartz_gamma_method,
+#endif
+#ifdef ENABLE_WINGDI
+		w32gdi_gamma_method,
+#endif
+		{ NULL }
+	};
+
+	char *method_arg = NULL;
+	int opt;
+	while ((opt = getopt(argc, argv, "hk:m:t:")) != -1) {
+		switch (opt) {
+		case 'h':
+			print_help(argv[0]);
+			exit(EXIT_SUCCESS);
+		case 'k':
+		{
+			int found = 0;
+			for (int k = 0; k < COLORRAMP_KERNEL_MAX; k++) {
+				if (colorramp_set_kernel(k) == 0 &&
+				    strcmp(colorramp_get_kernel_name(),
+					   optarg) == 0) {
+					found = 1;
+					break;
+				}
+			}
+			if (!found) {
+				fprintf(stderr, _("Color ramp kernel `%s' is"
+						  " not available.\n"),
+					optarg);
+				exit(EXIT_FAILURE);
+			}
+		}
+			break;
+		case 'm':
+			method_arg = optarg;
+			break;
+		case 't':
+			min_time = atof(optarg);
+			break;
+		default:
+			print_help(argv[0]);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	setvbuf(stdout, NULL, _IOLBF, 0);
+
+	printf("# kernel: %s\n", colorramp_get_kernel_name());
+	printf("# benchmark\tparam\titerations\tns/op\tallocs/op\n");
+
+	static ramp_bench_t ramp_bench;
+	static const int ramp_sizes[] = { 256, 1024, 2048, 4096 };
+	for (int i = 0; i < sizeof(ramp_sizes)/sizeof(ramp_sizes[0]); i++) {
+		init_ramp_bench(&ramp_bench, ramp_sizes[i]);
+
+		ramp_bench.same_setting = 0;
+		ramp_bench.vary_gamma = 1;
+		run_bench("colorramp_fill", ramp_sizes[i],
+			  bench_colorramp_fill, &ramp_bench, 0);
+		run_bench("colorramp_fill_float", ramp_sizes[i],
+			  bench_colorramp_fill_float, &ramp_bench, 0);
+
+		/* Only the temperature changes, as in most fades. */
+		ramp_bench.vary_gamma = 0;
+		run_bench("colorramp_fill_derived", ramp_sizes[i],
+			  bench_colorramp_fill, &ramp_bench, 0);
+
+		/* Repeated settings are served from the ramp cache. */
+		ramp_bench.same_setting = 1;
+		run_bench("colorramp_fill_cached", ramp_sizes[i],
+			  bench_colorramp_fill, &ramp_bench, 0);
+	}
+
+	static solar_bench_t solar_bench = { 55.7, 12.6, 0 };
+	run_bench("solar_elevation", 0, bench_solar_elevation,
+		  &solar_bench, 0);
+	run_bench("solar_cache_elevation", 0, bench_solar_cache_elevation,
+		  &solar_bench, 0);
+	run_bench("solar_table_fill", 0, bench_solar_table_fill,
+		  &solar_bench, 0);
+	run_bench("solar_elevation_many", 0, bench_solar_elevation_many,
+		  &solar_bench, 0);
+	run_bench("solar_table_fill_many", 0, bench_solar_table_fill_many,
+		  &solar_bench, 0);
+
+	static transition_bench_t transition_bench;
+	init_transition_bench(&transition_bench);
+	run_bench("interpolate_transition_scheme", 0,
+		  bench_interpolate_transition_scheme, &transition_bench, 0);
+
+	/* The dummy method prints every setting. */
+	int r = bench_method(&dummy_gamma_method, NULL, 1);
+	if (r < 0) exit(EXIT_FAILURE);
+
+	if (method_arg != NULL) {
+		char *args = strchr(method_arg, ':');
+		if (args != NULL) *(args++) = '\0';
+
+		const gamma_method_t *method = NULL;
+		for (int i = 0; gamma_methods[i].name != NULL; i++) {
+			if (strcmp(gamma_methods[i].name, method_arg) == 0) {
+				method = &gamma_methods[i];
+				break;
+			}
+		}
+
+		if (method == NULL) {
+			fprintf(stderr, _("Unknown adjustment method `%s'.\n"),
+				method_arg);
+			exit(EXIT_FAILURE);
+		}
+
+		r = bench_method(method, args, 0);
+		if (r < 0) exit(EXIT_FAILURE);
+	}
+
+	colorramp_cache_free();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,2427 @@
+/* colorramp-table.h -- White point table
+   Generated by gen-colorramp-table.py from README-colorramp.
+   Do not edit. */
+
+#ifndef REDSHIFT_COLORRAMP_TABLE_H
+#define REDSHIFT_COLORRAMP_TABLE_H
+
+/* Temperature of the first entry and interval between entries
+   (kelvins). */
+#define BLACKBODY_MIN   1000
+#define BLACKBODY_STEP  10
+
+static const float blackbody_color[] = {
+	1.00000000,  0.18172716,  0.00000000, /* 1000K */
+	1.00000000,  0.18914328,  0.00000000,
+	1.00000000,  0.19669187,  0.00000000,
+	1.00000000,  0.20431617,  0.00000000,
+	1.00000000,  0.21195939,  0.00000000,
+	1.00000000,  0.21956476,  0.00000000,
+	1.00000000,  0.22707551,  0.00000000,
+	1.00000000,  0.23443485,  0.00000000,
+	1.00000000,  0.24158602,  0.00000000,
+	1.00000000,  0.24847223,  0.00000000,
+	1.00000000,  0.25503671,  0.00000000,
+	1.00000000,  0.26128765,  0.00000000,
+	1.00000000,  0.26728849,  0.00000000,
+	1.00000000,  0.27306529,  0.00000000,
+	1.00000000,  0.27864415,  0.00000000,
+	1.00000000,  0.28405115,  0.00000000,
+	1.00000000,  0.28931236,  0.00000000,
+	1.00000000,  0.29445387,  0.00000000,
+	1.00000000,  0.29950175,  0.00000000,
+	1.00000000,  0.30448210,  0.00000000,
+	1.00000000,  0.30942099,  0.00000000,
+	1.00000000,  0.31428130,  0.00000000,
+	1.00000000,  0.31901535,  0.00000000,
+	1.00000000,  0.32363340,  0.00000000,
+	1.00000000,  0.32814572,  0.00000000,
+	1.00000000,  0.33256257,  0.00000000,
+	1.00000000,  0.33689420,  0.00000000,
+	1.00000000,  0.34115088,  0.00000000,
+	1.00000000,  0.34534286,  0.00000000,
+	1.00000000,  0.34948041,  0.00000000,
+	1.00000000,  0.35357379,  0.00000000,
+	1.00000000,  0.35760642,  0.00000000,
+	1.00000000,  0.36155846,  0.00000000,
+	1.00000000,  0.36543526,  0.00000000,
+	1.00000000,  0.36924216,  0.00000000,
+	1.00000000,  0.37298451,  0.00000000,
+	1.00000000,  0.37666766,  0.00000000,
+	1.00000000,  0.38029696,  0.00000000,
+	1.00000000,  0.38387776,  0.00000000,
+	1.00000000,  0.38741540,  0.00000000,
+	1.00000000,  0.39091524,  0.00000000,
+	1.00000000,  0.39436793,  0.00000000,
+	1.00000000,  0.39776273,  0.00000000,
+	1.00000000,  0.40110289,  0.00000000,
+	1.00000000,  0.40439169,  0.00000000,
+	1.00000000,  0.40763237,  0.00000000,
+	1.00000000,  0.41082820,  0.00000000,
+	1.00000000,  0.41398244,  0.00000000,
+	1.00000000,  0.41709834,  0.00000000,
+	1.00000000,  0.42017916,  0.00000000,
+	1.00000000,  0.42322816,  0.00000000,
+	1.00000000,  0.42623934,  0.00000000,
+	1.00000000,  0.42920597,  0.00000000,
+	1.00000000,  0.43213024,  0.00000000,
+	1.00000000,  0.43501437,  0.00000000,
+	1.00000000,  0.43786054,  0.00000000,
+	1.00000000,  0.44067094,  0.00000000,
+	1.00000000,  0.44344778,  0.00000000,
+	1.00000000,  0.44619324,  0.00000000,
+	1.00000000,  0.44890953,  0.00000000,
+	1.00000000,  0.45159884,  0.00000000,
+	1.00000000,  0.45425696,  0.00000000,
+	1.00000000,  0.45687928,  0.00000000,
+	1.00000000,  0.45946738,  0.00000000,
+	1.00000000,  0.46202285,  0.00000000,
+	1.00000000,  0.46454727,  0.00000000,
+	1.00000000,  0.46704223,  0.00000000,
+	1.00000000,  0.46950932,  0.00000000,
+	1.00000000,  0.47195011,  0.00000000,
+	1.00000000,  0.47436620,  0.00000000,
+	1.00000000,  0.47675916,  0.00000000,
+	1.00000000,  0.47912588,  0.00000000,
+	1.00000000,  0.48146298,  0.00000000,
+	1.00000000,  0.48377165,  0.00000000,
+	1.00000000,  0.48605310,  0.00000000,
+	1.00000000,  0.48830854,  0.00000000,
+	1.00000000,  0.49053916,  0.00000000,
+	1.00000000,  0.49274616,  0.00000000,
+	1.00000000,  0.49493074,  0.00000000,
+	1.00000000,  0.49709411,  0.00000000,
+	1.00000000,  0.49923747,  0.00000000,
+	1.00000000,  0.50133168,  0.00000000,
+	1.00000000,  0.50335932,  0.00000000,
+	1.00000000,  0.50533914,  0.00000000,
+	1.00000000,  0.50728989,  0.00000000,
+	1.00000000,  0.50923032,  0.00000000,
+	1.00000000,  0.51117920,  0.00000000,
+	1.00000000,  0.51315527,  0.00000000,
+	1.00000000,  0.51517730,  0.00000000,
+	1.00000000,  0.51726402,  0.00000000,
+	1.00000000,  0.51943421,  0.00000000,
+	1.00000000,  0.52169720,  0.00882820,
+	1.00000000,  0.52403873,  0.01788700,
+	1.00000000,  0.52644217,  0.02707758,
+	1.00000000,  0.52889085,  0.03630110,
+	1.00000000,  0.53136813,  0.04545874,
+	1.00000000,  0.53385736,  0.05445165,
+	1.00000000,  0.53634189,  0.06318102,
+	1.00000000,  0.53880507,  0.07154800,
+	1.00000000,  0.54123025,  0.07945377,
+	1.00000000,  0.54360078,  0.08679949, /* 2000K */
+	1.00000000,  0.54592984,  0.09356826,
+	1.00000000,  0.54824200,  0.09985317,
+	1.00000000,  0.55053774,  0.10572041,
+	1.00000000,  0.55281753,  0.11123615,
+	1.00000000,  0.55508183,  0.11646657,
+	1.00000000,  0.55733111,  0.12147785,
+	1.00000000,  0.55956583,  0.12633617,
+	1.00000000,  0.56178647,  0.13110770,
+	1.00000000,  0.56399349,  0.13585863,
+	1.00000000,  0.56618736,  0.14065513,
+	1.00000000,  0.56836698,  0.14541656,
+	1.00000000,  0.57053126,  0.15002947,
+	1.00000000,  0.57268067,  0.15451088,
+	1.00000000,  0.57481569,  0.15887778,
+	1.00000000,  0.57693677,  0.16314716,
+	1.00000000,  0.57904440,  0.16733604,
+	1.00000000,  0.58113904,  0.17146140,
+	1.00000000,  0.58322117,  0.17554025,
+	1.00000000,  0.58529125,  0.17958959,
+	1.00000000,  0.58734976,  0.18362641,
+	1.00000000,  0.58939572,  0.18762753,
+	1.00000000,  0.59142810,  0.19156245,
+	1.00000000,  0.59344729,  0.19543717,
+	1.00000000,  0.59545367,  0.19925770,
+	1.00000000,  0.59744765,  0.20303007,
+	1.00000000,  0.59942960,  0.20676027,
+	1.00000000,  0.60139991,  0.21045434,
+	1.00000000,  0.60335898,  0.21411827,
+	1.00000000,  0.60530719,  0.21775808,
+	1.00000000,  0.60724493,  0.22137978,
+	1.00000000,  0.60917139,  0.22497409,
+	1.00000000,  0.61108571,  0.22852960,
+	1.00000000,  0.61298822,  0.23204917,
+	1.00000000,  0.61487925,  0.23553565,
+	1.00000000,  0.61675912,  0.23899190,
+	1.00000000,  0.61862815,  0.24242076,
+	1.00000000,  0.62048668,  0.24582510,
+	1.00000000,  0.62233502,  0.24920777,
+	1.00000000,  0.62417352,  0.25257162,
+	1.00000000,  0.62600248,  0.25591950,
+	1.00000000,  0.62782123,  0.25924667,
+	1.00000000,  0.62962904,  0.26254752,
+	1.00000000,  0.63142619,  0.26582364,
+	1.00000000,  0.63321296,  0.26907661,
+	1.00000000,  0.63498963,  0.27230801,
+	1.00000000,  0.63675646,  0.27551942,
+	1.00000000,  0.63851375,  0.27871243,
+	1.00000000,  0.64026177,  0.28188860,
+	1.00000000,  0.64200079,  0.28504953,
+	1.00000000,  0.64373109,  0.28819679,
+	1.00000000,  0.64545209,  0.29132762,
+	1.00000000,  0.64716316,  0.29443883,
+	1.00000000,  0.64886455,  0.29753140,
+	1.00000000,  0.65055650,  0.30060630,
+	1.00000000,  0.65223924,  0.30366448,
+	1.00000000,  0.65391301,  0.30670692,
+	1.00000000,  0.65557805,  0.30973459,
+	1.00000000,  0.65723461,  0.31274845,
+	1.00000000,  0.65888291,  0.31574948,
+	1.00000000,  0.66052319,  0.31873863,
+	1.00000000,  0.66215495,  0.32171415,
+	1.00000000,  0.66377766,  0.32467406,
+	1.00000000,  0.66539152,  0.32761898,
+	1.00000000,  0.66699674,  0.33054957,
+	1.00000000,  0.66859353,  0.33346645,
+	1.00000000,  0.67018209,  0.33637027,
+	1.00000000,  0.67176263,  0.33926165,
+	1.00000000,  0.67333536,  0.34214124,
+	1.00000000,  0.67490049,  0.34500967,
+	1.00000000,  0.67645822,  0.34786758,
+	1.00000000,  0.67800811,  0.35071377,
+	1.00000000,  0.67954969,  0.35354693,
+	1.00000000,  0.68108315,  0.35636748,
+	1.00000000,  0.68260867,  0.35917589,
+	1.00000000,  0.68412643,  0.36197258,
+	1.00000000,  0.68563661,  0.36475800,
+	1.00000000,  0.68713940,  0.36753260,
+	1.00000000,  0.68863497,  0.37029682,
+	1.00000000,  0.69012350,  0.37305110,
+	1.00000000,  0.69160518,  0.37579588,
+	1.00000000,  0.69307962,  0.37853032,
+	1.00000000,  0.69454640,  0.38125347,
+	1.00000000,  0.69600570,  0.38396566,
+	1.00000000,  0.69745766,  0.38666722,
+	1.00000000,  0.69890246,  0.38935846,
+	1.00000000,  0.70034024,  0.39203971,
+	1.00000000,  0.70177118,  0.39471130,
+	1.00000000,  0.70319542,  0.39737354,
+	1.00000000,  0.70461314,  0.40002676,
+	1.00000000,  0.70602449,  0.40267128,
+	1.00000000,  0.70742912,  0.40530647,
+	1.00000000,  0.70882668,  0.40793163,
+	1.00000000,  0.71021730,  0.41054702,
+	1.00000000,  0.71160114,  0.41315287,
+	1.00000000,  0.71297833,  0.41574943,
+	1.00000000,  0.71434901,  0.41833696,
+	1.00000000,  0.71571332,  0.42091568,
+	1.00000000,  0.71707142,  0.42348585,
+	1.00000000,  0.71842343,  0.42604772,
+	1.00000000,  0.71976951,  0.42860152, /* 3000K */
+	1.00000000,  0.72110934,  0.43114677,
+	1.00000000,  0.72244260,  0.43368293,
+	1.00000000,  0.72376943,  0.43621021,
+	1.00000000,  0.72508994,  0.43872879,
+	1.00000000,  0.72640427,  0.44123886,
+	1.00000000,  0.72771255,  0.44374062,
+	1.00000000,  0.72901489,  0.44623426,
+	1.00000000,  0.73031143,  0.44871997,
+	1.00000000,  0.73160229,  0.45119795,
+	1.00000000,  0.73288760,  0.45366838,
+	1.00000000,  0.73416709,  0.45613088,
+	1.00000000,  0.73544046,  0.45858502,
+	1.00000000,  0.73670784,  0.46103096,
+	1.00000000,  0.73796933,  0.46346886,
+	1.00000000,  0.73922505,  0.46589887,
+	1.00000000,  0.74047512,  0.46832116,
+	1.00000000,  0.74171965,  0.47073586,
+	1.00000000,  0.74295875,  0.47314314,
+	1.00000000,  0.74419253,  0.47554317,
+	1.00000000,  0.74542112,  0.47793608,
+	1.00000000,  0.74664426,  0.48032156,
+	1.00000000,  0.74786169,  0.48269927,
+	1.00000000,  0.74907353,  0.48506933,
+	1.00000000,  0.75027986,  0.48743188,
+	1.00000000,  0.75148079,  0.48978704,
+	1.00000000,  0.75267644,  0.49213495,
+	1.00000000,  0.75386689,  0.49447573,
+	1.00000000,  0.75505226,  0.49680952,
+	1.00000000,  0.75623264,  0.49913644,
+	1.00000000,  0.75740814,  0.50145662,
+	1.00000000,  0.75857853,  0.50376979,
+	1.00000000,  0.75974359,  0.50607567,
+	1.00000000,  0.76090340,  0.50837435,
+	1.00000000,  0.76205805,  0.51066597,
+	1.00000000,  0.76320765,  0.51295061,
+	1.00000000,  0.76435228,  0.51522840,
+	1.00000000,  0.76549204,  0.51749945,
+	1.00000000,  0.76662703,  0.51976386,
+	1.00000000,  0.76775732,  0.52202175,
+	1.00000000,  0.76888303,  0.52427322,
+	1.00000000,  0.77000394,  0.52651804,
+	1.00000000,  0.77111984,  0.52875597,
+	1.00000000,  0.77223082,  0.53098710,
+	1.00000000,  0.77333696,  0.53321153,
+	1.00000000,  0.77443835,  0.53542935,
+	1.00000000,  0.77553507,  0.53764065,
+	1.00000000,  0.77662721,  0.53984555,
+	1.00000000,  0.77771485,  0.54204412,
+	1.00000000,  0.77879809,  0.54423646,
+	1.00000000,  0.77987699,  0.54642268,
+	1.00000000,  0.78095138,  0.54860256,
+	1.00000000,  0.78202106,  0.55077589,
+	1.00000000,  0.78308612,  0.55294276,
+	1.00000000,  0.78414662,  0.55510325,
+	1.00000000,  0.78520265,  0.55725744,
+	1.00000000,  0.78625429,  0.55940542,
+	1.00000000,  0.78730160,  0.56154727,
+	1.00000000,  0.78834468,  0.56368308,
+	1.00000000,  0.78938360,  0.56581294,
+	1.00000000,  0.79041843,  0.56793692,
+	1.00000000,  0.79144901,  0.57005485,
+	1.00000000,  0.79247515,  0.57216652,
+	1.00000000,  0.79349693,  0.57427203,
+	1.00000000,  0.79451443,  0.57637145,
+	1.00000000,  0.79552770,  0.57846484,
+	1.00000000,  0.79653683,  0.58055229,
+	1.00000000,  0.79754189,  0.58263387,
+	1.00000000,  0.79854294,  0.58470966,
+	1.00000000,  0.79954006,  0.58677974,
+	1.00000000,  0.80053332,  0.58884417,
+	1.00000000,  0.80152256,  0.59090280,
+	1.00000000,  0.80250762,  0.59295545,
+	1.00000000,  0.80348857,  0.59500219,
+	1.00000000,  0.80446547,  0.59704309,
+	1.00000000,  0.80543838,  0.59907822,
+	1.00000000,  0.80640738,  0.60110764,
+	1.00000000,  0.80737252,  0.60313144,
+	1.00000000,  0.80833388,  0.60514967,
+	1.00000000,  0.80929152,  0.60716240,
+	1.00000000,  0.81024551,  0.60916971,
+	1.00000000,  0.81119570,  0.61117144,
+	1.00000000,  0.81214193,  0.61316743,
+	1.00000000,  0.81308428,  0.61515776,
+	1.00000000,  0.81402280,  0.61714247,
+	1.00000000,  0.81495755,  0.61912164,
+	1.00000000,  0.81588859,  0.62109533,
+	1.00000000,  0.81681599,  0.62306360,
+	1.00000000,  0.81773981,  0.62502652,
+	1.00000000,  0.81866010,  0.62698414,
+	1.00000000,  0.81957693,  0.62893653,
+	1.00000000,  0.82049016,  0.63088355,
+	1.00000000,  0.82139966,  0.63282506,
+	1.00000000,  0.82230547,  0.63476112,
+	1.00000000,  0.82320766,  0.63669178,
+	1.00000000,  0.82410629,  0.63861710,
+	1.00000000,  0.82500140,  0.64053714,
+	1.00000000,  0.82589306,  0.64245197,
+	1.00000000,  0.82678131,  0.64436163,
+	1.00000000,  0.82766623,  0.64626619,
+	1.00000000,  0.82854786,  0.64816570, /* 4000K */
+	1.00000000,  0.82942608,  0.65006004,
+	1.00000000,  0.83030076,  0.65194907,
+	1.00000000,  0.83117195,  0.65383284,
+	1.00000000,  0.83203970,  0.65571142,
+	1.00000000,  0.83290407,  0.65758485,
+	1.00000000,  0.83376512,  0.65945319,
+	1.00000000,  0.83462288,  0.66131649,
+	1.00000000,  0.83547742,  0.66317482,
+	1.00000000,  0.83632879,  0.66502821,
+	1.00000000,  0.83717703,  0.66687674,
+	1.00000000,  0.83802204,  0.66872027,
+	1.00000000,  0.83886369,  0.67055868,
+	1.00000000,  0.83970203,  0.67239203,
+	1.00000000,  0.84053711,  0.67422036,
+	1.00000000,  0.84136898,  0.67604372,
+	1.00000000,  0.84219769,  0.67786217,
+	1.00000000,  0.84302329,  0.67967576,
+	1.00000000,  0.84384582,  0.68148454,
+	1.00000000,  0.84466533,  0.68328855,
+	1.00000000,  0.84548188,  0.68508786,
+	1.00000000,  0.84629535,  0.68688234,
+	1.00000000,  0.84710563,  0.68867189,
+	1.00000000,  0.84791277,  0.69045654,
+	1.00000000,  0.84871682,  0.69223634,
+	1.00000000,  0.84951781,  0.69401135,
+	1.00000000,  0.85031579,  0.69578162,
+	1.00000000,  0.85111082,  0.69754718,
+	1.00000000,  0.85190293,  0.69930809,
+	1.00000000,  0.85269217,  0.70106440,
+	1.00000000,  0.85347859,  0.70281616,
+	1.00000000,  0.85426208,  0.70456325,
+	1.00000000,  0.85504254,  0.70630557,
+	1.00000000,  0.85582002,  0.70804316,
+	1.00000000,  0.85659455,  0.70977607,
+	1.00000000,  0.85736618,  0.71150435,
+	1.00000000,  0.85813494,  0.71322803,
+	1.00000000,  0.85890090,  0.71494717,
+	1.00000000,  0.85966407,  0.71666181,
+	1.00000000,  0.86042452,  0.71837199,
+	1.00000000,  0.86118227,  0.72007777,
+	1.00000000,  0.86193724,  0.72177904,
+	1.00000000,  0.86268933,  0.72347569,
+	1.00000000,  0.86343857,  0.72516777,
+	1.00000000,  0.86418501,  0.72685532,
+	1.00000000,  0.86492869,  0.72853839,
+	1.00000000,  0.86566965,  0.73021701,
+	1.00000000,  0.86640792,  0.73189124,
+	1.00000000,  0.86714355,  0.73356111,
+	1.00000000,  0.86787658,  0.73522667,
+	1.00000000,  0.86860704,  0.73688797,
+	1.00000000,  0.86933485,  0.73854490,
+	1.00000000,  0.87005991,  0.74019737,
+	1.00000000,  0.87078227,  0.74184541,
+	1.00000000,  0.87150196,  0.74348907,
+	1.00000000,  0.87221901,  0.74512838,
+	1.00000000,  0.87293347,  0.74676340,
+	1.00000000,  0.87364538,  0.74839416,
+	1.00000000,  0.87435476,  0.75002071,
+	1.00000000,  0.87506166,  0.75164308,
+	1.00000000,  0.87576611,  0.75326132,
+	1.00000000,  0.87646803,  0.75487533,
+	1.00000000,  0.87716734,  0.75648502,
+	1.00000000,  0.87786407,  0.75809043,
+	1.00000000,  0.87855825,  0.75969159,
+	1.00000000,  0.87924993,  0.76128855,
+	1.00000000,  0.87993913,  0.76288134,
+	1.00000000,  0.88062588,  0.76447002,
+	1.00000000,  0.88131024,  0.76605460,
+	1.00000000,  0.88199222,  0.76763515,
+	1.00000000,  0.88267187,  0.76921169,
+	1.00000000,  0.88334910,  0.77078414,
+	1.00000000,  0.88402385,  0.77235240,
+	1.00000000,  0.88469613,  0.77391651,
+	1.00000000,  0.88536598,  0.77547651,
+	1.00000000,  0.88603344,  0.77703244,
+	1.00000000,  0.88669854,  0.77858434,
+	1.00000000,  0.88736130,  0.78013224,
+	1.00000000,  0.88802177,  0.78167619,
+	1.00000000,  0.88867998,  0.78321621,
+	1.00000000,  0.88933596,  0.78475236,
+	1.00000000,  0.88998963,  0.78628454,
+	1.00000000,  0.89064093,  0.78781266,
+	1.00000000,  0.89128987,  0.78933677,
+	1.00000000,  0.89193650,  0.79085689,
+	1.00000000,  0.89258084,  0.79237307,
+	1.00000000,  0.89322293,  0.79388534,
+	1.00000000,  0.89386279,  0.79539373,
+	1.00000000,  0.89450045,  0.79689829,
+	1.00000000,  0.89513596,  0.79839906,
+	1.00000000,  0.89576933,  0.79989606,
+	1.00000000,  0.89639309,  0.80139218,
+	1.00000000,  0.89700306,  0.80288899,
+	1.00000000,  0.89760420,  0.80438453,
+	1.00000000,  0.89820149,  0.80587688,
+	1.00000000,  0.89879988,  0.80736408,
+	1.00000000,  0.89940434,  0.80884420,
+	1.00000000,  0.90001985,  0.81031529,
+	1.00000000,  0.90065137,  0.81177542,
+	1.00000000,  0.90130386,  0.81322265,
+	1.00000000,  0.90198230,  0.81465502, /* 5000K */
+	1.00000000,  0.90268977,  0.81607042,
+	1.00000000,  0.90342283,  0.81746968,
+	1.00000000,  0.90417667,  0.81885530,
+	1.00000000,  0.90494647,  0.82022976,
+	1.00000000,  0.90572742,  0.82159557,
+	1.00000000,  0.90651469,  0.82295522,
+	1.00000000,  0.90730347,  0.82431120,
+	1.00000000,  0.90808894,  0.82566601,
+	1.00000000,  0.90886628,  0.82702215,
+	1.00000000,  0.90963069,  0.82838210,
+	1.00000000,  0.91038616,  0.82974378,
+	1.00000000,  0.91113992,  0.83110345,
+	1.00000000,  0.91189197,  0.83246110,
+	1.00000000,  0.91264232,  0.83381675,
+	1.00000000,  0.91339097,  0.83517040,
+	1.00000000,  0.91413792,  0.83652206,
+	1.00000000,  0.91488319,  0.83787173,
+	1.00000000,  0.91562677,  0.83921943,
+	1.00000000,  0.91636867,  0.84056514,
+	1.00000000,  0.91710889,  0.84190889,
+	1.00000000,  0.91784742,  0.84325066,
+	1.00000000,  0.91858426,  0.84459044,
+	1.00000000,  0.91931940,  0.84592822,
+	1.00000000,  0.92005285,  0.84726403,
+	1.00000000,  0.92078461,  0.84859785,
+	1.00000000,  0.92151471,  0.84992970,
+	1.00000000,  0.92224313,  0.85125958,
+	1.00000000,  0.92296988,  0.85258749,
+	1.00000000,  0.92369498,  0.85391343,
+	1.00000000,  0.92441842,  0.85523742,
+	1.00000000,  0.92514019,  0.85655944,
+	1.00000000,  0.92586029,  0.85787948,
+	1.00000000,  0.92657870,  0.85919755,
+	1.00000000,  0.92729545,  0.86051365,
+	1.00000000,  0.92801053,  0.86182779,
+	1.00000000,  0.92872396,  0.86313995,
+	1.00000000,  0.92943574,  0.86445016,
+	1.00000000,  0.93014588,  0.86575841,
+	1.00000000,  0.93085439,  0.86706470,
+	1.00000000,  0.93156127,  0.86836903,
+	1.00000000,  0.93226651,  0.86967140,
+	1.00000000,  0.93297008,  0.87097181,
+	1.00000000,  0.93367201,  0.87227026,
+	1.00000000,  0.93437228,  0.87356675,
+	1.00000000,  0.93507093,  0.87486127,
+	1.00000000,  0.93576794,  0.87615384,
+	1.00000000,  0.93646333,  0.87744445,
+	1.00000000,  0.93715711,  0.87873311,
+	1.00000000,  0.93784928,  0.88001982,
+	1.00000000,  0.93853986,  0.88130458,
+	1.00000000,  0.93922882,  0.88258738,
+	1.00000000,  0.93991615,  0.88386823,
+	1.00000000,  0.94060185,  0.88514712,
+	1.00000000,  0.94128593,  0.88642406,
+	1.00000000,  0.94196840,  0.88769904,
+	1.00000000,  0.94264927,  0.88897207,
+	1.00000000,  0.94332856,  0.89024315,
+	1.00000000,  0.94400626,  0.89151228,
+	1.00000000,  0.94468238,  0.89277946,
+	1.00000000,  0.94535695,  0.89404470,
+	1.00000000,  0.94602993,  0.89530799,
+	1.00000000,  0.94670130,  0.89656932,
+	1.00000000,  0.94737108,  0.89782870,
+	1.00000000,  0.94803926,  0.89908613,
+	1.00000000,  0.94870587,  0.90034161,
+	1.00000000,  0.94937091,  0.90159515,
+	1.00000000,  0.95003439,  0.90284673,
+	1.00000000,  0.95069633,  0.90409638,
+	1.00000000,  0.95135672,  0.90534407,
+	1.00000000,  0.95201559,  0.90658983,
+	1.00000000,  0.95267290,  0.90783364,
+	1.00000000,  0.95332864,  0.90907550,
+	1.00000000,  0.95398282,  0.91031542,
+	1.00000000,  0.95463543,  0.91155339,
+	1.00000000,  0.95528651,  0.91278941,
+	1.00000000,  0.95593605,  0.91402349,
+	1.00000000,  0.95658406,  0.91525563,
+	1.00000000,  0.95723056,  0.91648583,
+	1.00000000,  0.95787556,  0.91771409,
+	1.00000000,  0.95851906,  0.91894041,
+	1.00000000,  0.95916105,  0.92016479,
+	1.00000000,  0.95980149,  0.92138723,
+	1.00000000,  0.96044040,  0.92260772,
+	1.00000000,  0.96107779,  0.92382627,
+	1.00000000,  0.96171367,  0.92504288,
+	1.00000000,  0.96234805,  0.92625756,
+	1.00000000,  0.96298094,  0.92747029,
+	1.00000000,  0.96361235,  0.92868109,
+	1.00000000,  0.96424230,  0.92988996,
+	1.00000000,  0.96487079,  0.93109690,
+	1.00000000,  0.96549780,  0.93230190,
+	1.00000000,  0.96612330,  0.93350496,
+	1.00000000,  0.96674731,  0.93470609,
+	1.00000000,  0.96736983,  0.93590527,
+	1.00000000,  0.96799088,  0.93710253,
+	1.00000000,  0.96861046,  0.93829785,
+	1.00000000,  0.96922860,  0.93949124,
+	1.00000000,  0.96984529,  0.94068270,
+	1.00000000,  0.97046055,  0.94187224,
+	1.00000000,  0.97107439,  0.94305985, /* 6000K */
+	1.00000000,  0.97168679,  0.94424553,
+	1.00000000,  0.97229771,  0.94542928,
+	1.00000000,  0.97290718,  0.94661110,
+	1.00000000,  0.97351520,  0.94779099,
+	1.00000000,  0.97412178,  0.94896895,
+	1.00000000,  0.97472693,  0.95014498,
+	1.00000000,  0.97533067,  0.95131910,
+	1.00000000,  0.97593301,  0.95249129,
+	1.00000000,  0.97653395,  0.95366157,
+	1.00000000,  0.97713351,  0.95482993,
+	1.00000000,  0.97773166,  0.95599637,
+	1.00000000,  0.97832839,  0.95716088,
+	1.00000000,  0.97892368,  0.95832347,
+	1.00000000,  0.97951757,  0.95948414,
+	1.00000000,  0.98011006,  0.96064289,
+	1.00000000,  0.98070116,  0.96179972,
+	1.00000000,  0.98129088,  0.96295464,
+	1.00000000,  0.98187923,  0.96410765,
+	1.00000000,  0.98246623,  0.96525875,
+	1.00000000,  0.98305189,  0.96640795,
+	1.00000000,  0.98363618,  0.96755524,
+	1.00000000,  0.98421906,  0.96870060,
+	1.00000000,  0.98480057,  0.96984405,
+	1.00000000,  0.98538070,  0.97098559,
+	1.00000000,  0.98595947,  0.97212522,
+	1.00000000,  0.98653688,  0.97326295,
+	1.00000000,  0.98711296,  0.97439877,
+	1.00000000,  0.98768771,  0.97553269,
+	1.00000000,  0.98826114,  0.97666472,
+	1.00000000,  0.98883326,  0.97779486,
+	1.00000000,  0.98940405,  0.97892310,
+	1.00000000,  0.98997349,  0.98004942,
+	1.00000000,  0.99054157,  0.98117385,
+	1.00000000,  0.99110832,  0.98229637,
+	1.00000000,  0.99167375,  0.98341699,
+	1.00000000,  0.99223786,  0.98453572,
+	1.00000000,  0.99280067,  0.98565257,
+	1.00000000,  0.99336219,  0.98676752,
+	1.00000000,  0.99392242,  0.98788060,
+	1.00000000,  0.99448139,  0.98899179,
+	1.00000000,  0.99508816,  0.99010025,
+	1.00000000,  0.99577000,  0.99120551,
+	1.00000000,  0.99649417,  0.99230812,
+	1.00000000,  0.99722795,  0.99340866,
+	1.00000000,  0.99793862,  0.99450769,
+	1.00000000,  0.99859345,  0.99560577,
+	1.00000000,  0.99915973,  0.99670348,
+	1.00000000,  0.99960473,  0.99780138,
+	1.00000000,  0.99989573,  0.99890003,
+	1.00000000,  1.00000000,  1.00000000,
+	0.99894590,  0.99987512,  1.00000000,
+	0.99788867,  0.99952704,  1.00000000,
+	0.99682965,  0.99899559,  1.00000000,
+	0.99577019,  0.99832060,  1.00000000,
+	0.99471162,  0.99754192,  1.00000000,
+	0.99365528,  0.99669937,  1.00000000,
+	0.99260252,  0.99583279,  1.00000000,
+	0.99155466,  0.99498202,  1.00000000,
+	0.99051306,  0.99418689,  1.00000000,
+	0.98947904,  0.99348723,  1.00000000,
+	0.98845161,  0.99284991,  1.00000000,
+	0.98742883,  0.99221521,  1.00000000,
+	0.98641062,  0.99158310,  1.00000000,
+	0.98539690,  0.99095352,  1.00000000,
+	0.98438759,  0.99032644,  1.00000000,
+	0.98338261,  0.98970182,  1.00000000,
+	0.98238189,  0.98907963,  1.00000000,
+	0.98138535,  0.98845981,  1.00000000,
+	0.98039290,  0.98784233,  1.00000000,
+	0.97940448,  0.98722715,  1.00000000,
+	0.97842025,  0.98661436,  1.00000000,
+	0.97744039,  0.98600405,  1.00000000,
+	0.97646484,  0.98539618,  1.00000000,
+	0.97549351,  0.98479072,  1.00000000,
+	0.97452633,  0.98418763,  1.00000000,
+	0.97356324,  0.98358687,  1.00000000,
+	0.97260416,  0.98298840,  1.00000000,
+	0.97164901,  0.98239218,  1.00000000,
+	0.97069774,  0.98179819,  1.00000000,
+	0.96975025,  0.98120637,  1.00000000,
+	0.96880672,  0.98061682,  1.00000000,
+	0.96786731,  0.98002962,  1.00000000,
+	0.96693195,  0.97944473,  1.00000000,
+	0.96600057,  0.97886213,  1.00000000,
+	0.96507311,  0.97828176,  1.00000000,
+	0.96414950,  0.97770361,  1.00000000,
+	0.96322968,  0.97712764,  1.00000000,
+	0.96231357,  0.97655380,  1.00000000,
+	0.96140111,  0.97598206,  1.00000000,
+	0.96049223,  0.97541240,  1.00000000,
+	0.95958727,  0.97484500,  1.00000000,
+	0.95868647,  0.97428000,  1.00000000,
+	0.95778965,  0.97371731,  1.00000000,
+	0.95689664,  0.97315680,  1.00000000,
+	0.95600724,  0.97259837,  1.00000000,
+	0.95512128,  0.97204190,  1.00000000,
+	0.95423856,  0.97148730,  1.00000000,
+	0.95335890,  0.97093445,  1.00000000,
+	0.95248213,  0.97038323,  1.00000000,
+	0.95160805,  0.96983355,  1.00000000, /* 7000K */
+	0.95073670,  0.96928540,  1.00000000,
+	0.94986828,  0.96873891,  1.00000000,
+	0.94900288,  0.96819413,  1.00000000,
+	0.94814057,  0.96765111,  1.00000000,
+	0.94728145,  0.96710992,  1.00000000,
+	0.94642558,  0.96657061,  1.00000000,
+	0.94557306,  0.96603324,  1.00000000,
+	0.94472397,  0.96549786,  1.00000000,
+	0.94387838,  0.96496454,  1.00000000,
+	0.94303638,  0.96443333,  1.00000000,
+	0.94219800,  0.96390424,  1.00000000,
+	0.94136317,  0.96337720,  1.00000000,
+	0.94053183,  0.96285219,  1.00000000,
+	0.93970391,  0.96232917,  1.00000000,
+	0.93887934,  0.96180811,  1.00000000,
+	0.93805806,  0.96128895,  1.00000000,
+	0.93724000,  0.96077169,  1.00000000,
+	0.93642510,  0.96025626,  1.00000000,
+	0.93561329,  0.95974264,  1.00000000,
+	0.93480451,  0.95923080,  1.00000000,
+	0.93399889,  0.95872080,  1.00000000,
+	0.93319657,  0.95821273,  1.00000000,
+	0.93239750,  0.95770654,  1.00000000,
+	0.93160162,  0.95720223,  1.00000000,
+	0.93080889,  0.95669975,  1.00000000,
+	0.93001925,  0.95619908,  1.00000000,
+	0.92923265,  0.95570020,  1.00000000,
+	0.92844904,  0.95520306,  1.00000000,
+	0.92766836,  0.95470765,  1.00000000,
+	0.92689056,  0.95421394,  1.00000000,
+	0.92611576,  0.95372199,  1.00000000,
+	0.92534407,  0.95323186,  1.00000000,
+	0.92457546,  0.95274352,  1.00000000,
+	0.92380986,  0.95225696,  1.00000000,
+	0.92304724,  0.95177214,  1.00000000,
+	0.92228753,  0.95128905,  1.00000000,
+	0.92153071,  0.95080764,  1.00000000,
+	0.92077670,  0.95032790,  1.00000000,
+	0.92002547,  0.94984979,  1.00000000,
+	0.91927697,  0.94937330,  1.00000000,
+	0.91853130,  0.94889848,  1.00000000,
+	0.91778859,  0.94842539,  1.00000000,
+	0.91704877,  0.94795401,  1.00000000,
+	0.91631181,  0.94748431,  1.00000000,
+	0.91557766,  0.94701627,  1.00000000,
+	0.91484627,  0.94654986,  1.00000000,
+	0.91411760,  0.94608506,  1.00000000,
+	0.91339161,  0.94562184,  1.00000000,
+	0.91266825,  0.94516018,  1.00000000,
+	0.91194747,  0.94470005,  1.00000000,
+	0.91122937,  0.94424151,  1.00000000,
+	0.91051407,  0.94378462,  1.00000000,
+	0.90980151,  0.94332935,  1.00000000,
+	0.90909165,  0.94287568,  1.00000000,
+	0.90838445,  0.94242359,  1.00000000,
+	0.90767987,  0.94197304,  1.00000000,
+	0.90697787,  0.94152403,  1.00000000,
+	0.90627840,  0.94107653,  1.00000000,
+	0.90558143,  0.94063050,  1.00000000,
+	0.90488690,  0.94018594,  1.00000000,
+	0.90419492,  0.93974289,  1.00000000,
+	0.90350557,  0.93930140,  1.00000000,
+	0.90281883,  0.93886146,  1.00000000,
+	0.90213465,  0.93842304,  1.00000000,
+	0.90145299,  0.93798611,  1.00000000,
+	0.90077382,  0.93755067,  1.00000000,
+	0.90009708,  0.93711668,  1.00000000,
+	0.89942275,  0.93668412,  1.00000000,
+	0.89875079,  0.93625298,  1.00000000,
+	0.89808115,  0.93582323,  1.00000000,
+	0.89741392,  0.93539492,  1.00000000,
+	0.89674920,  0.93496810,  1.00000000,
+	0.89608694,  0.93454274,  1.00000000,
+	0.89542712,  0.93411884,  1.00000000,
+	0.89476968,  0.93369636,  1.00000000,
+	0.89411460,  0.93327529,  1.00000000,
+	0.89346184,  0.93285561,  1.00000000,
+	0.89281136,  0.93243730,  1.00000000,
+	0.89216313,  0.93202033,  1.00000000,
+	0.89151710,  0.93160469,  1.00000000,
+	0.89087336,  0.93119042,  1.00000000,
+	0.89023200,  0.93077757,  1.00000000,
+	0.88959298,  0.93036612,  1.00000000,
+	0.88895627,  0.92995605,  1.00000000,
+	0.88832182,  0.92954734,  1.00000000,
+	0.88768962,  0.92913997,  1.00000000,
+	0.88705961,  0.92873393,  1.00000000,
+	0.88643178,  0.92832919,  1.00000000,
+	0.88580607,  0.92792573,  1.00000000,
+	0.88518247,  0.92752354,  1.00000000,
+	0.88456104,  0.92712266,  1.00000000,
+	0.88394187,  0.92672313,  1.00000000,
+	0.88332492,  0.92632493,  1.00000000,
+	0.88271016,  0.92592805,  1.00000000,
+	0.88209756,  0.92553247,  1.00000000,
+	0.88148709,  0.92513817,  1.00000000,
+	0.88087871,  0.92474513,  1.00000000,
+	0.88027239,  0.92435333,  1.00000000,
+	0.87966810,  0.92396276,  1.00000000,
+	0.87906581,  0.92357340,  1.00000000, /* 8000K */
+	0.87846559,  0.92318529,  1.00000000,
+	0.87786751,  0.92279846,  1.00000000,
+	0.87727154,  0.92241291,  1.00000000,
+	0.87667766,  0.92202862,  1.00000000,
+	0.87608583,  0.92164556,  1.00000000,
+	0.87549602,  0.92126372,  1.00000000,
+	0.87490820,  0.92088310,  1.00000000,
+	0.87432234,  0.92050365,  1.00000000,
+	0.87373842,  0.92012538,  1.00000000,
+	0.87315640,  0.91974827,  1.00000000,
+	0.87257635,  0.91937235,  1.00000000,
+	0.87199833,  0.91899766,  1.00000000,
+	0.87142233,  0.91862418,  1.00000000,
+	0.87084831,  0.91825191,  1.00000000,
+	0.87027624,  0.91788081,  1.00000000,
+	0.86970610,  0.91751089,  1.00000000,
+	0.86913785,  0.91714211,  1.00000000,
+	0.86857147,  0.91677448,  1.00000000,
+	0.86800694,  0.91640796,  1.00000000,
+	0.86744421,  0.91604254,  1.00000000,
+	0.86688336,  0.91567826,  1.00000000,
+	0.86632445,  0.91531516,  1.00000000,
+	0.86576745,  0.91495322,  1.00000000,
+	0.86521234,  0.91459243,  1.00000000,
+	0.86465909,  0.91423276,  1.00000000,
+	0.86410768,  0.91387421,  1.00000000,
+	0.86355807,  0.91351677,  1.00000000,
+	0.86301025,  0.91316041,  1.00000000,
+	0.86246417,  0.91280511,  1.00000000,
+	0.86191983,  0.91245088,  1.00000000,
+	0.86137727,  0.91209774,  1.00000000,
+	0.86083657,  0.91174571,  1.00000000,
+	0.86029768,  0.91139480,  1.00000000,
+	0.85976059,  0.91104499,  1.00000000,
+	0.85922528,  0.91069625,  1.00000000,
+	0.85869171,  0.91034859,  1.00000000,
+	0.85815987,  0.91000197,  1.00000000,
+	0.85762973,  0.90965640,  1.00000000,
+	0.85710126,  0.90931185,  1.00000000,
+	0.85657444,  0.90896831,  1.00000000,
+	0.85604933,  0.90862581,  1.00000000,
+	0.85552597,  0.90828439,  1.00000000,
+	0.85500436,  0.90794403,  1.00000000,
+	0.85448446,  0.90760472,  1.00000000,
+	0.85396625,  0.90726644,  1.00000000,
+	0.85344971,  0.90692919,  1.00000000,
+	0.85293481,  0.90659294,  1.00000000,
+	0.85242154,  0.90625769,  1.00000000,
+	0.85190986,  0.90592341,  1.00000000,
+	0.85139976,  0.90559011,  1.00000000,
+	0.85089129,  0.90525780,  1.00000000,
+	0.85038449,  0.90492653,  1.00000000,
+	0.84987935,  0.90459627,  1.00000000,
+	0.84937585,  0.90426701,  1.00000000,
+	0.84887397,  0.90393874,  1.00000000,
+	0.84837368,  0.90361145,  1.00000000,
+	0.84787495,  0.90328513,  1.00000000,
+	0.84737778,  0.90295976,  1.00000000,
+	0.84688213,  0.90263533,  1.00000000,
+	0.84638799,  0.90231183,  1.00000000,
+	0.84589540,  0.90198928,  1.00000000,
+	0.84540442,  0.90166772,  1.00000000,
+	0.84491501,  0.90134713,  1.00000000,
+	0.84442718,  0.90102751,  1.00000000,
+	0.84394088,  0.90070883,  1.00000000,
+	0.84345610,  0.90039109,  1.00000000,
+	0.84297283,  0.90007427,  1.00000000,
+	0.84249103,  0.89975837,  1.00000000,
+	0.84201070,  0.89944337,  1.00000000,
+	0.84153180,  0.89912926,  1.00000000,
+	0.84105439,  0.89881607,  1.00000000,
+	0.84057851,  0.89850381,  1.00000000,
+	0.84010414,  0.89819250,  1.00000000,
+	0.83963127,  0.89788210,  1.00000000,
+	0.83915987,  0.89757261,  1.00000000,
+	0.83868993,  0.89726402,  1.00000000,
+	0.83822142,  0.89695632,  1.00000000,
+	0.83775432,  0.89664950,  1.00000000,
+	0.83728862,  0.89634354,  1.00000000,
+	0.83682430,  0.89603843,  1.00000000,
+	0.83636140,  0.89573420,  1.00000000,
+	0.83589996,  0.89543088,  1.00000000,
+	0.83543997,  0.89512845,  1.00000000,
+	0.83498140,  0.89482690,  1.00000000,
+	0.83452425,  0.89452623,  1.00000000,
+	0.83406848,  0.89422642,  1.00000000,
+	0.83361409,  0.89392746,  1.00000000,
+	0.83316105,  0.89362934,  1.00000000,
+	0.83270935,  0.89333205,  1.00000000,
+	0.83225897,  0.89303558,  1.00000000,
+	0.83180995,  0.89273995,  1.00000000,
+	0.83136232,  0.89244519,  1.00000000,
+	0.83091608,  0.89215129,  1.00000000,
+	0.83047121,  0.89185824,  1.00000000,
+	0.83002769,  0.89156602,  1.00000000,
+	0.82958549,  0.89127463,  1.00000000,
+	0.82914462,  0.89098406,  1.00000000,
+	0.82870503,  0.89069429,  1.00000000,
+	0.82826673,  0.89040532,  1.00000000,
+	0.82782969,  0.89011714,  1.00000000, /* 9000K */
+	0.82739395,  0.88982977,  1.00000000,
+	0.82695955,  0.88954323,  1.00000000,
+	0.82652648,  0.88925751,  1.00000000,
+	0.82609471,  0.88897261,  1.00000000,
+	0.82566424,  0.88868851,  1.00000000,
+	0.82523504,  0.88840521,  1.00000000,
+	0.82480709,  0.88812269,  1.00000000,
+	0.82438040,  0.88784094,  1.00000000,
+	0.82395492,  0.88755996,  1.00000000,
+	0.82353066,  0.88727974,  1.00000000,
+	0.82310764,  0.88700029,  1.00000000,
+	0.82268591,  0.88672165,  1.00000000,
+	0.82226545,  0.88644379,  1.00000000,
+	0.82184624,  0.88616672,  1.00000000,
+	0.82142826,  0.88589041,  1.00000000,
+	0.82101151,  0.88561488,  1.00000000,
+	0.82059596,  0.88534009,  1.00000000,
+	0.82018161,  0.88506605,  1.00000000,
+	0.81976843,  0.88479275,  1.00000000,
+	0.81935641,  0.88452017,  1.00000000,
+	0.81894558,  0.88424834,  1.00000000,
+	0.81853599,  0.88397728,  1.00000000,
+	0.81812761,  0.88370698,  1.00000000,
+	0.81772043,  0.88343743,  1.00000000,
+	0.81731444,  0.88316862,  1.00000000,
+	0.81690961,  0.88290054,  1.00000000,
+	0.81650595,  0.88263320,  1.00000000,
+	0.81610343,  0.88236656,  1.00000000,
+	0.81570203,  0.88210064,  1.00000000,
+	0.81530175,  0.88183541,  1.00000000,
+	0.81490261,  0.88157090,  1.00000000,
+	0.81450466,  0.88130713,  1.00000000,
+	0.81410787,  0.88104409,  1.00000000,
+	0.81371223,  0.88078178,  1.00000000,
+	0.81331773,  0.88052017,  1.00000000,
+	0.81292435,  0.88025927,  1.00000000,
+	0.81253208,  0.87999907,  1.00000000,
+	0.81214091,  0.87973956,  1.00000000,
+	0.81175082,  0.87948073,  1.00000000,
+	0.81136180,  0.87922257,  1.00000000,
+	0.81097388,  0.87896510,  1.00000000,
+	0.81058709,  0.87870835,  1.00000000,
+	0.81020141,  0.87845229,  1.00000000,
+	0.80981685,  0.87819693,  1.00000000,
+	0.80943337,  0.87794226,  1.00000000,
+	0.80905097,  0.87768826,  1.00000000,
+	0.80866964,  0.87743494,  1.00000000,
+	0.80828936,  0.87718227,  1.00000000,
+	0.80791012,  0.87693027,  1.00000000,
+	0.80753191,  0.87667891,  1.00000000,
+	0.80715475,  0.87642822,  1.00000000,
+	0.80677868,  0.87617821,  1.00000000,
+	0.80640368,  0.87592887,  1.00000000,
+	0.80602974,  0.87568020,  1.00000000,
+	0.80565685,  0.87543220,  1.00000000,
+	0.80528500,  0.87518485,  1.00000000,
+	0.80491417,  0.87493814,  1.00000000,
+	0.80454435,  0.87469207,  1.00000000,
+	0.80417553,  0.87444663,  1.00000000,
+	0.80380769,  0.87420182,  1.00000000,
+	0.80344087,  0.87395765,  1.00000000,
+	0.80307509,  0.87371413,  1.00000000,
+	0.80271034,  0.87347126,  1.00000000,
+	0.80234661,  0.87322904,  1.00000000,
+	0.80198389,  0.87298746,  1.00000000,
+	0.80162216,  0.87274650,  1.00000000,
+	0.80126142,  0.87250616,  1.00000000,
+	0.80090165,  0.87226644,  1.00000000,
+	0.80054283,  0.87202733,  1.00000000,
+	0.80018497,  0.87178882,  1.00000000,
+	0.79982808,  0.87155093,  1.00000000,
+	0.79947219,  0.87131366,  1.00000000,
+	0.79911729,  0.87107703,  1.00000000,
+	0.79876338,  0.87084102,  1.00000000,
+	0.79841043,  0.87060561,  1.00000000,
+	0.79805843,  0.87037082,  1.00000000,
+	0.79770738,  0.87013662,  1.00000000,
+	0.79735727,  0.86990302,  1.00000000,
+	0.79700808,  0.86967000,  1.00000000,
+	0.79665980,  0.86943756,  1.00000000,
+	0.79631246,  0.86920572,  1.00000000,
+	0.79596608,  0.86897448,  1.00000000,
+	0.79562065,  0.86874385,  1.00000000,
+	0.79527617,  0.86851382,  1.00000000,
+	0.79493261,  0.86828437,  1.00000000,
+	0.79458998,  0.86805551,  1.00000000,
+	0.79424826,  0.86782723,  1.00000000,
+	0.79390743,  0.86759952,  1.00000000,
+	0.79356749,  0.86737238,  1.00000000,
+	0.79322843,  0.86714579,  1.00000000,
+	0.79289027,  0.86691978,  1.00000000,
+	0.79255304,  0.86669435,  1.00000000,
+	0.79221672,  0.86646951,  1.00000000,
+	0.79188131,  0.86624524,  1.00000000,
+	0.79154679,  0.86602154,  1.00000000,
+	0.79121316,  0.86579840,  1.00000000,
+	0.79088040,  0.86557582,  1.00000000,
+	0.79054851,  0.86535380,  1.00000000,
+	0.79021747,  0.86513231,  1.00000000,
+	0.78988728,  0.86491137,  1.00000000, /* 10000K */
+	0.78955796,  0.86469098,  1.00000000,
+	0.78922952,  0.86447115,  1.00000000,
+	0.78890197,  0.86425189,  1.00000000,
+	0.78857529,  0.86403318,  1.00000000,
+	0.78824947,  0.86381502,  1.00000000,
+	0.78792450,  0.86359740,  1.00000000,
+	0.78760038,  0.86338032,  1.00000000,
+	0.78727708,  0.86316377,  1.00000000,
+	0.78695462,  0.86294775,  1.00000000,
+	0.78663296,  0.86273225,  1.00000000,
+	0.78631214,  0.86251728,  1.00000000,
+	0.78599218,  0.86230286,  1.00000000,
+	0.78567306,  0.86208898,  1.00000000,
+	0.78535479,  0.86187564,  1.00000000,
+	0.78503735,  0.86166282,  1.00000000,
+	0.78472072,  0.86145053,  1.00000000,
+	0.78440491,  0.86123876,  1.00000000,
+	0.78408990,  0.86102750,  1.00000000,
+	0.78377568,  0.86081675,  1.00000000,
+	0.78346225,  0.86060650,  1.00000000,
+	0.78314962,  0.86039676,  1.00000000,
+	0.78283782,  0.86018756,  1.00000000,
+	0.78252683,  0.85997887,  1.00000000,
+	0.78221665,  0.85977070,  1.00000000,
+	0.78190728,  0.85956304,  1.00000000,
+	0.78159869,  0.85935589,  1.00000000,
+	0.78129088,  0.85914924,  1.00000000,
+	0.78098385,  0.85894309,  1.00000000,
+	0.78067758,  0.85873742,  1.00000000,
+	0.78037207,  0.85853224,  1.00000000,
+	0.78006733,  0.85832756,  1.00000000,
+	0.77976339,  0.85812338,  1.00000000,
+	0.77946024,  0.85791971,  1.00000000,
+	0.77915786,  0.85771654,  1.00000000,
+	0.77885626,  0.85751386,  1.00000000,
+	0.77855541,  0.85731168,  1.00000000,
+	0.77825533,  0.85710997,  1.00000000,
+	0.77795598,  0.85690875,  1.00000000,
+	0.77765738,  0.85670799,  1.00000000,
+	0.77735950,  0.85650771,  1.00000000,
+	0.77706237,  0.85630791,  1.00000000,
+	0.77676601,  0.85610859,  1.00000000,
+	0.77647041,  0.85590977,  1.00000000,
+	0.77617555,  0.85571142,  1.00000000,
+	0.77588144,  0.85551356,  1.00000000,
+	0.77558807,  0.85531616,  1.00000000,
+	0.77529542,  0.85511924,  1.00000000,
+	0.77500349,  0.85492277,  1.00000000,
+	0.77471228,  0.85472676,  1.00000000,
+	0.77442176,  0.85453121,  1.00000000,
+	0.77413197,  0.85433612,  1.00000000,
+	0.77384291,  0.85414150,  1.00000000,
+	0.77355459,  0.85394736,  1.00000000,
+	0.77326699,  0.85375368,  1.00000000,
+	0.77298010,  0.85356046,  1.00000000,
+	0.77269393,  0.85336770,  1.00000000,
+	0.77240846,  0.85317539,  1.00000000,
+	0.77212368,  0.85298353,  1.00000000,
+	0.77183958,  0.85279210,  1.00000000,
+	0.77155617,  0.85260112,  1.00000000,
+	0.77127345,  0.85241058,  1.00000000,
+	0.77099145,  0.85222051,  1.00000000,
+	0.77071015,  0.85203089,  1.00000000,
+	0.77042955,  0.85184171,  1.00000000,
+	0.77014964,  0.85165299,  1.00000000,
+	0.76987042,  0.85146470,  1.00000000,
+	0.76959187,  0.85127685,  1.00000000,
+	0.76931399,  0.85108943,  1.00000000,
+	0.76903678,  0.85090245,  1.00000000,
+	0.76876022,  0.85071588,  1.00000000,
+	0.76848433,  0.85052975,  1.00000000,
+	0.76820913,  0.85034406,  1.00000000,
+	0.76793461,  0.85015881,  1.00000000,
+	0.76766077,  0.84997400,  1.00000000,
+	0.76738759,  0.84978962,  1.00000000,
+	0.76711507,  0.84960566,  1.00000000,
+	0.76684321,  0.84942213,  1.00000000,
+	0.76657199,  0.84923901,  1.00000000,
+	0.76630141,  0.84905631,  1.00000000,
+	0.76603147,  0.84887402,  1.00000000,
+	0.76576217,  0.84869215,  1.00000000,
+	0.76549354,  0.84851070,  1.00000000,
+	0.76522557,  0.84832969,  1.00000000,
+	0.76495825,  0.84814909,  1.00000000,
+	0.76469157,  0.84796891,  1.00000000,
+	0.76442553,  0.84778914,  1.00000000,
+	0.76416012,  0.84760978,  1.00000000,
+	0.76389534,  0.84743082,  1.00000000,
+	0.76363117,  0.84725227,  1.00000000,
+	0.76336762,  0.84707411,  1.00000000,
+	0.76310469,  0.84689636,  1.00000000,
+	0.76284241,  0.84671902,  1.00000000,
+	0.76258075,  0.84654209,  1.00000000,
+	0.76231973,  0.84636557,  1.00000000,
+	0.76205933,  0.84618946,  1.00000000,
+	0.76179955,  0.84601374,  1.00000000,
+	0.76154037,  0.84583842,  1.00000000,
+	0.76128180,  0.84566349,  1.00000000,
+	0.76102383,  0.84548895,  1.00000000,
+	0.76076645,  0.84531479,  1.00000000, /* 11000K */
+	0.76050967,  0.84514102,  1.00000000,
+	0.76025352,  0.84496766,  1.00000000,
+	0.75999798,  0.84479469,  1.00000000,
+	0.75974304,  0.84462212,  1.00000000,
+	0.75948871,  0.84444994,  1.00000000,
+	0.75923497,  0.84427815,  1.00000000,
+	0.75898182,  0.84410674,  1.00000000,
+	0.75872926,  0.84393570,  1.00000000,
+	0.75847727,  0.84376505,  1.00000000,
+	0.75822586,  0.84359476,  1.00000000,
+	0.75797503,  0.84342485,  1.00000000,
+	0.75772480,  0.84325534,  1.00000000,
+	0.75747516,  0.84308621,  1.00000000,
+	0.75722611,  0.84291746,  1.00000000,
+	0.75697765,  0.84274908,  1.00000000,
+	0.75672975,  0.84258109,  1.00000000,
+	0.75648243,  0.84241346,  1.00000000,
+	0.75623567,  0.84224620,  1.00000000,
+	0.75598948,  0.84207931,  1.00000000,
+	0.75574383,  0.84191277,  1.00000000,
+	0.75549875,  0.84174660,  1.00000000,
+	0.75525425,  0.84158081,  1.00000000,
+	0.75501032,  0.84141539,  1.00000000,
+	0.75476696,  0.84125034,  1.00000000,
+	0.75452417,  0.84108566,  1.00000000,
+	0.75428193,  0.84092134,  1.00000000,
+	0.75404024,  0.84075738,  1.00000000,
+	0.75379910,  0.84059378,  1.00000000,
+	0.75355850,  0.84043052,  1.00000000,
+	0.75331843,  0.84026762,  1.00000000,
+	0.75307891,  0.84010507,  1.00000000,
+	0.75283995,  0.83994289,  1.00000000,
+	0.75260155,  0.83978107,  1.00000000,
+	0.75236369,  0.83961961,  1.00000000,
+	0.75212638,  0.83945850,  1.00000000,
+	0.75188961,  0.83929774,  1.00000000,
+	0.75165337,  0.83913733,  1.00000000,
+	0.75141766,  0.83897727,  1.00000000,
+	0.75118247,  0.83881754,  1.00000000,
+	0.75094780,  0.83865816,  1.00000000,
+	0.75071366,  0.83849912,  1.00000000,
+	0.75048006,  0.83834044,  1.00000000,
+	0.75024700,  0.83818210,  1.00000000,
+	0.75001447,  0.83802411,  1.00000000,
+	0.74978247,  0.83786647,  1.00000000,
+	0.74955098,  0.83770916,  1.00000000,
+	0.74932002,  0.83755220,  1.00000000,
+	0.74908956,  0.83739557,  1.00000000,
+	0.74885962,  0.83723926,  1.00000000,
+	0.74863017,  0.83708329,  1.00000000,
+	0.74840124,  0.83692765,  1.00000000,
+	0.74817283,  0.83677235,  1.00000000,
+	0.74794494,  0.83661740,  1.00000000,
+	0.74771757,  0.83646278,  1.00000000,
+	0.74749070,  0.83630849,  1.00000000,
+	0.74726434,  0.83615453,  1.00000000,
+	0.74703849,  0.83600090,  1.00000000,
+	0.74681312,  0.83584759,  1.00000000,
+	0.74658825,  0.83569461,  1.00000000,
+	0.74636386,  0.83554194,  1.00000000,
+	0.74613997,  0.83538960,  1.00000000,
+	0.74591658,  0.83523759,  1.00000000,
+	0.74569370,  0.83508591,  1.00000000,
+	0.74547132,  0.83493455,  1.00000000,
+	0.74524943,  0.83478352,  1.00000000,
+	0.74502803,  0.83463281,  1.00000000,
+	0.74480711,  0.83448242,  1.00000000,
+	0.74458667,  0.83433234,  1.00000000,
+	0.74436671,  0.83418257,  1.00000000,
+	0.74414722,  0.83403311,  1.00000000,
+	0.74392821,  0.83388397,  1.00000000,
+	0.74370969,  0.83373514,  1.00000000,
+	0.74349166,  0.83358664,  1.00000000,
+	0.74327411,  0.83343845,  1.00000000,
+	0.74305704,  0.83329058,  1.00000000,
+	0.74284045,  0.83314302,  1.00000000,
+	0.74262432,  0.83299577,  1.00000000,
+	0.74240866,  0.83284882,  1.00000000,
+	0.74219346,  0.83270217,  1.00000000,
+	0.74197871,  0.83255582,  1.00000000,
+	0.74176443,  0.83240978,  1.00000000,
+	0.74155063,  0.83226405,  1.00000000,
+	0.74133729,  0.83211863,  1.00000000,
+	0.74112443,  0.83197351,  1.00000000,
+	0.74091203,  0.83182870,  1.00000000,
+	0.74070008,  0.83168419,  1.00000000,
+	0.74048860,  0.83153998,  1.00000000,
+	0.74027756,  0.83139607,  1.00000000,
+	0.74006697,  0.83125245,  1.00000000,
+	0.73985682,  0.83110912,  1.00000000,
+	0.73964712,  0.83096609,  1.00000000,
+	0.73943789,  0.83082336,  1.00000000,
+	0.73922911,  0.83068093,  1.00000000,
+	0.73902078,  0.83053879,  1.00000000,
+	0.73881291,  0.83039696,  1.00000000,
+	0.73860548,  0.83025541,  1.00000000,
+	0.73839849,  0.83011416,  1.00000000,
+	0.73819193,  0.82997319,  1.00000000,
+	0.73798581,  0.82983251,  1.00000000,
+	0.73778012,  0.82969211,  1.00000000, /* 12000K */
+	0.73757487,  0.82955200,  1.00000000,
+	0.73737006,  0.82941218,  1.00000000,
+	0.73716569,  0.82927266,  1.00000000,
+	0.73696177,  0.82913342,  1.00000000,
+	0.73675828,  0.82899447,  1.00000000,
+	0.73655522,  0.82885580,  1.00000000,
+	0.73635259,  0.82871742,  1.00000000,
+	0.73615039,  0.82857931,  1.00000000,
+	0.73594860,  0.82844149,  1.00000000,
+	0.73574723,  0.82830393,  1.00000000,
+	0.73554628,  0.82816665,  1.00000000,
+	0.73534577,  0.82802966,  1.00000000,
+	0.73514569,  0.82789296,  1.00000000,
+	0.73494603,  0.82775653,  1.00000000,
+	0.73474680,  0.82762038,  1.00000000,
+	0.73454798,  0.82748451,  1.00000000,
+	0.73434958,  0.82734891,  1.00000000,
+	0.73415159,  0.82721358,  1.00000000,
+	0.73395401,  0.82707852,  1.00000000,
+	0.73375683,  0.82694373,  1.00000000,
+	0.73356006,  0.82680921,  1.00000000,
+	0.73336372,  0.82667496,  1.00000000,
+	0.73316779,  0.82654099,  1.00000000,
+	0.73297227,  0.82640730,  1.00000000,
+	0.73277717,  0.82627387,  1.00000000,
+	0.73258246,  0.82614071,  1.00000000,
+	0.73238817,  0.82600782,  1.00000000,
+	0.73219427,  0.82587519,  1.00000000,
+	0.73200076,  0.82574282,  1.00000000,
+	0.73180765,  0.82561071,  1.00000000,
+	0.73161494,  0.82547886,  1.00000000,
+	0.73142263,  0.82534729,  1.00000000,
+	0.73123073,  0.82521598,  1.00000000,
+	0.73103923,  0.82508493,  1.00000000,
+	0.73084813,  0.82495415,  1.00000000,
+	0.73065742,  0.82482363,  1.00000000,
+	0.73046710,  0.82469336,  1.00000000,
+	0.73027717,  0.82456336,  1.00000000,
+	0.73008762,  0.82443360,  1.00000000,
+	0.72989845,  0.82430410,  1.00000000,
+	0.72970967,  0.82417485,  1.00000000,
+	0.72952129,  0.82404587,  1.00000000,
+	0.72933330,  0.82391715,  1.00000000,
+	0.72914569,  0.82378868,  1.00000000,
+	0.72895848,  0.82366047,  1.00000000,
+	0.72877165,  0.82353251,  1.00000000,
+	0.72858519,  0.82340480,  1.00000000,
+	0.72839911,  0.82327734,  1.00000000,
+	0.72821341,  0.82315013,  1.00000000,
+	0.72802807,  0.82302316,  1.00000000,
+	0.72784311,  0.82289644,  1.00000000,
+	0.72765853,  0.82276997,  1.00000000,
+	0.72747434,  0.82264376,  1.00000000,
+	0.72729052,  0.82251780,  1.00000000,
+	0.72710708,  0.82239208,  1.00000000,
+	0.72692401,  0.82226661,  1.00000000,
+	0.72674130,  0.82214139,  1.00000000,
+	0.72655896,  0.82201640,  1.00000000,
+	0.72637699,  0.82189166,  1.00000000,
+	0.72619537,  0.82176715,  1.00000000,
+	0.72601412,  0.82164289,  1.00000000,
+	0.72583324,  0.82151887,  1.00000000,
+	0.72565273,  0.82139510,  1.00000000,
+	0.72547259,  0.82127157,  1.00000000,
+	0.72529281,  0.82114828,  1.00000000,
+	0.72511339,  0.82102523,  1.00000000,
+	0.72493433,  0.82090242,  1.00000000,
+	0.72475563,  0.82077984,  1.00000000,
+	0.72457728,  0.82065750,  1.00000000,
+	0.72439927,  0.82053539,  1.00000000,
+	0.72422162,  0.82041351,  1.00000000,
+	0.72404433,  0.82029188,  1.00000000,
+	0.72386740,  0.82017048,  1.00000000,
+	0.72369083,  0.82004932,  1.00000000,
+	0.72351462,  0.81992840,  1.00000000,
+	0.72333875,  0.81980771,  1.00000000,
+	0.72316323,  0.81968724,  1.00000000,
+	0.72298805,  0.81956701,  1.00000000,
+	0.72281322,  0.81944700,  1.00000000,
+	0.72263872,  0.81932722,  1.00000000,
+	0.72246457,  0.81920767,  1.00000000,
+	0.72229077,  0.81908835,  1.00000000,
+	0.72211732,  0.81896926,  1.00000000,
+	0.72194421,  0.81885040,  1.00000000,
+	0.72177145,  0.81873177,  1.00000000,
+	0.72159903,  0.81861336,  1.00000000,
+	0.72142695,  0.81849518,  1.00000000,
+	0.72125520,  0.81837722,  1.00000000,
+	0.72108379,  0.81825949,  1.00000000,
+	0.72091270,  0.81814197,  1.00000000,
+	0.72074195,  0.81802468,  1.00000000,
+	0.72057154,  0.81790761,  1.00000000,
+	0.72040147,  0.81779077,  1.00000000,
+	0.72023174,  0.81767415,  1.00000000,
+	0.72006234,  0.81755776,  1.00000000,
+	0.71989327,  0.81744158,  1.00000000,
+	0.71972453,  0.81732563,  1.00000000,
+	0.71955611,  0.81720989,  1.00000000,
+	0.71938802,  0.81709436,  1.00000000,
+	0.71922025,  0.81697905,  1.00000000, /* 13000K */
+	0.71905280,  0.81686395,  1.00000000,
+	0.71888569,  0.81674908,  1.00000000,
+	0.71871891,  0.81663442,  1.00000000,
+	0.71855245,  0.81651998,  1.00000000,
+	0.71838632,  0.81640576,  1.00000000,
+	0.71822051,  0.81629175,  1.00000000,
+	0.71805502,  0.81617796,  1.00000000,
+	0.71788984,  0.81606437,  1.00000000,
+	0.71772498,  0.81595100,  1.00000000,
+	0.71756043,  0.81583783,  1.00000000,
+	0.71739620,  0.81572487,  1.00000000,
+	0.71723229,  0.81561213,  1.00000000,
+	0.71706870,  0.81549960,  1.00000000,
+	0.71690543,  0.81538729,  1.00000000,
+	0.71674247,  0.81527518,  1.00000000,
+	0.71657983,  0.81516329,  1.00000000,
+	0.71641750,  0.81505160,  1.00000000,
+	0.71625548,  0.81494011,  1.00000000,
+	0.71609376,  0.81482883,  1.00000000,
+	0.71593234,  0.81471775,  1.00000000,
+	0.71577123,  0.81460688,  1.00000000,
+	0.71561044,  0.81449621,  1.00000000,
+	0.71544995,  0.81438576,  1.00000000,
+	0.71528978,  0.81427551,  1.00000000,
+	0.71512992,  0.81416546,  1.00000000,
+	0.71497035,  0.81405562,  1.00000000,
+	0.71481109,  0.81394598,  1.00000000,
+	0.71465213,  0.81383654,  1.00000000,
+	0.71449347,  0.81372730,  1.00000000,
+	0.71433510,  0.81361825,  1.00000000,
+	0.71417703,  0.81350940,  1.00000000,
+	0.71401927,  0.81340076,  1.00000000,
+	0.71386181,  0.81329232,  1.00000000,
+	0.71370465,  0.81318408,  1.00000000,
+	0.71354779,  0.81307604,  1.00000000,
+	0.71339122,  0.81296820,  1.00000000,
+	0.71323495,  0.81286056,  1.00000000,
+	0.71307897,  0.81275310,  1.00000000,
+	0.71292328,  0.81264585,  1.00000000,
+	0.71276788,  0.81253878,  1.00000000,
+	0.71261277,  0.81243191,  1.00000000,
+	0.71245795,  0.81232524,  1.00000000,
+	0.71230343,  0.81221876,  1.00000000,
+	0.71214921,  0.81211248,  1.00000000,
+	0.71199527,  0.81200640,  1.00000000,
+	0.71184162,  0.81190050,  1.00000000,
+	0.71168826,  0.81179480,  1.00000000,
+	0.71153519,  0.81168929,  1.00000000,
+	0.71138239,  0.81158397,  1.00000000,
+	0.71122987,  0.81147883,  1.00000000,
+	0.71107764,  0.81137388,  1.00000000,
+	0.71092569,  0.81126913,  1.00000000,
+	0.71077403,  0.81116457,  1.00000000,
+	0.71062266,  0.81106020,  1.00000000,
+	0.71047157,  0.81095602,  1.00000000,
+	0.71032077,  0.81085202,  1.00000000,
+	0.71017023,  0.81074821,  1.00000000,
+	0.71001998,  0.81064459,  1.00000000,
+	0.70987000,  0.81054115,  1.00000000,
+	0.70972029,  0.81043789,  1.00000000,
+	0.70957086,  0.81033482,  1.00000000,
+	0.70942171,  0.81023193,  1.00000000,
+	0.70927283,  0.81012923,  1.00000000,
+	0.70912424,  0.81002672,  1.00000000,
+	0.70897592,  0.80992439,  1.00000000,
+	0.70882788,  0.80982224,  1.00000000,
+	0.70868010,  0.80972028,  1.00000000,
+	0.70853259,  0.80961849,  1.00000000,
+	0.70838536,  0.80951689,  1.00000000,
+	0.70823838,  0.80941546,  1.00000000,
+	0.70809167,  0.80931421,  1.00000000,
+	0.70794524,  0.80921315,  1.00000000,
+	0.70779908,  0.80911227,  1.00000000,
+	0.70765320,  0.80901157,  1.00000000,
+	0.70750758,  0.80891105,  1.00000000,
+	0.70736222,  0.80881070,  1.00000000,
+	0.70721713,  0.80871054,  1.00000000,
+	0.70707230,  0.80861055,  1.00000000,
+	0.70692773,  0.80851073,  1.00000000,
+	0.70678342,  0.80841109,  1.00000000,
+	0.70663937,  0.80831162,  1.00000000,
+	0.70649559,  0.80821234,  1.00000000,
+	0.70635207,  0.80811323,  1.00000000,
+	0.70620881,  0.80801429,  1.00000000,
+	0.70606582,  0.80791553,  1.00000000,
+	0.70592308,  0.80781695,  1.00000000,
+	0.70578060,  0.80771854,  1.00000000,
+	0.70563838,  0.80762030,  1.00000000,
+	0.70549641,  0.80752222,  1.00000000,
+	0.70535469,  0.80742432,  1.00000000,
+	0.70521323,  0.80732659,  1.00000000,
+	0.70507202,  0.80722903,  1.00000000,
+	0.70493108,  0.80713164,  1.00000000,
+	0.70479039,  0.80703443,  1.00000000,
+	0.70464996,  0.80693739,  1.00000000,
+	0.70450977,  0.80684051,  1.00000000,
+	0.70436984,  0.80674381,  1.00000000,
+	0.70423016,  0.80664727,  1.00000000,
+	0.70409072,  0.80655090,  1.00000000,
+	0.70395153,  0.80645469,  1.00000000, /* 14000K */
+	0.70381259,  0.80635865,  1.00000000,
+	0.70367390,  0.80626278,  1.00000000,
+	0.70353546,  0.80616708,  1.00000000,
+	0.70339727,  0.80607155,  1.00000000,
+	0.70325933,  0.80597618,  1.00000000,
+	0.70312163,  0.80588098,  1.00000000,
+	0.70298418,  0.80578594,  1.00000000,
+	0.70284697,  0.80569107,  1.00000000,
+	0.70271000,  0.80559635,  1.00000000,
+	0.70257327,  0.80550180,  1.00000000,
+	0.70243678,  0.80540741,  1.00000000,
+	0.70230054,  0.80531319,  1.00000000,
+	0.70216454,  0.80521913,  1.00000000,
+	0.70202879,  0.80512523,  1.00000000,
+	0.70189328,  0.80503150,  1.00000000,
+	0.70175801,  0.80493792,  1.00000000,
+	0.70162297,  0.80484451,  1.00000000,
+	0.70148818,  0.80475126,  1.00000000,
+	0.70135361,  0.80465816,  1.00000000,
+	0.70121928,  0.80456522,  1.00000000,
+	0.70108518,  0.80447244,  1.00000000,
+	0.70095133,  0.80437982,  1.00000000,
+	0.70081771,  0.80428736,  1.00000000,
+	0.70068433,  0.80419506,  1.00000000,
+	0.70055119,  0.80410292,  1.00000000,
+	0.70041828,  0.80401094,  1.00000000,
+	0.70028560,  0.80391911,  1.00000000,
+	0.70015315,  0.80382744,  1.00000000,
+	0.70002093,  0.80373592,  1.00000000,
+	0.69988894,  0.80364455,  1.00000000,
+	0.69975718,  0.80355334,  1.00000000,
+	0.69962565,  0.80346229,  1.00000000,
+	0.69949436,  0.80337139,  1.00000000,
+	0.69936329,  0.80328065,  1.00000000,
+	0.69923246,  0.80319006,  1.00000000,
+	0.69910185,  0.80309963,  1.00000000,
+	0.69897147,  0.80300935,  1.00000000,
+	0.69884132,  0.80291922,  1.00000000,
+	0.69871138,  0.80282924,  1.00000000,
+	0.69858167,  0.80273941,  1.00000000,
+	0.69845218,  0.80264973,  1.00000000,
+	0.69832292,  0.80256021,  1.00000000,
+	0.69819389,  0.80247084,  1.00000000,
+	0.69806508,  0.80238162,  1.00000000,
+	0.69793650,  0.80229255,  1.00000000,
+	0.69780814,  0.80220363,  1.00000000,
+	0.69768000,  0.80211486,  1.00000000,
+	0.69755207,  0.80202624,  1.00000000,
+	0.69742437,  0.80193776,  1.00000000,
+	0.69729688,  0.80184943,  1.00000000,
+	0.69716961,  0.80176125,  1.00000000,
+	0.69704256,  0.80167321,  1.00000000,
+	0.69691574,  0.80158533,  1.00000000,
+	0.69678913,  0.80149759,  1.00000000,
+	0.69666274,  0.80141000,  1.00000000,
+	0.69653657,  0.80132256,  1.00000000,
+	0.69641062,  0.80123526,  1.00000000,
+	0.69628487,  0.80114811,  1.00000000,
+	0.69615934,  0.80106110,  1.00000000,
+	0.69603402,  0.80097423,  1.00000000,
+	0.69590891,  0.80088751,  1.00000000,
+	0.69578402,  0.80080093,  1.00000000,
+	0.69565935,  0.80071450,  1.00000000,
+	0.69553489,  0.80062821,  1.00000000,
+	0.69541064,  0.80054207,  1.00000000,
+	0.69528661,  0.80045607,  1.00000000,
+	0.69516278,  0.80037021,  1.00000000,
+	0.69503917,  0.80028449,  1.00000000,
+	0.69491576,  0.80019891,  1.00000000,
+	0.69479255,  0.80011347,  1.00000000,
+	0.69466955,  0.80002817,  1.00000000,
+	0.69454677,  0.79994302,  1.00000000,
+	0.69442420,  0.79985800,  1.00000000,
+	0.69430183,  0.79977313,  1.00000000,
+	0.69417968,  0.79968840,  1.00000000,
+	0.69405773,  0.79960381,  1.00000000,
+	0.69393598,  0.79951935,  1.00000000,
+	0.69381444,  0.79943504,  1.00000000,
+	0.69369310,  0.79935086,  1.00000000,
+	0.69357196,  0.79926681,  1.00000000,
+	0.69345102,  0.79918290,  1.00000000,
+	0.69333029,  0.79909913,  1.00000000,
+	0.69320977,  0.79901550,  1.00000000,
+	0.69308945,  0.79893201,  1.00000000,
+	0.69296933,  0.79884866,  1.00000000,
+	0.69284941,  0.79876544,  1.00000000,
+	0.69272970,  0.79868236,  1.00000000,
+	0.69261018,  0.79859941,  1.00000000,
+	0.69249086,  0.79851659,  1.00000000,
+	0.69237173,  0.79843391,  1.00000000,
+	0.69225280,  0.79835136,  1.00000000,
+	0.69213408,  0.79826895,  1.00000000,
+	0.69201555,  0.79818667,  1.00000000,
+	0.69189723,  0.79810453,  1.00000000,
+	0.69177910,  0.79802252,  1.00000000,
+	0.69166117,  0.79794065,  1.00000000,
+	0.69154343,  0.79785891,  1.00000000,
+	0.69142589,  0.79777729,  1.00000000,
+	0.69130854,  0.79769581,  1.00000000,
+	0.69119138,  0.79761446,  1.00000000, /* 15000K */
+	0.69107441,  0.79753324,  1.00000000,
+	0.69095765,  0.79745215,  1.00000000,
+	0.69084107,  0.79737119,  1.00000000,
+	0.69072470,  0.79729037,  1.00000000,
+	0.69060851,  0.79720968,  1.00000000,
+	0.69049252,  0.79712911,  1.00000000,
+	0.69037672,  0.79704868,  1.00000000,
+	0.69026111,  0.79696837,  1.00000000,
+	0.69014568,  0.79688819,  1.00000000,
+	0.69003044,  0.79680814,  1.00000000,
+	0.68991539,  0.79672822,  1.00000000,
+	0.68980053,  0.79664842,  1.00000000,
+	0.68968587,  0.79656876,  1.00000000,
+	0.68957139,  0.79648922,  1.00000000,
+	0.68945710,  0.79640981,  1.00000000,
+	0.68934300,  0.79633053,  1.00000000,
+	0.68922908,  0.79625138,  1.00000000,
+	0.68911535,  0.79617235,  1.00000000,
+	0.68900181,  0.79609344,  1.00000000,
+	0.68888844,  0.79601466,  1.00000000,
+	0.68877526,  0.79593600,  1.00000000,
+	0.68866227,  0.79585747,  1.00000000,
+	0.68854946,  0.79577907,  1.00000000,
+	0.68843684,  0.79570079,  1.00000000,
+	0.68832440,  0.79562264,  1.00000000,
+	0.68821215,  0.79554461,  1.00000000,
+	0.68810008,  0.79546670,  1.00000000,
+	0.68798819,  0.79538891,  1.00000000,
+	0.68787647,  0.79531125,  1.00000000,
+	0.68776494,  0.79523371,  1.00000000,
+	0.68765359,  0.79515629,  1.00000000,
+	0.68754242,  0.79507900,  1.00000000,
+	0.68743143,  0.79500182,  1.00000000,
+	0.68732062,  0.79492478,  1.00000000,
+	0.68720999,  0.79484785,  1.00000000,
+	0.68709954,  0.79477105,  1.00000000,
+	0.68698927,  0.79469436,  1.00000000,
+	0.68687918,  0.79461780,  1.00000000,
+	0.68676926,  0.79454135,  1.00000000,
+	0.68665951,  0.79446502,  1.00000000,
+	0.68654994,  0.79438881,  1.00000000,
+	0.68644055,  0.79431272,  1.00000000,
+	0.68633134,  0.79423676,  1.00000000,
+	0.68622230,  0.79416091,  1.00000000,
+	0.68611344,  0.79408518,  1.00000000,
+	0.68600475,  0.79400957,  1.00000000,
+	0.68589624,  0.79393408,  1.00000000,
+	0.68578790,  0.79385870,  1.00000000,
+	0.68567973,  0.79378344,  1.00000000,
+	0.68557173,  0.79370830,  1.00000000,
+	0.68546390,  0.79363327,  1.00000000,
+	0.68535625,  0.79355837,  1.00000000,
+	0.68524877,  0.79348358,  1.00000000,
+	0.68514146,  0.79340891,  1.00000000,
+	0.68503433,  0.79333435,  1.00000000,
+	0.68492736,  0.79325991,  1.00000000,
+	0.68482057,  0.79318559,  1.00000000,
+	0.68471394,  0.79311138,  1.00000000,
+	0.68460748,  0.79303728,  1.00000000,
+	0.68450119,  0.79296330,  1.00000000,
+	0.68439507,  0.79288943,  1.00000000,
+	0.68428911,  0.79281568,  1.00000000,
+	0.68418333,  0.79274204,  1.00000000,
+	0.68407771,  0.79266852,  1.00000000,
+	0.68397227,  0.79259511,  1.00000000,
+	0.68386699,  0.79252181,  1.00000000,
+	0.68376187,  0.79244863,  1.00000000,
+	0.68365692,  0.79237556,  1.00000000,
+	0.68355214,  0.79230260,  1.00000000,
+	0.68344751,  0.79222975,  1.00000000,
+	0.68334305,  0.79215701,  1.00000000,
+	0.68323875,  0.79208439,  1.00000000,
+	0.68313463,  0.79201188,  1.00000000,
+	0.68303066,  0.79193948,  1.00000000,
+	0.68292686,  0.79186719,  1.00000000,
+	0.68282323,  0.79179501,  1.00000000,
+	0.68271975,  0.79172295,  1.00000000,
+	0.68261644,  0.79165099,  1.00000000,
+	0.68251329,  0.79157914,  1.00000000,
+	0.68241029,  0.79150740,  1.00000000,
+	0.68230746,  0.79143577,  1.00000000,
+	0.68220479,  0.79136425,  1.00000000,
+	0.68210228,  0.79129284,  1.00000000,
+	0.68199993,  0.79122154,  1.00000000,
+	0.68189774,  0.79115035,  1.00000000,
+	0.68179572,  0.79107926,  1.00000000,
+	0.68169385,  0.79100829,  1.00000000,
+	0.68159214,  0.79093742,  1.00000000,
+	0.68149058,  0.79086666,  1.00000000,
+	0.68138918,  0.79079600,  1.00000000,
+	0.68128794,  0.79072545,  1.00000000,
+	0.68118685,  0.79065501,  1.00000000,
+	0.68108593,  0.79058468,  1.00000000,
+	0.68098516,  0.79051445,  1.00000000,
+	0.68088454,  0.79044433,  1.00000000,
+	0.68078409,  0.79037432,  1.00000000,
+	0.68068379,  0.79030441,  1.00000000,
+	0.68058364,  0.79023461,  1.00000000,
+	0.68048364,  0.79016491,  1.00000000,
+	0.68038380,  0.79009531,  1.00000000, /* 16000K */
+	0.68028411,  0.79002582,  1.00000000,
+	0.68018458,  0.78995643,  1.00000000,
+	0.68008520,  0.78988716,  1.00000000,
+	0.67998597,  0.78981798,  1.00000000,
+	0.67988690,  0.78974891,  1.00000000,
+	0.67978798,  0.78967995,  1.00000000,
+	0.67968922,  0.78961109,  1.00000000,
+	0.67959060,  0.78954233,  1.00000000,
+	0.67949213,  0.78947367,  1.00000000,
+	0.67939381,  0.78940511,  1.00000000,
+	0.67929564,  0.78933666,  1.00000000,
+	0.67919762,  0.78926830,  1.00000000,
+	0.67909976,  0.78920006,  1.00000000,
+	0.67900205,  0.78913191,  1.00000000,
+	0.67890448,  0.78906387,  1.00000000,
+	0.67880707,  0.78899593,  1.00000000,
+	0.67870980,  0.78892809,  1.00000000,
+	0.67861268,  0.78886035,  1.00000000,
+	0.67851571,  0.78879271,  1.00000000,
+	0.67841888,  0.78872517,  1.00000000,
+	0.67832220,  0.78865773,  1.00000000,
+	0.67822566,  0.78859039,  1.00000000,
+	0.67812928,  0.78852315,  1.00000000,
+	0.67803304,  0.78845601,  1.00000000,
+	0.67793695,  0.78838897,  1.00000000,
+	0.67784101,  0.78832203,  1.00000000,
+	0.67774520,  0.78825519,  1.00000000,
+	0.67764955,  0.78818845,  1.00000000,
+	0.67755403,  0.78812181,  1.00000000,
+	0.67745866,  0.78805526,  1.00000000,
+	0.67736343,  0.78798881,  1.00000000,
+	0.67726835,  0.78792246,  1.00000000,
+	0.67717341,  0.78785621,  1.00000000,
+	0.67707862,  0.78779006,  1.00000000,
+	0.67698397,  0.78772400,  1.00000000,
+	0.67688946,  0.78765805,  1.00000000,
+	0.67679510,  0.78759219,  1.00000000,
+	0.67670087,  0.78752642,  1.00000000,
+	0.67660679,  0.78746075,  1.00000000,
+	0.67651284,  0.78739518,  1.00000000,
+	0.67641903,  0.78732970,  1.00000000,
+	0.67632537,  0.78726432,  1.00000000,
+	0.67623185,  0.78719904,  1.00000000,
+	0.67613848,  0.78713385,  1.00000000,
+	0.67604524,  0.78706876,  1.00000000,
+	0.67595214,  0.78700376,  1.00000000,
+	0.67585918,  0.78693886,  1.00000000,
+	0.67576636,  0.78687406,  1.00000000,
+	0.67567367,  0.78680934,  1.00000000,
+	0.67558112,  0.78674472,  1.00000000,
+	0.67548871,  0.78668019,  1.00000000,
+	0.67539643,  0.78661576,  1.00000000,
+	0.67530430,  0.78655143,  1.00000000,
+	0.67521230,  0.78648718,  1.00000000,
+	0.67512044,  0.78642303,  1.00000000,
+	0.67502872,  0.78635898,  1.00000000,
+	0.67493713,  0.78629502,  1.00000000,
+	0.67484568,  0.78623115,  1.00000000,
+	0.67475436,  0.78616737,  1.00000000,
+	0.67466317,  0.78610368,  1.00000000,
+	0.67457212,  0.78604008,  1.00000000,
+	0.67448120,  0.78597658,  1.00000000,
+	0.67439043,  0.78591317,  1.00000000,
+	0.67429978,  0.78584985,  1.00000000,
+	0.67420928,  0.78578663,  1.00000000,
+	0.67411890,  0.78572350,  1.00000000,
+	0.67402866,  0.78566045,  1.00000000,
+	0.67393855,  0.78559750,  1.00000000,
+	0.67384857,  0.78553463,  1.00000000,
+	0.67375872,  0.78547186,  1.00000000,
+	0.67366900,  0.78540918,  1.00000000,
+	0.67357942,  0.78534658,  1.00000000,
+	0.67348997,  0.78528408,  1.00000000,
+	0.67340065,  0.78522167,  1.00000000,
+	0.67331147,  0.78515935,  1.00000000,
+	0.67322241,  0.78509712,  1.00000000,
+	0.67313349,  0.78503497,  1.00000000,
+	0.67304469,  0.78497292,  1.00000000,
+	0.67295602,  0.78491095,  1.00000000,
+	0.67286748,  0.78484907,  1.00000000,
+	0.67277907,  0.78478728,  1.00000000,
+	0.67269079,  0.78472558,  1.00000000,
+	0.67260264,  0.78466396,  1.00000000,
+	0.67251461,  0.78460244,  1.00000000,
+	0.67242672,  0.78454100,  1.00000000,
+	0.67233896,  0.78447965,  1.00000000,
+	0.67225132,  0.78441839,  1.00000000,
+	0.67216381,  0.78435721,  1.00000000,
+	0.67207642,  0.78429612,  1.00000000,
+	0.67198916,  0.78423512,  1.00000000,
+	0.67190203,  0.78417420,  1.00000000,
+	0.67181502,  0.78411337,  1.00000000,
+	0.67172814,  0.78405263,  1.00000000,
+	0.67164139,  0.78399198,  1.00000000,
+	0.67155476,  0.78393141,  1.00000000,
+	0.67146826,  0.78387092,  1.00000000,
+	0.67138189,  0.78381053,  1.00000000,
+	0.67129564,  0.78375021,  1.00000000,
+	0.67120951,  0.78368999,  1.00000000,
+	0.67112350,  0.78362984,  1.00000000, /* 17000K */
+	0.67103762,  0.78356978,  1.00000000,
+	0.67095186,  0.78350981,  1.00000000,
+	0.67086623,  0.78344992,  1.00000000,
+	0.67078072,  0.78339011,  1.00000000,
+	0.67069534,  0.78333040,  1.00000000,
+	0.67061008,  0.78327076,  1.00000000,
+	0.67052494,  0.78321121,  1.00000000,
+	0.67043992,  0.78315174,  1.00000000,
+	0.67035502,  0.78309235,  1.00000000,
+	0.67027024,  0.78303305,  1.00000000,
+	0.67018558,  0.78297383,  1.00000000,
+	0.67010105,  0.78291469,  1.00000000,
+	0.67001663,  0.78285564,  1.00000000,
+	0.66993234,  0.78279667,  1.00000000,
+	0.66984817,  0.78273778,  1.00000000,
+	0.66976412,  0.78267898,  1.00000000,
+	0.66968019,  0.78262025,  1.00000000,
+	0.66959638,  0.78256161,  1.00000000,
+	0.66951269,  0.78250305,  1.00000000,
+	0.66942911,  0.78244457,  1.00000000,
+	0.66934565,  0.78238617,  1.00000000,
+	0.66926232,  0.78232786,  1.00000000,
+	0.66917910,  0.78226962,  1.00000000,
+	0.66909600,  0.78221147,  1.00000000,
+	0.66901302,  0.78215340,  1.00000000,
+	0.66893016,  0.78209541,  1.00000000,
+	0.66884742,  0.78203750,  1.00000000,
+	0.66876479,  0.78197967,  1.00000000,
+	0.66868228,  0.78192192,  1.00000000,
+	0.66859988,  0.78186425,  1.00000000,
+	0.66851760,  0.78180666,  1.00000000,
+	0.66843543,  0.78174915,  1.00000000,
+	0.66835339,  0.78169171,  1.00000000,
+	0.66827145,  0.78163436,  1.00000000,
+	0.66818964,  0.78157709,  1.00000000,
+	0.66810794,  0.78151990,  1.00000000,
+	0.66802635,  0.78146279,  1.00000000,
+	0.66794488,  0.78140575,  1.00000000,
+	0.66786353,  0.78134879,  1.00000000,
+	0.66778228,  0.78129191,  1.00000000,
+	0.66770115,  0.78123511,  1.00000000,
+	0.66762013,  0.78117838,  1.00000000,
+	0.66753923,  0.78112174,  1.00000000,
+	0.66745845,  0.78106517,  1.00000000,
+	0.66737778,  0.78100869,  1.00000000,
+	0.66729722,  0.78095228,  1.00000000,
+	0.66721677,  0.78089594,  1.00000000,
+	0.66713644,  0.78083969,  1.00000000,
+	0.66705621,  0.78078350,  1.00000000,
+	0.66697610,  0.78072740,  1.00000000,
+	0.66689610,  0.78067137,  1.00000000,
+	0.66681621,  0.78061542,  1.00000000,
+	0.66673643,  0.78055955,  1.00000000,
+	0.66665677,  0.78050375,  1.00000000,
+	0.66657722,  0.78044803,  1.00000000,
+	0.66649777,  0.78039239,  1.00000000,
+	0.66641844,  0.78033682,  1.00000000,
+	0.66633922,  0.78028133,  1.00000000,
+	0.66626011,  0.78022591,  1.00000000,
+	0.66618110,  0.78017057,  1.00000000,
+	0.66610220,  0.78011530,  1.00000000,
+	0.66602342,  0.78006011,  1.00000000,
+	0.66594474,  0.78000499,  1.00000000,
+	0.66586618,  0.77994995,  1.00000000,
+	0.66578772,  0.77989499,  1.00000000,
+	0.66570938,  0.77984010,  1.00000000,
+	0.66563114,  0.77978528,  1.00000000,
+	0.66555301,  0.77973054,  1.00000000,
+	0.66547498,  0.77967587,  1.00000000,
+	0.66539706,  0.77962127,  1.00000000,
+	0.66531925,  0.77956675,  1.00000000,
+	0.66524154,  0.77951230,  1.00000000,
+	0.66516395,  0.77945792,  1.00000000,
+	0.66508646,  0.77940362,  1.00000000,
+	0.66500908,  0.77934939,  1.00000000,
+	0.66493181,  0.77929524,  1.00000000,
+	0.66485464,  0.77924115,  1.00000000,
+	0.66477757,  0.77918714,  1.00000000,
+	0.66470062,  0.77913321,  1.00000000,
+	0.66462376,  0.77907934,  1.00000000,
+	0.66454701,  0.77902555,  1.00000000,
+	0.66447037,  0.77897183,  1.00000000,
+	0.66439383,  0.77891818,  1.00000000,
+	0.66431740,  0.77886460,  1.00000000,
+	0.66424107,  0.77881110,  1.00000000,
+	0.66416484,  0.77875767,  1.00000000,
+	0.66408872,  0.77870431,  1.00000000,
+	0.66401271,  0.77865102,  1.00000000,
+	0.66393679,  0.77859780,  1.00000000,
+	0.66386098,  0.77854465,  1.00000000,
+	0.66378527,  0.77849157,  1.00000000,
+	0.66370967,  0.77843856,  1.00000000,
+	0.66363416,  0.77838563,  1.00000000,
+	0.66355877,  0.77833276,  1.00000000,
+	0.66348347,  0.77827997,  1.00000000,
+	0.66340828,  0.77822725,  1.00000000,
+	0.66333319,  0.77817459,  1.00000000,
+	0.66325820,  0.77812201,  1.00000000,
+	0.66318331,  0.77806950,  1.00000000,
+	0.66310852,  0.77801705,  1.00000000, /* 18000K */
+	0.66303383,  0.77796467,  1.00000000,
+	0.66295925,  0.77791237,  1.00000000,
+	0.66288476,  0.77786013,  1.00000000,
+	0.66281038,  0.77780797,  1.00000000,
+	0.66273610,  0.77775587,  1.00000000,
+	0.66266192,  0.77770385,  1.00000000,
+	0.66258783,  0.77765189,  1.00000000,
+	0.66251385,  0.77760000,  1.00000000,
+	0.66243997,  0.77754818,  1.00000000,
+	0.66236618,  0.77749642,  1.00000000,
+	0.66229249,  0.77744473,  1.00000000,
+	0.66221890,  0.77739311,  1.00000000,
+	0.66214542,  0.77734156,  1.00000000,
+	0.66207203,  0.77729008,  1.00000000,
+	0.66199874,  0.77723867,  1.00000000,
+	0.66192555,  0.77718732,  1.00000000,
+	0.66185245,  0.77713604,  1.00000000,
+	0.66177945,  0.77708483,  1.00000000,
+	0.66170655,  0.77703369,  1.00000000,
+	0.66163375,  0.77698261,  1.00000000,
+	0.66156104,  0.77693160,  1.00000000,
+	0.66148844,  0.77688066,  1.00000000,
+	0.66141593,  0.77682978,  1.00000000,
+	0.66134351,  0.77677897,  1.00000000,
+	0.66127120,  0.77672823,  1.00000000,
+	0.66119898,  0.77667755,  1.00000000,
+	0.66112686,  0.77662695,  1.00000000,
+	0.66105483,  0.77657640,  1.00000000,
+	0.66098290,  0.77652592,  1.00000000,
+	0.66091106,  0.77647551,  1.00000000,
+	0.66083932,  0.77642516,  1.00000000,
+	0.66076767,  0.77637488,  1.00000000,
+	0.66069612,  0.77632466,  1.00000000,
+	0.66062466,  0.77627452,  1.00000000,
+	0.66055330,  0.77622443,  1.00000000,
+	0.66048204,  0.77617441,  1.00000000,
+	0.66041087,  0.77612446,  1.00000000,
+	0.66033979,  0.77607457,  1.00000000,
+	0.66026880,  0.77602474,  1.00000000,
+	0.66019791,  0.77597498,  1.00000000,
+	0.66012711,  0.77592528,  1.00000000,
+	0.66005641,  0.77587565,  1.00000000,
+	0.65998580,  0.77582608,  1.00000000,
+	0.65991528,  0.77577658,  1.00000000,
+	0.65984486,  0.77572714,  1.00000000,
+	0.65977453,  0.77567777,  1.00000000,
+	0.65970429,  0.77562846,  1.00000000,
+	0.65963414,  0.77557921,  1.00000000,
+	0.65956408,  0.77553002,  1.00000000,
+	0.65949412,  0.77548090,  1.00000000,
+	0.65942425,  0.77543184,  1.00000000,
+	0.65935447,  0.77538285,  1.00000000,
+	0.65928478,  0.77533391,  1.00000000,
+	0.65921519,  0.77528505,  1.00000000,
+	0.65914568,  0.77523624,  1.00000000,
+	0.65907627,  0.77518750,  1.00000000,
+	0.65900695,  0.77513882,  1.00000000,
+	0.65893772,  0.77509020,  1.00000000,
+	0.65886857,  0.77504165,  1.00000000,
+	0.65879952,  0.77499315,  1.00000000,
+	0.65873056,  0.77494472,  1.00000000,
+	0.65866168,  0.77489635,  1.00000000,
+	0.65859290,  0.77484804,  1.00000000,
+	0.65852421,  0.77479979,  1.00000000,
+	0.65845560,  0.77475161,  1.00000000,
+	0.65838709,  0.77470349,  1.00000000,
+	0.65831867,  0.77465543,  1.00000000,
+	0.65825033,  0.77460743,  1.00000000,
+	0.65818208,  0.77455949,  1.00000000,
+	0.65811392,  0.77451161,  1.00000000,
+	0.65804585,  0.77446379,  1.00000000,
+	0.65797786,  0.77441604,  1.00000000,
+	0.65790997,  0.77436834,  1.00000000,
+	0.65784216,  0.77432071,  1.00000000,
+	0.65777444,  0.77427314,  1.00000000,
+	0.65770681,  0.77422563,  1.00000000,
+	0.65763927,  0.77417818,  1.00000000,
+	0.65757182,  0.77413079,  1.00000000,
+	0.65750444,  0.77408345,  1.00000000,
+	0.65743716,  0.77403618,  1.00000000,
+	0.65736996,  0.77398897,  1.00000000,
+	0.65730285,  0.77394181,  1.00000000,
+	0.65723583,  0.77389472,  1.00000000,
+	0.65716889,  0.77384769,  1.00000000,
+	0.65710205,  0.77380071,  1.00000000,
+	0.65703528,  0.77375380,  1.00000000,
+	0.65696860,  0.77370694,  1.00000000,
+	0.65690201,  0.77366015,  1.00000000,
+	0.65683550,  0.77361341,  1.00000000,
+	0.65676908,  0.77356673,  1.00000000,
+	0.65670274,  0.77352011,  1.00000000,
+	0.65663649,  0.77347355,  1.00000000,
+	0.65657032,  0.77342704,  1.00000000,
+	0.65650424,  0.77338060,  1.00000000,
+	0.65643825,  0.77333422,  1.00000000,
+	0.65637233,  0.77328789,  1.00000000,
+	0.65630651,  0.77324162,  1.00000000,
+	0.65624076,  0.77319541,  1.00000000,
+	0.65617510,  0.77314926,  1.00000000,
+	0.65610952,  0.77310316,  1.00000000, /* 19000K */
+	0.65604402,  0.77305712,  1.00000000,
+	0.65597861,  0.77301114,  1.00000000,
+	0.65591328,  0.77296522,  1.00000000,
+	0.65584804,  0.77291936,  1.00000000,
+	0.65578288,  0.77287355,  1.00000000,
+	0.65571780,  0.77282780,  1.00000000,
+	0.65565281,  0.77278211,  1.00000000,
+	0.65558789,  0.77273647,  1.00000000,
+	0.65552306,  0.77269089,  1.00000000,
+	0.65545831,  0.77264537,  1.00000000,
+	0.65539364,  0.77259990,  1.00000000,
+	0.65532905,  0.77255449,  1.00000000,
+	0.65526455,  0.77250914,  1.00000000,
+	0.65520013,  0.77246384,  1.00000000,
+	0.65513579,  0.77241860,  1.00000000,
+	0.65507153,  0.77237342,  1.00000000,
+	0.65500735,  0.77232829,  1.00000000,
+	0.65494325,  0.77228322,  1.00000000,
+	0.65487924,  0.77223820,  1.00000000,
+	0.65481530,  0.77219324,  1.00000000,
+	0.65475144,  0.77214833,  1.00000000,
+	0.65468767,  0.77210349,  1.00000000,
+	0.65462398,  0.77205869,  1.00000000,
+	0.65456036,  0.77201396,  1.00000000,
+	0.65449683,  0.77196928,  1.00000000,
+	0.65443338,  0.77192465,  1.00000000,
+	0.65437001,  0.77188008,  1.00000000,
+	0.65430671,  0.77183556,  1.00000000,
+	0.65424350,  0.77179110,  1.00000000,
+	0.65418036,  0.77174669,  1.00000000,
+	0.65411730,  0.77170234,  1.00000000,
+	0.65405432,  0.77165804,  1.00000000,
+	0.65399142,  0.77161379,  1.00000000,
+	0.65392860,  0.77156960,  1.00000000,
+	0.65386586,  0.77152547,  1.00000000,
+	0.65380320,  0.77148139,  1.00000000,
+	0.65374061,  0.77143736,  1.00000000,
+	0.65367810,  0.77139339,  1.00000000,
+	0.65361567,  0.77134947,  1.00000000,
+	0.65355332,  0.77130560,  1.00000000,
+	0.65349104,  0.77126179,  1.00000000,
+	0.65342885,  0.77121803,  1.00000000,
+	0.65336672,  0.77117432,  1.00000000,
+	0.65330468,  0.77113067,  1.00000000,
+	0.65324272,  0.77108707,  1.00000000,
+	0.65318083,  0.77104353,  1.00000000,
+	0.65311902,  0.77100004,  1.00000000,
+	0.65305728,  0.77095660,  1.00000000,
+	0.65299562,  0.77091321,  1.00000000,
+	0.65293404,  0.77086988,  1.00000000,
+	0.65287253,  0.77082660,  1.00000000,
+	0.65281110,  0.77078337,  1.00000000,
+	0.65274975,  0.77074020,  1.00000000,
+	0.65268847,  0.77069707,  1.00000000,
+	0.65262727,  0.77065401,  1.00000000,
+	0.65256615,  0.77061099,  1.00000000,
+	0.65250510,  0.77056802,  1.00000000,
+	0.65244413,  0.77052511,  1.00000000,
+	0.65238323,  0.77048225,  1.00000000,
+	0.65232240,  0.77043944,  1.00000000,
+	0.65226165,  0.77039668,  1.00000000,
+	0.65220097,  0.77035398,  1.00000000,
+	0.65214037,  0.77031132,  1.00000000,
+	0.65207984,  0.77026872,  1.00000000,
+	0.65201939,  0.77022617,  1.00000000,
+	0.65195902,  0.77018367,  1.00000000,
+	0.65189871,  0.77014123,  1.00000000,
+	0.65183848,  0.77009883,  1.00000000,
+	0.65177832,  0.77005649,  1.00000000,
+	0.65171824,  0.77001419,  1.00000000,
+	0.65165823,  0.76997195,  1.00000000,
+	0.65159829,  0.76992975,  1.00000000,
+	0.65153843,  0.76988761,  1.00000000,
+	0.65147864,  0.76984552,  1.00000000,
+	0.65141893,  0.76980348,  1.00000000,
+	0.65135929,  0.76976150,  1.00000000,
+	0.65129972,  0.76971956,  1.00000000,
+	0.65124022,  0.76967767,  1.00000000,
+	0.65118079,  0.76963583,  1.00000000,
+	0.65112144,  0.76959404,  1.00000000,
+	0.65106216,  0.76955230,  1.00000000,
+	0.65100295,  0.76951061,  1.00000000,
+	0.65094381,  0.76946897,  1.00000000,
+	0.65088475,  0.76942738,  1.00000000,
+	0.65082576,  0.76938584,  1.00000000,
+	0.65076684,  0.76934436,  1.00000000,
+	0.65070799,  0.76930292,  1.00000000,
+	0.65064921,  0.76926153,  1.00000000,
+	0.65059051,  0.76922018,  1.00000000,
+	0.65053187,  0.76917889,  1.00000000,
+	0.65047330,  0.76913765,  1.00000000,
+	0.65041481,  0.76909645,  1.00000000,
+	0.65035639,  0.76905531,  1.00000000,
+	0.65029804,  0.76901421,  1.00000000,
+	0.65023976,  0.76897317,  1.00000000,
+	0.65018155,  0.76893217,  1.00000000,
+	0.65012341,  0.76889122,  1.00000000,
+	0.65006534,  0.76885032,  1.00000000,
+	0.65000734,  0.76880947,  1.00000000,
+	0.64994941,  0.76876866,  1.00000000, /* 20000K */
+	0.64989155,  0.76872790,  1.00000000,
+	0.64983376,  0.76868719,  1.00000000,
+	0.64977603,  0.76864653,  1.00000000,
+	0.64971838,  0.76860592,  1.00000000,
+	0.64966080,  0.76856536,  1.00000000,
+	0.64960329,  0.76852484,  1.00000000,
+	0.64954584,  0.76848438,  1.00000000,
+	0.64948847,  0.76844396,  1.00000000,
+	0.64943116,  0.76840359,  1.00000000,
+	0.64937392,  0.76836326,  1.00000000,
+	0.64931675,  0.76832298,  1.00000000,
+	0.64925965,  0.76828275,  1.00000000,
+	0.64920261,  0.76824257,  1.00000000,
+	0.64914565,  0.76820244,  1.00000000,
+	0.64908875,  0.76816236,  1.00000000,
+	0.64903192,  0.76812232,  1.00000000,
+	0.64897516,  0.76808233,  1.00000000,
+	0.64891847,  0.76804238,  1.00000000,
+	0.64886184,  0.76800248,  1.00000000,
+	0.64880528,  0.76796263,  1.00000000,
+	0.64874879,  0.76792282,  1.00000000,
+	0.64869236,  0.76788306,  1.00000000,
+	0.64863601,  0.76784335,  1.00000000,
+	0.64857972,  0.76780369,  1.00000000,
+	0.64852350,  0.76776407,  1.00000000,
+	0.64846735,  0.76772449,  1.00000000,
+	0.64841126,  0.76768497,  1.00000000,
+	0.64835524,  0.76764549,  1.00000000,
+	0.64829928,  0.76760605,  1.00000000,
+	0.64824339,  0.76756666,  1.00000000,
+	0.64818757,  0.76752732,  1.00000000,
+	0.64813181,  0.76748802,  1.00000000,
+	0.64807612,  0.76744877,  1.00000000,
+	0.64802049,  0.76740956,  1.00000000,
+	0.64796493,  0.76737040,  1.00000000,
+	0.64790944,  0.76733129,  1.00000000,
+	0.64785401,  0.76729222,  1.00000000,
+	0.64779865,  0.76725320,  1.00000000,
+	0.64774335,  0.76721422,  1.00000000,
+	0.64768812,  0.76717529,  1.00000000,
+	0.64763295,  0.76713640,  1.00000000,
+	0.64757785,  0.76709756,  1.00000000,
+	0.64752281,  0.76705876,  1.00000000,
+	0.64746784,  0.76702001,  1.00000000,
+	0.64741293,  0.76698130,  1.00000000,
+	0.64735808,  0.76694264,  1.00000000,
+	0.64730331,  0.76690403,  1.00000000,
+	0.64724859,  0.76686545,  1.00000000,
+	0.64719394,  0.76682692,  1.00000000,
+	0.64713935,  0.76678844,  1.00000000,
+	0.64708483,  0.76675000,  1.00000000,
+	0.64703037,  0.76671160,  1.00000000,
+	0.64697597,  0.76667325,  1.00000000,
+	0.64692164,  0.76663495,  1.00000000,
+	0.64686738,  0.76659668,  1.00000000,
+	0.64681317,  0.76655847,  1.00000000,
+	0.64675903,  0.76652029,  1.00000000,
+	0.64670496,  0.76648216,  1.00000000,
+	0.64665094,  0.76644407,  1.00000000,
+	0.64659699,  0.76640603,  1.00000000,
+	0.64654310,  0.76636803,  1.00000000,
+	0.64648927,  0.76633007,  1.00000000,
+	0.64643551,  0.76629216,  1.00000000,
+	0.64638181,  0.76625429,  1.00000000,
+	0.64632818,  0.76621646,  1.00000000,
+	0.64627460,  0.76617868,  1.00000000,
+	0.64622109,  0.76614094,  1.00000000,
+	0.64616764,  0.76610324,  1.00000000,
+	0.64611425,  0.76606559,  1.00000000,
+	0.64606092,  0.76602798,  1.00000000,
+	0.64600765,  0.76599041,  1.00000000,
+	0.64595445,  0.76595289,  1.00000000,
+	0.64590131,  0.76591541,  1.00000000,
+	0.64584823,  0.76587797,  1.00000000,
+	0.64579521,  0.76584058,  1.00000000,
+	0.64574225,  0.76580323,  1.00000000,
+	0.64568936,  0.76576592,  1.00000000,
+	0.64563652,  0.76572865,  1.00000000,
+	0.64558374,  0.76569142,  1.00000000,
+	0.64553103,  0.76565424,  1.00000000,
+	0.64547838,  0.76561710,  1.00000000,
+	0.64542578,  0.76558000,  1.00000000,
+	0.64537325,  0.76554294,  1.00000000,
+	0.64532078,  0.76550593,  1.00000000,
+	0.64526837,  0.76546896,  1.00000000,
+	0.64521602,  0.76543203,  1.00000000,
+	0.64516373,  0.76539514,  1.00000000,
+	0.64511150,  0.76535829,  1.00000000,
+	0.64505933,  0.76532148,  1.00000000,
+	0.64500722,  0.76528472,  1.00000000,
+	0.64495517,  0.76524800,  1.00000000,
+	0.64490318,  0.76521131,  1.00000000,
+	0.64485125,  0.76517467,  1.00000000,
+	0.64479937,  0.76513808,  1.00000000,
+	0.64474756,  0.76510152,  1.00000000,
+	0.64469581,  0.76506500,  1.00000000,
+	0.64464412,  0.76502853,  1.00000000,
+	0.64459248,  0.76499210,  1.00000000,
+	0.64454091,  0.76495570,  1.00000000,
+	0.64448939,  0.76491935,  1.00000000, /* 21000K */
+	0.64443793,  0.76488304,  1.00000000,
+	0.64438653,  0.76484677,  1.00000000,
+	0.64433519,  0.76481054,  1.00000000,
+	0.64428391,  0.76477435,  1.00000000,
+	0.64423269,  0.76473821,  1.00000000,
+	0.64418153,  0.76470210,  1.00000000,
+	0.64413042,  0.76466604,  1.00000000,
+	0.64407937,  0.76463001,  1.00000000,
+	0.64402838,  0.76459403,  1.00000000,
+	0.64397745,  0.76455808,  1.00000000,
+	0.64392657,  0.76452217,  1.00000000,
+	0.64387576,  0.76448631,  1.00000000,
+	0.64382500,  0.76445048,  1.00000000,
+	0.64377430,  0.76441470,  1.00000000,
+	0.64372365,  0.76437895,  1.00000000,
+	0.64367307,  0.76434325,  1.00000000,
+	0.64362254,  0.76430758,  1.00000000,
+	0.64357207,  0.76427195,  1.00000000,
+	0.64352165,  0.76423637,  1.00000000,
+	0.64347129,  0.76420082,  1.00000000,
+	0.64342099,  0.76416531,  1.00000000,
+	0.64337074,  0.76412985,  1.00000000,
+	0.64332055,  0.76409442,  1.00000000,
+	0.64327042,  0.76405903,  1.00000000,
+	0.64322034,  0.76402368,  1.00000000,
+	0.64317033,  0.76398838,  1.00000000,
+	0.64312036,  0.76395311,  1.00000000,
+	0.64307046,  0.76391788,  1.00000000,
+	0.64302061,  0.76388268,  1.00000000,
+	0.64297081,  0.76384753,  1.00000000,
+	0.64292107,  0.76381242,  1.00000000,
+	0.64287139,  0.76377734,  1.00000000,
+	0.64282176,  0.76374230,  1.00000000,
+	0.64277219,  0.76370731,  1.00000000,
+	0.64272268,  0.76367235,  1.00000000,
+	0.64267322,  0.76363743,  1.00000000,
+	0.64262382,  0.76360255,  1.00000000,
+	0.64257447,  0.76356770,  1.00000000,
+	0.64252518,  0.76353290,  1.00000000,
+	0.64247594,  0.76349813,  1.00000000,
+	0.64242676,  0.76346340,  1.00000000,
+	0.64237763,  0.76342871,  1.00000000,
+	0.64232855,  0.76339406,  1.00000000,
+	0.64227954,  0.76335945,  1.00000000,
+	0.64223057,  0.76332487,  1.00000000,
+	0.64218166,  0.76329033,  1.00000000,
+	0.64213281,  0.76325583,  1.00000000,
+	0.64208401,  0.76322137,  1.00000000,
+	0.64203526,  0.76318695,  1.00000000,
+	0.64198657,  0.76315256,  1.00000000,
+	0.64193793,  0.76311821,  1.00000000,
+	0.64188935,  0.76308390,  1.00000000,
+	0.64184082,  0.76304963,  1.00000000,
+	0.64179234,  0.76301539,  1.00000000,
+	0.64174392,  0.76298119,  1.00000000,
+	0.64169555,  0.76294703,  1.00000000,
+	0.64164724,  0.76291291,  1.00000000,
+	0.64159897,  0.76287882,  1.00000000,
+	0.64155077,  0.76284477,  1.00000000,
+	0.64150261,  0.76281076,  1.00000000,
+	0.64145451,  0.76277678,  1.00000000,
+	0.64140646,  0.76274285,  1.00000000,
+	0.64135847,  0.76270895,  1.00000000,
+	0.64131053,  0.76267508,  1.00000000,
+	0.64126264,  0.76264125,  1.00000000,
+	0.64121480,  0.76260746,  1.00000000,
+	0.64116702,  0.76257371,  1.00000000,
+	0.64111929,  0.76253999,  1.00000000,
+	0.64107162,  0.76250631,  1.00000000,
+	0.64102399,  0.76247267,  1.00000000,
+	0.64097642,  0.76243906,  1.00000000,
+	0.64092890,  0.76240549,  1.00000000,
+	0.64088143,  0.76237196,  1.00000000,
+	0.64083401,  0.76233846,  1.00000000,
+	0.64078665,  0.76230500,  1.00000000,
+	0.64073934,  0.76227158,  1.00000000,
+	0.64069208,  0.76223819,  1.00000000,
+	0.64064487,  0.76220484,  1.00000000,
+	0.64059772,  0.76217152,  1.00000000,
+	0.64055061,  0.76213824,  1.00000000,
+	0.64050356,  0.76210499,  1.00000000,
+	0.64045655,  0.76207179,  1.00000000,
+	0.64040960,  0.76203861,  1.00000000,
+	0.64036271,  0.76200548,  1.00000000,
+	0.64031586,  0.76197237,  1.00000000,
+	0.64026906,  0.76193931,  1.00000000,
+	0.64022232,  0.76190628,  1.00000000,
+	0.64017563,  0.76187328,  1.00000000,
+	0.64012898,  0.76184032,  1.00000000,
+	0.64008239,  0.76180740,  1.00000000,
+	0.64003585,  0.76177451,  1.00000000,
+	0.63998936,  0.76174166,  1.00000000,
+	0.63994292,  0.76170884,  1.00000000,
+	0.63989653,  0.76167606,  1.00000000,
+	0.63985019,  0.76164331,  1.00000000,
+	0.63980391,  0.76161060,  1.00000000,
+	0.63975767,  0.76157792,  1.00000000,
+	0.63971149,  0.76154528,  1.00000000,
+	0.63966535,  0.76151267,  1.00000000,
+	0.63961926,  0.76148010,  1.00000000, /* 22000K */
+	0.63957322,  0.76144756,  1.00000000,
+	0.63952723,  0.76141506,  1.00000000,
+	0.63948130,  0.76138259,  1.00000000,
+	0.63943541,  0.76135016,  1.00000000,
+	0.63938957,  0.76131776,  1.00000000,
+	0.63934378,  0.76128539,  1.00000000,
+	0.63929804,  0.76125306,  1.00000000,
+	0.63925235,  0.76122077,  1.00000000,
+	0.63920671,  0.76118851,  1.00000000,
+	0.63916112,  0.76115628,  1.00000000,
+	0.63911558,  0.76112409,  1.00000000,
+	0.63907008,  0.76109193,  1.00000000,
+	0.63902464,  0.76105981,  1.00000000,
+	0.63897924,  0.76102772,  1.00000000,
+	0.63893390,  0.76099566,  1.00000000,
+	0.63888860,  0.76096364,  1.00000000,
+	0.63884335,  0.76093166,  1.00000000,
+	0.63879815,  0.76089970,  1.00000000,
+	0.63875300,  0.76086779,  1.00000000,
+	0.63870790,  0.76083590,  1.00000000,
+	0.63866285,  0.76080405,  1.00000000,
+	0.63861784,  0.76077223,  1.00000000,
+	0.63857288,  0.76074045,  1.00000000,
+	0.63852797,  0.76070870,  1.00000000,
+	0.63848311,  0.76067698,  1.00000000,
+	0.63843830,  0.76064530,  1.00000000,
+	0.63839354,  0.76061365,  1.00000000,
+	0.63834882,  0.76058203,  1.00000000,
+	0.63830415,  0.76055045,  1.00000000,
+	0.63825953,  0.76051890,  1.00000000,
+	0.63821496,  0.76048738,  1.00000000,
+	0.63817043,  0.76045590,  1.00000000,
+	0.63812595,  0.76042445,  1.00000000,
+	0.63808152,  0.76039303,  1.00000000,
+	0.63803713,  0.76036165,  1.00000000,
+	0.63799280,  0.76033030,  1.00000000,
+	0.63794851,  0.76029898,  1.00000000,
+	0.63790427,  0.76026769,  1.00000000,
+	0.63786007,  0.76023644,  1.00000000,
+	0.63781592,  0.76020522,  1.00000000,
+	0.63777182,  0.76017403,  1.00000000,
+	0.63772776,  0.76014288,  1.00000000,
+	0.63768376,  0.76011176,  1.00000000,
+	0.63763980,  0.76008067,  1.00000000,
+	0.63759588,  0.76004961,  1.00000000,
+	0.63755202,  0.76001859,  1.00000000,
+	0.63750819,  0.75998760,  1.00000000,
+	0.63746442,  0.75995664,  1.00000000,
+	0.63742069,  0.75992571,  1.00000000,
+	0.63737701,  0.75989482,  1.00000000,
+	0.63733337,  0.75986396,  1.00000000,
+	0.63728979,  0.75983313,  1.00000000,
+	0.63724624,  0.75980233,  1.00000000,
+	0.63720275,  0.75977156,  1.00000000,
+	0.63715930,  0.75974083,  1.00000000,
+	0.63711589,  0.75971013,  1.00000000,
+	0.63707253,  0.75967946,  1.00000000,
+	0.63702922,  0.75964882,  1.00000000,
+	0.63698595,  0.75961821,  1.00000000,
+	0.63694273,  0.75958764,  1.00000000,
+	0.63689955,  0.75955710,  1.00000000,
+	0.63685642,  0.75952659,  1.00000000,
+	0.63681333,  0.75949611,  1.00000000,
+	0.63677029,  0.75946566,  1.00000000,
+	0.63672730,  0.75943525,  1.00000000,
+	0.63668434,  0.75940487,  1.00000000,
+	0.63664144,  0.75937452,  1.00000000,
+	0.63659858,  0.75934420,  1.00000000,
+	0.63655576,  0.75931391,  1.00000000,
+	0.63651299,  0.75928365,  1.00000000,
+	0.63647026,  0.75925342,  1.00000000,
+	0.63642758,  0.75922323,  1.00000000,
+	0.63638495,  0.75919306,  1.00000000,
+	0.63634235,  0.75916293,  1.00000000,
+	0.63629981,  0.75913283,  1.00000000,
+	0.63625731,  0.75910276,  1.00000000,
+	0.63621485,  0.75907272,  1.00000000,
+	0.63617244,  0.75904271,  1.00000000,
+	0.63613007,  0.75901273,  1.00000000,
+	0.63608774,  0.75898278,  1.00000000,
+	0.63604546,  0.75895286,  1.00000000,
+	0.63600322,  0.75892298,  1.00000000,
+	0.63596103,  0.75889312,  1.00000000,
+	0.63591888,  0.75886330,  1.00000000,
+	0.63587678,  0.75883350,  1.00000000,
+	0.63583472,  0.75880374,  1.00000000,
+	0.63579270,  0.75877401,  1.00000000,
+	0.63575073,  0.75874430,  1.00000000,
+	0.63570880,  0.75871463,  1.00000000,
+	0.63566691,  0.75868499,  1.00000000,
+	0.63562507,  0.75865538,  1.00000000,
+	0.63558327,  0.75862580,  1.00000000,
+	0.63554151,  0.75859625,  1.00000000,
+	0.63549980,  0.75856673,  1.00000000,
+	0.63545813,  0.75853724,  1.00000000,
+	0.63541650,  0.75850779,  1.00000000,
+	0.63537491,  0.75847836,  1.00000000,
+	0.63533337,  0.75844896,  1.00000000,
+	0.63529188,  0.75841959,  1.00000000,
+	0.63525042,  0.75839025,  1.00000000, /* 23000K */
+	0.63520901,  0.75836094,  1.00000000,
+	0.63516764,  0.75833166,  1.00000000,
+	0.63512631,  0.75830241,  1.00000000,
+	0.63508503,  0.75827319,  1.00000000,
+	0.63504379,  0.75824400,  1.00000000,
+	0.63500259,  0.75821484,  1.00000000,
+	0.63496144,  0.75818571,  1.00000000,
+	0.63492032,  0.75815660,  1.00000000,
+	0.63487925,  0.75812753,  1.00000000,
+	0.63483822,  0.75809849,  1.00000000,
+	0.63479723,  0.75806948,  1.00000000,
+	0.63475629,  0.75804049,  1.00000000,
+	0.63471538,  0.75801154,  1.00000000,
+	0.63467452,  0.75798262,  1.00000000,
+	0.63463370,  0.75795372,  1.00000000,
+	0.63459292,  0.75792486,  1.00000000,
+	0.63455219,  0.75789602,  1.00000000,
+	0.63451149,  0.75786722,  1.00000000,
+	0.63447084,  0.75783844,  1.00000000,
+	0.63443023,  0.75780969,  1.00000000,
+	0.63438966,  0.75778097,  1.00000000,
+	0.63434913,  0.75775228,  1.00000000,
+	0.63430865,  0.75772362,  1.00000000,
+	0.63426821,  0.75769498,  1.00000000,
+	0.63422780,  0.75766638,  1.00000000,
+	0.63418744,  0.75763780,  1.00000000,
+	0.63414712,  0.75760926,  1.00000000,
+	0.63410685,  0.75758074,  1.00000000,
+	0.63406661,  0.75755225,  1.00000000,
+	0.63402641,  0.75752379,  1.00000000,
+	0.63398625,  0.75749536,  1.00000000,
+	0.63394614,  0.75746695,  1.00000000,
+	0.63390606,  0.75743858,  1.00000000,
+	0.63386603,  0.75741023,  1.00000000,
+	0.63382603,  0.75738192,  1.00000000,
+	0.63378608,  0.75735363,  1.00000000,
+	0.63374617,  0.75732536,  1.00000000,
+	0.63370629,  0.75729713,  1.00000000,
+	0.63366646,  0.75726893,  1.00000000,
+	0.63362667,  0.75724075,  1.00000000,
+	0.63358692,  0.75721260,  1.00000000,
+	0.63354721,  0.75718448,  1.00000000,
+	0.63350754,  0.75715639,  1.00000000,
+	0.63346791,  0.75712833,  1.00000000,
+	0.63342832,  0.75710029,  1.00000000,
+	0.63338877,  0.75707228,  1.00000000,
+	0.63334926,  0.75704430,  1.00000000,
+	0.63330979,  0.75701635,  1.00000000,
+	0.63327036,  0.75698843,  1.00000000,
+	0.63323097,  0.75696053,  1.00000000,
+	0.63319162,  0.75693266,  1.00000000,
+	0.63315231,  0.75690482,  1.00000000,
+	0.63311304,  0.75687701,  1.00000000,
+	0.63307381,  0.75684923,  1.00000000,
+	0.63303462,  0.75682147,  1.00000000,
+	0.63299547,  0.75679374,  1.00000000,
+	0.63295635,  0.75676604,  1.00000000,
+	0.63291728,  0.75673837,  1.00000000,
+	0.63287825,  0.75671072,  1.00000000,
+	0.63283925,  0.75668310,  1.00000000,
+	0.63280029,  0.75665551,  1.00000000,
+	0.63276138,  0.75662794,  1.00000000,
+	0.63272250,  0.75660040,  1.00000000,
+	0.63268366,  0.75657289,  1.00000000,
+	0.63264486,  0.75654541,  1.00000000,
+	0.63260610,  0.75651795,  1.00000000,
+	0.63256738,  0.75649052,  1.00000000,
+	0.63252869,  0.75646312,  1.00000000,
+	0.63249005,  0.75643575,  1.00000000,
+	0.63245144,  0.75640840,  1.00000000,
+	0.63241287,  0.75638108,  1.00000000,
+	0.63237434,  0.75635379,  1.00000000,
+	0.63233585,  0.75632652,  1.00000000,
+	0.63229740,  0.75629928,  1.00000000,
+	0.63225899,  0.75627207,  1.00000000,
+	0.63222061,  0.75624489,  1.00000000,
+	0.63218227,  0.75621773,  1.00000000,
+	0.63214397,  0.75619060,  1.00000000,
+	0.63210571,  0.75616349,  1.00000000,
+	0.63206749,  0.75613641,  1.00000000,
+	0.63202930,  0.75610936,  1.00000000,
+	0.63199116,  0.75608233,  1.00000000,
+	0.63195305,  0.75605533,  1.00000000,
+	0.63191498,  0.75602836,  1.00000000,
+	0.63187695,  0.75600141,  1.00000000,
+	0.63183895,  0.75597449,  1.00000000,
+	0.63180100,  0.75594760,  1.00000000,
+	0.63176308,  0.75592073,  1.00000000,
+	0.63172519,  0.75589389,  1.00000000,
+	0.63168735,  0.75586707,  1.00000000,
+	0.63164954,  0.75584028,  1.00000000,
+	0.63161177,  0.75581352,  1.00000000,
+	0.63157404,  0.75578678,  1.00000000,
+	0.63153635,  0.75576007,  1.00000000,
+	0.63149869,  0.75573339,  1.00000000,
+	0.63146107,  0.75570673,  1.00000000,
+	0.63142349,  0.75568010,  1.00000000,
+	0.63138594,  0.75565349,  1.00000000,
+	0.63134843,  0.75562691,  1.00000000,
+	0.63131096,  0.75560036,  1.00000000, /* 24000K */
+	0.63127352,  0.75557383,  1.00000000,
+	0.63123613,  0.75554733,  1.00000000,
+	0.63119876,  0.75552085,  1.00000000,
+	0.63116144,  0.75549440,  1.00000000,
+	0.63112415,  0.75546798,  1.00000000,
+	0.63108690,  0.75544158,  1.00000000,
+	0.63104969,  0.75541521,  1.00000000,
+	0.63101251,  0.75538886,  1.00000000,
+	0.63097537,  0.75536254,  1.00000000,
+	0.63093826,  0.75533624,  1.00000000,
+	0.63090119,  0.75530997,  1.00000000,
+	0.63086416,  0.75528372,  1.00000000,
+	0.63082716,  0.75525750,  1.00000000,
+	0.63079020,  0.75523131,  1.00000000,
+	0.63075328,  0.75520514,  1.00000000,
+	0.63071639,  0.75517899,  1.00000000,
+	0.63067954,  0.75515288,  1.00000000,
+	0.63064272,  0.75512678,  1.00000000,
+	0.63060594,  0.75510071,  1.00000000,
+	0.63056920,  0.75507467,  1.00000000,
+	0.63053249,  0.75504865,  1.00000000,
+	0.63049582,  0.75502266,  1.00000000,
+	0.63045919,  0.75499669,  1.00000000,
+	0.63042259,  0.75497075,  1.00000000,
+	0.63038602,  0.75494483,  1.00000000,
+	0.63034950,  0.75491894,  1.00000000,
+	0.63031301,  0.75489307,  1.00000000,
+	0.63027655,  0.75486723,  1.00000000,
+	0.63024013,  0.75484141,  1.00000000,
+	0.63020374,  0.75481562,  1.00000000,
+	0.63016739,  0.75478985,  1.00000000,
+	0.63013107,  0.75476411,  1.00000000,
+	0.63009479,  0.75473839,  1.00000000,
+	0.63005855,  0.75471269,  1.00000000,
+	0.63002234,  0.75468702,  1.00000000,
+	0.62998616,  0.75466138,  1.00000000,
+	0.62995002,  0.75463576,  1.00000000,
+	0.62991392,  0.75461016,  1.00000000,
+	0.62987785,  0.75458459,  1.00000000,
+	0.62984181,  0.75455904,  1.00000000,
+	0.62980581,  0.75453352,  1.00000000,
+	0.62976984,  0.75450802,  1.00000000,
+	0.62973391,  0.75448255,  1.00000000,
+	0.62969802,  0.75445710,  1.00000000,
+	0.62966216,  0.75443167,  1.00000000,
+	0.62962633,  0.75440627,  1.00000000,
+	0.62959054,  0.75438089,  1.00000000,
+	0.62955478,  0.75435554,  1.00000000,
+	0.62951906,  0.75433021,  1.00000000,
+	0.62948337,  0.75430491,  1.00000000,
+	0.62944772,  0.75427963,  1.00000000,
+	0.62941210,  0.75425437,  1.00000000,
+	0.62937651,  0.75422914,  1.00000000,
+	0.62934096,  0.75420393,  1.00000000,
+	0.62930545,  0.75417875,  1.00000000,
+	0.62926997,  0.75415359,  1.00000000,
+	0.62923452,  0.75412846,  1.00000000,
+	0.62919911,  0.75410334,  1.00000000,
+	0.62916373,  0.75407825,  1.00000000,
+	0.62912838,  0.75405319,  1.00000000,
+	0.62909307,  0.75402815,  1.00000000,
+	0.62905779,  0.75400313,  1.00000000,
+	0.62902255,  0.75397814,  1.00000000,
+	0.62898734,  0.75395317,  1.00000000,
+	0.62895216,  0.75392823,  1.00000000,
+	0.62891702,  0.75390330,  1.00000000,
+	0.62888191,  0.75387841,  1.00000000,
+	0.62884683,  0.75385353,  1.00000000,
+	0.62881179,  0.75382868,  1.00000000,
+	0.62877678,  0.75380385,  1.00000000,
+	0.62874180,  0.75377904,  1.00000000,
+	0.62870686,  0.75375426,  1.00000000,
+	0.62867195,  0.75372950,  1.00000000,
+	0.62863708,  0.75370477,  1.00000000,
+	0.62860224,  0.75368006,  1.00000000,
+	0.62856743,  0.75365537,  1.00000000,
+	0.62853265,  0.75363071,  1.00000000,
+	0.62849791,  0.75360606,  1.00000000,
+	0.62846320,  0.75358145,  1.00000000,
+	0.62842852,  0.75355685,  1.00000000,
+	0.62839388,  0.75353228,  1.00000000,
+	0.62835926,  0.75350773,  1.00000000,
+	0.62832469,  0.75348320,  1.00000000,
+	0.62829014,  0.75345870,  1.00000000,
+	0.62825563,  0.75343422,  1.00000000,
+	0.62822115,  0.75340977,  1.00000000,
+	0.62818670,  0.75338533,  1.00000000,
+	0.62815229,  0.75336092,  1.00000000,
+	0.62811791,  0.75333654,  1.00000000,
+	0.62808356,  0.75331217,  1.00000000,
+	0.62804924,  0.75328783,  1.00000000,
+	0.62801496,  0.75326351,  1.00000000,
+	0.62798071,  0.75323921,  1.00000000,
+	0.62794649,  0.75321494,  1.00000000,
+	0.62791231,  0.75319069,  1.00000000,
+	0.62787815,  0.75316646,  1.00000000,
+	0.62784403,  0.75314225,  1.00000000,
+	0.62780994,  0.75311807,  1.00000000,
+	0.62777589,  0.75309391,  1.00000000,
+	0.62774186,  0.75306977,  1.00000000, /* 25000K */
+	0.62770788,  0.75304566,  1.00000000,
+	0.62767396,  0.75302160,  1.00000000,
+	0.62764007,  0.75299756,  1.00000000,
+	0.62760623,  0.75297355,  1.00000000,
+	0.62757241,  0.75294955,  1.00000000,
+	0.62753861,  0.75292557,  1.00000000,
+	0.62750481,  0.75290159,  1.00000000,
+	0.62747101,  0.75287761,  1.00000000,
+	0.62743720,  0.75285362,  1.00000000,
+	0.62740336,  0.75282962,  1.00000000  /* 25100K */
+};
+
+#endif /* ! REDSHIFT_COLORRAMP_TABLE_H */
@@ -18,259 +18,58 @@
    Copyright (c) 2013  Ingo Thies <ithies@astro.uni-bonn.de>
 */
 
+#include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 #include <math.h>
 
 #include "redshift.h"
+#include "colorramp.h"
+#include "stats.h"
 
-/* Whitepoint values for temperatures at 100K intervals.
-   These will be interpolated for the actual temperature.
-   This table was provided by Ingo Thies, 2013. See
-   the file README-colorramp for more information. */
-static const float blackbody_color[] = {
-	1.00000000,  0.18172716,  0.00000000, /* 1000K */
-	1.00000000,  0.25503671,  0.00000000, /* 1100K */
-	1.00000000,  0.30942099,  0.00000000, /* 1200K */
-	1.00000000,  0.35357379,  0.00000000, /* ...   */
-	1.00000000,  0.39091524,  0.00000000,
-	1.00000000,  0.42322816,  0.00000000,
-	1.00000000,  0.45159884,  0.00000000,
-	1.00000000,  0.47675916,  0.00000000,
-	1.00000000,  0.49923747,  0.00000000,
-	1.00000000,  0.51943421,  0.00000000,
-	1.00000000,  0.54360078,  0.08679949,
-	1.00000000,  0.56618736,  0.14065513,
-	1.00000000,  0.58734976,  0.18362641,
-	1.00000000,  0.60724493,  0.22137978,
-	1.00000000,  0.62600248,  0.25591950,
-	1.00000000,  0.64373109,  0.28819679,
-	1.00000000,  0.66052319,  0.31873863,
-	1.00000000,  0.67645822,  0.34786758,
-	1.00000000,  0.69160518,  0.37579588,
-	1.00000000,  0.70602449,  0.40267128,
-	1.00000000,  0.71976951,  0.42860152,
-	1.00000000,  0.73288760,  0.45366838,
-	1.00000000,  0.74542112,  0.47793608,
-	1.00000000,  0.75740814,  0.50145662,
-	1.00000000,  0.76888303,  0.52427322,
-	1.00000000,  0.77987699,  0.54642268,
-	1.00000000,  0.79041843,  0.56793692,
-	1.00000000,  0.80053332,  0.58884417,
-	1.00000000,  0.81024551,  0.60916971,
-	1.00000000,  0.81957693,  0.62893653,
-	1.00000000,  0.82854786,  0.64816570,
-	1.00000000,  0.83717703,  0.66687674,
-	1.00000000,  0.84548188,  0.68508786,
-	1.00000000,  0.85347859,  0.70281616,
-	1.00000000,  0.86118227,  0.72007777,
-	1.00000000,  0.86860704,  0.73688797,
-	1.00000000,  0.87576611,  0.75326132,
-	1.00000000,  0.88267187,  0.76921169,
-	1.00000000,  0.88933596,  0.78475236,
-	1.00000000,  0.89576933,  0.79989606,
-	1.00000000,  0.90198230,  0.81465502,
-	1.00000000,  0.90963069,  0.82838210,
-	1.00000000,  0.91710889,  0.84190889,
-	1.00000000,  0.92441842,  0.85523742,
-	1.00000000,  0.93156127,  0.86836903,
-	1.00000000,  0.93853986,  0.88130458,
-	1.00000000,  0.94535695,  0.89404470,
-	1.00000000,  0.95201559,  0.90658983,
-	1.00000000,  0.95851906,  0.91894041,
-	1.00000000,  0.96487079,  0.93109690,
-	1.00000000,  0.97107439,  0.94305985,
-	1.00000000,  0.97713351,  0.95482993,
-	1.00000000,  0.98305189,  0.96640795,
-	1.00000000,  0.98883326,  0.97779486,
-	1.00000000,  0.99448139,  0.98899179,
-	1.00000000,  1.00000000,  1.00000000, /* 6500K */
-	0.98947904,  0.99348723,  1.00000000,
-	0.97940448,  0.98722715,  1.00000000,
-	0.96975025,  0.98120637,  1.00000000,
-	0.96049223,  0.97541240,  1.00000000,
-	0.95160805,  0.96983355,  1.00000000,
-	0.94303638,  0.96443333,  1.00000000,
-	0.93480451,  0.95923080,  1.00000000,
-	0.92689056,  0.95421394,  1.00000000,
-	0.91927697,  0.94937330,  1.00000000,
-	0.91194747,  0.94470005,  1.00000000,
-	0.90488690,  0.94018594,  1.00000000,
-	0.89808115,  0.93582323,  1.00000000,
-	0.89151710,  0.93160469,  1.00000000,
-	0.88518247,  0.92752354,  1.00000000,
-	0.87906581,  0.92357340,  1.00000000,
-	0.87315640,  0.91974827,  1.00000000,
-	0.86744421,  0.91604254,  1.00000000,
-	0.86191983,  0.91245088,  1.00000000,
-	0.85657444,  0.90896831,  1.00000000,
-	0.85139976,  0.90559011,  1.00000000,
-	0.84638799,  0.90231183,  1.00000000,
-	0.84153180,  0.89912926,  1.00000000,
-	0.83682430,  0.89603843,  1.00000000,
-	0.83225897,  0.89303558,  1.00000000,
-	0.82782969,  0.89011714,  1.00000000,
-	0.82353066,  0.88727974,  1.00000000,
-	0.81935641,  0.88452017,  1.00000000,
-	0.81530175,  0.88183541,  1.00000000,
-	0.81136180,  0.87922257,  1.00000000,
-	0.80753191,  0.87667891,  1.00000000,
-	0.80380769,  0.87420182,  1.00000000,
-	0.80018497,  0.87178882,  1.00000000,
-	0.79665980,  0.86943756,  1.00000000,
-	0.79322843,  0.86714579,  1.00000000,
-	0.78988728,  0.86491137,  1.00000000, /* 10000K */
-	0.78663296,  0.86273225,  1.00000000,
-	0.78346225,  0.86060650,  1.00000000,
-	0.78037207,  0.85853224,  1.00000000,
-	0.77735950,  0.85650771,  1.00000000,
-	0.77442176,  0.85453121,  1.00000000,
-	0.77155617,  0.85260112,  1.00000000,
-	0.76876022,  0.85071588,  1.00000000,
-	0.76603147,  0.84887402,  1.00000000,
-	0.76336762,  0.84707411,  1.00000000,
-	0.76076645,  0.84531479,  1.00000000,
-	0.75822586,  0.84359476,  1.00000000,
-	0.75574383,  0.84191277,  1.00000000,
-	0.75331843,  0.84026762,  1.00000000,
-	0.75094780,  0.83865816,  1.00000000,
-	0.74863017,  0.83708329,  1.00000000,
-	0.74636386,  0.83554194,  1.00000000,
-	0.74414722,  0.83403311,  1.00000000,
-	0.74197871,  0.83255582,  1.00000000,
-	0.73985682,  0.83110912,  1.00000000,
-	0.73778012,  0.82969211,  1.00000000,
-	0.73574723,  0.82830393,  1.00000000,
-	0.73375683,  0.82694373,  1.00000000,
-	0.73180765,  0.82561071,  1.00000000,
-	0.72989845,  0.82430410,  1.00000000,
-	0.72802807,  0.82302316,  1.00000000,
-	0.72619537,  0.82176715,  1.00000000,
-	0.72439927,  0.82053539,  1.00000000,
-	0.72263872,  0.81932722,  1.00000000,
-	0.72091270,  0.81814197,  1.00000000,
-	0.71922025,  0.81697905,  1.00000000,
-	0.71756043,  0.81583783,  1.00000000,
-	0.71593234,  0.81471775,  1.00000000,
-	0.71433510,  0.81361825,  1.00000000,
-	0.71276788,  0.81253878,  1.00000000,
-	0.71122987,  0.81147883,  1.00000000,
-	0.70972029,  0.81043789,  1.00000000,
-	0.70823838,  0.80941546,  1.00000000,
-	0.70678342,  0.80841109,  1.00000000,
-	0.70535469,  0.80742432,  1.00000000,
-	0.70395153,  0.80645469,  1.00000000,
-	0.70257327,  0.80550180,  1.00000000,
-	0.70121928,  0.80456522,  1.00000000,
-	0.69988894,  0.80364455,  1.00000000,
-	0.69858167,  0.80273941,  1.00000000,
-	0.69729688,  0.80184943,  1.00000000,
-	0.69603402,  0.80097423,  1.00000000,
-	0.69479255,  0.80011347,  1.00000000,
-	0.69357196,  0.79926681,  1.00000000,
-	0.69237173,  0.79843391,  1.00000000,
-	0.69119138,  0.79761446,  1.00000000, /* 15000K */
-	0.69003044,  0.79680814,  1.00000000,
-	0.68888844,  0.79601466,  1.00000000,
-	0.68776494,  0.79523371,  1.00000000,
-	0.68665951,  0.79446502,  1.00000000,
-	0.68557173,  0.79370830,  1.00000000,
-	0.68450119,  0.79296330,  1.00000000,
-	0.68344751,  0.79222975,  1.00000000,
-	0.68241029,  0.79150740,  1.00000000,
-	0.68138918,  0.79079600,  1.00000000,
-	0.68038380,  0.79009531,  1.00000000,
-	0.67939381,  0.78940511,  1.00000000,
-	0.67841888,  0.78872517,  1.00000000,
-	0.67745866,  0.78805526,  1.00000000,
-	0.67651284,  0.78739518,  1.00000000,
-	0.67558112,  0.78674472,  1.00000000,
-	0.67466317,  0.78610368,  1.00000000,
-	0.67375872,  0.78547186,  1.00000000,
-	0.67286748,  0.78484907,  1.00000000,
-	0.67198916,  0.78423512,  1.00000000,
-	0.67112350,  0.78362984,  1.00000000,
-	0.67027024,  0.78303305,  1.00000000,
-	0.66942911,  0.78244457,  1.00000000,
-	0.66859988,  0.78186425,  1.00000000,
-	0.66778228,  0.78129191,  1.00000000,
-	0.66697610,  0.78072740,  1.00000000,
-	0.66618110,  0.78017057,  1.00000000,
-	0.66539706,  0.77962127,  1.00000000,
-	0.66462376,  0.77907934,  1.00000000,
-	0.66386098,  0.77854465,  1.00000000,
-	0.66310852,  0.77801705,  1.00000000,
-	0.66236618,  0.77749642,  1.00000000,
-	0.66163375,  0.77698261,  1.00000000,
-	0.66091106,  0.77647551,  1.00000000,
-	0.66019791,  0.77597498,  1.00000000,
-	0.65949412,  0.77548090,  1.00000000,
-	0.65879952,  0.77499315,  1.00000000,
-	0.65811392,  0.77451161,  1.00000000,
-	0.65743716,  0.77403618,  1.00000000,
-	0.65676908,  0.77356673,  1.00000000,
-	0.65610952,  0.77310316,  1.00000000,
-	0.65545831,  0.77264537,  1.00000000,
-	0.65481530,  0.77219324,  1.00000000,
-	0.65418036,  0.77174669,  1.00000000,
-	0.65355332,  0.77130560,  1.00000000,
-	0.65293404,  0.77086988,  1.00000000,
-	0.65232240,  0.77043944,  1.00000000,
-	0.65171824,  0.77001419,  1.00000000,
-	0.65112144,  0.76959404,  1.00000000,
-	0.65053187,  0.76917889,  1.00000000,
-	0.64994941,  0.76876866,  1.00000000, /* 20000K */
-	0.64937392,  0.76836326,  1.00000000,
-	0.64880528,  0.76796263,  1.00000000,
-	0.64824339,  0.76756666,  1.00000000,
-	0.64768812,  0.76717529,  1.00000000,
-	0.64713935,  0.76678844,  1.00000000,
-	0.64659699,  0.76640603,  1.00000000,
-	0.64606092,  0.76602798,  1.00000000,
-	0.64553103,  0.76565424,  1.00000000,
-	0.64500722,  0.76528472,  1.00000000,
-	0.64448939,  0.76491935,  1.00000000,
-	0.64397745,  0.76455808,  1.00000000,
-	0.64347129,  0.76420082,  1.00000000,
-	0.64297081,  0.76384753,  1.00000000,
-	0.64247594,  0.76349813,  1.00000000,
-	0.64198657,  0.76315256,  1.00000000,
-	0.64150261,  0.76281076,  1.00000000,
-	0.64102399,  0.76247267,  1.00000000,
-	0.64055061,  0.76213824,  1.00000000,
-	0.64008239,  0.76180740,  1.00000000,
-	0.63961926,  0.76148010,  1.00000000,
-	0.63916112,  0.76115628,  1.00000000,
-	0.63870790,  0.76083590,  1.00000000,
-	0.63825953,  0.76051890,  1.00000000,
-	0.63781592,  0.76020522,  1.00000000,
-	0.63737701,  0.75989482,  1.00000000,
-	0.63694273,  0.75958764,  1.00000000,
-	0.63651299,  0.75928365,  1.00000000,
-	0.63608774,  0.75898278,  1.00000000,
-	0.63566691,  0.75868499,  1.00000000,
-	0.63525042,  0.75839025,  1.00000000,
-	0.63483822,  0.75809849,  1.00000000,
-	0.63443023,  0.75780969,  1.00000000,
-	0.63402641,  0.75752379,  1.00000000,
-	0.63362667,  0.75724075,  1.00000000,
-	0.63323097,  0.75696053,  1.00000000,
-	0.63283925,  0.75668310,  1.00000000,
-	0.63245144,  0.75640840,  1.00000000,
-	0.63206749,  0.75613641,  1.00000000,
-	0.63168735,  0.75586707,  1.00000000,
-	0.63131096,  0.75560036,  1.00000000,
-	0.63093826,  0.75533624,  1.00000000,
-	0.63056920,  0.75507467,  1.00000000,
-	0.63020374,  0.75481562,  1.00000000,
-	0.62984181,  0.75455904,  1.00000000,
-	0.62948337,  0.75430491,  1.00000000,
-	0.62912838,  0.75405319,  1.00000000,
-	0.62877678,  0.75380385,  1.00000000,
-	0.62842852,  0.75355685,  1.00000000,
-	0.62808356,  0.75331217,  1.00000000,
-	0.62774186,  0.75306977,  1.00000000, /* 25000K */
-	0.62740336,  0.75282962,  1.00000000  /* 25100K */
-};
+/* Whitepoint values for temperatures at BLACKBODY_STEP intervals.
+   These will be interpolated for the actual temperature. The table is
+   generated from the one at 100K intervals that was provided by Ingo
+   Thies, 2013. See the file README-colorramp for more information. */
+#include "colorramp-table.h"
+
+
+/* Number of computed ramps that are kept for reuse. The same ramp is
+   typically applied to several CRTCs, and in steady state the same
+   setting is applied on every update. */
+#define COLORRAMP_CACHE_SIZE  4
+
+typedef struct {
+	color_setting_t setting;
+	int size;
+	/* Input and output ramps, each 3*size entries (red, green, blue). */
+	uint16_t *input;
+	uint16_t *output;
+	unsigned int last_use;
+} colorramp_cache_entry_t;
+
+static colorramp_cache_entry_t ramp_cache[COLORRAMP_CACHE_SIZE];
+static unsigned int ramp_cache_clock = 0;
+
+/* Number of unscaled base ramps that are kept. Outputs with their own
+   gamma each need one while they fade at the same time. */
+#define COLORRAMP_BASE_CACHE_SIZE  2
+
+/* Unscaled ramps pow(y, exponent) for one set of input ramps and gamma.
+   Settings that differ only in temperature or brightness change just
+   the per-channel scale, so during such fades the ramps are derived
+   from these with one multiply per entry. */
+typedef struct {
+	float gamma[3];
+	int size;
+	/* Base ramps in double precision followed by the input ramps,
+	   each 3*size entries. */
+	double *base;
+	uint16_t *input;
+	unsigned int last_use;
+} colorramp_base_t;
+
+static colorramp_base_t ramp_bases[COLORRAMP_BASE_CACHE_SIZE];
 
 
 static void
@@ -281,47 +80,843 @@ interpolate_color(float a, const float *c1, const float *c2, float *c)
 	c[2] = (1.0-a)*c1[2] + a*c2[2];
 }
 
-/* Helper macro used in the fill functions */
-#define F(Y, C)  pow((Y) * setting->brightness * \
-		     white_point[C], 1.0/setting->gamma[C])
-
+/* Calculate the per-channel parameters of the transfer function.
+   The ramp value for input Y is pow(Y * brightness * white_point, 1/gamma)
+   which is the same as scale * pow(Y, exponent). This moves everything
+   but the per-entry power out of the fill loops, and the power can be
+   skipped entirely for unit gamma. Backends that take the transfer
+   function as a formula can use the parameters without any ramps. */
 void
-colorramp_fill(uint16_t *gamma_r, uint16_t *gamma_g, uint16_t *gamma_b,
-	       int size, const color_setting_t *setting)
+colorramp_params(const color_setting_t *setting,
+		 double scale[3], double exponent[3])
 {
 	/* Approximate white point */
 	float white_point[3];
-	float alpha = (setting->temperature % 100) / 100.0;
-	int temp_index = ((setting->temperature - 1000) / 100)*3;
+	int offset = setting->temperature - BLACKBODY_MIN;
+	float alpha = (offset % BLACKBODY_STEP) / (float)BLACKBODY_STEP;
+	int temp_index = (offset / BLACKBODY_STEP)*3;
 	interpolate_color(alpha, &blackbody_color[temp_index],
 			  &blackbody_color[temp_index+3], white_point);
 
+	for (int c = 0; c < 3; c++) {
+		exponent[c] = 1.0/setting->gamma[c];
+		scale[c] = pow(setting->brightness * white_point[c],
+			       exponent[c]);
+	}
+}
+
+/* Loops that only scale the ramp are cheap enough that the loop
+   bound matters. They are called with constant sizes for the common
+   ramp sizes, so that copies with a fixed trip count are unrolled and
+   vectorized. Backends with a fixed ramp size, like the 256 entries
+   used with Windows GDI, always take one of these. */
+static inline void
+scale_channel(uint16_t *ramp, int size, double scale)
+{
 	for (int i = 0; i < size; i++) {
-		gamma_r[i] = F((double)gamma_r[i]/(UINT16_MAX+1), 0) *
-			(UINT16_MAX+1);
-		gamma_g[i] = F((double)gamma_g[i]/(UINT16_MAX+1), 1) *
-			(UINT16_MAX+1);
-		gamma_b[i] = F((double)gamma_b[i]/(UINT16_MAX+1), 2) *
-			(UINT16_MAX+1);
+		ramp[i] = scale * ramp[i];
 	}
 }
 
+static inline void
+scale_channel_base(uint16_t *ramp, const double *base, int size,
+		   double scale)
+{
+	for (int i = 0; i < size; i++) {
+		ramp[i] = scale * base[i];
+	}
+}
+
+static void
+fill_channel(uint16_t *ramp, int size, double scale, double exponent)
+{
+	if (exponent == 1.0) {
+		switch (size) {
+		case 256:
+			scale_channel(ramp, 256, scale);
+			break;
+		case 1024:
+			scale_channel(ramp, 1024, scale);
+			break;
+		case 4096:
+			scale_channel(ramp, 4096, scale);
+			break;
+		default:
+			scale_channel(ramp, size, scale);
+			break;
+		}
+	} else {
+		for (int i = 0; i < size; i++) {
+			double y = (double)ramp[i]/(UINT16_MAX+1);
+			ramp[i] = scale * pow(y, exponent) * (UINT16_MAX+1);
+		}
+	}
+}
+
+/* Scale the base ramp, giving the same result as the reference kernel. */
+static void
+fill_channel_derived(uint16_t *ramp, const double *base, int size,
+		     double scale)
+{
+	switch (size) {
+	case 256:
+		scale_channel_base(ramp, base, 256, scale);
+		break;
+	case 1024:
+		scale_channel_base(ramp, base, 1024, scale);
+		break;
+	case 4096:
+		scale_channel_base(ramp, base, 4096, scale);
+		break;
+	default:
+		scale_channel_base(ramp, base, size, scale);
+		break;
+	}
+}
+
+static void
+fill_channel_float(float *ramp, int size, double scale, double exponent)
+{
+	if (exponent == 1.0) {
+		for (int i = 0; i < size; i++) {
+			ramp[i] = scale * ramp[i];
+		}
+	} else {
+		for (int i = 0; i < size; i++) {
+			ramp[i] = scale * pow((double)ramp[i], exponent);
+		}
+	}
+}
+
+
+/* Vectorized kernels.
+   These evaluate pow(y, exponent) as exp2(exponent * log2(y)) in single
+   precision. The mantissa is reduced to [sqrt(1/2), sqrt(2)) and log2 is
+   computed from the atanh series up to the ninth power (error below
+   3e-8); exp2 of the fractional part uses a degree 7 Taylor polynomial
+   (relative error below 1e-9). Including rounding this keeps the
+   unquantized output within 0.05 of the reference computation on the
+   16-bit scale for gamma values between 0.1 and 10, so after truncation
+   the result differs from the reference path by at most one unit. */
+
+/* Coefficients for log2(m) = 2/ln(2) * atanh(t), t = (m-1)/(m+1) */
+#define LOG2_C1  2.8853900817779268f
+#define LOG2_C3  (LOG2_C1/3.0f)
+#define LOG2_C5  (LOG2_C1/5.0f)
+#define LOG2_C7  (LOG2_C1/7.0f)
+#define LOG2_C9  (LOG2_C1/9.0f)
+
+/* Coefficients for exp2(f) = exp(f*ln(2)) */
+#define EXP2_C1  0.6931471805599453f
+#define EXP2_C2  0.2402265069591007f
+#define EXP2_C3  0.05550410866482158f
+#define EXP2_C4  0.009618129107628477f
+#define EXP2_C5  0.0013333558146428443f
+#define EXP2_C6  0.00015403530393381606f
+#define EXP2_C7  1.525273380405984e-05f
+
+#define SQRT2_F  1.4142135623730951f
+
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define COLORRAMP_X86  1
+# include <immintrin.h>
+# define TARGET_SSE2  __attribute__((target("sse2")))
+# define TARGET_AVX2  __attribute__((target("avx2,fma")))
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+# define COLORRAMP_NEON  1
+# include <arm_neon.h>
+#endif
+
+
+#ifdef COLORRAMP_X86
+
+static inline TARGET_SSE2 __m128
+pow_sse2(__m128 x, __m128 exponent)
+{
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	/* Split into exponent and mantissa in [sqrt(1/2), sqrt(2)) */
+	__m128i bits = _mm_castps_si128(x);
+	__m128i k = _mm_sub_epi32(_mm_srli_epi32(bits, 23),
+				  _mm_set1_epi32(127));
+	__m128 m = _mm_castsi128_ps(_mm_or_si128(
+		_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)),
+		_mm_set1_epi32(0x3f800000)));
+	__m128 big = _mm_cmpgt_ps(m, _mm_set1_ps(SQRT2_F));
+	m = _mm_or_ps(_mm_and_ps(big, _mm_mul_ps(m, _mm_set1_ps(0.5f))),
+		      _mm_andnot_ps(big, m));
+	k = _mm_sub_epi32(k, _mm_castps_si128(big));
+
+	/* log2 of mantissa */
+	__m128 t = _mm_div_ps(_mm_sub_ps(m, one), _mm_add_ps(m, one));
+	__m128 t2 = _mm_mul_ps(t, t);
+	__m128 p = _mm_set1_ps(LOG2_C9);
+	p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(LOG2_C7));
+	p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(LOG2_C5));
+	p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(LOG2_C3));
+	p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(LOG2_C1));
+	__m128 z = _mm_mul_ps(exponent,
+			      _mm_add_ps(_mm_cvtepi32_ps(k), _mm_mul_ps(p, t)));
+
+	/* exp2 of the product */
+	z = _mm_min_ps(_mm_max_ps(z, _mm_set1_ps(-126.0f)),
+		       _mm_set1_ps(127.0f));
+	__m128i n = _mm_cvtps_epi32(z);
+	__m128 f = _mm_sub_ps(z, _mm_cvtepi32_ps(n));
+	p = _mm_set1_ps(EXP2_C7);
+	p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(EXP2_C6));
+	p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(EXP2_C5));
+	p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(EXP2_C4));
+	p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(EXP2_C3));
+	p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(EXP2_C2));
+	p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(EXP2_C1));
+	p = _mm_add_ps(_mm_mul_ps(p, f), one);
+	__m128 scale = _mm_castsi128_ps(_mm_slli_epi32(
+		_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+
+	/* pow(0, exponent) is zero */
+	return _mm_and_ps(_mm_mul_ps(p, scale),
+			  _mm_cmpgt_ps(x, _mm_setzero_ps()));
+}
+
+static TARGET_SSE2 void
+fill_channel_sse2(uint16_t *ramp, int size, double scale, double exponent)
+{
+	if (exponent == 1.0) {
+		fill_channel(ramp, size, scale, exponent);
+		return;
+	}
+
+	const __m128 vscale = _mm_set1_ps(scale * (UINT16_MAX+1));
+	const __m128 vinv = _mm_set1_ps(1.0f/(UINT16_MAX+1));
+	const __m128 vexp = _mm_set1_ps(exponent);
+	const __m128i bias32 = _mm_set1_epi32(0x8000);
+	const __m128i bias16 = _mm_set1_epi16((short)0x8000);
+	const __m128i zero = _mm_setzero_si128();
+
+	int i = 0;
+	for (; i + 8 <= size; i += 8) {
+		__m128i v = _mm_loadu_si128((const __m128i *)&ramp[i]);
+		__m128 lo = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero));
+		__m128 hi = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v, zero));
+		lo = _mm_mul_ps(pow_sse2(_mm_mul_ps(lo, vinv), vexp), vscale);
+		hi = _mm_mul_ps(pow_sse2(_mm_mul_ps(hi, vinv), vexp), vscale);
+
+		/* SSE2 only has a signed pack so shift the range down
+		   and back up again around the pack. */
+		__m128i ilo = _mm_sub_epi32(_mm_cvttps_epi32(lo), bias32);
+		__m128i ihi = _mm_sub_epi32(_mm_cvttps_epi32(hi), bias32);
+		v = _mm_xor_si128(_mm_packs_epi32(ilo, ihi), bias16);
+		_mm_storeu_si128((__m128i *)&ramp[i], v);
+	}
+
+	fill_channel(&ramp[i], size - i, scale, exponent);
+}
+
+static TARGET_SSE2 void
+fill_channel_float_sse2(float *ramp, int size, double scale, double exponent)
+{
+	if (exponent == 1.0) {
+		fill_channel_float(ramp, size, scale, exponent);
+		return;
+	}
+
+	const __m128 vscale = _mm_set1_ps(scale);
+	const __m128 vexp = _mm_set1_ps(exponent);
+
+	int i = 0;
+	for (; i + 4 <= size; i += 4) {
+		__m128 x = _mm_loadu_ps(&ramp[i]);
+		x = _mm_mul_ps(pow_sse2(x, vexp), vscale);
+		_mm_storeu_ps(&ramp[i], x);
+	}
+
+	fill_channel_float(&ramp[i], size - i, scale, exponent);
+}
+
+static inline TARGET_AVX2 __m256
+pow_avx2(__m256 x, __m256 exponent)
+{
+	const __m256 one = _mm256_set1_ps(1.0f);
+
+	/* Split into exponent and mantissa in [sqrt(1/2), sqrt(2)) */
+	__m256i bits = _mm256_castps_si256(x);
+	__m256i k = _mm256_sub_epi32(_mm256_srli_epi32(bits, 23),
+				     _mm256_set1_epi32(127));
+	__m256 m = _mm256_castsi256_ps(_mm256_or_si256(
+		_mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)),
+		_mm256_set1_epi32(0x3f800000)));
+	__m256 big = _mm256_cmp_ps(m, _mm256_set1_ps(SQRT2_F), _CMP_GT_OQ);
+	m = _mm256_blendv_ps(m, _mm256_mul_ps(m, _mm256_set1_ps(0.5f)), big);
+	k = _mm256_sub_epi32(k, _mm256_castps_si256(big));
+
+	/* log2 of mantissa */
+	__m256 t = _mm256_div_ps(_mm256_sub_ps(m, one), _mm256_add_ps(m, one));
+	__m256 t2 = _mm256_mul_ps(t, t);
+	__m256 p = _mm256_set1_ps(LOG2_C9);
+	p = _mm256_fmadd_ps(p, t2, _mm256_set1_ps(LOG2_C7));
+	p = _mm256_fmadd_ps(p, t2, _mm256_set1_ps(LOG2_C5));
+	p = _mm256_fmadd_ps(p, t2, _mm256_set1_ps(LOG2_C3));
+	p = _mm256_fmadd_ps(p, t2, _mm256_set1_ps(LOG2_C1));
+	__m256 z = _mm256_mul_ps(exponent,
+				 _mm256_fmadd_ps(p, t, _mm256_cvtepi32_ps(k)));
+
+	/* exp2 of the product */
+	z = _mm256_min_ps(_mm256_max_ps(z, _mm256_set1_ps(-126.0f)),
+			  _mm256_set1_ps(127.0f));
+	__m256i n = _mm256_cvtps_epi32(z);
+	__m256 f = _mm256_sub_ps(z, _mm256_cvtepi32_ps(n));
+	p = _mm256_set1_ps(EXP2_C7);
+	p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(EXP2_C6));
+	p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(EXP2_C5));
+	p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(EXP2_C4));
+	p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(EXP2_C3));
+	p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(EXP2_C2));
+	p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(EXP2_C1));
+	p = _mm256_fmadd_ps(p, f, one);
+	__m256 scale = _mm256_castsi256_ps(_mm256_slli_epi32(
+		_mm256_add_epi32(n, _mm256_set1_epi32(127)), 23));
+
+	/* pow(0, exponent) is zero */
+	return _mm256_and_ps(_mm256_mul_ps(p, scale),
+			     _mm256_cmp_ps(x, _mm256_setzero_ps(),
+					   _CMP_GT_OQ));
+}
+
+static TARGET_AVX2 void
+fill_channel_avx2(uint16_t *ramp, int size, double scale, double exponent)
+{
+	if (exponent == 1.0) {
+		fill_channel(ramp, size, scale, exponent);
+		return;
+	}
+
+	const __m256 vscale = _mm256_set1_ps(scale * (UINT16_MAX+1));
+	const __m256 vinv = _mm256_set1_ps(1.0f/(UINT16_MAX+1));
+	const __m256 vexp = _mm256_set1_ps(exponent);
+
+	int i = 0;
+	for (; i + 8 <= size; i += 8) {
+		__m128i v = _mm_loadu_si128((const __m128i *)&ramp[i]);
+		__m256 x = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(v));
+		x = _mm256_mul_ps(pow_avx2(_mm256_mul_ps(x, vinv), vexp),
+				  vscale);
+
+		__m256i iv = _mm256_cvttps_epi32(x);
+		v = _mm_packus_epi32(_mm256_castsi256_si128(iv),
+				     _mm256_extracti128_si256(iv, 1));
+		_mm_storeu_si128((__m128i *)&ramp[i], v);
+	}
+
+	fill_channel(&ramp[i], size - i, scale, exponent);
+}
+
+static TARGET_AVX2 void
+fill_channel_derived_avx2(uint16_t *ramp, const double *base, int size,
+			  double scale)
+{
+	const __m256d vscale = _mm256_set1_pd(scale);
+
+	int i = 0;
+	for (; i + 8 <= size; i += 8) {
+		__m128i lo = _mm256_cvttpd_epi32(
+			_mm256_mul_pd(_mm256_loadu_pd(&base[i]), vscale));
+		__m128i hi = _mm256_cvttpd_epi32(
+			_mm256_mul_pd(_mm256_loadu_pd(&base[i+4]), vscale));
+		_mm_storeu_si128((__m128i *)&ramp[i],
+				 _mm_packus_epi32(lo, hi));
+	}
+
+	fill_channel_derived(&ramp[i], &base[i], size - i, scale);
+}
+
+static TARGET_AVX2 void
+fill_channel_float_avx2(float *ramp, int size, double scale, double exponent)
+{
+	if (exponent == 1.0) {
+		fill_channel_float(ramp, size, scale, exponent);
+		return;
+	}
+
+	const __m256 vscale = _mm256_set1_ps(scale);
+	const __m256 vexp = _mm256_set1_ps(exponent);
+
+	int i = 0;
+	for (; i + 8 <= size; i += 8) {
+		__m256 x = _mm256_loadu_ps(&ramp[i]);
+		x = _mm256_mul_ps(pow_avx2(x, vexp), vscale);
+		_mm256_storeu_ps(&ramp[i], x);
+	}
+
+	fill_channel_float(&ramp[i], size - i, scale, exponent);
+}
+
+static int
+cpu_has_sse2(void)
+{
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("sse2");
+}
+
+static int
+cpu_has_avx2(void)
+{
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") &&
+		__builtin_cpu_supports("fma");
+}
+
+#endif /* COLORRAMP_X86 */
+
+
+#ifdef COLORRAMP_NEON
+
+static inline float32x4_t
+pow_neon(float32x4_t x, float32x4_t exponent)
+{
+	const float32x4_t one = vdupq_n_f32(1.0f);
+
+	/* Split into exponent and mantissa in [sqrt(1/2), sqrt(2)) */
+	uint32x4_t bits = vreinterpretq_u32_f32(x);
+	int32x4_t k = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)),
+				vdupq_n_s32(127));
+	float32x4_t m = vreinterpretq_f32_u32(vorrq_u32(
+		vandq_u32(bits, vdupq_n_u32(0x007fffff)),
+		vdupq_n_u32(0x3f800000)));
+	uint32x4_t big = vcgtq_f32(m, vdupq_n_f32(SQRT2_F));
+	m = vbslq_f32(big, vmulq_n_f32(m, 0.5f), m);
+	k = vsubq_s32(k, vreinterpretq_s32_u32(big));
+
+	/* log2 of mantissa */
+	float32x4_t t = vdivq_f32(vsubq_f32(m, one), vaddq_f32(m, one));
+	float32x4_t t2 = vmulq_f32(t, t);
+	float32x4_t p = vdupq_n_f32(LOG2_C9);
+	p = vfmaq_f32(vdupq_n_f32(LOG2_C7), p, t2);
+	p = vfmaq_f32(vdupq_n_f32(LOG2_C5), p, t2);
+	p = vfmaq_f32(vdupq_n_f32(LOG2_C3), p, t2);
+	p = vfmaq_f32(vdupq_n_f32(LOG2_C1), p, t2);
+	float32x4_t z = vmulq_f32(exponent,
+				  vfmaq_f32(vcvtq_f32_s32(k), p, t));
+
+	/* exp2 of the product */
+	z = vminq_f32(vmaxq_f32(z, vdupq_n_f32(-126.0f)),
+		      vdupq_n_f32(127.0f));
+	int32x4_t n = vcvtnq_s32_f32(z);
+	float32x4_t f = vsubq_f32(z, vcvtq_f32_s32(n));
+	p = vdupq_n_f32(EXP2_C7);
+	p = vfmaq_f32(vdupq_n_f32(EXP2_C6), p, f);
+	p = vfmaq_f32(vdupq_n_f32(EXP2_C5), p, f);
+	p = vfmaq_f32(vdupq_n_f32(EXP2_C4), p, f);
+	p = vfmaq_f32(vdupq_n_f32(EXP2_C3), p, f);
+	p = vfmaq_f32(vdupq_n_f32(EXP2_C2), p, f);
+	p = vfmaq_f32(vdupq_n_f32(EXP2_C1), p, f);
+	p = vfmaq_f32(one, p, f);
+	float32x4_t scale = vreinterpretq_f32_s32(vshlq_n_s32(
+		vaddq_s32(n, vdupq_n_s32(127)), 23));
+
+	/* pow(0, exponent) is zero */
+	uint32x4_t nonzero = vcgtq_f32(x, vdupq_n_f32(0.0f));
+	return vreinterpretq_f32_u32(vandq_u32(
+		vreinterpretq_u32_f32(vmulq_f32(p, scale)), nonzero));
+}
+
+static void
+fill_channel_neon(uint16_t *ramp, int size, double scale, double exponent)
+{
+	if (exponent == 1.0) {
+		fill_channel(ramp, size, scale, exponent);
+		return;
+	}
+
+	const float vscale = scale * (UINT16_MAX+1);
+	const float vinv = 1.0f/(UINT16_MAX+1);
+	const float32x4_t vexp = vdupq_n_f32(exponent);
+
+	int i = 0;
+	for (; i + 8 <= size; i += 8) {
+		uint16x8_t v = vld1q_u16(&ramp[i]);
+		float32x4_t lo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(v)));
+		float32x4_t hi = vcvtq_f32_u32(vmovl_high_u16(v));
+		lo = vmulq_n_f32(pow_neon(vmulq_n_f32(lo, vinv), vexp),
+				 vscale);
+		hi = vmulq_n_f32(pow_neon(vmulq_n_f32(hi, vinv), vexp),
+				 vscale);
+
+		v = vcombine_u16(vqmovn_u32(vcvtq_u32_f32(lo)),
+				 vqmovn_u32(vcvtq_u32_f32(hi)));
+		vst1q_u16(&ramp[i], v);
+	}
+
+	fill_channel(&ramp[i], size - i, scale, exponent);
+}
+
+static void
+fill_channel_float_neon(float *ramp, int size, double scale, double exponent)
+{
+	if (exponent == 1.0) {
+		fill_channel_float(ramp, size, scale, exponent);
+		return;
+	}
+
+	const float32x4_t vexp = vdupq_n_f32(exponent);
+
+	int i = 0;
+	for (; i + 4 <= size; i += 4) {
+		float32x4_t x = vld1q_f32(&ramp[i]);
+		x = vmulq_n_f32(pow_neon(x, vexp), scale);
+		vst1q_f32(&ramp[i], x);
+	}
+
+	fill_channel_float(&ramp[i], size - i, scale, exponent);
+}
+
+#endif /* COLORRAMP_NEON */
+
+
+typedef void fill_channel_func(uint16_t *ramp, int size,
+			       double scale, double exponent);
+typedef void fill_channel_float_func(float *ramp, int size,
+				     double scale, double exponent);
+typedef void fill_channel_derived_func(uint16_t *ramp, const double *base,
+				       int size, double scale);
+
+typedef struct {
+	const char *name;
+	/* Return non-zero if the kernel can run on this CPU. */
+	int (*supported)(void);
+	fill_channel_func *fill;
+	fill_channel_float_func *fill_float;
+	/* Scaling of base ramps. It must match fill_channel_derived()
+	   exactly, or be NULL to use that. */
+	fill_channel_derived_func *fill_derived;
+} colorramp_kernel_desc_t;
+
+/* Kernels indexed by colorramp_kernel_t. Entries for instruction sets
+   that are not available at compile time are left empty. */
+static const colorramp_kernel_desc_t kernels[] = {
+	[COLORRAMP_KERNEL_REFERENCE] = {
+		"reference", NULL, fill_channel, fill_channel_float },
+#ifdef COLORRAMP_X86
+	[COLORRAMP_KERNEL_SSE2] = {
+		"sse2", cpu_has_sse2,
+		fill_channel_sse2, fill_channel_float_sse2 },
+	[COLORRAMP_KERNEL_AVX2] = {
+		"avx2", cpu_has_avx2,
+		fill_channel_avx2, fill_channel_float_avx2,
+		fill_channel_derived_avx2 },
+#endif
+#ifdef COLORRAMP_NEON
+	[COLORRAMP_KERNEL_NEON] = {
+		"neon", NULL, fill_channel_neon, fill_channel_float_neon },
+#endif
+	[COLORRAMP_KERNEL_MAX] = { NULL }
+};
+
+/* Selected kernel or NULL if not selected yet. */
+static const colorramp_kernel_desc_t *kernel = NULL;
+
+/* Select the kernel used for filling ramps. With COLORRAMP_KERNEL_AUTO
+   the fastest kernel supported by the CPU is selected. Returns -1 if
+   the requested kernel is not available. */
+int
+colorramp_set_kernel(colorramp_kernel_t id)
+{
+	if (id == COLORRAMP_KERNEL_AUTO) {
+		/* Preferred kernels first. */
+		static const colorramp_kernel_t order[] = {
+			COLORRAMP_KERNEL_AVX2,
+			COLORRAMP_KERNEL_SSE2,
+			COLORRAMP_KERNEL_NEON,
+			COLORRAMP_KERNEL_REFERENCE
+		};
+		for (int i = 0; i < sizeof(order)/sizeof(order[0]); i++) {
+			if (colorramp_set_kernel(order[i]) == 0) return 0;
+		}
+		return -1;
+	}
+
+	if (id < 0 || id >= COLORRAMP_KERNEL_MAX) return -1;
+
+	const colorramp_kernel_desc_t *k = &kernels[id];
+	if (k->name == NULL) return -1;
+	if (k->supported != NULL && !k->supported()) return -1;
+
+	/* Cached ramps were computed by the previous kernel. */
+	if (kernel != k) colorramp_cache_free();
+
+	kernel = k;
+	return 0;
+}
+
+/* Return name of the selected kernel. */
+const char *
+colorramp_get_kernel_name(void)
+{
+	if (kernel == NULL) colorramp_set_kernel(COLORRAMP_KERNEL_AUTO);
+	return kernel->name;
+}
+
+static int
+color_setting_equal(const color_setting_t *first,
+		    const color_setting_t *second)
+{
+	return first->temperature == second->temperature &&
+		first->brightness == second->brightness &&
+		first->gamma[0] == second->gamma[0] &&
+		first->gamma[1] == second->gamma[1] &&
+		first->gamma[2] == second->gamma[2];
+}
+
+static int
+gamma_equal(const float *first, const float *second)
+{
+	return first[0] == second[0] &&
+		first[1] == second[1] &&
+		first[2] == second[2];
+}
+
+/* Return non-zero if INPUT holds the given ramps. */
+static int
+input_equal(const uint16_t *input, const uint16_t *gamma_r,
+	    const uint16_t *gamma_g, const uint16_t *gamma_b, int size)
+{
+	size_t len = size*sizeof(uint16_t);
+	return memcmp(&input[0*size], gamma_r, len) == 0 &&
+		memcmp(&input[1*size], gamma_g, len) == 0 &&
+		memcmp(&input[2*size], gamma_b, len) == 0;
+}
+
+/* Return the cache entry that was computed from the given input ramps
+   and setting, or NULL if there is none. */
+static colorramp_cache_entry_t *
+cache_lookup(const uint16_t *gamma_r, const uint16_t *gamma_g,
+	     const uint16_t *gamma_b, int size,
+	     const color_setting_t *setting)
+{
+	for (int i = 0; i < COLORRAMP_CACHE_SIZE; i++) {
+		colorramp_cache_entry_t *entry = &ramp_cache[i];
+		if (entry->input != NULL && entry->size == size &&
+		    color_setting_equal(&entry->setting, setting) &&
+		    input_equal(entry->input, gamma_r, gamma_g, gamma_b,
+				size)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Return non-zero if a cached ramp was computed from the given input
+   ramps and gamma. A miss then means only the temperature or the
+   brightness changed, which is what happens during most fades. */
+static int
+cache_has_gamma(const uint16_t *gamma_r, const uint16_t *gamma_g,
+		const uint16_t *gamma_b, int size, const float *gamma)
+{
+	for (int i = 0; i < COLORRAMP_CACHE_SIZE; i++) {
+		colorramp_cache_entry_t *entry = &ramp_cache[i];
+		if (entry->input != NULL && entry->size == size &&
+		    gamma_equal(entry->setting.gamma, gamma) &&
+		    input_equal(entry->input, gamma_r, gamma_g, gamma_b,
+				size)) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/* Return base ramps for the given input ramps and gamma. They are only
+   computed once a second setting with the same gamma is seen, so a
+   single update still uses the selected kernel. Returns NULL if there
+   is no matching base. */
+static const colorramp_base_t *
+base_lookup(const uint16_t *gamma_r, const uint16_t *gamma_g,
+	    const uint16_t *gamma_b, int size,
+	    const color_setting_t *setting, const double exponent[3])
+{
+	for (int i = 0; i < COLORRAMP_BASE_CACHE_SIZE; i++) {
+		colorramp_base_t *entry = &ramp_bases[i];
+		if (entry->base != NULL && entry->size == size &&
+		    gamma_equal(entry->gamma, setting->gamma) &&
+		    input_equal(entry->input, gamma_r, gamma_g, gamma_b,
+				size)) {
+			entry->last_use = ramp_cache_clock;
+			return entry;
+		}
+	}
+
+	if (!cache_has_gamma(gamma_r, gamma_g, gamma_b, size,
+			     setting->gamma)) {
+		return NULL;
+	}
+
+	colorramp_base_t *entry = &ramp_bases[0];
+	for (int i = 1; i < COLORRAMP_BASE_CACHE_SIZE; i++) {
+		if (ramp_bases[i].last_use < entry->last_use) {
+			entry = &ramp_bases[i];
+		}
+	}
+
+	if (entry->base == NULL || entry->size != size) {
+		free(entry->base);
+		entry->base = malloc(3*size*(sizeof(double) +
+					     sizeof(uint16_t)));
+		if (entry->base == NULL) {
+			entry->input = NULL;
+			return NULL;
+		}
+		entry->input = (uint16_t *)&entry->base[3*size];
+		entry->size = size;
+	}
+
+	size_t len = size*sizeof(uint16_t);
+	memcpy(&entry->input[0*size], gamma_r, len);
+	memcpy(&entry->input[1*size], gamma_g, len);
+	memcpy(&entry->input[2*size], gamma_b, len);
+	memcpy(entry->gamma, setting->gamma, sizeof(entry->gamma));
+	entry->last_use = ramp_cache_clock;
+
+	for (int c = 0; c < 3; c++) {
+		const uint16_t *input = &entry->input[c*size];
+		double *base = &entry->base[c*size];
+		if (exponent[c] == 1.0) {
+			for (int i = 0; i < size; i++) base[i] = input[i];
+		} else {
+			for (int i = 0; i < size; i++) {
+				double y = (double)input[i]/(UINT16_MAX+1);
+				base[i] = pow(y, exponent[c]) *
+					(UINT16_MAX+1);
+			}
+		}
+	}
+
+	return entry;
+}
+
+/* Return the least recently used cache entry, with storage for ramps
+   of the given size, or NULL if storage could not be allocated. */
+static colorramp_cache_entry_t *
+cache_victim(int size)
+{
+	colorramp_cache_entry_t *entry = &ramp_cache[0];
+	for (int i = 1; i < COLORRAMP_CACHE_SIZE; i++) {
+		if (ramp_cache[i].last_use < entry->last_use) {
+			entry = &ramp_cache[i];
+		}
+	}
+
+	if (entry->input == NULL || entry->size != size) {
+		free(entry->input);
+		entry->input = malloc(2*3*size*sizeof(uint16_t));
+		if (entry->input == NULL) {
+			entry->output = NULL;
+			return NULL;
+		}
+		entry->output = &entry->input[3*size];
+		entry->size = size;
+	}
+
+	return entry;
+}
+
+void
+colorramp_fill(uint16_t *gamma_r, uint16_t *gamma_g, uint16_t *gamma_b,
+	       int size, const color_setting_t *setting)
+{
+	size_t len = size*sizeof(uint16_t);
+	double stats_start = stats_begin();
+
+	colorramp_cache_entry_t *entry =
+		cache_lookup(gamma_r, gamma_g, gamma_b, size, setting);
+	if (entry != NULL) {
+		entry->last_use = ++ramp_cache_clock;
+		memcpy(gamma_r, &entry->output[0*size], len);
+		memcpy(gamma_g, &entry->output[1*size], len);
+		memcpy(gamma_b, &entry->output[2*size], len);
+		stats_end(STATS_RAMP, stats_start);
+		return;
+	}
+
+	if (kernel == NULL) colorramp_set_kernel(COLORRAMP_KERNEL_AUTO);
+
+	double scale[3];
+	double exponent[3];
+	colorramp_params(setting, scale, exponent);
+
+	const colorramp_base_t *base = base_lookup(
+		gamma_r, gamma_g, gamma_b, size, setting, exponent);
+
+	/* Save input ramps before they are overwritten. If no storage
+	   is available the ramps are simply computed without caching. */
+	entry = cache_victim(size);
+	if (entry != NULL) {
+		memcpy(&entry->input[0*size], gamma_r, len);
+		memcpy(&entry->input[1*size], gamma_g, len);
+		memcpy(&entry->input[2*size], gamma_b, len);
+	}
+
+	if (base != NULL) {
+		fill_channel_derived_func *fill_derived =
+			kernel->fill_derived != NULL ?
+			kernel->fill_derived : fill_channel_derived;
+		fill_derived(gamma_r, &base->base[0*size], size, scale[0]);
+		fill_derived(gamma_g, &base->base[1*size], size, scale[1]);
+		fill_derived(gamma_b, &base->base[2*size], size, scale[2]);
+	} else {
+		kernel->fill(gamma_r, size, scale[0], exponent[0]);
+		kernel->fill(gamma_g, size, scale[1], exponent[1]);
+		kernel->fill(gamma_b, size, scale[2], exponent[2]);
+	}
+
+	if (entry != NULL) {
+		memcpy(&entry->output[0*size], gamma_r, len);
+		memcpy(&entry->output[1*size], gamma_g, len);
+		memcpy(&entry->output[2*size], gamma_b, len);
+		entry->setting = *setting;
+		entry->last_use = ++ramp_cache_clock;
+	}
+
+	stats_end(STATS_RAMP, stats_start);
+}
+
 void
 colorramp_fill_float(float *gamma_r, float *gamma_g, float *gamma_b,
 		     int size, const color_setting_t *setting)
 {
-	/* Approximate white point */
-	float white_point[3];
-	float alpha = (setting->temperature % 100) / 100.0;
-	int temp_index = ((setting->temperature - 1000) / 100)*3;
-	interpolate_color(alpha, &blackbody_color[temp_index],
-			  &blackbody_color[temp_index+3], white_point);
+	double stats_start = stats_begin();
 
-	for (int i = 0; i < size; i++) {
-		gamma_r[i] = F((double)gamma_r[i], 0);
-		gamma_g[i] = F((double)gamma_g[i], 1);
-		gamma_b[i] = F((double)gamma_b[i], 2);
-	}
+	if (kernel == NULL) colorramp_set_kernel(COLORRAMP_KERNEL_AUTO);
+
+	double scale[3];
+	double exponent[3];
+	colorramp_params(setting, scale, exponent);
+
+	kernel->fill_float(gamma_r, size, scale[0], exponent[0]);
+	kernel->fill_float(gamma_g, size, scale[1], exponent[1]);
+	kernel->fill_float(gamma_b, size, scale[2], exponent[2]);
+
+	stats_end(STATS_RAMP, stats_start);
 }
 
-#undef F
+/* Release storage held by the ramp cache. */
+void
+colorramp_cache_free(void)
+{
+	for (int i = 0; i < COLORRAMP_CACHE_SIZE; i++) {
+		free(ramp_cache[i].input);
+		ramp_cache[i].input = NULL;
+		ramp_cache[i].output = NULL;
+		ramp_cache[i].size = 0;
+	}
+
+	for (int i = 0; i < COLORRAMP_BASE_CACHE_SIZE; i++) {
+		free(ramp_bases[i].base);
+		ramp_bases[i].base = NULL;
+		ramp_bases[i].input = NULL;
+		ramp_bases[i].size = 0;
+	}
+}
@@ -24,9 +24,25 @@
 
 #include "redshift.h"
 
+/* Implementations of the ramp computation. */
+typedef enum {
+	COLORRAMP_KERNEL_AUTO = -1,
+	COLORRAMP_KERNEL_REFERENCE = 0,
+	COLORRAMP_KERNEL_SSE2,
+	COLORRAMP_KERNEL_AVX2,
+	COLORRAMP_KERNEL_NEON,
+	COLORRAMP_KERNEL_MAX
+} colorramp_kernel_t;
+
 void colorramp_fill(uint16_t *gamma_r, uint16_t *gamma_g, uint16_t *gamma_b,
 		    int size, const color_setting_t *setting);
 void colorramp_fill_float(float *gamma_r, float *gamma_g, float *gamma_b,
 			  int size, const color_setting_t *setting);
+void colorramp_params(const color_setting_t *setting,
+		      double scale[3], double exponent[3]);
+void colorramp_cache_free(void);
+
+int colorramp_set_kernel(colorramp_kernel_t kernel);
+const char *colorramp_get_kernel_name(void);
 
 #endif /* ! REDSHIFT_COLORRAMP_H */
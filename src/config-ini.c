@@ -31,6 +31,9 @@
 #ifndef _WIN32
 # include <pwd.h>
 #endif
+#ifdef HAVE_SYS_INOTIFY_H
+# include <sys/inotify.h>
+#endif
 
 #include "config-ini.h"
 
@@ -42,11 +45,10 @@
 #endif
 
 #define MAX_CONFIG_PATH  4096
-#define MAX_LINE_LENGTH   512
 
 
 static FILE *
-open_config_file(const char *filepath)
+open_config_file(const char *filepath, char **path)
 {
 	FILE *f = NULL;
 
@@ -146,6 +148,7 @@ open_config_file(const char *filepath)
 		}
 #endif
 
+		if (f != NULL) *path = strdup(cp);
 		return f;
 	} else {
 		f = fopen(filepath, "r");
@@ -153,174 +156,377 @@ open_config_file(const char *filepath)
 			perror("fopen");
 			return NULL;
 		}
+		*path = strdup(filepath);
 	}
 
 	return f;
 }
 
+/* Setting in the hash table, with the section it belongs to. */
+struct _config_ini_entry {
+	const config_ini_section_t *section;
+	config_ini_setting_t *setting;
+};
+
+
+/* Read the whole file into a NUL-terminated buffer. */
+static char *
+read_config_file(FILE *f, size_t *length)
+{
+	size_t size = 4096;
+	struct stat st;
+	if (fstat(fileno(f), &st) == 0 && st.st_size > 0) {
+		size = st.st_size + 1;
+	}
+
+	char *buffer = malloc(size);
+	if (buffer == NULL) {
+		perror("malloc");
+		return NULL;
+	}
+
+	size_t len = 0;
+	while (1) {
+		if (len + 1 >= size) {
+			char *new_buffer = realloc(buffer, 2*size);
+			if (new_buffer == NULL) {
+				perror("realloc");
+				free(buffer);
+				return NULL;
+			}
+			buffer = new_buffer;
+			size *= 2;
+		}
+
+		size_t r = fread(&buffer[len], 1, size - len - 1, f);
+		len += r;
+		if (r == 0) break;
+	}
+
+	if (ferror(f)) {
+		perror("fread");
+		free(buffer);
+		return NULL;
+	}
+
+	buffer[len] = '\0';
+	*length = len;
+	return buffer;
+}
+
+/* Case-insensitive FNV-1a hash of NAME, starting from SEED. */
+static size_t
+hash_name(const char *name, size_t seed)
+{
+	size_t hash = 2166136261u ^ seed;
+	for (const char *c = name; *c != '\0'; c++) {
+		char ch = *c;
+		if (ch >= 'A' && ch <= 'Z') ch += 'a' - 'A';
+		hash = (hash ^ (unsigned char)ch) * 16777619u;
+	}
+	return hash;
+}
+
+/* Return size of a hash table for COUNT entries. */
+static size_t
+table_size(size_t count)
+{
+	size_t size = 1;
+	while (size < 2*count) size <<= 1;
+	return size;
+}
+
+/* Later sections and settings with the same name replace earlier ones. */
+static void
+insert_section(config_ini_state_t *state, config_ini_section_t *section)
+{
+	size_t i = hash_name(section->name, 0) & state->section_mask;
+	while (state->section_table[i] != NULL &&
+	       strcasecmp(state->section_table[i]->name,
+			  section->name) != 0) {
+		i = (i + 1) & state->section_mask;
+	}
+	state->section_table[i] = section;
+}
+
+static void
+insert_setting(config_ini_state_t *state,
+	       const config_ini_section_t *section,
+	       config_ini_setting_t *setting)
+{
+	size_t i = hash_name(setting->name, (size_t)section) &
+		state->setting_mask;
+	while (state->setting_table[i].setting != NULL &&
+	       (state->setting_table[i].section != section ||
+		strcasecmp(state->setting_table[i].setting->name,
+			   setting->name) != 0)) {
+		i = (i + 1) & state->setting_mask;
+	}
+	state->setting_table[i].section = section;
+	state->setting_table[i].setting = setting;
+}
+
 int
 config_ini_init(config_ini_state_t *state, const char *filepath)
 {
-	config_ini_section_t *section = NULL;
 	state->sections = NULL;
-
-	FILE *f = open_config_file(filepath);
+	state->path = NULL;
+	state->buffer = NULL;
+	state->arena = NULL;
+	state->section_table = NULL;
+	state->section_mask = 0;
+	state->setting_table = NULL;
+	state->setting_mask = 0;
+
+	FILE *f = open_config_file(filepath, &state->path);
 	if (f == NULL) {
 		/* Only a serious error if a file was explicitly requested. */
 		if (filepath != NULL) return -1;
 		return 0;
 	}
 
-	char line[MAX_LINE_LENGTH];
-	char *s;
+	size_t length = 0;
+	state->buffer = read_config_file(f, &length);
+	fclose(f);
+	if (state->buffer == NULL) return -1;
+
+	/* Split lines in place and count sections and settings so
+	   everything can be allocated at once. */
+	char *end = state->buffer + length;
+	size_t section_count = 0;
+	size_t setting_count = 0;
+	int line_start = 1;
+	for (char *c = state->buffer; c < end; c++) {
+		if (*c == '\n' || *c == '\r' || *c == '\0') {
+			*c = '\0';
+			line_start = 1;
+		} else if (line_start && *c != ' ' && *c != '\t') {
+			if (*c == '[') section_count += 1;
+			else setting_count += 1;
+			line_start = 0;
+		}
+	}
 
-	while (1) {
-		/* Handle the file input linewise. */
-		char *r = fgets(line, sizeof(line), f);
-		if (r == NULL) break;
+	size_t section_table_size = table_size(section_count);
+	size_t setting_table_size = table_size(setting_count);
+	size_t arena_size =
+		section_count*sizeof(config_ini_section_t) +
+		setting_count*sizeof(config_ini_setting_t) +
+		section_table_size*sizeof(config_ini_section_t *) +
+		setting_table_size*sizeof(config_ini_entry_t);
+	state->arena = calloc(1, arena_size);
+	if (state->arena == NULL) {
+		perror("calloc");
+		config_ini_free(state);
+		return -1;
+	}
+
+	config_ini_section_t *sections = state->arena;
+	config_ini_setting_t *settings =
+		(config_ini_setting_t *)&sections[section_count];
+	state->section_table =
+		(config_ini_section_t **)&settings[setting_count];
+	state->section_mask = section_table_size - 1;
+	state->setting_table =
+		(config_ini_entry_t *)&state->section_table[section_table_size];
+	state->setting_mask = setting_table_size - 1;
 
-		/* Strip leading blanks and trailing newline. */
-		s = line + strspn(line, " \t");
-		s[strcspn(s, "\r\n")] = '\0';
+	config_ini_section_t *section = NULL;
+	char *line = state->buffer;
+	while (line < end) {
+		/* Strip leading blanks. */
+		char *s = line + strspn(line, " \t");
+		line += strlen(line) + 1;
 
 		/* Skip comments and empty lines. */
 		if (s[0] == ';' || s[0] == '#' || s[0] == '\0') continue;
 
 		if (s[0] == '[') {
 			/* Read name of section. */
-			const char *name = s+1;
-			char *end = strchr(s, ']');
-			if (end == NULL || end[1] != '\0' || end == name) {
+			char *name = s+1;
+			char *name_end = strchr(s, ']');
+			if (name_end == NULL || name_end[1] != '\0' ||
+			    name_end == name) {
 				fputs(_("Malformed section header in config"
 					" file.\n"), stderr);
-				fclose(f);
 				config_ini_free(state);
 				return -1;
 			}
 
-			*end = '\0';
-
-			/* Create section. */
-			section = malloc(sizeof(config_ini_section_t));
-			if (section == NULL) {
-				fclose(f);
-				config_ini_free(state);
-				return -1;
-			}
+			*name_end = '\0';
 
 			/* Insert into section list. */
-			section->name = NULL;
+			section = sections++;
+			section->name = name;
 			section->settings = NULL;
 			section->next = state->sections;
 			state->sections = section;
-
-			/* Copy section name. */
-			section->name = malloc(end - name + 1);
-			if (section->name == NULL) {
-				fclose(f);
-				config_ini_free(state);
-				return -1;
-			}
-
-			memcpy(section->name, name, end - name + 1);
+			insert_section(state, section);
 		} else {
 			/* Split assignment at equals character. */
-			char *end = strchr(s, '=');
-			if (end == NULL || end == s) {
+			char *value = strchr(s, '=');
+			if (value == NULL || value == s) {
 				fputs(_("Malformed assignment in config"
 					" file.\n"), stderr);
-				fclose(f);
 				config_ini_free(state);
 				return -1;
 			}
 
-			*end = '\0';
-			char *value = end + 1;
+			*(value++) = '\0';
 
 			if (section == NULL) {
 				fputs(_("Assignment outside section in config"
 					" file.\n"), stderr);
-				fclose(f);
 				config_ini_free(state);
 				return -1;
 			}
 
-			/* Create section. */
-			config_ini_setting_t *setting =
-				malloc(sizeof(config_ini_setting_t));
-			if (setting == NULL) {
-				fclose(f);
-				config_ini_free(state);
-				return -1;
-			}
-
-			/* Insert into section list. */
-			setting->name = NULL;
-			setting->value = NULL;
+			/* Insert into setting list of section. */
+			config_ini_setting_t *setting = settings++;
+			setting->name = s;
+			setting->value = value;
 			setting->next = section->settings;
 			section->settings = setting;
+			insert_setting(state, section, setting);
+		}
+	}
 
-			/* Copy name of setting. */
-			setting->name = malloc(end - s + 1);
-			if (setting->name == NULL) {
-				fclose(f);
-				config_ini_free(state);
-				return -1;
-			}
+	return 0;
+}
 
-			memcpy(setting->name, s, end - s + 1);
+void
+config_ini_free(config_ini_state_t *state)
+{
+	free(state->arena);
+	free(state->buffer);
+	free(state->path);
+	state->sections = NULL;
+	state->path = NULL;
+	state->buffer = NULL;
+	state->arena = NULL;
+	state->section_table = NULL;
+	state->setting_table = NULL;
+}
 
-			/* Copy setting value. */
-			size_t value_len = strlen(value) + 1;
-			setting->value = malloc(value_len);
-			if (setting->value == NULL) {
-				fclose(f);
-				config_ini_free(state);
-				return -1;
-			}
+config_ini_section_t *
+config_ini_get_section(config_ini_state_t *state, const char *name)
+{
+	if (state->section_table == NULL) return NULL;
 
-			memcpy(setting->value, value, value_len);
+	size_t i = hash_name(name, 0) & state->section_mask;
+	while (state->section_table[i] != NULL) {
+		if (strcasecmp(state->section_table[i]->name, name) == 0) {
+			return state->section_table[i];
 		}
+		i = (i + 1) & state->section_mask;
 	}
 
-	fclose(f);
+	return NULL;
+}
 
-	return 0;
+/* Return value of setting NAME in SECTION, or NULL if not set. */
+const char *
+config_ini_get_value(config_ini_state_t *state, const char *section,
+		     const char *name)
+{
+	const config_ini_section_t *s = config_ini_get_section(state, section);
+	if (s == NULL) return NULL;
+
+	size_t i = hash_name(name, (size_t)s) & state->setting_mask;
+	while (state->setting_table[i].setting != NULL) {
+		const config_ini_entry_t *entry = &state->setting_table[i];
+		if (entry->section == s &&
+		    strcasecmp(entry->setting->name, name) == 0) {
+			return entry->setting->value;
+		}
+		i = (i + 1) & state->setting_mask;
+	}
+
+	return NULL;
 }
 
-void
-config_ini_free(config_ini_state_t *state)
+/* Return non-zero if sections A and B, either of which may be NULL,
+   contain the same settings in the same order. */
+int
+config_ini_section_equal(const config_ini_section_t *a,
+			 const config_ini_section_t *b)
 {
-	config_ini_section_t *section = state->sections;
-
-	while (section != NULL) {
-		config_ini_setting_t *setting = section->settings;
-		config_ini_section_t *section_prev = section;
-
-		while (setting != NULL) {
-			config_ini_setting_t *setting_prev = setting;
-			free(setting->name);
-			free(setting->value);
-			setting = setting->next;
-			free(setting_prev);
+	const config_ini_setting_t *x = a != NULL ? a->settings : NULL;
+	const config_ini_setting_t *y = b != NULL ? b->settings : NULL;
+	while (x != NULL && y != NULL) {
+		if (strcmp(x->name, y->name) != 0 ||
+		    strcmp(x->value, y->value) != 0) {
+			return 0;
 		}
+		x = x->next;
+		y = y->next;
+	}
+
+	return x == NULL && y == NULL;
+}
 
-		free(section->name);
-		section = section->next;
-		free(section_prev);
+/* Return a file descriptor that becomes readable when the file at PATH
+   may have been replaced or written, or -1 if not supported. The
+   directory is watched since files are often replaced by renaming. */
+int
+config_ini_watch(const char *path)
+{
+#ifdef HAVE_SYS_INOTIFY_H
+	char dir[MAX_CONFIG_PATH];
+	const char *slash = strrchr(path, '/');
+	if (slash == NULL) {
+		strcpy(dir, ".");
+	} else if (slash == path) {
+		strcpy(dir, "/");
+	} else {
+		snprintf(dir, sizeof(dir), "%.*s", (int)(slash - path), path);
 	}
+
+	int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (fd < 0) {
+		perror("inotify_init1");
+		return -1;
+	}
+
+	int r = inotify_add_watch(fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO);
+	if (r < 0) {
+		perror("inotify_add_watch");
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+#else
+	return -1;
+#endif
 }
 
-config_ini_section_t *
-config_ini_get_section(config_ini_state_t *state, const char *name)
+/* Read pending events from watch FD. Returns 1 if the file at PATH
+   changed, otherwise 0. */
+int
+config_ini_watch_handle(int fd, const char *path)
 {
-	config_ini_section_t *section = state->sections;
-	while (section != NULL) {
-		if (strcasecmp(section->name, name) == 0) {
-			return section;
+	int changed = 0;
+#ifdef HAVE_SYS_INOTIFY_H
+	const char *slash = strrchr(path, '/');
+	const char *name = slash != NULL ? slash + 1 : path;
+
+	char buffer[4096]
+		__attribute__((aligned(__alignof__(struct inotify_event))));
+	while (1) {
+		ssize_t r = read(fd, buffer, sizeof(buffer));
+		if (r <= 0) break;
+
+		for (char *p = buffer; p < buffer + r;) {
+			const struct inotify_event *event =
+				(const struct inotify_event *)p;
+			if (event->len > 0 &&
+			    strcmp(event->name, name) == 0) {
+				changed = 1;
+			}
+			p += sizeof(struct inotify_event) + event->len;
 		}
-		section = section->next;
 	}
-
-	return NULL;
+#endif
+	return changed;
 }
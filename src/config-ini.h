@@ -35,8 +35,22 @@ struct _config_ini_section {
 	config_ini_setting_t *settings;
 };
 
+typedef struct _config_ini_entry config_ini_entry_t;
+
 typedef struct {
 	config_ini_section_t *sections;
+
+	/* Path of the loaded file, or NULL if no file was found. */
+	char *path;
+
+	/* File contents. Names and values point into it. */
+	char *buffer;
+	/* Sections, settings and hash tables. */
+	void *arena;
+	config_ini_section_t **section_table;
+	size_t section_mask;
+	config_ini_entry_t *setting_table;
+	size_t setting_mask;
 } config_ini_state_t;
 
 
@@ -45,5 +59,12 @@ void config_ini_free(config_ini_state_t *state);
 
 config_ini_section_t *config_ini_get_section(config_ini_state_t *state,
 					     const char *name);
+const char *config_ini_get_value(config_ini_state_t *state,
+				 const char *section, const char *name);
+int config_ini_section_equal(const config_ini_section_t *a,
+			     const config_ini_section_t *b);
+
+int config_ini_watch(const char *path);
+int config_ini_watch_handle(int fd, const char *path);
 
 #endif /* ! REDSHIFT_CONFIG_INI_H */
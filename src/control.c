@@ -0,0 +1,644 @@
+/* control.c -- Control socket source
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/* The control socket accepts commands, one per line:
+
+     toggle                  Toggle between enabled and disabled
+     enable, disable         Enable or disable adjustment
+     pause MINUTES           Disable adjustment for a number of minutes
+     set-temperature K       Override the color temperature, 0 to reset
+     status                  Reply with the current status
+     stats                   Reply with timing statistics
+     subscribe               Reply with the current status and send
+                             it again whenever it changes
+
+   Every reply is a single line containing a JSON object. */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+
+#ifndef _WIN32
+# include <unistd.h>
+# include <fcntl.h>
+# include <poll.h>
+# include <sys/types.h>
+# include <sys/stat.h>
+# include <sys/socket.h>
+# include <sys/un.h>
+#endif
+
+#ifdef ENABLE_NLS
+# include <libintl.h>
+# define _(s) gettext(s)
+#else
+# define _(s) s
+#endif
+
+#include "control.h"
+#include "systemtime.h"
+#include "stats.h"
+
+/* Longest command line accepted from a client. */
+#define CONTROL_LINE_MAX  128
+
+/* Longest status line sent to clients. */
+#define CONTROL_STATUS_MAX  256
+
+/* Longest statistics line sent to clients. */
+#define CONTROL_STATS_MAX  1024
+
+/* Time to wait for replies when sending commands (ms). */
+#define CONTROL_REPLY_TIMEOUT  1000
+
+#ifndef MSG_NOSIGNAL
+# define MSG_NOSIGNAL  0
+#endif
+
+
+#ifndef _WIN32
+
+/* Names of periods reported to clients. */
+static const char *period_names[] = {
+	"none",
+	"daytime",
+	"night",
+	"transition"
+};
+
+typedef struct {
+	int fd;
+	int subscribed;
+	size_t length;
+	char buffer[CONTROL_LINE_MAX];
+} control_client_t;
+
+struct control {
+	int fd;
+	char *path;
+	control_client_t clients[CONTROL_MAX_CLIENTS];
+	/* Status line last sent to subscribers. */
+	char last_status[CONTROL_STATUS_MAX];
+};
+
+
+/* Set file descriptor non-blocking and close-on-exec. */
+static int
+control_set_flags(int fd)
+{
+	int flags = fcntl(fd, F_GETFL);
+	if (flags == -1 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1) {
+		perror("fcntl");
+		return -1;
+	}
+
+	flags = fcntl(fd, F_GETFD);
+	if (flags == -1 || fcntl(fd, F_SETFD, flags | FD_CLOEXEC) == -1) {
+		perror("fcntl");
+		return -1;
+	}
+
+#ifdef SO_NOSIGPIPE
+	int one = 1;
+	setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+
+	return 0;
+}
+
+/* Create control socket listening at PATH. A socket left behind by an
+   instance that is no longer running is replaced. */
+control_t *
+control_start(const char *path)
+{
+	struct sockaddr_un addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (strlen(path) >= sizeof(addr.sun_path)) {
+		fprintf(stderr, _("Control socket path is too long: %s\n"),
+			path);
+		return NULL;
+	}
+	strcpy(addr.sun_path, path);
+
+	control_t *control = malloc(sizeof(control_t));
+	if (control == NULL) {
+		perror("malloc");
+		return NULL;
+	}
+
+	control->path = strdup(path);
+	control->last_status[0] = '\0';
+	for (int i = 0; i < CONTROL_MAX_CLIENTS; i++) {
+		control->clients[i].fd = -1;
+	}
+
+	control->fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (control->path == NULL || control->fd < 0) {
+		perror(control->path == NULL ? "strdup" : "socket");
+		goto fail;
+	}
+
+	int r = control_set_flags(control->fd);
+	if (r < 0) goto fail;
+
+	/* Check whether another instance owns the socket. */
+	int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (probe >= 0) {
+		r = connect(probe, (struct sockaddr *)&addr, sizeof(addr));
+		close(probe);
+		if (r == 0) {
+			fprintf(stderr, _("Control socket `%s' is in use by"
+					  " another instance.\n"), path);
+			goto fail;
+		} else if (errno == ECONNREFUSED) {
+			unlink(path);
+		}
+	}
+
+	/* Only the user may connect. */
+	mode_t mask = umask(0077);
+	r = bind(control->fd, (struct sockaddr *)&addr, sizeof(addr));
+	umask(mask);
+	if (r < 0) {
+		perror("bind");
+		fprintf(stderr, _("Unable to create control socket `%s'.\n"),
+			path);
+		goto fail;
+	}
+
+	r = listen(control->fd, CONTROL_MAX_CLIENTS);
+	if (r < 0) {
+		perror("listen");
+		unlink(path);
+		goto fail;
+	}
+
+	return control;
+
+fail:
+	if (control->fd >= 0) close(control->fd);
+	free(control->path);
+	free(control);
+	return NULL;
+}
+
+static void
+control_close_client(control_client_t *client)
+{
+	close(client->fd);
+	client->fd = -1;
+}
+
+void
+control_free(control_t *control)
+{
+	if (control == NULL) return;
+
+	for (int i = 0; i < CONTROL_MAX_CLIENTS; i++) {
+		if (control->clients[i].fd >= 0) {
+			control_close_client(&control->clients[i]);
+		}
+	}
+
+	close(control->fd);
+	unlink(control->path);
+	free(control->path);
+	free(control);
+}
+
+/* Fill POLLFDS with the file descriptors to wait for. Returns the
+   number of entries used, at most CONTROL_MAX_POLLFDS. */
+int
+control_add_pollfds(control_t *control, struct pollfd *pollfds)
+{
+	if (control == NULL) return 0;
+
+	int count = 0;
+	pollfds[count].fd = control->fd;
+	pollfds[count].events = POLLIN;
+	count++;
+
+	for (int i = 0; i < CONTROL_MAX_CLIENTS; i++) {
+		if (control->clients[i].fd < 0) continue;
+		pollfds[count].fd = control->clients[i].fd;
+		pollfds[count].events = POLLIN;
+		count++;
+	}
+
+	return count;
+}
+
+/* Send line to client. Clients that do not keep up are dropped. */
+static void
+control_send(control_client_t *client, const char *line)
+{
+	size_t length = strlen(line);
+	ssize_t r = send(client->fd, line, length, MSG_NOSIGNAL);
+	if (r < 0 || (size_t)r != length) {
+		control_close_client(client);
+	}
+}
+
+static void
+control_format_status(char *buffer, size_t size,
+		      const control_status_t *status)
+{
+	char location[64];
+	if (isnan(status->location.lat) || isnan(status->location.lon)) {
+		strcpy(location, "null");
+	} else {
+		snprintf(location, sizeof(location), "[%.2f,%.2f]",
+			 status->location.lat, status->location.lon);
+	}
+
+	snprintf(buffer, size,
+		 "{\"type\":\"status\",\"enabled\":%s,\"pause_until\":%.0f,"
+		 "\"period\":\"%s\",\"progress\":%.2f,"
+		 "\"temperature\":%d,\"brightness\":%.2f,"
+		 "\"override\":%d,\"location\":%s}\n",
+		 status->disabled ? "false" : "true",
+		 status->pause_until, period_names[status->period],
+		 status->transition_prog, status->setting.temperature,
+		 status->setting.brightness, status->temperature, location);
+}
+
+/* Parse a positive integer argument. Returns -1 if malformed. */
+static int
+control_parse_int(const char *value)
+{
+	if (value == NULL) return -1;
+
+	char *end;
+	errno = 0;
+	long parsed = strtol(value, &end, 10);
+	if (errno != 0 || end == value || *end != '\0' ||
+	    parsed < 0 || parsed > 1000000) {
+		return -1;
+	}
+
+	return parsed;
+}
+
+/* Run command from client. Returns 1 if the status was changed. */
+static int
+control_run_command(control_client_t *client, char *line,
+		    control_status_t *status)
+{
+	static const char *reply_ok = "{\"type\":\"reply\",\"ok\":true}\n";
+
+	char *saveptr;
+	char *command = strtok_r(line, " \t\r", &saveptr);
+	char *arg = strtok_r(NULL, " \t\r", &saveptr);
+	const char *error = NULL;
+	int changed = 0;
+
+	if (command == NULL) {
+		return 0;
+	} else if (strcmp(command, "toggle") == 0) {
+		status->disabled = !status->disabled;
+		status->pause_until = 0;
+		changed = 1;
+	} else if (strcmp(command, "enable") == 0 ||
+		   strcmp(command, "disable") == 0) {
+		status->disabled = strcmp(command, "disable") == 0;
+		status->pause_until = 0;
+		changed = 1;
+	} else if (strcmp(command, "pause") == 0) {
+		int minutes = control_parse_int(arg);
+		double now;
+		if (minutes <= 0) {
+			error = "invalid duration";
+		} else if (systemtime_get_time(&now) < 0) {
+			error = "unable to read time";
+		} else {
+			status->disabled = 1;
+			status->pause_until = now + minutes*60.0;
+			changed = 1;
+		}
+	} else if (strcmp(command, "set-temperature") == 0) {
+		int temperature = control_parse_int(arg);
+		if (temperature != 0 &&
+		    (temperature < MIN_TEMP || temperature > MAX_TEMP)) {
+			error = "temperature out of range";
+		} else {
+			status->temperature = temperature;
+			changed = 1;
+		}
+	} else if (strcmp(command, "stats") == 0) {
+		char buffer[CONTROL_STATS_MAX];
+		if (stats_format_json(buffer, sizeof(buffer)) < 0) {
+			error = "statistics too long";
+		} else {
+			control_send(client, buffer);
+			return 0;
+		}
+	} else if (strcmp(command, "status") == 0 ||
+		   strcmp(command, "subscribe") == 0) {
+		char buffer[CONTROL_STATUS_MAX];
+		control_format_status(buffer, sizeof(buffer), status);
+		if (strcmp(command, "subscribe") == 0) {
+			client->subscribed = 1;
+		}
+		control_send(client, buffer);
+		return 0;
+	} else {
+		error = "unknown command";
+	}
+
+	if (error != NULL) {
+		char buffer[CONTROL_STATUS_MAX];
+		snprintf(buffer, sizeof(buffer),
+			 "{\"type\":\"reply\",\"ok\":false,"
+			 "\"error\":\"%s\"}\n", error);
+		control_send(client, buffer);
+	} else {
+		control_send(client, reply_ok);
+	}
+
+	return changed;
+}
+
+/* Read and run commands from client. */
+static int
+control_read_client(control_client_t *client, control_status_t *status)
+{
+	int changed = 0;
+
+	while (client->fd >= 0) {
+		ssize_t r = read(client->fd, &client->buffer[client->length],
+				 CONTROL_LINE_MAX - client->length);
+		if (r < 0 && (errno == EAGAIN || errno == EINTR)) {
+			break;
+		} else if (r <= 0) {
+			control_close_client(client);
+			break;
+		}
+		client->length += r;
+
+		/* Run complete lines */
+		char *start = client->buffer;
+		char *end;
+		while (client->fd >= 0 &&
+		       (end = memchr(start, '\n', client->length -
+				     (start - client->buffer))) != NULL) {
+			*end = '\0';
+			changed |= control_run_command(client, start, status);
+			start = end + 1;
+		}
+		if (client->fd < 0) break;
+
+		client->length -= start - client->buffer;
+		memmove(client->buffer, start, client->length);
+
+		if (client->length == CONTROL_LINE_MAX) {
+			control_send(client, "{\"type\":\"reply\",\"ok\":false,"
+				     "\"error\":\"line too long\"}\n");
+			if (client->fd >= 0) control_close_client(client);
+		}
+	}
+
+	return changed;
+}
+
+/* Handle events on the COUNT entries of POLLFDS filled in by
+   control_add_pollfds(). Returns 1 if clients changed STATUS. */
+int
+control_handle(control_t *control, const struct pollfd *pollfds,
+	       int count, control_status_t *status)
+{
+	int changed = 0;
+
+	for (int i = 1; i < count; i++) {
+		if (pollfds[i].revents == 0) continue;
+		for (int j = 0; j < CONTROL_MAX_CLIENTS; j++) {
+			control_client_t *client = &control->clients[j];
+			if (client->fd == pollfds[i].fd) {
+				changed |= control_read_client(client, status);
+				break;
+			}
+		}
+	}
+
+	/* Accept new clients */
+	if (count > 0 && pollfds[0].revents != 0) {
+		while (1) {
+			int fd = accept(control->fd, NULL, NULL);
+			if (fd < 0) break;
+
+			control_client_t *client = NULL;
+			for (int j = 0; j < CONTROL_MAX_CLIENTS; j++) {
+				if (control->clients[j].fd < 0) {
+					client = &control->clients[j];
+					break;
+				}
+			}
+
+			if (client == NULL || control_set_flags(fd) < 0) {
+				close(fd);
+				continue;
+			}
+
+			client->fd = fd;
+			client->subscribed = 0;
+			client->length = 0;
+		}
+	}
+
+	return changed;
+}
+
+/* Send status to subscribed clients if it changed since the last
+   time it was sent. */
+void
+control_notify(control_t *control, const control_status_t *status)
+{
+	if (control == NULL) return;
+
+	char buffer[CONTROL_STATUS_MAX];
+	control_format_status(buffer, sizeof(buffer), status);
+	if (strcmp(buffer, control->last_status) == 0) return;
+	strcpy(control->last_status, buffer);
+
+	for (int i = 0; i < CONTROL_MAX_CLIENTS; i++) {
+		control_client_t *client = &control->clients[i];
+		if (client->fd >= 0 && client->subscribed) {
+			control_send(client, buffer);
+		}
+	}
+}
+
+/* Send COUNT commands to the instance listening at PATH and wait for
+   the replies. Returns 1 if all commands were accepted, 0 if no
+   instance is listening, or -1 on error. */
+int
+control_send_commands(const char *path, const char *const *commands,
+		      int count)
+{
+	struct sockaddr_un addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (strlen(path) >= sizeof(addr.sun_path)) {
+		fprintf(stderr, _("Control socket path is too long: %s\n"),
+			path);
+		return -1;
+	}
+	strcpy(addr.sun_path, path);
+
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0) {
+		perror("socket");
+		return -1;
+	}
+
+	int r = connect(fd, (struct sockaddr *)&addr, sizeof(addr));
+	if (r < 0) {
+		int connect_errno = errno;
+		close(fd);
+		if (connect_errno == ENOENT ||
+		    connect_errno == ECONNREFUSED) {
+			return 0;
+		}
+		errno = connect_errno;
+		perror("connect");
+		return -1;
+	}
+
+	/* Send all commands at once, then read one reply for each. */
+	char buffer[CONTROL_STATUS_MAX];
+	size_t length = 0;
+	for (int i = 0; i < count; i++) {
+		r = snprintf(&buffer[length], sizeof(buffer) - length,
+			     "%s\n", commands[i]);
+		if (r < 0 || (size_t)r >= sizeof(buffer) - length) {
+			fputs(_("Control command too long.\n"), stderr);
+			close(fd);
+			return -1;
+		}
+		length += r;
+	}
+
+	ssize_t sent = send(fd, buffer, length, MSG_NOSIGNAL);
+	if (sent < 0 || (size_t)sent != length) {
+		perror("send");
+		close(fd);
+		return -1;
+	}
+
+	int replies = 0;
+	int result = 1;
+	length = 0;
+	while (replies < count) {
+		struct pollfd pollfd = { fd, POLLIN, 0 };
+		r = poll(&pollfd, 1, CONTROL_REPLY_TIMEOUT);
+		if (r < 0 && errno == EINTR) continue;
+		if (r <= 0) {
+			if (r < 0) perror("poll");
+			result = -1;
+			break;
+		}
+
+		ssize_t n = read(fd, &buffer[length],
+				 sizeof(buffer) - 1 - length);
+		if (n < 0 && errno == EINTR) continue;
+		if (n <= 0) {
+			result = -1;
+			break;
+		}
+		length += n;
+		buffer[length] = '\0';
+
+		/* Check complete reply lines */
+		char *start = buffer;
+		char *end;
+		while ((end = strchr(start, '\n')) != NULL) {
+			*end = '\0';
+			if (strstr(start, "\"ok\":true") == NULL) {
+				fprintf(stderr, _("Command `%s' was rejected:"
+						  " %s\n"),
+					commands[replies], start);
+				result = -1;
+			}
+			replies += 1;
+			start = end + 1;
+		}
+
+		length -= start - buffer;
+		memmove(buffer, start, length);
+		if (length == sizeof(buffer) - 1) {
+			result = -1;
+			break;
+		}
+	}
+
+	if (replies < count) {
+		fprintf(stderr, _("No reply from control socket `%s'.\n"),
+			path);
+	}
+
+	close(fd);
+	return result;
+}
+
+#else /* _WIN32 */
+
+/* Not supported on Windows! Always fails. */
+control_t *
+control_start(const char *path)
+{
+	fputs(_("Control socket is not supported on this platform.\n"),
+	      stderr);
+	return NULL;
+}
+
+void
+control_free(control_t *control)
+{
+}
+
+int
+control_add_pollfds(control_t *control, struct pollfd *pollfds)
+{
+	return 0;
+}
+
+int
+control_handle(control_t *control, const struct pollfd *pollfds,
+	       int count, control_status_t *status)
+{
+	return 0;
+}
+
+void
+control_notify(control_t *control, const control_status_t *status)
+{
+}
+
+int
+control_send_commands(const char *path, const char *const *commands,
+		      int count)
+{
+	return 0;
+}
+
+#endif /* _WIN32 */
@@ -0,0 +1,59 @@
+/* control.h -- Control socket header
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REDSHIFT_CONTROL_H
+#define REDSHIFT_CONTROL_H
+
+#include "redshift.h"
+
+/* Maximum number of clients connected at the same time. */
+#define CONTROL_MAX_CLIENTS  8
+
+/* Number of poll() entries needed by the control socket. */
+#define CONTROL_MAX_POLLFDS  (CONTROL_MAX_CLIENTS + 1)
+
+/* State of the continual mode loop shared with control clients.
+   Clients change the first group of fields, the second is reported
+   back to them. */
+typedef struct {
+	int disabled;
+	/* Time when a pause ends, or 0 if not paused. */
+	double pause_until;
+	/* Temperature overriding the transition scheme, or 0. */
+	int temperature;
+
+	period_t period;
+	double transition_prog;
+	color_setting_t setting;
+	location_t location;
+} control_status_t;
+
+typedef struct control control_t;
+
+control_t *control_start(const char *path);
+void control_free(control_t *control);
+
+struct pollfd;
+int control_add_pollfds(control_t *control, struct pollfd *pollfds);
+int control_handle(control_t *control, const struct pollfd *pollfds,
+		   int count, control_status_t *status);
+void control_notify(control_t *control, const control_status_t *status);
+
+int control_send_commands(const char *path, const char *const *commands,
+			  int count);
+
+#endif /* ! REDSHIFT_CONTROL_H */
@@ -0,0 +1,620 @@
+/* forecast.c -- Schedule of color settings source
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/* The forecast is split into units of one site and a few days. Units
+   are filled in batches by one thread each, and written in order. */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#ifdef HAVE_PTHREAD_H
+# include <pthread.h>
+#endif
+
+#ifdef ENABLE_NLS
+# include <libintl.h>
+# define _(s) gettext(s)
+#else
+# define _(s) s
+#endif
+
+#include "forecast.h"
+#include "redshift.h"
+#include "solar.h"
+#include "transition.h"
+
+/* Days in each unit of work. */
+#define FORECAST_CHUNK_DAYS  7
+
+/* Most threads filling units at once. */
+#define FORECAST_MAX_THREADS  64
+
+/* Longest row in any format. */
+#define FORECAST_ROW_MAX  512
+
+#define MIN_LAT   -90.0
+#define MAX_LAT    90.0
+#define MIN_LON  -180.0
+#define MAX_LON   180.0
+
+
+/* Names of periods in the output. Not translated as the output is
+   meant to be read by programs. */
+static const char *period_keys[] = {
+	"none",
+	"daytime",
+	"night",
+	"transition"
+};
+
+/* Names of solar events in the output, in the order of columns. */
+static const struct {
+	solar_time_t time;
+	const char *key;
+} event_keys[] = {
+	{ SOLAR_TIME_ASTRO_DAWN, "astro_dawn" },
+	{ SOLAR_TIME_NAUT_DAWN, "naut_dawn" },
+	{ SOLAR_TIME_CIVIL_DAWN, "civil_dawn" },
+	{ SOLAR_TIME_SUNRISE, "sunrise" },
+	{ SOLAR_TIME_NOON, "noon" },
+	{ SOLAR_TIME_SUNSET, "sunset" },
+	{ SOLAR_TIME_CIVIL_DUSK, "civil_dusk" },
+	{ SOLAR_TIME_NAUT_DUSK, "naut_dusk" },
+	{ SOLAR_TIME_ASTRO_DUSK, "astro_dusk" }
+};
+
+#define EVENT_COUNT  (sizeof(event_keys)/sizeof(event_keys[0]))
+
+
+typedef struct {
+	char *data;
+	size_t length;
+	size_t size;
+} forecast_buffer_t;
+
+typedef struct {
+	const forecast_t *forecast;
+	int site;
+	/* Days of the forecast covered by the unit. */
+	int day;
+	int days;
+	/* Whether the unit is the first one written. */
+	int first;
+	/* Fields naming the site, formatted once. */
+	char site_fields[64];
+	forecast_buffer_t buffer;
+	double *values;
+	size_t values_size;
+	int error;
+} forecast_unit_t;
+
+
+/* Make room for another row in BUFFER. */
+static int
+buffer_reserve(forecast_buffer_t *buffer)
+{
+	if (buffer->length + FORECAST_ROW_MAX <= buffer->size) return 0;
+
+	size_t size = buffer->size > 0 ? 2*buffer->size : 65536;
+	char *data = realloc(buffer->data, size);
+	if (data == NULL) {
+		perror("realloc");
+		return -1;
+	}
+
+	buffer->data = data;
+	buffer->size = size;
+
+	return 0;
+}
+
+/* Append formatted text to BUFFER, which has room reserved. */
+static void
+buffer_printf(forecast_buffer_t *buffer, const char *format, ...)
+{
+	va_list ap;
+	va_start(ap, format);
+	int r = vsnprintf(buffer->data + buffer->length,
+			  buffer->size - buffer->length, format, ap);
+	va_end(ap);
+	if (r > 0) buffer->length += r;
+}
+
+/* The rows at regular steps are many, so their fields are formatted
+   without printf(). */
+
+static void
+buffer_print_string(forecast_buffer_t *buffer, const char *str)
+{
+	size_t length = strlen(str);
+	memcpy(buffer->data + buffer->length, str, length);
+	buffer->length += length;
+}
+
+/* Append VALUE with at least WIDTH digits. */
+static void
+buffer_print_uint(forecast_buffer_t *buffer, unsigned long value, int width)
+{
+	char digits[24];
+	int n = 0;
+	do {
+		digits[n++] = '0' + value % 10;
+		value /= 10;
+	} while (value > 0 || n < width);
+
+	while (n > 0) buffer->data[buffer->length++] = digits[--n];
+}
+
+/* Append VALUE rounded to two decimals. */
+static void
+buffer_print_fixed2(forecast_buffer_t *buffer, double value)
+{
+	long hundredths = lround(value*100.0);
+	if (hundredths < 0) {
+		buffer->data[buffer->length++] = '-';
+		hundredths = -hundredths;
+	}
+	buffer_print_uint(buffer, hundredths / 100, 1);
+	buffer->data[buffer->length++] = '.';
+	buffer_print_uint(buffer, hundredths % 100, 2);
+}
+
+/* Split TIMESTAMP into UTC date and seconds of the day. Unlike gmtime()
+   this takes no locks, so threads do not wait on each other. */
+static int
+utc_from_timestamp(double timestamp, int *year, int *month, int *day)
+{
+	long long secs = (long long)floor(timestamp);
+	long long days = secs / 86400;
+	if (secs % 86400 < 0) days -= 1;
+	int seconds = secs - days*86400;
+
+	/* Civil date from days since epoch, after Howard Hinnant. */
+	days += 719468;
+	long long era = (days >= 0 ? days : days - 146096) / 146097;
+	long long doe = days - era*146097;
+	long long yoe = (doe - doe/1460 + doe/36524 - doe/146096) / 365;
+	long long doy = doe - (365*yoe + yoe/4 - yoe/100);
+	long long mp = (5*doy + 2)/153;
+
+	*day = doy - (153*mp + 2)/5 + 1;
+	*month = mp < 10 ? mp + 3 : mp - 9;
+	*year = yoe + era*400 + (*month <= 2);
+
+	return seconds;
+}
+
+/* Append TIMESTAMP as ISO 8601 date and time in UTC, quoted if QUOTE
+   is set, or EMPTY if it is not a number. */
+static void
+buffer_print_time(forecast_buffer_t *buffer, double timestamp, int quote,
+		  const char *empty)
+{
+	if (isnan(timestamp)) {
+		buffer_print_string(buffer, empty);
+		return;
+	}
+
+	int year, month, day;
+	int seconds = utc_from_timestamp(round(timestamp), &year, &month,
+					 &day);
+	if (year < 0 || year > 9999) {
+		buffer_printf(buffer, quote ? "\"%d\"" : "%d", year);
+		return;
+	}
+
+	if (quote) buffer->data[buffer->length++] = '"';
+	buffer_print_uint(buffer, year, 4);
+	buffer->data[buffer->length++] = '-';
+	buffer_print_uint(buffer, month, 2);
+	buffer->data[buffer->length++] = '-';
+	buffer_print_uint(buffer, day, 2);
+	buffer->data[buffer->length++] = 'T';
+	buffer_print_uint(buffer, seconds / 3600, 2);
+	buffer->data[buffer->length++] = ':';
+	buffer_print_uint(buffer, seconds / 60 % 60, 2);
+	buffer->data[buffer->length++] = ':';
+	buffer_print_uint(buffer, seconds % 60, 2);
+	buffer->data[buffer->length++] = 'Z';
+	if (quote) buffer->data[buffer->length++] = '"';
+}
+
+/* Format the fields naming the site of UNIT, which start each row. */
+static void
+forecast_format_site(forecast_unit_t *unit)
+{
+	const forecast_t *forecast = unit->forecast;
+	int json = forecast->format == FORECAST_FORMAT_JSON;
+
+	if (forecast->site_count == 0) {
+		snprintf(unit->site_fields, sizeof(unit->site_fields), "%s",
+			 json ? "{" : ",,");
+		return;
+	}
+
+	const location_t *loc = &forecast->sites[unit->site];
+	snprintf(unit->site_fields, sizeof(unit->site_fields), json ?
+		 "{\"latitude\":%.4f,\"longitude\":%.4f," : "%.4f,%.4f,",
+		 loc->lat, loc->lon);
+}
+
+/* Start a row of UNIT. Rows of JSON after the first are separated by
+   commas. */
+static void
+buffer_print_row_start(
+	forecast_buffer_t *buffer, const forecast_unit_t *unit, int row)
+{
+	if (unit->forecast->format == FORECAST_FORMAT_JSON) {
+		buffer_print_string(buffer, unit->first && row == 0 ?
+				    "\n" : ",\n");
+	}
+	buffer_print_string(buffer, unit->site_fields);
+}
+
+/* Fill UNIT with rows of color settings at regular steps. */
+static int
+forecast_fill_samples(forecast_unit_t *unit)
+{
+	const forecast_t *forecast = unit->forecast;
+	const transition_scheme_t *scheme = forecast->scheme;
+	int json = forecast->format == FORECAST_FORMAT_JSON;
+
+	/* Rows at steps from the start that fall on the days of the
+	   unit. */
+	long long first = ((long long)unit->day*86400 + forecast->step - 1) /
+		forecast->step;
+	long long end = ((long long)(unit->day + unit->days)*86400 +
+			 forecast->step - 1) / forecast->step;
+	size_t count = end - first;
+	double start = forecast->start + first*forecast->step;
+
+	const location_t *loc = NULL;
+	if (forecast->site_count > 0) {
+		loc = &forecast->sites[unit->site];
+		if (count > unit->values_size) {
+			double *values = realloc(unit->values,
+						 count*sizeof(double));
+			if (values == NULL) {
+				perror("realloc");
+				return -1;
+			}
+			unit->values = values;
+			unit->values_size = count;
+		}
+		solar_elevation_many(start, forecast->step, count,
+				     loc->lat, loc->lon, unit->values);
+	}
+
+	forecast_buffer_t *buffer = &unit->buffer;
+	for (size_t i = 0; i < count; i++) {
+		double timestamp = start + (double)i*forecast->step;
+		double elevation = loc != NULL ? unit->values[i] : NAN;
+
+		period_t period;
+		double progress;
+		if (scheme->use_time) {
+			int offset = get_seconds_since_midnight(timestamp);
+			period = get_period_from_time(scheme, offset);
+			progress = get_transition_progress_from_time(
+				scheme, offset);
+		} else {
+			period = get_period_from_elevation(scheme, elevation);
+			progress = get_transition_progress_from_elevation(
+				scheme, elevation);
+		}
+
+		color_setting_t setting;
+		interpolate_transition_scheme(scheme, progress, &setting);
+
+		if (buffer_reserve(buffer) < 0) return -1;
+		buffer_print_row_start(buffer, unit, i);
+		buffer_print_string(buffer, json ? "\"time\":" : "");
+		buffer_print_time(buffer, timestamp, json, "");
+		buffer_print_string(buffer, json ? ",\"period\":\"" : ",");
+		buffer_print_string(buffer, period_keys[period]);
+		if (loc != NULL) {
+			buffer_print_string(buffer, json ?
+					    "\",\"elevation\":" : ",");
+			buffer_print_fixed2(buffer, elevation);
+		} else {
+			buffer_print_string(buffer, json ? "\"" : ",");
+		}
+		buffer_print_string(buffer, json ?
+				    ",\"temperature\":" : ",");
+		buffer_print_uint(buffer, setting.temperature, 1);
+		buffer_print_string(buffer, json ? ",\"brightness\":" : ",");
+		buffer_print_fixed2(buffer, setting.brightness);
+		buffer_print_string(buffer, json ? "}" : "\n");
+	}
+
+	return 0;
+}
+
+/* Fill UNIT with rows of solar event times for each day. */
+static int
+forecast_fill_events(forecast_unit_t *unit)
+{
+	const forecast_t *forecast = unit->forecast;
+	const location_t *loc = &forecast->sites[unit->site];
+	int json = forecast->format == FORECAST_FORMAT_JSON;
+
+	size_t count = (size_t)unit->days*SOLAR_TIME_MAX;
+	if (count > unit->values_size) {
+		double *values = realloc(unit->values, count*sizeof(double));
+		if (values == NULL) {
+			perror("realloc");
+			return -1;
+		}
+		unit->values = values;
+		unit->values_size = count;
+	}
+
+	/* Days are those of the local dates from the start, as long as
+	   the start is close to local midnight. Noon UTC on the date
+	   selects the day of the solar tables. */
+	double first_day = floor((forecast->start + 43200.0)/86400.0) +
+		unit->day;
+	solar_table_fill_many(first_day*86400.0 + 43200.0, unit->days,
+			      loc->lat, loc->lon, unit->values);
+
+	forecast_buffer_t *buffer = &unit->buffer;
+	for (int i = 0; i < unit->days; i++) {
+		const double *table = &unit->values[i*SOLAR_TIME_MAX];
+		int year, month, day;
+		utc_from_timestamp((first_day + i)*86400.0, &year, &month,
+				   &day);
+
+		if (buffer_reserve(buffer) < 0) return -1;
+		buffer_print_row_start(buffer, unit, i);
+		buffer_printf(buffer, json ? "\"date\":\"%04d-%02d-%02d\"" :
+			      "%04d-%02d-%02d", year, month, day);
+		for (int j = 0; j < EVENT_COUNT; j++) {
+			double timestamp = table[event_keys[j].time];
+			if (json) {
+				buffer_printf(buffer, ",\"%s\":",
+					      event_keys[j].key);
+				buffer_print_time(buffer, timestamp, 1,
+						  "null");
+			} else {
+				buffer_printf(buffer, ",");
+				buffer_print_time(buffer, timestamp, 0, "");
+			}
+		}
+		buffer_printf(buffer, json ? "}" : "\n");
+	}
+
+	return 0;
+}
+
+static void
+forecast_fill(forecast_unit_t *unit)
+{
+	unit->buffer.length = 0;
+	forecast_format_site(unit);
+	int r = unit->forecast->step > 0 ?
+		forecast_fill_samples(unit) :
+		forecast_fill_events(unit);
+	unit->error = r < 0;
+}
+
+#ifdef HAVE_PTHREAD_H
+static void *
+forecast_thread(void *data)
+{
+	forecast_fill(data);
+	return NULL;
+}
+#endif
+
+/* Number of threads to fill units with. */
+static int
+forecast_thread_count(void)
+{
+#if defined(HAVE_PTHREAD_H) && defined(_SC_NPROCESSORS_ONLN)
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+	if (n < 1) return 1;
+	return n < FORECAST_MAX_THREADS ? n : FORECAST_MAX_THREADS;
+#else
+	return 1;
+#endif
+}
+
+/* Print header of the forecast to F. */
+static void
+forecast_print_header(const forecast_t *forecast, FILE *f)
+{
+	if (forecast->format == FORECAST_FORMAT_JSON) {
+		fputs("[", f);
+		return;
+	}
+
+	fputs("latitude,longitude,", f);
+	if (forecast->step > 0) {
+		fputs("time,period,elevation,temperature,brightness\n", f);
+	} else {
+		fputs("date", f);
+		for (int j = 0; j < EVENT_COUNT; j++) {
+			fprintf(f, ",%s", event_keys[j].key);
+		}
+		fputs("\n", f);
+	}
+}
+
+/* Write FORECAST to F. Returns -1 on failure. */
+int
+forecast_run(const forecast_t *forecast, FILE *f)
+{
+	if (forecast->step == 0 && forecast->site_count == 0) {
+		fputs(_("Solar events need a location.\n"), stderr);
+		return -1;
+	}
+
+	int sites = forecast->site_count > 0 ? forecast->site_count : 1;
+	int chunk_days = forecast->step > 0 ? FORECAST_CHUNK_DAYS :
+		forecast->days;
+	int chunks = (forecast->days + chunk_days - 1) / chunk_days;
+	int total = sites*chunks;
+
+	int thread_count = forecast_thread_count();
+	if (thread_count > total) thread_count = total;
+
+	forecast_unit_t *units = calloc(thread_count, sizeof(forecast_unit_t));
+	if (units == NULL) {
+		perror("calloc");
+		return -1;
+	}
+
+	forecast_print_header(forecast, f);
+
+	int error = 0;
+	for (int next = 0; next < total && !error; next += thread_count) {
+		int batch = total - next < thread_count ?
+			total - next : thread_count;
+		for (int i = 0; i < batch; i++) {
+			forecast_unit_t *unit = &units[i];
+			int chunk = (next + i) % chunks;
+			unit->forecast = forecast;
+			unit->site = (next + i) / chunks;
+			unit->day = chunk*chunk_days;
+			unit->days = forecast->days - unit->day < chunk_days ?
+				forecast->days - unit->day : chunk_days;
+			unit->first = next + i == 0;
+		}
+
+#ifdef HAVE_PTHREAD_H
+		/* The first unit is filled by this thread, and any unit
+		   a thread can not be started for as well. */
+		pthread_t threads[FORECAST_MAX_THREADS];
+		int started[FORECAST_MAX_THREADS] = { 0 };
+		for (int i = 1; i < batch; i++) {
+			int r = pthread_create(&threads[i], NULL,
+					       forecast_thread, &units[i]);
+			started[i] = r == 0;
+		}
+		for (int i = 0; i < batch; i++) {
+			if (started[i]) {
+				pthread_join(threads[i], NULL);
+			} else {
+				forecast_fill(&units[i]);
+			}
+		}
+#else
+		for (int i = 0; i < batch; i++) forecast_fill(&units[i]);
+#endif
+
+		for (int i = 0; i < batch && !error; i++) {
+			const forecast_buffer_t *buffer = &units[i].buffer;
+			if (units[i].error ||
+			    fwrite(buffer->data, 1, buffer->length, f) !=
+			    buffer->length) {
+				error = 1;
+			}
+		}
+	}
+
+	if (!error && forecast->format == FORECAST_FORMAT_JSON) {
+		fputs("\n]\n", f);
+	}
+	if (fflush(f) != 0) error = 1;
+
+	for (int i = 0; i < thread_count; i++) {
+		free(units[i].buffer.data);
+		free(units[i].values);
+	}
+	free(units);
+
+	return error ? -1 : 0;
+}
+
+/* Load sites from PATH, or standard input if PATH is `-'. Each line
+   holds latitude and longitude separated by a colon, comma or space.
+   Empty lines and lines starting with `#' are skipped. */
+int
+forecast_load_sites(const char *path, location_t **sites, int *count)
+{
+	FILE *f = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+	if (f == NULL) {
+		fprintf(stderr, _("Unable to open sites file `%s'.\n"), path);
+		return -1;
+	}
+
+	location_t *list = NULL;
+	int size = 0;
+	int n = 0;
+	int error = 0;
+	char line[256];
+	for (int number = 1; fgets(line, sizeof(line), f) != NULL;
+	     number++) {
+		char *s = line + strspn(line, " \t");
+		if (s[0] == '#' || s[0] == '\n' || s[0] == '\0') continue;
+
+		char *lat_end;
+		double lat = strtod(s, &lat_end);
+		char *t = lat_end + strspn(lat_end, " \t");
+		if (t[0] == ':' || t[0] == ',') t++;
+
+		char *lon_end;
+		double lon = strtod(t, &lon_end);
+		char *rest = lon_end + strspn(lon_end, " \t\r\n");
+		if (lat_end == s || lon_end == t || rest[0] != '\0' ||
+		    lat < MIN_LAT || lat > MAX_LAT ||
+		    lon < MIN_LON || lon > MAX_LON) {
+			fprintf(stderr, _("Invalid site on line %i of `%s'.\n"),
+				number, path);
+			error = 1;
+			break;
+		}
+
+		if (n == size) {
+			size = size > 0 ? 2*size : 64;
+			location_t *l = realloc(list, size*sizeof(location_t));
+			if (l == NULL) {
+				perror("realloc");
+				error = 1;
+				break;
+			}
+			list = l;
+		}
+
+		list[n].lat = lat;
+		list[n].lon = lon;
+		n += 1;
+	}
+
+	if (f != stdin) fclose(f);
+	if (!error && n == 0) {
+		fprintf(stderr, _("No sites in `%s'.\n"), path);
+		error = 1;
+	}
+	if (error) {
+		free(list);
+		return -1;
+	}
+
+	*sites = list;
+	*count = n;
+
+	return 0;
+}
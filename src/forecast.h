@@ -0,0 +1,48 @@
+/* forecast.h -- Schedule of color settings header
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REDSHIFT_FORECAST_H
+#define REDSHIFT_FORECAST_H
+
+#include <stdio.h>
+
+#include "redshift.h"
+
+typedef enum {
+	FORECAST_FORMAT_CSV,
+	FORECAST_FORMAT_JSON
+} forecast_format_t;
+
+/* Forecast of color settings. Without sites the color settings
+   follow the time of day only. */
+typedef struct {
+	const transition_scheme_t *scheme;
+	const location_t *sites;
+	int site_count;
+	/* Start as seconds since unix epoch, and number of days. */
+	double start;
+	int days;
+	/* Seconds between rows, or 0 to list the times of solar
+	   events for each day. */
+	int step;
+	forecast_format_t format;
+} forecast_t;
+
+int forecast_load_sites(const char *path, location_t **sites, int *count);
+int forecast_run(const forecast_t *forecast, FILE *f);
+
+#endif /* ! REDSHIFT_FORECAST_H */
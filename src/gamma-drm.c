@@ -30,6 +30,8 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <errno.h>
+#include <poll.h>
 
 #ifdef ENABLE_NLS
 # include <libintl.h>
@@ -45,6 +47,10 @@
 #include <xf86drm.h>
 #include <xf86drmMode.h>
 
+#ifdef HAVE_LIBUDEV
+# include <libudev.h>
+#endif
+
 #include "gamma-drm.h"
 #include "colorramp.h"
 
@@ -53,17 +59,62 @@ typedef struct {
 	int crtc_num;
 	int crtc_id;
 	int gamma_size;
+	int active;
 	uint16_t* r_gamma;
 	uint16_t* g_gamma;
 	uint16_t* b_gamma;
+	/* Atomic mode setting state. The GAMMA_LUT property is zero
+	   if the CRTC is not adjusted. */
+	uint32_t gamma_lut_prop;
+	int lut_size;
+	uint64_t saved_lut_blob;
+	uint32_t lut_blob;
+	uint32_t new_lut_blob;
+	/* The CTM property is zero if the white point is applied with
+	   the LUT. Otherwise the matrix scales the channels and the LUT
+	   only holds the gamma curve, so it is rebuilt only when the
+	   gamma changes. */
+	uint32_t ctm_prop;
+	uint64_t saved_ctm_blob;
+	uint32_t ctm_blob;
+	uint32_t new_ctm_blob;
+	struct drm_color_ctm ctm;
+	struct drm_color_ctm new_ctm;
+	float lut_gamma[3];
+	float new_lut_gamma[3];
+	/* Working and pure state ramps of the LUT size followed by
+	   each other, and the LUT currently applied followed by space
+	   for the next one. */
+	uint16_t *lut_ramps;
+	struct drm_color_lut *luts;
+	/* Name of the connector driven by the CRTC, empty if none. */
+	char output_name[32];
 } drm_crtc_state_t;
 
 typedef struct {
 	int card_num;
 	int crtc_num;
 	int fd;
+	/* Use atomic mode setting: 1 for yes, 0 for no,
+	   -1 when supported. */
+	int atomic;
+	/* Use the color transformation matrix with atomic mode
+	   setting: 1 for yes, 0 for no, -1 when supported. */
+	int ctm;
+	/* Save current gamma ramps for restore. */
+	int save;
+	/* Sequence of the requested vertical blank, and whether it has
+	   passed. */
+	unsigned int vblank_sequence;
+	int vblank_passed;
 	drmModeRes* res;
 	drm_crtc_state_t* crtcs;
+#ifdef HAVE_LIBUDEV
+	/* Monitor for hotplug events of the graphics card. */
+	int hotplug;
+	struct udev *udev;
+	struct udev_monitor *monitor;
+#endif
 } drm_state_t;
 
 
@@ -78,12 +129,348 @@ drm_init(drm_state_t **state)
 	s->card_num = 0;
 	s->crtc_num = -1;
 	s->fd = -1;
+	s->atomic = -1;
+	s->ctm = -1;
+	s->save = 1;
+	s->vblank_sequence = 0;
+	s->vblank_passed = 0;
 	s->res = NULL;
 	s->crtcs = NULL;
+#ifdef HAVE_LIBUDEV
+	s->hotplug = 1;
+	s->udev = NULL;
+	s->monitor = NULL;
+#endif
 
 	return 0;
 }
 
+/* Connector type names as used by the kernel, indexed by
+   DRM_MODE_CONNECTOR_* values. */
+static const char *connector_type_names[] = {
+	"Unknown", "VGA", "DVI-I", "DVI-D", "DVI-A", "Composite",
+	"SVIDEO", "LVDS", "Component", "DIN", "DP", "HDMI-A", "HDMI-B",
+	"TV", "eDP", "Virtual", "DSI", "DPI", "Writeback", "SPI", "USB"
+};
+
+/* Store the name of the connected connector driven by each CRTC.
+   The current state is read without probing the connectors. */
+static void
+drm_update_output_names(drm_state_t *state)
+{
+	drm_crtc_state_t *crtcs;
+	for (crtcs = state->crtcs; crtcs->crtc_num >= 0; crtcs++) {
+		crtcs->output_name[0] = '\0';
+	}
+
+	for (int i = 0; i < state->res->count_connectors; i++) {
+		drmModeConnector *connector = drmModeGetConnectorCurrent(
+			state->fd, state->res->connectors[i]);
+		if (connector == NULL) continue;
+
+		drmModeEncoder *encoder = NULL;
+		if (connector->connection == DRM_MODE_CONNECTED &&
+		    connector->encoder_id != 0) {
+			encoder = drmModeGetEncoder(state->fd,
+						    connector->encoder_id);
+		}
+
+		if (encoder != NULL) {
+			const char *type = connector_type_names[0];
+			size_t type_count = sizeof(connector_type_names) /
+				sizeof(connector_type_names[0]);
+			if (connector->connector_type < type_count) {
+				type = connector_type_names[
+					connector->connector_type];
+			}
+
+			for (crtcs = state->crtcs; crtcs->crtc_num >= 0;
+			     crtcs++) {
+				if (crtcs->crtc_id == (int)encoder->crtc_id &&
+				    crtcs->output_name[0] == '\0') {
+					snprintf(crtcs->output_name,
+						 sizeof(crtcs->output_name),
+						 "%s-%u", type,
+						 connector->connector_type_id);
+					break;
+				}
+			}
+
+			drmModeFreeEncoder(encoder);
+		}
+
+		drmModeFreeConnector(connector);
+	}
+}
+
+/* Return the setting for the output driven by CRTC if it is one of
+   OUTPUTS, otherwise SETTING. */
+static const color_setting_t *
+drm_setting_for_crtc(
+	const drm_crtc_state_t *crtc, const color_setting_t *setting,
+	const gamma_output_setting_t *outputs, int count)
+{
+	if (crtc->output_name[0] == '\0') return setting;
+
+	for (int i = 0; i < count; i++) {
+		if (strcmp(crtc->output_name, outputs[i].name) == 0) {
+			return &outputs[i].setting;
+		}
+	}
+
+	return setting;
+}
+
+/* Look up GAMMA_LUT and CTM properties of the CRTC. Their current
+   values are saved for restore if SAVE is true. Returns -1 if the CRTC
+   does not support GAMMA_LUT. */
+static int
+drm_get_lut_properties(drm_state_t *state, drm_crtc_state_t *crtc,
+		       int save)
+{
+	crtc->gamma_lut_prop = 0;
+	crtc->ctm_prop = 0;
+	crtc->lut_size = 0;
+
+	drmModeObjectProperties *props = drmModeObjectGetProperties(
+		state->fd, crtc->crtc_id, DRM_MODE_OBJECT_CRTC);
+	if (props == NULL) return -1;
+
+	for (int i = 0; i < props->count_props; i++) {
+		drmModePropertyRes *prop = drmModeGetProperty(
+			state->fd, props->props[i]);
+		if (prop == NULL) continue;
+
+		if (strcmp(prop->name, "GAMMA_LUT") == 0) {
+			crtc->gamma_lut_prop = prop->prop_id;
+			if (save) crtc->saved_lut_blob = props->prop_values[i];
+		} else if (strcmp(prop->name, "GAMMA_LUT_SIZE") == 0) {
+			crtc->lut_size = props->prop_values[i];
+		} else if (strcmp(prop->name, "CTM") == 0) {
+			crtc->ctm_prop = prop->prop_id;
+			if (save) crtc->saved_ctm_blob = props->prop_values[i];
+		}
+
+		drmModeFreeProperty(prop);
+	}
+
+	drmModeFreeObjectProperties(props);
+
+	if (crtc->gamma_lut_prop == 0 || crtc->lut_size <= 1) {
+		crtc->gamma_lut_prop = 0;
+		return -1;
+	}
+
+	return 0;
+}
+
+/* Allocate the LUTs of the CRTC for atomic commits. The LUT size and
+   properties are looked up again, and the current values saved if
+   SAVE is true. Returns -1 if the CRTC does not support GAMMA_LUT, or
+   the CTM when it is required. */
+static int
+drm_start_crtc_lut(drm_state_t *state, drm_crtc_state_t *crtcs, int save)
+{
+	int old_size = crtcs->lut_size;
+	int r = drm_get_lut_properties(state, crtcs, save);
+	if (r < 0) {
+		if (state->atomic > 0) {
+			fprintf(stderr, _("CRTC %i does not support"
+					  " the GAMMA_LUT property.\n"),
+				crtcs->crtc_num);
+		}
+		return -1;
+	}
+
+	if (state->ctm == 0) {
+		crtcs->ctm_prop = 0;
+	} else if (crtcs->ctm_prop == 0 && state->ctm > 0) {
+		fprintf(stderr, _("CRTC %i does not support"
+				  " the CTM property.\n"),
+			crtcs->crtc_num);
+		crtcs->gamma_lut_prop = 0;
+		return -1;
+	}
+
+	int lut_size = crtcs->lut_size;
+	if (crtcs->lut_ramps != NULL && lut_size == old_size) return 0;
+
+	/* The LUT currently applied no longer fits, so a new blob is
+	   always created. */
+	free(crtcs->lut_ramps);
+	free(crtcs->luts);
+	if (crtcs->lut_blob != 0) {
+		drmModeDestroyPropertyBlob(state->fd, crtcs->lut_blob);
+		crtcs->lut_blob = 0;
+	}
+
+	crtcs->lut_ramps = malloc(6*lut_size*sizeof(uint16_t));
+	crtcs->luts = calloc(2*lut_size, sizeof(struct drm_color_lut));
+	if (crtcs->lut_ramps == NULL || crtcs->luts == NULL) {
+		perror("malloc");
+		crtcs->gamma_lut_prop = 0;
+		return -1;
+	}
+
+	uint16_t *pure_ramps = &crtcs->lut_ramps[3*lut_size];
+	for (int i = 0; i < lut_size; i++) {
+		uint16_t value = (double)i/lut_size * (UINT16_MAX+1);
+		pure_ramps[0*lut_size+i] = value;
+		pure_ramps[1*lut_size+i] = value;
+		pure_ramps[2*lut_size+i] = value;
+	}
+
+	return 0;
+}
+
+/* Prepare CRTCs for setting gamma with atomic commits. Returns -1 if
+   atomic mode setting or the GAMMA_LUT property is not supported. */
+static int
+drm_start_atomic(drm_state_t *state)
+{
+	int r = drmSetClientCap(state->fd, DRM_CLIENT_CAP_ATOMIC, 1);
+	if (r < 0) {
+		if (state->atomic > 0) {
+			fprintf(stderr, _("DRM atomic mode setting is not"
+					  " supported by graphics card"
+					  " %i.\n"), state->card_num);
+		}
+		return -1;
+	}
+
+	drm_crtc_state_t *crtcs = state->crtcs;
+	for (; crtcs->crtc_num >= 0; crtcs++) {
+		if (crtcs->gamma_size <= 1) continue;
+
+		r = drm_start_crtc_lut(state, crtcs, 1);
+		if (r < 0) return -1;
+	}
+
+	return 0;
+}
+
+/* Save the current gamma ramps of the CRTC for restore. A CRTC whose
+   ramps can not be read is not restored. Returns -1 only if memory can
+   not be allocated. */
+static int
+drm_save_crtc_gamma(drm_state_t *state, drm_crtc_state_t *crtcs)
+{
+	/* Valgrind complains about us reading uninitialize memory if we just use malloc. */
+	crtcs->r_gamma = calloc(3 * crtcs->gamma_size, sizeof(uint16_t));
+	if (crtcs->r_gamma == NULL) {
+		perror("malloc");
+		return -1;
+	}
+	crtcs->g_gamma = crtcs->r_gamma + crtcs->gamma_size;
+	crtcs->b_gamma = crtcs->g_gamma + crtcs->gamma_size;
+
+	int r = drmModeCrtcGetGamma(state->fd, crtcs->crtc_id, crtcs->gamma_size,
+				    crtcs->r_gamma, crtcs->g_gamma, crtcs->b_gamma);
+	if (r < 0) {
+		fprintf(stderr, _("DRM could not read gamma ramps on CRTC %i on\n"
+				  "graphics card %i, ignoring device.\n"),
+			crtcs->crtc_num, state->card_num);
+		free(crtcs->r_gamma);
+		crtcs->r_gamma = NULL;
+	}
+
+	return 0;
+}
+
+#ifdef HAVE_LIBUDEV
+/* Create udev monitor for DRM device events. */
+static int
+drm_start_monitor(drm_state_t *state)
+{
+	state->udev = udev_new();
+	if (state->udev == NULL) return -1;
+
+	state->monitor = udev_monitor_new_from_netlink(state->udev, "udev");
+	if (state->monitor == NULL) return -1;
+
+	int r = udev_monitor_filter_add_match_subsystem_devtype(
+		state->monitor, "drm", NULL);
+	if (r < 0) return -1;
+
+	r = udev_monitor_enable_receiving(state->monitor);
+	if (r < 0) return -1;
+
+	return 0;
+}
+
+static int
+drm_get_fd(drm_state_t *state)
+{
+	if (state->monitor == NULL) return -1;
+	return udev_monitor_get_fd(state->monitor);
+}
+
+/* Handle udev events. On a hotplug event for our card the CRTCs are
+   queried again and 1 is returned so the adjustment is applied again;
+   the kernel may reset gamma on a mode set. The ramps of CRTCs that
+   became usable or changed gamma size are saved as at start. */
+static int
+drm_handle(drm_state_t *state)
+{
+	char sysname[32];
+	snprintf(sysname, sizeof(sysname), "card%d", state->card_num);
+
+	int changed = 0;
+	struct udev_device *dev;
+	while ((dev = udev_monitor_receive_device(state->monitor)) != NULL) {
+		const char *name = udev_device_get_sysname(dev);
+		const char *hotplug =
+			udev_device_get_property_value(dev, "HOTPLUG");
+		if (name != NULL && strcmp(name, sysname) == 0 &&
+		    hotplug != NULL && strcmp(hotplug, "1") == 0) {
+			changed = 1;
+		}
+		udev_device_unref(dev);
+	}
+
+	if (!changed) return 0;
+
+	drm_crtc_state_t *crtcs = state->crtcs;
+	for (; crtcs->crtc_num >= 0; crtcs++) {
+		drmModeCrtc *crtc_info =
+			drmModeGetCrtc(state->fd, crtcs->crtc_id);
+		if (crtc_info == NULL) {
+			crtcs->active = 0;
+			continue;
+		}
+		int gamma_size = crtc_info->gamma_size;
+		crtcs->active = crtc_info->mode_valid;
+		drmModeFreeCrtc(crtc_info);
+
+		int added = gamma_size != crtcs->gamma_size;
+		if (added) {
+			free(crtcs->r_gamma);
+			crtcs->r_gamma = NULL;
+			crtcs->g_gamma = NULL;
+			crtcs->b_gamma = NULL;
+			crtcs->gamma_size = gamma_size;
+			if (gamma_size > 1 && state->save) {
+				int r = drm_save_crtc_gamma(state, crtcs);
+				if (r < 0) return -1;
+			}
+		}
+
+		if (state->atomic > 0 && crtcs->gamma_size > 1) {
+			/* A CRTC that does not support it is not
+			   adjusted. */
+			int save = added || crtcs->gamma_lut_prop == 0;
+			drm_start_crtc_lut(state, crtcs, save);
+		} else if (state->atomic > 0) {
+			crtcs->gamma_lut_prop = 0;
+		}
+	}
+
+	drm_update_output_names(state);
+
+	return 1;
+}
+#endif /* HAVE_LIBUDEV */
+
 static int
 drm_start(drm_state_t *state)
 {
@@ -137,9 +524,19 @@ drm_start(drm_state_t *state)
 		state->crtcs->crtc_num = state->crtc_num;
 		state->crtcs->crtc_id = -1;
 		state->crtcs->gamma_size = -1;
+		state->crtcs->active = 0;
 		state->crtcs->r_gamma = NULL;
 		state->crtcs->g_gamma = NULL;
 		state->crtcs->b_gamma = NULL;
+		state->crtcs->gamma_lut_prop = 0;
+		state->crtcs->lut_size = 0;
+		state->crtcs->saved_lut_blob = 0;
+		state->crtcs->lut_blob = 0;
+		state->crtcs->ctm_prop = 0;
+		state->crtcs->saved_ctm_blob = 0;
+		state->crtcs->ctm_blob = 0;
+		state->crtcs->lut_ramps = NULL;
+		state->crtcs->luts = NULL;
 	} else {
 		int crtc_num;
 		state->crtcs = malloc((crtc_count + 1) * sizeof(drm_crtc_state_t));
@@ -148,9 +545,19 @@ drm_start(drm_state_t *state)
 			state->crtcs[crtc_num].crtc_num = crtc_num;
 			state->crtcs[crtc_num].crtc_id = -1;
 			state->crtcs[crtc_num].gamma_size = -1;
+			state->crtcs[crtc_num].active = 0;
 			state->crtcs[crtc_num].r_gamma = NULL;
 			state->crtcs[crtc_num].g_gamma = NULL;
 			state->crtcs[crtc_num].b_gamma = NULL;
+			state->crtcs[crtc_num].gamma_lut_prop = 0;
+			state->crtcs[crtc_num].lut_size = 0;
+			state->crtcs[crtc_num].saved_lut_blob = 0;
+			state->crtcs[crtc_num].lut_blob = 0;
+			state->crtcs[crtc_num].ctm_prop = 0;
+			state->crtcs[crtc_num].saved_ctm_blob = 0;
+			state->crtcs[crtc_num].ctm_blob = 0;
+			state->crtcs[crtc_num].lut_ramps = NULL;
+			state->crtcs[crtc_num].luts = NULL;
 		}
 	}
 
@@ -164,6 +571,7 @@ drm_start(drm_state_t *state)
 			continue;
 		}
 		crtcs->gamma_size = crtc_info->gamma_size;
+		crtcs->active = crtc_info->mode_valid;
 		drmModeFreeCrtc(crtc_info);
 		if (crtcs->gamma_size <= 1) {
 			fprintf(stderr, _("Could not get gamma ramp size for CRTC %i\n"
@@ -171,22 +579,9 @@ drm_start(drm_state_t *state)
 				crtcs->crtc_num, state->card_num);
 			continue;
 		}
-		/* Valgrind complains about us reading uninitialize memory if we just use malloc. */
-		crtcs->r_gamma = calloc(3 * crtcs->gamma_size, sizeof(uint16_t));
-		crtcs->g_gamma = crtcs->r_gamma + crtcs->gamma_size;
-		crtcs->b_gamma = crtcs->g_gamma + crtcs->gamma_size;
-		if (crtcs->r_gamma != NULL) {
-			int r = drmModeCrtcGetGamma(state->fd, crtcs->crtc_id, crtcs->gamma_size,
-						    crtcs->r_gamma, crtcs->g_gamma, crtcs->b_gamma);
-			if (r < 0) {
-				fprintf(stderr, _("DRM could not read gamma ramps on CRTC %i on\n"
-						  "graphics card %i, ignoring device.\n"),
-					crtcs->crtc_num, state->card_num);
-				free(crtcs->r_gamma);
-				crtcs->r_gamma = NULL;
-			}
-		} else {
-			perror("malloc");
+		/* Without restore the current ramps are not needed. */
+		if (!state->save) continue;
+		if (drm_save_crtc_gamma(state, crtcs) < 0) {
 			drmModeFreeResources(state->res);
 			state->res = NULL;
 			close(state->fd);
@@ -199,6 +594,32 @@ drm_start(drm_state_t *state)
 		}
 	}
 
+	drm_update_output_names(state);
+
+	/* Use atomic mode setting if possible or requested. */
+	if (state->atomic != 0) {
+		int r = drm_start_atomic(state);
+		if (r < 0) {
+			if (state->atomic > 0) return -1;
+			state->atomic = 0;
+		} else {
+			state->atomic = 1;
+		}
+	}
+
+#ifdef HAVE_LIBUDEV
+	/* Listen for connectors being plugged in or removed. Failure
+	   only disables following changes. */
+	if (state->hotplug) {
+		int r = drm_start_monitor(state);
+		if (r < 0) {
+			fprintf(stderr, _("Unable to monitor graphics card %i"
+					  " for hotplug events.\n"),
+				state->card_num);
+		}
+	}
+#endif
+
 	return 0;
 }
 
@@ -206,6 +627,35 @@ static void
 drm_restore(drm_state_t *state)
 {
 	drm_crtc_state_t *crtcs = state->crtcs;
+
+	if (state->atomic > 0) {
+		/* Put back the LUT and CTM that were set at start. */
+		drmModeAtomicReq *req = drmModeAtomicAlloc();
+		if (req == NULL) return;
+
+		for (; crtcs->crtc_num >= 0; crtcs++) {
+			if (crtcs->gamma_lut_prop == 0) continue;
+			drmModeAtomicAddProperty(req, crtcs->crtc_id,
+						 crtcs->gamma_lut_prop,
+						 crtcs->saved_lut_blob);
+			if (crtcs->ctm_prop == 0) continue;
+			drmModeAtomicAddProperty(req, crtcs->crtc_id,
+						 crtcs->ctm_prop,
+						 crtcs->saved_ctm_blob);
+		}
+
+		int r = drmModeAtomicCommit(state->fd, req, 0, NULL);
+		if (r < 0) {
+			perror("drmModeAtomicCommit");
+			fprintf(stderr, _("Unable to restore gamma ramps on"
+					  " graphics card %i\n"),
+				state->card_num);
+		}
+
+		drmModeAtomicFree(req);
+		return;
+	}
+
 	while (crtcs->crtc_num >= 0) {
 		if (crtcs->r_gamma != NULL) {
 			drmModeCrtcSetGamma(state->fd, crtcs->crtc_id, crtcs->gamma_size,
@@ -215,12 +665,33 @@ drm_restore(drm_state_t *state)
 	}
 }
 
+/* Called before start when restore will not be used. */
+static void
+drm_skip_save(drm_state_t *state)
+{
+	state->save = 0;
+#ifdef HAVE_LIBUDEV
+	/* Output changes are never handled either. */
+	state->hotplug = 0;
+#endif
+}
+
 static void
 drm_free(drm_state_t *state)
 {
 	if (state->crtcs != NULL) {
 		drm_crtc_state_t *crtcs = state->crtcs;
 		while (crtcs->crtc_num >= 0) {
+			if (crtcs->lut_blob != 0) {
+				drmModeDestroyPropertyBlob(state->fd,
+							   crtcs->lut_blob);
+			}
+			if (crtcs->ctm_blob != 0) {
+				drmModeDestroyPropertyBlob(state->fd,
+							   crtcs->ctm_blob);
+			}
+			free(crtcs->lut_ramps);
+			free(crtcs->luts);
 			free(crtcs->r_gamma);
 			crtcs->crtc_num = -1;
 			crtcs++;
@@ -236,6 +707,10 @@ drm_free(drm_state_t *state)
 		close(state->fd);
 		state->fd = -1;
 	}
+#ifdef HAVE_LIBUDEV
+	if (state->monitor != NULL) udev_monitor_unref(state->monitor);
+	if (state->udev != NULL) udev_unref(state->udev);
+#endif
 
 	free(state);
 }
@@ -249,7 +724,15 @@ drm_print_help(FILE *f)
 	/* TRANSLATORS: DRM help output
 	   left column must not be translated */
 	fputs(_("  card=N\tGraphics card to apply adjustments to\n"
-		"  crtc=N\tCRTC to apply adjustments to\n"), f);
+		"  crtc=N\tCRTC to apply adjustments to\n"
+		"  atomic=0|1\tUse atomic mode setting (default: if"
+		" supported)\n"
+		"  ctm=0|1\tApply white point with the CTM property"
+		" (default: if supported)\n"), f);
+#ifdef HAVE_LIBUDEV
+	fputs(_("  hotplug=0|1\tReapply when monitors are connected"
+		" (default 1)\n"), f);
+#endif
 	fputs("\n", f);
 }
 
@@ -264,6 +747,14 @@ drm_set_option(drm_state_t *state, const char *key, const char *value)
 			fprintf(stderr, _("CRTC must be a non-negative integer\n"));
 			return -1;
 		}
+	} else if (strcasecmp(key, "atomic") == 0) {
+		state->atomic = !!atoi(value);
+	} else if (strcasecmp(key, "ctm") == 0) {
+		state->ctm = !!atoi(value);
+#ifdef HAVE_LIBUDEV
+	} else if (strcasecmp(key, "hotplug") == 0) {
+		state->hotplug = atoi(value);
+#endif
 	} else {
 		fprintf(stderr, _("Unknown method parameter: `%s'.\n"), key);
 		return -1;
@@ -272,10 +763,220 @@ drm_set_option(drm_state_t *state, const char *key, const char *value)
 	return 0;
 }
 
+/* Fill the LUT of the CRTC for SETTING in the space for the next LUT. */
+static void
+drm_fill_lut(drm_crtc_state_t *crtc, const color_setting_t *setting)
+{
+	int lut_size = crtc->lut_size;
+	uint16_t *r_gamma = &crtc->lut_ramps[0*lut_size];
+	uint16_t *g_gamma = &crtc->lut_ramps[1*lut_size];
+	uint16_t *b_gamma = &crtc->lut_ramps[2*lut_size];
+
+	/* Initialize gamma ramps to pure state */
+	memcpy(crtc->lut_ramps, &crtc->lut_ramps[3*lut_size],
+	       3*lut_size*sizeof(uint16_t));
+
+	colorramp_fill(r_gamma, g_gamma, b_gamma, lut_size, setting);
+
+	struct drm_color_lut *lut = &crtc->luts[lut_size];
+	for (int i = 0; i < lut_size; i++) {
+		lut[i].red = r_gamma[i];
+		lut[i].green = g_gamma[i];
+		lut[i].blue = b_gamma[i];
+		lut[i].reserved = 0;
+	}
+}
+
+/* Set the next CTM of the CRTC to scale the channels by the white
+   point and brightness of SETTING. The LUT is applied after the CTM,
+   so this gives the same result as a LUT for the whole setting. */
+static void
+drm_fill_ctm(drm_crtc_state_t *crtc, const color_setting_t *setting)
+{
+	color_setting_t linear = *setting;
+	for (int c = 0; c < 3; c++) linear.gamma[c] = 1.0;
+
+	double scale[3];
+	double exponent[3];
+	colorramp_params(&linear, scale, exponent);
+
+	/* Entries are S31.32 sign-magnitude fixed point. */
+	memset(&crtc->new_ctm, 0, sizeof(crtc->new_ctm));
+	for (int c = 0; c < 3; c++) {
+		crtc->new_ctm.matrix[4*c] =
+			(uint64_t)(scale[c] * ((uint64_t)1 << 32));
+	}
+}
+
+/* Set gamma on all CRTCs in a single atomic commit. A new LUT blob is
+   only created for CRTCs where the LUT changed, and likewise for the
+   CTM. */
 static int
-drm_set_temperature(
-	drm_state_t *state, const color_setting_t *setting, int preserve)
+drm_set_temperature_atomic(
+	drm_state_t *state, const color_setting_t *setting,
+	const gamma_output_setting_t *outputs, int count)
+{
+	drm_crtc_state_t *crtcs;
+	int r;
+
+	drmModeAtomicReq *req = drmModeAtomicAlloc();
+	if (req == NULL) {
+		perror("drmModeAtomicAlloc");
+		return -1;
+	}
+
+	for (crtcs = state->crtcs; crtcs->crtc_num >= 0; crtcs++) {
+		if (crtcs->gamma_lut_prop == 0) continue;
+
+		int lut_size = crtcs->lut_size;
+		const color_setting_t *crtc_setting = drm_setting_for_crtc(
+			crtcs, setting, outputs, count);
+
+		crtcs->new_lut_blob = crtcs->lut_blob;
+		crtcs->new_ctm_blob = crtcs->ctm_blob;
+		memcpy(crtcs->new_lut_gamma, crtc_setting->gamma,
+		       sizeof(crtcs->new_lut_gamma));
+
+		/* With the CTM the LUT only depends on the gamma. */
+		int fill_lut = 1;
+		color_setting_t lut_setting = *crtc_setting;
+		if (crtcs->ctm_prop != 0) {
+			lut_setting.temperature = NEUTRAL_TEMP;
+			lut_setting.brightness = 1.0;
+			fill_lut = crtcs->lut_blob == 0 ||
+				memcmp(crtcs->lut_gamma, crtc_setting->gamma,
+				       sizeof(crtcs->lut_gamma)) != 0;
+		}
+
+		/* Reuse the current blob if the LUT is unchanged. */
+		struct drm_color_lut *lut = &crtcs->luts[lut_size];
+		if (fill_lut) drm_fill_lut(crtcs, &lut_setting);
+		if (fill_lut &&
+		    (crtcs->lut_blob == 0 ||
+		     memcmp(lut, crtcs->luts,
+			    lut_size*sizeof(struct drm_color_lut)) != 0)) {
+			r = drmModeCreatePropertyBlob(
+				state->fd, lut,
+				lut_size*sizeof(struct drm_color_lut),
+				&crtcs->new_lut_blob);
+			if (r < 0) {
+				perror("drmModeCreatePropertyBlob");
+				crtcs->new_lut_blob = crtcs->lut_blob;
+				goto fail;
+			}
+		}
+
+		r = drmModeAtomicAddProperty(req, crtcs->crtc_id,
+					     crtcs->gamma_lut_prop,
+					     crtcs->new_lut_blob);
+		if (r < 0) {
+			perror("drmModeAtomicAddProperty");
+			crtcs++;
+			goto fail;
+		}
+
+		if (crtcs->ctm_prop == 0) continue;
+
+		drm_fill_ctm(crtcs, crtc_setting);
+		if (crtcs->ctm_blob == 0 ||
+		    memcmp(&crtcs->new_ctm, &crtcs->ctm,
+			   sizeof(crtcs->ctm)) != 0) {
+			r = drmModeCreatePropertyBlob(
+				state->fd, &crtcs->new_ctm,
+				sizeof(crtcs->new_ctm),
+				&crtcs->new_ctm_blob);
+			if (r < 0) {
+				perror("drmModeCreatePropertyBlob");
+				crtcs->new_ctm_blob = crtcs->ctm_blob;
+				crtcs++;
+				goto fail;
+			}
+		}
+
+		r = drmModeAtomicAddProperty(req, crtcs->crtc_id,
+					     crtcs->ctm_prop,
+					     crtcs->new_ctm_blob);
+		if (r < 0) {
+			perror("drmModeAtomicAddProperty");
+			crtcs++;
+			goto fail;
+		}
+	}
+
+	/* A nonblocking commit fails if the previous one is still
+	   pending. Wait for it in that case. */
+	r = drmModeAtomicCommit(state->fd, req, DRM_MODE_ATOMIC_NONBLOCK,
+				NULL);
+	if (r < 0 && errno == EBUSY) {
+		r = drmModeAtomicCommit(state->fd, req, 0, NULL);
+	}
+	if (r < 0) {
+		perror("drmModeAtomicCommit");
+		goto fail;
+	}
+
+	drmModeAtomicFree(req);
+
+	/* The commit holds references to the new blobs so the old ones
+	   can be destroyed. */
+	for (crtcs = state->crtcs; crtcs->crtc_num >= 0; crtcs++) {
+		if (crtcs->gamma_lut_prop == 0) continue;
+
+		if (crtcs->new_lut_blob != crtcs->lut_blob) {
+			if (crtcs->lut_blob != 0) {
+				drmModeDestroyPropertyBlob(state->fd,
+							   crtcs->lut_blob);
+			}
+			crtcs->lut_blob = crtcs->new_lut_blob;
+			memcpy(crtcs->luts, &crtcs->luts[crtcs->lut_size],
+			       crtcs->lut_size*sizeof(struct drm_color_lut));
+		}
+		memcpy(crtcs->lut_gamma, crtcs->new_lut_gamma,
+		       sizeof(crtcs->lut_gamma));
+
+		if (crtcs->new_ctm_blob != crtcs->ctm_blob) {
+			if (crtcs->ctm_blob != 0) {
+				drmModeDestroyPropertyBlob(state->fd,
+							   crtcs->ctm_blob);
+			}
+			crtcs->ctm_blob = crtcs->new_ctm_blob;
+			crtcs->ctm = crtcs->new_ctm;
+		}
+	}
+
+	return 0;
+
+fail:
+	/* Destroy blobs created for CRTCs before the failure. */
+	drmModeAtomicFree(req);
+	while (crtcs-- != state->crtcs) {
+		if (crtcs->gamma_lut_prop == 0) continue;
+		if (crtcs->new_lut_blob != crtcs->lut_blob) {
+			drmModeDestroyPropertyBlob(state->fd,
+						   crtcs->new_lut_blob);
+		}
+		if (crtcs->new_ctm_blob != crtcs->ctm_blob) {
+			drmModeDestroyPropertyBlob(state->fd,
+						   crtcs->new_ctm_blob);
+		}
+	}
+	fprintf(stderr, _("Unable to set gamma ramps on graphics card %i\n"),
+		state->card_num);
+	return -1;
+}
+
+/* Set SETTING on all CRTCs, except those driving one of OUTPUTS,
+   which get the setting of that output. */
+static int
+drm_set_output_temperatures(
+	drm_state_t *state, const color_setting_t *setting,
+	const gamma_output_setting_t *outputs, int count, int preserve)
 {
+	if (state->atomic > 0) {
+		return drm_set_temperature_atomic(state, setting,
+						  outputs, count);
+	}
+
 	drm_crtc_state_t *crtcs = state->crtcs;
 	int last_gamma_size = 0;
 	uint16_t *r_gamma = NULL;
@@ -312,9 +1013,18 @@ drm_set_temperature(
 		}
 
 		colorramp_fill(r_gamma, g_gamma, b_gamma, crtcs->gamma_size,
-			       setting);
-		drmModeCrtcSetGamma(state->fd, crtcs->crtc_id, crtcs->gamma_size,
-				    r_gamma, g_gamma, b_gamma);
+			       drm_setting_for_crtc(crtcs, setting,
+						    outputs, count));
+		int r = drmModeCrtcSetGamma(state->fd, crtcs->crtc_id,
+					    crtcs->gamma_size,
+					    r_gamma, g_gamma, b_gamma);
+		if (r < 0) {
+			fprintf(stderr, _("DRM could not set gamma ramps on"
+					  " CRTC %i on graphics card %i.\n"),
+				crtcs->crtc_num, state->card_num);
+			free(r_gamma);
+			return -1;
+		}
 	}
 
 	free(r_gamma);
@@ -322,6 +1032,96 @@ drm_set_temperature(
 	return 0;
 }
 
+static int
+drm_set_temperature(
+	drm_state_t *state, const color_setting_t *setting, int preserve)
+{
+	return drm_set_output_temperatures(state, setting, NULL, 0,
+					   preserve);
+}
+
+static void
+drm_vblank_handler(int fd, unsigned int sequence, unsigned int tv_sec,
+		   unsigned int tv_usec, void *data)
+{
+	drm_state_t *state = data;
+
+	/* Events of earlier requests that timed out are ignored. */
+	if ((int)(sequence - state->vblank_sequence) >= 0) {
+		state->vblank_passed = 1;
+	}
+}
+
+/* Ask for an event at the next vertical blank on the first active
+   CRTC. */
+static int
+drm_request_vblank(drm_state_t *state)
+{
+	drm_crtc_state_t *crtcs = state->crtcs;
+	while (crtcs->crtc_num >= 0 &&
+	       (!crtcs->active || crtcs->gamma_size <= 1)) {
+		crtcs++;
+	}
+	if (crtcs->crtc_num < 0) return -1;
+
+	drmVBlank vbl;
+	vbl.request.type = DRM_VBLANK_RELATIVE | DRM_VBLANK_EVENT;
+	if (crtcs->crtc_num == 1) {
+		vbl.request.type |= DRM_VBLANK_SECONDARY;
+	} else if (crtcs->crtc_num > 1) {
+		vbl.request.type |=
+			(crtcs->crtc_num << DRM_VBLANK_HIGH_CRTC_SHIFT) &
+			DRM_VBLANK_HIGH_CRTC_MASK;
+	}
+	vbl.request.sequence = 1;
+	vbl.request.signal = (unsigned long)state;
+
+	int r;
+	do {
+		r = drmWaitVBlank(state->fd, &vbl);
+	} while (r < 0 && errno == EINTR);
+	if (r < 0) {
+		perror("drmWaitVBlank");
+		return -1;
+	}
+
+	state->vblank_sequence = vbl.reply.sequence;
+	state->vblank_passed = 0;
+
+	return state->fd;
+}
+
+/* Read vertical blank events that are pending on the device. */
+static int
+drm_handle_vblank(drm_state_t *state)
+{
+	struct pollfd pollfd = { state->fd, POLLIN, 0 };
+	while (!state->vblank_passed) {
+		/* Reading from the device blocks if there are no
+		   events. */
+		int r = poll(&pollfd, 1, 0);
+		if (r < 0 && errno == EINTR) continue;
+		if (r < 0) {
+			perror("poll");
+			return -1;
+		} else if (r == 0) {
+			break;
+		}
+
+		drmEventContext context;
+		memset(&context, 0, sizeof(context));
+		context.version = 2;
+		context.vblank_handler = drm_vblank_handler;
+		r = drmHandleEvent(state->fd, &context);
+		if (r < 0) {
+			perror("drmHandleEvent");
+			return -1;
+		}
+	}
+
+	return state->vblank_passed;
+}
+
 
 const gamma_method_t drm_gamma_method = {
 	"drm", 0,
@@ -331,5 +1131,17 @@ const gamma_method_t drm_gamma_method = {
 	(gamma_method_print_help_func *)drm_print_help,
 	(gamma_method_set_option_func *)drm_set_option,
 	(gamma_method_restore_func *)drm_restore,
-	(gamma_method_set_temperature_func *)drm_set_temperature
+	(gamma_method_set_temperature_func *)drm_set_temperature,
+	(gamma_method_request_vblank_func *)drm_request_vblank,
+	(gamma_method_handle_vblank_func *)drm_handle_vblank,
+#ifdef HAVE_LIBUDEV
+	(gamma_method_get_fd_func *)drm_get_fd,
+	(gamma_method_handle_func *)drm_handle,
+#else
+	NULL,
+	NULL,
+#endif
+	(gamma_method_set_output_temperatures_func *)
+	drm_set_output_temperatures,
+	(gamma_method_skip_save_func *)drm_skip_save
 };
@@ -32,6 +32,8 @@
 #endif
 
 #include "redshift.h"
+#include "gamma-dummy.h"
+#include "systemtime.h"
 
 
 static int
@@ -80,6 +82,19 @@ gamma_dummy_set_temperature(
 	return 0;
 }
 
+static int
+gamma_dummy_set_output_temperatures(
+	void *state, const color_setting_t *setting,
+	const gamma_output_setting_t *outputs, int count, int preserve)
+{
+	printf(_("Temperature: %i\n"), setting->temperature);
+	for (int i = 0; i < count; i++) {
+		printf(_("Temperature of %s: %i\n"), outputs[i].name,
+		       outputs[i].setting.temperature);
+	}
+	return 0;
+}
+
 
 const gamma_method_t dummy_gamma_method = {
 	"dummy", 0,
@@ -89,5 +104,87 @@ const gamma_method_t dummy_gamma_method = {
 	(gamma_method_print_help_func *)gamma_dummy_print_help,
 	(gamma_method_set_option_func *)gamma_dummy_set_option,
 	(gamma_method_restore_func *)gamma_dummy_restore,
-	(gamma_method_set_temperature_func *)gamma_dummy_set_temperature
+	(gamma_method_set_temperature_func *)gamma_dummy_set_temperature,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	(gamma_method_set_output_temperatures_func *)
+	gamma_dummy_set_output_temperatures
+};
+
+
+/* The record method prints each color setting with the time it was
+   set as a line of tab separated fields. With the virtual clock of a
+   simulation this gives a replay of the schedule. */
+
+static int
+gamma_record_start(void *state)
+{
+	return 0;
+}
+
+static void
+gamma_record_print_help(FILE *f)
+{
+	fputs(_("Does not affect the display but prints each color setting with the time it is set.\n"), f);
+	fputs("\n", f);
+}
+
+static void
+gamma_record_print(double now, const char *target,
+		   const color_setting_t *setting)
+{
+	printf("%.3f\tset\t%s\t%i\t%.2f\t%.3f:%.3f:%.3f\n", now, target,
+	       setting->temperature, setting->brightness,
+	       setting->gamma[0], setting->gamma[1], setting->gamma[2]);
+}
+
+static void
+gamma_record_restore(void *state)
+{
+	double now;
+	if (systemtime_get_time(&now) < 0) return;
+	printf("%.3f\trestore\n", now);
+}
+
+static int
+gamma_record_set_output_temperatures(
+	void *state, const color_setting_t *setting,
+	const gamma_output_setting_t *outputs, int count, int preserve)
+{
+	double now;
+	if (systemtime_get_time(&now) < 0) return -1;
+
+	gamma_record_print(now, "*", setting);
+	for (int i = 0; i < count; i++) {
+		gamma_record_print(now, outputs[i].name, &outputs[i].setting);
+	}
+	return 0;
+}
+
+static int
+gamma_record_set_temperature(
+	void *state, const color_setting_t *setting, int preserve)
+{
+	return gamma_record_set_output_temperatures(
+		state, setting, NULL, 0, preserve);
+}
+
+
+const gamma_method_t record_gamma_method = {
+	"record", 0,
+	(gamma_method_init_func *)gamma_dummy_init,
+	(gamma_method_start_func *)gamma_record_start,
+	(gamma_method_free_func *)gamma_dummy_free,
+	(gamma_method_print_help_func *)gamma_record_print_help,
+	(gamma_method_set_option_func *)gamma_dummy_set_option,
+	(gamma_method_restore_func *)gamma_record_restore,
+	(gamma_method_set_temperature_func *)gamma_record_set_temperature,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	(gamma_method_set_output_temperatures_func *)
+	gamma_record_set_output_temperatures
 };
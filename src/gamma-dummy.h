@@ -23,5 +23,6 @@
 #include "redshift.h"
 
 extern const gamma_method_t dummy_gamma_method;
+extern const gamma_method_t record_gamma_method;
 
 #endif /* ! REDSHIFT_GAMMA_DUMMY_H */
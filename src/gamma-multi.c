@@ -0,0 +1,268 @@
+/* gamma-multi.c -- Gamma adjustment of several targets source
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#ifdef HAVE_SYS_EPOLL_H
+# include <sys/epoll.h>
+#endif
+
+#ifdef ENABLE_NLS
+# include <libintl.h>
+# define _(s) gettext(s)
+#else
+# define _(s) s
+#endif
+
+#include "gamma-multi.h"
+#include "redshift.h"
+
+
+typedef struct {
+	const gamma_method_t *method;
+	gamma_state_t *state;
+	/* File descriptor watched for the target, or -1. */
+	int fd;
+} multi_target_t;
+
+typedef struct {
+	multi_target_t targets[MAX_GAMMA_TARGETS];
+	int count;
+	/* Watches the file descriptors of all targets. */
+	int epoll_fd;
+} multi_state_t;
+
+
+static int
+multi_init(multi_state_t **state)
+{
+	*state = malloc(sizeof(multi_state_t));
+	if (*state == NULL) return -1;
+
+	multi_state_t *s = *state;
+	s->count = 0;
+	s->epoll_fd = -1;
+
+	return 0;
+}
+
+/* Add a started method. The state is freed along with STATE. */
+int
+multi_gamma_add_target(
+	gamma_state_t *state, const gamma_method_t *method,
+	gamma_state_t *target_state)
+{
+	multi_state_t *s = (multi_state_t *)state;
+	if (s->count == MAX_GAMMA_TARGETS) {
+		fprintf(stderr, _("At most %i adjustment targets can be"
+				  " used.\n"), MAX_GAMMA_TARGETS);
+		return -1;
+	}
+
+	multi_target_t *target = &s->targets[s->count++];
+	target->method = method;
+	target->state = target_state;
+	target->fd = -1;
+
+	return 0;
+}
+
+static int
+multi_start(multi_state_t *state)
+{
+#ifdef HAVE_SYS_EPOLL_H
+	for (int i = 0; i < state->count; i++) {
+		multi_target_t *target = &state->targets[i];
+		if (target->method->get_fd == NULL) continue;
+
+		target->fd = target->method->get_fd(target->state);
+		if (target->fd < 0) continue;
+
+		if (state->epoll_fd < 0) {
+			state->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+			if (state->epoll_fd < 0) {
+				perror("epoll_create1");
+				return -1;
+			}
+		}
+
+		struct epoll_event event;
+		event.events = EPOLLIN;
+		event.data.u32 = i;
+		int r = epoll_ctl(state->epoll_fd, EPOLL_CTL_ADD,
+				  target->fd, &event);
+		if (r < 0) {
+			perror("epoll_ctl");
+			return -1;
+		}
+	}
+#endif
+
+	return 0;
+}
+
+static void
+multi_free(multi_state_t *state)
+{
+	for (int i = 0; i < state->count; i++) {
+		state->targets[i].method->free(state->targets[i].state);
+	}
+	if (state->epoll_fd >= 0) close(state->epoll_fd);
+
+	free(state);
+}
+
+static void
+multi_print_help(FILE *f)
+{
+	fputs(_("Adjust several targets given with repeated -m"
+		" options.\n"), f);
+	fputs("\n", f);
+}
+
+static int
+multi_set_option(multi_state_t *state, const char *key, const char *value)
+{
+	fprintf(stderr, _("Unknown method parameter: `%s'.\n"), key);
+	return -1;
+}
+
+static void
+multi_restore(multi_state_t *state)
+{
+	for (int i = 0; i < state->count; i++) {
+		state->targets[i].method->restore(state->targets[i].state);
+	}
+}
+
+/* Set the adjustment on all targets. A failing target does not keep
+   the others from being adjusted. */
+static int
+multi_set_output_temperatures(
+	multi_state_t *state, const color_setting_t *setting,
+	const gamma_output_setting_t *outputs, int count, int preserve)
+{
+	int error = 0;
+	for (int i = 0; i < state->count; i++) {
+		multi_target_t *target = &state->targets[i];
+		int r;
+		if (count > 0 &&
+		    target->method->set_output_temperatures != NULL) {
+			r = target->method->set_output_temperatures(
+				target->state, setting, outputs, count,
+				preserve);
+		} else {
+			r = target->method->set_temperature(
+				target->state, setting, preserve);
+		}
+		if (r < 0) error = 1;
+	}
+
+	return error ? -1 : 0;
+}
+
+static int
+multi_set_temperature(
+	multi_state_t *state, const color_setting_t *setting, int preserve)
+{
+	return multi_set_output_temperatures(state, setting, NULL, 0,
+					     preserve);
+}
+
+/* Use vertical blank of the first target that supports it. */
+static int
+multi_request_vblank(multi_state_t *state)
+{
+	for (int i = 0; i < state->count; i++) {
+		multi_target_t *target = &state->targets[i];
+		if (target->method->request_vblank != NULL) {
+			return target->method->request_vblank(target->state);
+		}
+	}
+
+	return -1;
+}
+
+static int
+multi_handle_vblank(multi_state_t *state)
+{
+	for (int i = 0; i < state->count; i++) {
+		multi_target_t *target = &state->targets[i];
+		if (target->method->request_vblank != NULL) {
+			return target->method->handle_vblank(target->state);
+		}
+	}
+
+	return -1;
+}
+
+static int
+multi_get_fd(multi_state_t *state)
+{
+	return state->epoll_fd;
+}
+
+/* Let the targets with pending events handle them. Returns 1 if the
+   outputs of any target changed. */
+static int
+multi_handle(multi_state_t *state)
+{
+#ifdef HAVE_SYS_EPOLL_H
+	struct epoll_event events[MAX_GAMMA_TARGETS];
+	int n = epoll_wait(state->epoll_fd, events, MAX_GAMMA_TARGETS, 0);
+	if (n < 0) {
+		perror("epoll_wait");
+		return -1;
+	}
+
+	int changed = 0;
+	for (int i = 0; i < n; i++) {
+		multi_target_t *target = &state->targets[events[i].data.u32];
+		int r = target->method->handle(target->state);
+		if (r < 0) return -1;
+		if (r > 0) changed = 1;
+	}
+
+	return changed;
+#else
+	return 0;
+#endif
+}
+
+
+const gamma_method_t multi_gamma_method = {
+	"multi", 0,
+	(gamma_method_init_func *)multi_init,
+	(gamma_method_start_func *)multi_start,
+	(gamma_method_free_func *)multi_free,
+	(gamma_method_print_help_func *)multi_print_help,
+	(gamma_method_set_option_func *)multi_set_option,
+	(gamma_method_restore_func *)multi_restore,
+	(gamma_method_set_temperature_func *)multi_set_temperature,
+	(gamma_method_request_vblank_func *)multi_request_vblank,
+	(gamma_method_handle_vblank_func *)multi_handle_vblank,
+	(gamma_method_get_fd_func *)multi_get_fd,
+	(gamma_method_handle_func *)multi_handle,
+	(gamma_method_set_output_temperatures_func *)
+	multi_set_output_temperatures
+};
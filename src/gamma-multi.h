@@ -0,0 +1,34 @@
+/* gamma-multi.h -- Gamma adjustment of several targets header
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REDSHIFT_GAMMA_MULTI_H
+#define REDSHIFT_GAMMA_MULTI_H
+
+#include "redshift.h"
+
+/* Maximum number of targets adjusted by one process. */
+#define MAX_GAMMA_TARGETS  16
+
+/* Applies every adjustment to several started methods. It is not in
+   the list of methods; targets are added before it is started. */
+extern const gamma_method_t multi_gamma_method;
+
+int multi_gamma_add_target(
+	gamma_state_t *state, const gamma_method_t *method,
+	gamma_state_t *target_state);
+
+#endif /* ! REDSHIFT_GAMMA_MULTI_H */
@@ -23,6 +23,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <ApplicationServices/ApplicationServices.h>
 
@@ -41,6 +42,7 @@ typedef struct {
 	CGDirectDisplayID display;
 	uint32_t ramp_size;
 	float *saved_ramps;
+	float *ramps;
 } quartz_display_state_t;
 
 typedef struct {
@@ -101,6 +103,7 @@ quartz_start(quartz_state_t *state)
 	for (int i = 0; i < display_count; i++) {
 		state->displays[i].display = displays[i];
 		state->displays[i].saved_ramps = NULL;
+		state->displays[i].ramps = NULL;
 	}
 
 	free(displays);
@@ -141,6 +144,14 @@ quartz_start(quartz_state_t *state)
 			      stderr);
 			return -1;
 		}
+
+		/* Allocate working gamma ramps so setting the
+		   temperature does not need to allocate. */
+		state->displays[i].ramps = malloc(3*ramp_size*sizeof(float));
+		if (state->displays[i].ramps == NULL) {
+			perror("malloc");
+			return -1;
+		}
 	}
 
 	return 0;
@@ -158,6 +169,7 @@ quartz_free(quartz_state_t *state)
 	if (state->displays != NULL) {
 		for (int i = 0; i < state->display_count; i++) {
 			free(state->displays[i].saved_ramps);
+			free(state->displays[i].ramps);
 		}
 	}
 	free(state->displays);
@@ -188,65 +200,67 @@ quartz_set_option(quartz_state_t *state, const char *key, const char *value)
 }
 
 static void
-quartz_set_temperature_for_display(
+quartz_fill_display(
 	quartz_state_t *state, int display_index,
-	const color_setting_t *setting, int preserve)
+	const color_setting_t *setting)
 {
-	CGDirectDisplayID display = state->displays[display_index].display;
 	uint32_t ramp_size = state->displays[display_index].ramp_size;
 
-	/* Create new gamma ramps */
-	float *gamma_ramps = malloc(3*ramp_size*sizeof(float));
-	if (gamma_ramps == NULL) {
-		perror("malloc");
-		return;
-	}
-
+	float *gamma_ramps = state->displays[display_index].ramps;
 	float *gamma_r = &gamma_ramps[0*ramp_size];
 	float *gamma_g = &gamma_ramps[1*ramp_size];
 	float *gamma_b = &gamma_ramps[2*ramp_size];
 
-	if (preserve) {
-		/* Initialize gamma ramps from saved state */
-		memcpy(gamma_ramps, state->displays[display_index].saved_ramps,
-		       3*ramp_size*sizeof(float));
-	} else {
-		/* Initialize gamma ramps to pure state */
-		for (int i = 0; i < ramp_size; i++) {
-			float value = (double)i/ramp_size;
-			gamma_r[i] = value;
-			gamma_g[i] = value;
-			gamma_b[i] = value;
-		}
-	}
+	/* Initialize gamma ramps from saved state */
+	memcpy(gamma_ramps, state->displays[display_index].saved_ramps,
+	       3*ramp_size*sizeof(float));
 
 	colorramp_fill_float(gamma_r, gamma_g, gamma_b, ramp_size,
 			     setting);
-
-	CGError error =
-		CGSetDisplayTransferByTable(display, ramp_size,
-					    gamma_r, gamma_g, gamma_b);
-	if (error != kCGErrorSuccess) {
-		free(gamma_ramps);
-		return;
-	}
-
-	free(gamma_ramps);
 }
 
 static int
 quartz_set_temperature(
 	quartz_state_t *state, const color_setting_t *setting, int preserve)
 {
+	/* From the pure state the ramps are scale * pow(x, exponent),
+	   which Quartz takes as a formula with no table to build or
+	   upload. */
+	if (!preserve) {
+		double scale[3];
+		double exponent[3];
+		colorramp_params(setting, scale, exponent);
+
+		for (int i = 0; i < state->display_count; i++) {
+			CGSetDisplayTransferByFormula(
+				state->displays[i].display,
+				0, scale[0], exponent[0],
+				0, scale[1], exponent[1],
+				0, scale[2], exponent[2]);
+		}
+
+		return 0;
+	}
+
+	/* Fill the ramps of all displays before setting any of them,
+	   so that the displays change as close together as possible. */
+	for (int i = 0; i < state->display_count; i++) {
+		quartz_fill_display(state, i, setting);
+	}
+
 	for (int i = 0; i < state->display_count; i++) {
-		quartz_set_temperature_for_display(
-			state, i, setting, preserve);
+		uint32_t ramp_size = state->displays[i].ramp_size;
+		float *gamma_ramps = state->displays[i].ramps;
+		CGSetDisplayTransferByTable(state->displays[i].display,
+					    ramp_size,
+					    &gamma_ramps[0*ramp_size],
+					    &gamma_ramps[1*ramp_size],
+					    &gamma_ramps[2*ramp_size]);
 	}
 
 	return 0;
 }
 
-
 const gamma_method_t quartz_gamma_method = {
 	"quartz", 1,
 	(gamma_method_init_func *)quartz_init,
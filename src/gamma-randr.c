@@ -36,6 +36,9 @@
 
 #include <xcb/xcb.h>
 #include <xcb/randr.h>
+#ifdef HAVE_XCB_PRESENT
+# include <xcb/present.h>
+#endif
 
 #include "gamma-randr.h"
 #include "redshift.h"
@@ -50,9 +53,18 @@ typedef struct {
 	xcb_randr_crtc_t crtc;
 	unsigned int ramp_size;
 	uint16_t *saved_ramps;
+	uint16_t *pure_ramps;
+	uint16_t *ramps;
+	xcb_void_cookie_t cookie;
+	/* Names of outputs shown by the CRTC, each terminated by a
+	   null character. */
+	char *output_names;
+	int output_names_length;
 } randr_crtc_state_t;
 
 typedef struct {
+	/* X display to connect to, or NULL for $DISPLAY. */
+	char *display;
 	xcb_connection_t *conn;
 	xcb_screen_t *screen;
 	int preferred_screen;
@@ -61,6 +73,17 @@ typedef struct {
 	int* crtc_num;
 	unsigned int crtc_count;
 	randr_crtc_state_t *crtcs;
+	int pipeline;
+	int hotplug;
+	/* Save current gamma ramps for restore and preserve. */
+	int save;
+	int event_base;
+#ifdef HAVE_XCB_PRESENT
+	/* Present extension events used to wait for vertical blank. */
+	xcb_special_event_t *present_events;
+	uint32_t present_serial;
+	int vblank_passed;
+#endif
 } randr_state_t;
 
 
@@ -78,18 +101,37 @@ randr_init(randr_state_t **state)
 	s->crtc_num_count = 0;
 	s->crtc_count = 0;
 	s->crtcs = NULL;
+	s->pipeline = 1;
+	s->hotplug = 1;
+	s->save = 1;
+	s->event_base = 0;
+#ifdef HAVE_XCB_PRESENT
+	s->present_events = NULL;
+	s->present_serial = 0;
+	s->vblank_passed = 0;
+#endif
+
+	s->display = NULL;
+	s->conn = NULL;
 
+	return 0;
+}
+
+/* Open connection to the X server and check the RandR version. */
+static int
+randr_connect(randr_state_t *state)
+{
 	xcb_generic_error_t *error;
 
 	/* Open X server connection */
-	s->conn = xcb_connect(NULL, &s->preferred_screen);
+	state->conn = xcb_connect(state->display, &state->preferred_screen);
 
 	/* Query RandR version */
 	xcb_randr_query_version_cookie_t ver_cookie =
-		xcb_randr_query_version(s->conn, RANDR_VERSION_MAJOR,
+		xcb_randr_query_version(state->conn, RANDR_VERSION_MAJOR,
 					RANDR_VERSION_MINOR);
 	xcb_randr_query_version_reply_t *ver_reply =
-		xcb_randr_query_version_reply(s->conn, ver_cookie, &error);
+		xcb_randr_query_version_reply(state->conn, ver_cookie, &error);
 
 	/* TODO What does it mean when both error and ver_reply is NULL?
 	   Apparently, we have to check both to avoid seg faults. */
@@ -97,8 +139,6 @@ randr_init(randr_state_t **state)
 		int ec = (error != 0) ? error->error_code : -1;
 		fprintf(stderr, _("`%s' returned error %d\n"),
 			"RANDR Query Version", ec);
-		xcb_disconnect(s->conn);
-		free(s);
 		return -1;
 	}
 
@@ -107,8 +147,6 @@ randr_init(randr_state_t **state)
 		fprintf(stderr, _("Unsupported RANDR version (%u.%u)\n"),
 			ver_reply->major_version, ver_reply->minor_version);
 		free(ver_reply);
-		xcb_disconnect(s->conn);
-		free(s);
 		return -1;
 	}
 
@@ -117,11 +155,189 @@ randr_init(randr_state_t **state)
 	return 0;
 }
 
+/* Save size and current gamma ramps of CRTC and allocate ramps. */
+static int
+randr_start_crtc(randr_state_t *state, randr_crtc_state_t *crtc_state)
+{
+	xcb_generic_error_t *error;
+	xcb_randr_crtc_t crtc = crtc_state->crtc;
+
+	/* Request size of gamma ramps */
+	xcb_randr_get_crtc_gamma_size_cookie_t gamma_size_cookie =
+		xcb_randr_get_crtc_gamma_size(state->conn, crtc);
+	xcb_randr_get_crtc_gamma_size_reply_t *gamma_size_reply =
+		xcb_randr_get_crtc_gamma_size_reply(state->conn,
+						    gamma_size_cookie,
+						    &error);
+
+	if (error) {
+		fprintf(stderr, _("`%s' returned error %d\n"),
+			"RANDR Get CRTC Gamma Size",
+			error->error_code);
+		free(error);
+		return -1;
+	}
+
+	unsigned int ramp_size = gamma_size_reply->size;
+
+	free(gamma_size_reply);
+
+	if (ramp_size == 0) {
+		fprintf(stderr, _("Gamma ramp size too small: %i\n"),
+			ramp_size);
+		return -1;
+	}
+
+	/* Allocate space for saved gamma ramps, and working and pure
+	   state gamma ramps so setting the temperature does not need to
+	   allocate. */
+	crtc_state->saved_ramps = malloc(3*ramp_size*sizeof(uint16_t));
+	crtc_state->ramps = malloc(3*ramp_size*sizeof(uint16_t));
+	crtc_state->pure_ramps = malloc(3*ramp_size*sizeof(uint16_t));
+	if (crtc_state->saved_ramps == NULL ||
+	    crtc_state->ramps == NULL ||
+	    crtc_state->pure_ramps == NULL) {
+		perror("malloc");
+		return -1;
+	}
+
+	crtc_state->ramp_size = ramp_size;
+
+	for (int j = 0; j < ramp_size; j++) {
+		uint16_t value = (double)j/ramp_size * (UINT16_MAX+1);
+		crtc_state->pure_ramps[0*ramp_size+j] = value;
+		crtc_state->pure_ramps[1*ramp_size+j] = value;
+		crtc_state->pure_ramps[2*ramp_size+j] = value;
+	}
+
+	/* Without restore the current ramps are not needed, which saves
+	   a round trip to the server. */
+	if (!state->save) {
+		memcpy(crtc_state->saved_ramps, crtc_state->pure_ramps,
+		       3*ramp_size*sizeof(uint16_t));
+		return 0;
+	}
+
+	/* Request current gamma ramps */
+	xcb_randr_get_crtc_gamma_cookie_t gamma_get_cookie =
+		xcb_randr_get_crtc_gamma(state->conn, crtc);
+	xcb_randr_get_crtc_gamma_reply_t *gamma_get_reply =
+		xcb_randr_get_crtc_gamma_reply(state->conn,
+					       gamma_get_cookie,
+					       &error);
+
+	if (error) {
+		fprintf(stderr, _("`%s' returned error %d\n"),
+			"RANDR Get CRTC Gamma", error->error_code);
+		free(error);
+		return -1;
+	}
+
+	uint16_t *gamma_r =
+		xcb_randr_get_crtc_gamma_red(gamma_get_reply);
+	uint16_t *gamma_g =
+		xcb_randr_get_crtc_gamma_green(gamma_get_reply);
+	uint16_t *gamma_b =
+		xcb_randr_get_crtc_gamma_blue(gamma_get_reply);
+
+	/* Copy gamma ramps into CRTC state */
+	memcpy(&crtc_state->saved_ramps[0*ramp_size], gamma_r,
+	       ramp_size*sizeof(uint16_t));
+	memcpy(&crtc_state->saved_ramps[1*ramp_size], gamma_g,
+	       ramp_size*sizeof(uint16_t));
+	memcpy(&crtc_state->saved_ramps[2*ramp_size], gamma_b,
+	       ramp_size*sizeof(uint16_t));
+
+	free(gamma_get_reply);
+
+	return 0;
+}
+
+/* Store the names of the outputs shown by each CRTC. */
+static int
+randr_update_output_names(
+	randr_state_t *state,
+	const xcb_randr_get_screen_resources_current_reply_t *res_reply)
+{
+	xcb_generic_error_t *error;
+
+	int output_count = res_reply->num_outputs;
+	xcb_randr_output_t *outputs =
+		xcb_randr_get_screen_resources_current_outputs(res_reply);
+
+	for (int i = 0; i < state->crtc_count; i++) {
+		free(state->crtcs[i].output_names);
+		state->crtcs[i].output_names = NULL;
+		state->crtcs[i].output_names_length = 0;
+	}
+
+	/* Send all requests before waiting for the replies. */
+	xcb_randr_get_output_info_cookie_t *cookies =
+		malloc(output_count*sizeof(xcb_randr_get_output_info_cookie_t));
+	if (cookies == NULL && output_count > 0) {
+		perror("malloc");
+		return -1;
+	}
+
+	for (int i = 0; i < output_count; i++) {
+		cookies[i] = xcb_randr_get_output_info(
+			state->conn, outputs[i], res_reply->config_timestamp);
+	}
+
+	for (int i = 0; i < output_count; i++) {
+		xcb_randr_get_output_info_reply_t *reply =
+			xcb_randr_get_output_info_reply(
+				state->conn, cookies[i], &error);
+		if (error) {
+			free(error);
+			continue;
+		}
+
+		randr_crtc_state_t *crtc = NULL;
+		for (int j = 0; j < state->crtc_count; j++) {
+			if (reply->crtc != XCB_NONE &&
+			    state->crtcs[j].crtc == reply->crtc) {
+				crtc = &state->crtcs[j];
+				break;
+			}
+		}
+
+		if (crtc != NULL) {
+			int length =
+				xcb_randr_get_output_info_name_length(reply);
+			char *names = realloc(
+				crtc->output_names,
+				crtc->output_names_length + length + 1);
+			if (names == NULL) {
+				perror("realloc");
+				free(reply);
+				free(cookies);
+				return -1;
+			}
+
+			memcpy(&names[crtc->output_names_length],
+			       xcb_randr_get_output_info_name(reply), length);
+			names[crtc->output_names_length + length] = '\0';
+			crtc->output_names = names;
+			crtc->output_names_length += length + 1;
+		}
+
+		free(reply);
+	}
+
+	free(cookies);
+
+	return 0;
+}
+
 static int
 randr_start(randr_state_t *state)
 {
 	xcb_generic_error_t *error;
 
+	int r = randr_connect(state);
+	if (r < 0) return -1;
+
 	int screen_num = state->screen_num;
 	if (screen_num < 0) screen_num = state->preferred_screen;
 
@@ -176,84 +392,179 @@ randr_start(randr_state_t *state)
 		state->crtcs[i].crtc = crtcs[i];
 	}
 
+	r = randr_update_output_names(state, res_reply);
 	free(res_reply);
+	if (r < 0) return -1;
 
 	/* Save size and gamma ramps of all CRTCs.
 	   Current gamma ramps are saved so we can restore them
 	   at program exit. */
 	for (int i = 0; i < state->crtc_count; i++) {
-		xcb_randr_crtc_t crtc = state->crtcs[i].crtc;
+		r = randr_start_crtc(state, &state->crtcs[i]);
+		if (r < 0) return -1;
+	}
 
-		/* Request size of gamma ramps */
-		xcb_randr_get_crtc_gamma_size_cookie_t gamma_size_cookie =
-			xcb_randr_get_crtc_gamma_size(state->conn, crtc);
-		xcb_randr_get_crtc_gamma_size_reply_t *gamma_size_reply =
-			xcb_randr_get_crtc_gamma_size_reply(state->conn,
-							    gamma_size_cookie,
-							    &error);
+	/* Listen for changes to CRTCs and outputs */
+	if (state->hotplug) {
+		const xcb_query_extension_reply_t *ext =
+			xcb_get_extension_data(state->conn, &xcb_randr_id);
+		state->event_base = ext->first_event;
+
+		xcb_randr_select_input(
+			state->conn, state->screen->root,
+			XCB_RANDR_NOTIFY_MASK_SCREEN_CHANGE |
+			XCB_RANDR_NOTIFY_MASK_CRTC_CHANGE);
+		xcb_flush(state->conn);
+	}
 
-		if (error) {
-			fprintf(stderr, _("`%s' returned error %d\n"),
-				"RANDR Get CRTC Gamma Size",
-				error->error_code);
-			return -1;
-		}
+	return 0;
+}
 
-		unsigned int ramp_size = gamma_size_reply->size;
-		state->crtcs[i].ramp_size = ramp_size;
+/* Free storage of CRTC state. */
+static void
+randr_free_crtc(randr_crtc_state_t *crtc)
+{
+	free(crtc->saved_ramps);
+	free(crtc->pure_ramps);
+	free(crtc->ramps);
+	free(crtc->output_names);
+	crtc->saved_ramps = NULL;
+	crtc->pure_ramps = NULL;
+	crtc->ramps = NULL;
+	crtc->output_names = NULL;
+	crtc->output_names_length = 0;
+	crtc->ramp_size = 0;
+}
 
-		free(gamma_size_reply);
+/* Update list of CRTCs after the screen configuration changed. State of
+   CRTCs that still exist is kept, and the current gamma ramps of new
+   CRTCs are saved. */
+static int
+randr_update_crtcs(randr_state_t *state)
+{
+	xcb_generic_error_t *error;
 
-		if (ramp_size == 0) {
-			fprintf(stderr, _("Gamma ramp size too small: %i\n"),
-				ramp_size);
-			return -1;
-		}
+	xcb_randr_get_screen_resources_current_cookie_t res_cookie =
+		xcb_randr_get_screen_resources_current(state->conn,
+						       state->screen->root);
+	xcb_randr_get_screen_resources_current_reply_t *res_reply =
+		xcb_randr_get_screen_resources_current_reply(state->conn,
+							     res_cookie,
+							     &error);
 
-		/* Request current gamma ramps */
-		xcb_randr_get_crtc_gamma_cookie_t gamma_get_cookie =
-			xcb_randr_get_crtc_gamma(state->conn, crtc);
-		xcb_randr_get_crtc_gamma_reply_t *gamma_get_reply =
-			xcb_randr_get_crtc_gamma_reply(state->conn,
-						       gamma_get_cookie,
-						       &error);
+	if (error) {
+		fprintf(stderr, _("`%s' returned error %d\n"),
+			"RANDR Get Screen Resources Current",
+			error->error_code);
+		free(error);
+		return -1;
+	}
 
-		if (error) {
-			fprintf(stderr, _("`%s' returned error %d\n"),
-				"RANDR Get CRTC Gamma", error->error_code);
-			return -1;
-		}
+	int crtc_count = res_reply->num_crtcs;
+	xcb_randr_crtc_t *crtc_ids =
+		xcb_randr_get_screen_resources_current_crtcs(res_reply);
 
-		uint16_t *gamma_r =
-			xcb_randr_get_crtc_gamma_red(gamma_get_reply);
-		uint16_t *gamma_g =
-			xcb_randr_get_crtc_gamma_green(gamma_get_reply);
-		uint16_t *gamma_b =
-			xcb_randr_get_crtc_gamma_blue(gamma_get_reply);
-
-		/* Allocate space for saved gamma ramps */
-		state->crtcs[i].saved_ramps =
-			malloc(3*ramp_size*sizeof(uint16_t));
-		if (state->crtcs[i].saved_ramps == NULL) {
-			perror("malloc");
-			free(gamma_get_reply);
-			return -1;
+	randr_crtc_state_t *crtcs = calloc(crtc_count,
+					   sizeof(randr_crtc_state_t));
+	if (crtcs == NULL) {
+		perror("malloc");
+		free(res_reply);
+		return -1;
+	}
+
+	for (int i = 0; i < crtc_count; i++) {
+		/* Move state of known CRTC */
+		int found = 0;
+		for (int j = 0; j < state->crtc_count; j++) {
+			if (state->crtcs[j].crtc == crtc_ids[i] &&
+			    state->crtcs[j].saved_ramps != NULL) {
+				crtcs[i] = state->crtcs[j];
+				memset(&state->crtcs[j], 0,
+				       sizeof(randr_crtc_state_t));
+				found = 1;
+				break;
+			}
 		}
 
-		/* Copy gamma ramps into CRTC state */
-		memcpy(&state->crtcs[i].saved_ramps[0*ramp_size], gamma_r,
-		       ramp_size*sizeof(uint16_t));
-		memcpy(&state->crtcs[i].saved_ramps[1*ramp_size], gamma_g,
-		       ramp_size*sizeof(uint16_t));
-		memcpy(&state->crtcs[i].saved_ramps[2*ramp_size], gamma_b,
-		       ramp_size*sizeof(uint16_t));
+		if (!found) {
+			/* A CRTC that fails to start is left with zero
+			   ramp size and skipped. */
+			crtcs[i].crtc = crtc_ids[i];
+			int r = randr_start_crtc(state, &crtcs[i]);
+			if (r < 0) {
+				fprintf(stderr, _("Unable to adjust new"
+						  " CRTC %i.\n"), i);
+				randr_free_crtc(&crtcs[i]);
+			}
+		}
+	}
 
-		free(gamma_get_reply);
+	/* Free state of CRTCs that are gone */
+	for (int j = 0; j < state->crtc_count; j++) {
+		randr_free_crtc(&state->crtcs[j]);
 	}
+	free(state->crtcs);
+
+	state->crtcs = crtcs;
+	state->crtc_count = crtc_count;
+
+	/* Outputs may have moved between CRTCs that were kept. */
+	int r = randr_update_output_names(state, res_reply);
+	free(res_reply);
+	if (r < 0) return -1;
 
 	return 0;
 }
 
+/* Handle RandR events. Events are read from the connection if READ is
+   non-zero, otherwise only events already queued are handled. Returns
+   1 if the CRTCs changed, 0 if not, or -1 on error. */
+static int
+randr_process_events(randr_state_t *state, int read)
+{
+	int changed = 0;
+
+	while (1) {
+		xcb_generic_event_t *event = read ?
+			xcb_poll_for_event(state->conn) :
+			xcb_poll_for_queued_event(state->conn);
+		if (event == NULL) break;
+
+		int type = event->response_type & ~0x80;
+		if (type == state->event_base +
+		    XCB_RANDR_SCREEN_CHANGE_NOTIFY ||
+		    type == state->event_base + XCB_RANDR_NOTIFY) {
+			changed = 1;
+		}
+		free(event);
+	}
+
+	if (xcb_connection_has_error(state->conn)) {
+		fputs(_("Connection to X server lost.\n"), stderr);
+		return -1;
+	}
+
+	if (!changed) return 0;
+
+	int r = randr_update_crtcs(state);
+	if (r < 0) return -1;
+
+	return 1;
+}
+
+static int
+randr_get_fd(randr_state_t *state)
+{
+	if (!state->hotplug) return -1;
+	return xcb_get_file_descriptor(state->conn);
+}
+
+static int
+randr_handle(randr_state_t *state)
+{
+	return randr_process_events(state, 1);
+}
+
 static void
 randr_restore(randr_state_t *state)
 {
@@ -264,37 +575,66 @@ randr_restore(randr_state_t *state)
 		xcb_randr_crtc_t crtc = state->crtcs[i].crtc;
 
 		unsigned int ramp_size = state->crtcs[i].ramp_size;
+		if (ramp_size == 0) {
+			state->crtcs[i].cookie.sequence = 0;
+			continue;
+		}
+
 		uint16_t *gamma_r = &state->crtcs[i].saved_ramps[0*ramp_size];
 		uint16_t *gamma_g = &state->crtcs[i].saved_ramps[1*ramp_size];
 		uint16_t *gamma_b = &state->crtcs[i].saved_ramps[2*ramp_size];
 
 		/* Set gamma ramps */
-		xcb_void_cookie_t gamma_set_cookie =
+		state->crtcs[i].cookie =
 			xcb_randr_set_crtc_gamma_checked(state->conn, crtc,
 							 ramp_size, gamma_r,
 							 gamma_g, gamma_b);
-		error = xcb_request_check(state->conn, gamma_set_cookie);
+	}
 
+	/* Check results. The first check waits for a reply that
+	   covers all preceding requests. */
+	for (int i = 0; i < state->crtc_count; i++) {
+		if (state->crtcs[i].cookie.sequence == 0) continue;
+		error = xcb_request_check(state->conn,
+					  state->crtcs[i].cookie);
 		if (error) {
 			fprintf(stderr, _("`%s' returned error %d\n"),
 				"RANDR Set CRTC Gamma", error->error_code);
 			fprintf(stderr, _("Unable to restore CRTC %i\n"), i);
+			free(error);
 		}
 	}
 }
 
+/* Called before start when restore will not be used. */
+static void
+randr_skip_save(randr_state_t *state)
+{
+	state->save = 0;
+	/* Output changes are never handled either. */
+	state->hotplug = 0;
+}
+
 static void
 randr_free(randr_state_t *state)
 {
 	/* Free CRTC state */
 	for (int i = 0; i < state->crtc_count; i++) {
-		free(state->crtcs[i].saved_ramps);
+		randr_free_crtc(&state->crtcs[i]);
 	}
 	free(state->crtcs);
 	free(state->crtc_num);
 
+#ifdef HAVE_XCB_PRESENT
+	if (state->present_events != NULL) {
+		xcb_unregister_for_special_event(state->conn,
+						 state->present_events);
+	}
+#endif
+
 	/* Close connection */
-	xcb_disconnect(state->conn);
+	if (state->conn != NULL) xcb_disconnect(state->conn);
+	free(state->display);
 
 	free(state);
 }
@@ -307,9 +647,15 @@ randr_print_help(FILE *f)
 
 	/* TRANSLATORS: RANDR help output
 	   left column must not be translated */
-	fputs(_("  screen=N\t\tX screen to apply adjustments to\n"
+	fputs(_("  display=NAME\tX display to connect to, a number N"
+		" for :N (default $DISPLAY)\n"
+		"  screen=N\t\tX screen to apply adjustments to\n"
 		"  crtc=N\tList of comma separated CRTCs to apply"
-		" adjustments to\n"),
+		" adjustments to\n"
+		"  pipeline=0|1\tSend requests for all CRTCs before"
+		" waiting for the server (default 1)\n"
+		"  hotplug=0|1\tFollow CRTCs being added or removed"
+		" (default 1)\n"),
 	      f);
 	fputs("\n", f);
 }
@@ -317,7 +663,18 @@ randr_print_help(FILE *f)
 static int
 randr_set_option(randr_state_t *state, const char *key, const char *value)
 {
-	if (strcasecmp(key, "screen") == 0) {
+	if (strcasecmp(key, "display") == 0) {
+		/* A colon can not be given in command line options. */
+		size_t length = strlen(value) + 2;
+		free(state->display);
+		state->display = malloc(length);
+		if (state->display == NULL) {
+			perror("malloc");
+			return -1;
+		}
+		snprintf(state->display, length,
+			 strchr(value, ':') == NULL ? ":%s" : "%s", value);
+	} else if (strcasecmp(key, "screen") == 0) {
 		state->screen_num = atoi(value);
 	} else if (strcasecmp(key, "crtc") == 0) {
 		char *tail;
@@ -364,6 +721,10 @@ randr_set_option(randr_state_t *state, const char *key, const char *value)
 				break;
 			}
 		}
+	} else if (strcasecmp(key, "pipeline") == 0) {
+		state->pipeline = atoi(value);
+	} else if (strcasecmp(key, "hotplug") == 0) {
+		state->hotplug = atoi(value);
 	} else if (strcasecmp(key, "preserve") == 0) {
 		fprintf(stderr, _("Parameter `%s` is now always on; "
 				  " Use the `%s` command-line option"
@@ -377,13 +738,13 @@ randr_set_option(randr_state_t *state, const char *key, const char *value)
 	return 0;
 }
 
+/* Fill gamma ramps for CRTC and send a request to set them. The
+   request cookie is stored in the CRTC state. */
 static int
-randr_set_temperature_for_crtc(
+randr_send_temperature_for_crtc(
 	randr_state_t *state, int crtc_num, const color_setting_t *setting,
 	int preserve)
 {
-	xcb_generic_error_t *error;
-
 	if (crtc_num >= state->crtc_count || crtc_num < 0) {
 		fprintf(stderr, _("CRTC %d does not exist. "),
 			crtc_num);
@@ -400,78 +761,258 @@ randr_set_temperature_for_crtc(
 	xcb_randr_crtc_t crtc = state->crtcs[crtc_num].crtc;
 	unsigned int ramp_size = state->crtcs[crtc_num].ramp_size;
 
-	/* Create new gamma ramps */
-	uint16_t *gamma_ramps = malloc(3*ramp_size*sizeof(uint16_t));
-	if (gamma_ramps == NULL) {
-		perror("malloc");
-		return -1;
+	/* Skip CRTC that could not be started after a change */
+	if (ramp_size == 0) {
+		state->crtcs[crtc_num].cookie.sequence = 0;
+		return 0;
 	}
 
+	uint16_t *gamma_ramps = state->crtcs[crtc_num].ramps;
 	uint16_t *gamma_r = &gamma_ramps[0*ramp_size];
 	uint16_t *gamma_g = &gamma_ramps[1*ramp_size];
 	uint16_t *gamma_b = &gamma_ramps[2*ramp_size];
 
-	if (preserve) {
-		/* Initialize gamma ramps from saved state */
-		memcpy(gamma_ramps, state->crtcs[crtc_num].saved_ramps,
-		       3*ramp_size*sizeof(uint16_t));
-	} else {
-		/* Initialize gamma ramps to pure state */
-		for (int i = 0; i < ramp_size; i++) {
-			uint16_t value = (double)i/ramp_size * (UINT16_MAX+1);
-			gamma_r[i] = value;
-			gamma_g[i] = value;
-			gamma_b[i] = value;
-		}
-	}
+	/* Initialize gamma ramps from saved or pure state */
+	memcpy(gamma_ramps, preserve ? state->crtcs[crtc_num].saved_ramps :
+	       state->crtcs[crtc_num].pure_ramps,
+	       3*ramp_size*sizeof(uint16_t));
 
 	colorramp_fill(gamma_r, gamma_g, gamma_b, ramp_size,
 		       setting);
 
 	/* Set new gamma ramps */
-	xcb_void_cookie_t gamma_set_cookie =
+	state->crtcs[crtc_num].cookie =
 		xcb_randr_set_crtc_gamma_checked(state->conn, crtc,
 						 ramp_size, gamma_r,
 						 gamma_g, gamma_b);
-	error = xcb_request_check(state->conn, gamma_set_cookie);
+
+	return 0;
+}
+
+/* Wait for the result of the last request sent for CRTC. */
+static int
+randr_check_temperature_for_crtc(randr_state_t *state, int crtc_num)
+{
+	if (state->crtcs[crtc_num].cookie.sequence == 0) return 0;
+
+	xcb_generic_error_t *error =
+		xcb_request_check(state->conn, state->crtcs[crtc_num].cookie);
 
 	if (error) {
 		fprintf(stderr, _("`%s' returned error %d\n"),
 			"RANDR Set CRTC Gamma", error->error_code);
-		free(gamma_ramps);
+		free(error);
 		return -1;
 	}
 
-	free(gamma_ramps);
-
 	return 0;
 }
 
+/* Return the setting for the first of OUTPUTS shown by CRTC, or
+   SETTING if none of them is. */
+static const color_setting_t *
+randr_setting_for_crtc(
+	const randr_crtc_state_t *crtc, const color_setting_t *setting,
+	const gamma_output_setting_t *outputs, int count)
+{
+	for (int i = 0; i < count; i++) {
+		int offset = 0;
+		while (offset < crtc->output_names_length) {
+			const char *name = &crtc->output_names[offset];
+			if (strcmp(name, outputs[i].name) == 0) {
+				return &outputs[i].setting;
+			}
+			offset += strlen(name) + 1;
+		}
+	}
+
+	return setting;
+}
+
 static int
-randr_set_temperature(
-	randr_state_t *state, const color_setting_t *setting, int preserve)
+randr_set_temperature_for_crtcs(
+	randr_state_t *state, const color_setting_t *setting,
+	const gamma_output_setting_t *outputs, int output_count,
+	int preserve)
 {
 	int r;
 
 	/* If no CRTC numbers have been specified,
 	   set temperature on all CRTCs. */
-	if (state->crtc_num_count == 0) {
-		for (int i = 0; i < state->crtc_count; i++) {
-			r = randr_set_temperature_for_crtc(
-				state, i, setting, preserve);
+	int count = state->crtc_num_count;
+	if (count == 0) count = state->crtc_count;
+
+	if (!state->pipeline) {
+		for (int i = 0; i < count; i++) {
+			int crtc_num = state->crtc_num_count == 0 ?
+				i : state->crtc_num[i];
+			const color_setting_t *s = setting;
+			if (crtc_num >= 0 && crtc_num < state->crtc_count) {
+				s = randr_setting_for_crtc(
+					&state->crtcs[crtc_num], setting,
+					outputs, output_count);
+			}
+			r = randr_send_temperature_for_crtc(
+				state, crtc_num, s, preserve);
 			if (r < 0) return -1;
-		}
-	} else {
-		for (int i = 0; i < state->crtc_num_count; ++i) {
-			r = randr_set_temperature_for_crtc(
-				state, state->crtc_num[i], setting, preserve);
+			r = randr_check_temperature_for_crtc(state, crtc_num);
 			if (r < 0) return -1;
 		}
+
+		return 0;
+	}
+
+	/* Send requests for all CRTCs first and then check the
+	   results. Checking the first request waits for a single
+	   round trip that covers all of them. */
+	int sent = 0;
+	int error = 0;
+	for (; sent < count; sent++) {
+		int crtc_num = state->crtc_num_count == 0 ?
+			sent : state->crtc_num[sent];
+		const color_setting_t *s = setting;
+		if (crtc_num >= 0 && crtc_num < state->crtc_count) {
+			s = randr_setting_for_crtc(
+				&state->crtcs[crtc_num], setting,
+				outputs, output_count);
+		}
+		r = randr_send_temperature_for_crtc(
+			state, crtc_num, s, preserve);
+		if (r < 0) {
+			error = 1;
+			break;
+		}
+	}
+
+	for (int i = 0; i < sent; i++) {
+		int crtc_num = state->crtc_num_count == 0 ?
+			i : state->crtc_num[i];
+		r = randr_check_temperature_for_crtc(state, crtc_num);
+		if (r < 0) error = 1;
+	}
+
+	return error ? -1 : 0;
+}
+
+/* Set SETTING on all CRTCs, except those showing one of OUTPUTS,
+   which get the setting of that output. */
+static int
+randr_set_output_temperatures(
+	randr_state_t *state, const color_setting_t *setting,
+	const gamma_output_setting_t *outputs, int count, int preserve)
+{
+	/* Events may have been queued by xcb while waiting for
+	   replies. Apply CRTC changes they announce before setting
+	   and set again if more arrived in the meantime. */
+	for (int i = 0; i < 3; i++) {
+		int r = randr_process_events(state, 0);
+		if (r < 0) return -1;
+		if (i > 0 && r == 0) break;
+
+		r = randr_set_temperature_for_crtcs(
+			state, setting, outputs, count, preserve);
+		if (r < 0) return -1;
 	}
 
 	return 0;
 }
 
+static int
+randr_set_temperature(
+	randr_state_t *state, const color_setting_t *setting, int preserve)
+{
+	return randr_set_output_temperatures(
+		state, setting, NULL, 0, preserve);
+}
+
+#ifdef HAVE_XCB_PRESENT
+/* Select Present events on the root window. */
+static int
+randr_start_present(randr_state_t *state)
+{
+	xcb_generic_error_t *error;
+
+	xcb_present_query_version_cookie_t ver_cookie =
+		xcb_present_query_version(state->conn, 1, 0);
+	xcb_present_query_version_reply_t *ver_reply =
+		xcb_present_query_version_reply(state->conn, ver_cookie,
+						&error);
+	if (error) {
+		fprintf(stderr, _("`%s' returned error %d\n"),
+			"Present Query Version", error->error_code);
+		free(error);
+		return -1;
+	}
+	free(ver_reply);
+
+	uint32_t eid = xcb_generate_id(state->conn);
+	xcb_void_cookie_t select_cookie =
+		xcb_present_select_input_checked(
+			state->conn, eid, state->screen->root,
+			XCB_PRESENT_EVENT_MASK_COMPLETE_NOTIFY);
+	error = xcb_request_check(state->conn, select_cookie);
+	if (error) {
+		fprintf(stderr, _("`%s' returned error %d\n"),
+			"Present Select Input", error->error_code);
+		free(error);
+		return -1;
+	}
+
+	state->present_events = xcb_register_for_special_xge(
+		state->conn, &xcb_present_id, eid, NULL);
+	if (state->present_events == NULL) return -1;
+
+	return 0;
+}
+
+/* Ask for a Present MSC notification at the next vertical blank. */
+static int
+randr_request_vblank(randr_state_t *state)
+{
+	if (state->present_events == NULL) {
+		int r = randr_start_present(state);
+		if (r < 0) return -1;
+	}
+
+	state->present_serial += 1;
+	state->vblank_passed = 0;
+	xcb_present_notify_msc(state->conn, state->screen->root,
+			       state->present_serial, 0, 1, 0);
+	xcb_flush(state->conn);
+
+	return xcb_get_file_descriptor(state->conn);
+}
+
+/* Check for the notification without blocking. Notifications of
+   earlier requests that timed out are ignored. */
+static int
+randr_handle_vblank(randr_state_t *state)
+{
+	while (!state->vblank_passed) {
+		xcb_generic_event_t *event = xcb_poll_for_special_event(
+			state->conn, state->present_events);
+		if (event == NULL) {
+			if (xcb_connection_has_error(state->conn)) {
+				fputs(_("Connection to X server"
+					" lost.\n"), stderr);
+				return -1;
+			}
+			break;
+		}
+
+		xcb_present_complete_notify_event_t *notify =
+			(xcb_present_complete_notify_event_t *)event;
+		if (notify->event_type == XCB_PRESENT_COMPLETE_NOTIFY &&
+		    notify->serial == state->present_serial) {
+			state->vblank_passed = 1;
+		}
+		free(event);
+	}
+
+	return state->vblank_passed;
+}
+#endif /* HAVE_XCB_PRESENT */
+
 
 const gamma_method_t randr_gamma_method = {
 	"randr", 1,
@@ -481,5 +1022,17 @@ const gamma_method_t randr_gamma_method = {
 	(gamma_method_print_help_func *)randr_print_help,
 	(gamma_method_set_option_func *)randr_set_option,
 	(gamma_method_restore_func *)randr_restore,
-	(gamma_method_set_temperature_func *)randr_set_temperature
+	(gamma_method_set_temperature_func *)randr_set_temperature,
+#ifdef HAVE_XCB_PRESENT
+	(gamma_method_request_vblank_func *)randr_request_vblank,
+	(gamma_method_handle_vblank_func *)randr_handle_vblank,
+#else
+	NULL,
+	NULL,
+#endif
+	(gamma_method_get_fd_func *)randr_get_fd,
+	(gamma_method_handle_func *)randr_handle,
+	(gamma_method_set_output_temperatures_func *)
+	randr_set_output_temperatures,
+	(gamma_method_skip_save_func *)randr_skip_save
 };
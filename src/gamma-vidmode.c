@@ -45,7 +45,11 @@ typedef struct {
 	Display *display;
 	int screen_num;
 	int ramp_size;
+	/* Save current gamma ramps for restore and preserve. */
+	int save;
 	uint16_t *saved_ramps;
+	uint16_t *pure_ramps;
+	uint16_t *ramps;
 } vidmode_state_t;
 
 
@@ -57,7 +61,13 @@ vidmode_init(vidmode_state_t **state)
 
 	vidmode_state_t *s = *state;
 	s->screen_num = -1;
+	s->save = 1;
 	s->saved_ramps = NULL;
+	s->pure_ramps = NULL;
+	s->ramps = NULL;
+
+	/* Other methods may be probed in threads at the same time. */
+	XInitThreads();
 
 	/* Open display */
 	s->display = XOpenDisplay(NULL);
@@ -114,23 +124,55 @@ vidmode_start(vidmode_state_t *state)
 	uint16_t *gamma_b = &state->saved_ramps[2*state->ramp_size];
 
 	/* Save current gamma ramps so we can restore them at program exit. */
-	r = XF86VidModeGetGammaRamp(state->display, state->screen_num,
-				    state->ramp_size, gamma_r, gamma_g,
-				    gamma_b);
-	if (!r) {
-		fprintf(stderr, _("X request failed: %s\n"),
-			"XF86VidModeGetGammaRamp");
+	if (state->save) {
+		r = XF86VidModeGetGammaRamp(state->display, state->screen_num,
+					    state->ramp_size, gamma_r, gamma_g,
+					    gamma_b);
+		if (!r) {
+			fprintf(stderr, _("X request failed: %s\n"),
+				"XF86VidModeGetGammaRamp");
+			return -1;
+		}
+	}
+
+	/* Allocate working and pure state gamma ramps so
+	   setting the temperature does not need to allocate. */
+	state->ramps = malloc(3*state->ramp_size*sizeof(uint16_t));
+	state->pure_ramps = malloc(3*state->ramp_size*sizeof(uint16_t));
+	if (state->ramps == NULL || state->pure_ramps == NULL) {
+		perror("malloc");
 		return -1;
 	}
 
+	for (int i = 0; i < state->ramp_size; i++) {
+		uint16_t value = (double)i/state->ramp_size * (UINT16_MAX+1);
+		state->pure_ramps[0*state->ramp_size+i] = value;
+		state->pure_ramps[1*state->ramp_size+i] = value;
+		state->pure_ramps[2*state->ramp_size+i] = value;
+	}
+
+	if (!state->save) {
+		memcpy(state->saved_ramps, state->pure_ramps,
+		       3*state->ramp_size*sizeof(uint16_t));
+	}
+
 	return 0;
 }
 
+/* Called before start when restore will not be used. */
+static void
+vidmode_skip_save(vidmode_state_t *state)
+{
+	state->save = 0;
+}
+
 static void
 vidmode_free(vidmode_state_t *state)
 {
 	/* Free saved ramps */
 	free(state->saved_ramps);
+	free(state->pure_ramps);
+	free(state->ramps);
 
 	/* Close display connection */
 	XCloseDisplay(state->display);
@@ -192,31 +234,14 @@ vidmode_set_temperature(
 {
 	int r;
 
-	/* Create new gamma ramps */
-	uint16_t *gamma_ramps = malloc(3*state->ramp_size*sizeof(uint16_t));
-	if (gamma_ramps == NULL) {
-		perror("malloc");
-		return -1;
-	}
-
+	uint16_t *gamma_ramps = state->ramps;
 	uint16_t *gamma_r = &gamma_ramps[0*state->ramp_size];
 	uint16_t *gamma_g = &gamma_ramps[1*state->ramp_size];
 	uint16_t *gamma_b = &gamma_ramps[2*state->ramp_size];
 
-	if (preserve) {
-		/* Initialize gamma ramps from saved state */
-		memcpy(gamma_ramps, state->saved_ramps,
-		       3*state->ramp_size*sizeof(uint16_t));
-	} else {
-		/* Initialize gamma ramps to pure state */
-		for (int i = 0; i < state->ramp_size; i++) {
-			uint16_t value = (double)i/state->ramp_size *
-				(UINT16_MAX+1);
-			gamma_r[i] = value;
-			gamma_g[i] = value;
-			gamma_b[i] = value;
-		}
-	}
+	/* Initialize gamma ramps from saved or pure state */
+	memcpy(gamma_ramps, preserve ? state->saved_ramps : state->pure_ramps,
+	       3*state->ramp_size*sizeof(uint16_t));
 
 	colorramp_fill(gamma_r, gamma_g, gamma_b, state->ramp_size,
 		       setting);
@@ -228,12 +253,9 @@ vidmode_set_temperature(
 	if (!r) {
 		fprintf(stderr, _("X request failed: %s\n"),
 			"XF86VidModeSetGammaRamp");
-		free(gamma_ramps);
 		return -1;
 	}
 
-	free(gamma_ramps);
-
 	return 0;
 }
 
@@ -246,5 +268,11 @@ const gamma_method_t vidmode_gamma_method = {
 	(gamma_method_print_help_func *)vidmode_print_help,
 	(gamma_method_set_option_func *)vidmode_set_option,
 	(gamma_method_restore_func *)vidmode_restore,
-	(gamma_method_set_temperature_func *)vidmode_set_temperature
+	(gamma_method_set_temperature_func *)vidmode_set_temperature,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	(gamma_method_skip_save_func *)vidmode_skip_save
 };
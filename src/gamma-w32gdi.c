@@ -23,6 +23,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifndef WINVER
 # define WINVER  0x0500
@@ -43,62 +44,205 @@
 #define GAMMA_RAMP_SIZE  256
 #define MAX_ATTEMPTS  10
 
+/* Most monitors that are adjusted. */
+#define MAX_MONITORS  16
+
+#define WINDOW_CLASS_NAME  "redshift-w32gdi"
+
+
+typedef struct {
+	/* Device name, such as \\.\DISPLAY1. */
+	char device[CCHDEVICENAME];
+	/* Device context kept open while the monitor is attached. */
+	HDC hDC;
+	WORD saved_ramps[3*GAMMA_RAMP_SIZE];
+	/* Ramps last uploaded, and whether they are valid. */
+	WORD applied_ramps[3*GAMMA_RAMP_SIZE];
+	int applied;
+	/* Working ramps, kept here so setting the temperature does not
+	   need to allocate. */
+	WORD ramps[3*GAMMA_RAMP_SIZE];
+} w32gdi_monitor_t;
 
 typedef struct {
-	WORD *saved_ramps;
+	w32gdi_monitor_t monitors[MAX_MONITORS];
+	int monitor_count;
+	WORD pure_ramps[3*GAMMA_RAMP_SIZE];
+	/* Hidden window that receives WM_DISPLAYCHANGE. */
+	HWND window;
+	int display_changed;
 } w32gdi_state_t;
 
 
+static LRESULT CALLBACK
+w32gdi_window_proc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam)
+{
+	if (msg == WM_DISPLAYCHANGE) {
+		w32gdi_state_t *state = (w32gdi_state_t *)
+			GetWindowLongPtr(hwnd, GWLP_USERDATA);
+		if (state != NULL) state->display_changed = 1;
+		return 0;
+	}
+
+	return DefWindowProc(hwnd, msg, wparam, lparam);
+}
+
 static int
 w32gdi_init(w32gdi_state_t **state)
 {
 	*state = malloc(sizeof(w32gdi_state_t));
-	if (state == NULL) return -1;
+	if (*state == NULL) return -1;
 
 	w32gdi_state_t *s = *state;
-	s->saved_ramps = NULL;
+	s->monitor_count = 0;
+	s->window = NULL;
+	s->display_changed = 0;
+
+	for (int i = 0; i < GAMMA_RAMP_SIZE; i++) {
+		WORD value = (double)i/GAMMA_RAMP_SIZE * (UINT16_MAX+1);
+		s->pure_ramps[0*GAMMA_RAMP_SIZE+i] = value;
+		s->pure_ramps[1*GAMMA_RAMP_SIZE+i] = value;
+		s->pure_ramps[2*GAMMA_RAMP_SIZE+i] = value;
+	}
 
 	return 0;
 }
 
-static int
-w32gdi_start(w32gdi_state_t *state)
+/* Return the monitor with the given device name in MONITORS, or NULL. */
+static w32gdi_monitor_t *
+w32gdi_find_monitor(w32gdi_monitor_t *monitors, int count,
+		    const char *device)
 {
-	BOOL r;
+	for (int i = 0; i < count; i++) {
+		if (strcmp(monitors[i].device, device) == 0) {
+			return &monitors[i];
+		}
+	}
+
+	return NULL;
+}
+
+typedef struct {
+	w32gdi_state_t *state;
+	/* Monitors that were open before enumeration started. */
+	w32gdi_monitor_t *previous;
+	int previous_count;
+} w32gdi_enum_t;
+
+static BOOL CALLBACK
+w32gdi_enum_monitor(HMONITOR hMonitor, HDC hdc, LPRECT rect, LPARAM data)
+{
+	w32gdi_enum_t *e = (w32gdi_enum_t *)data;
+	w32gdi_state_t *state = e->state;
+
+	if (state->monitor_count >= MAX_MONITORS) return FALSE;
+
+	MONITORINFOEX info;
+	info.cbSize = sizeof(info);
+	if (!GetMonitorInfo(hMonitor, (MONITORINFO *)&info)) return TRUE;
 
-	/* Open device context */
-	HDC hDC = GetDC(NULL);
+	/* Monitors that mirror each other share one device. */
+	if (w32gdi_find_monitor(state->monitors, state->monitor_count,
+				info.szDevice) != NULL) {
+		return TRUE;
+	}
+
+	HDC hDC = CreateDC(NULL, info.szDevice, NULL, NULL);
 	if (hDC == NULL) {
-		fputs(_("Unable to open device context.\n"), stderr);
-		return -1;
+		fprintf(stderr, _("Unable to open device context"
+				  " for `%s'.\n"), info.szDevice);
+		return TRUE;
 	}
 
 	/* Check support for gamma ramps */
 	int cmcap = GetDeviceCaps(hDC, COLORMGMTCAPS);
 	if (cmcap != CM_GAMMA_RAMP) {
-		fputs(_("Display device does not support gamma ramps.\n"),
-		      stderr);
-		return -1;
+		fprintf(stderr, _("Display device `%s' does not support"
+				  " gamma ramps.\n"), info.szDevice);
+		DeleteDC(hDC);
+		return TRUE;
+	}
+
+	w32gdi_monitor_t *monitor = &state->monitors[state->monitor_count];
+	strcpy(monitor->device, info.szDevice);
+	monitor->hDC = hDC;
+	monitor->applied = 0;
+
+	/* Keep the ramps saved when the monitor was first seen, since
+	   the current ramps were set by us. */
+	w32gdi_monitor_t *previous = w32gdi_find_monitor(
+		e->previous, e->previous_count, info.szDevice);
+	if (previous != NULL) {
+		memcpy(monitor->saved_ramps, previous->saved_ramps,
+		       sizeof(monitor->saved_ramps));
+	} else if (!GetDeviceGammaRamp(hDC, monitor->saved_ramps)) {
+		fprintf(stderr, _("Unable to save current gamma ramp"
+				  " for `%s'.\n"), info.szDevice);
+		DeleteDC(hDC);
+		return TRUE;
 	}
 
-	/* Allocate space for saved gamma ramps */
-	state->saved_ramps = malloc(3*GAMMA_RAMP_SIZE*sizeof(WORD));
-	if (state->saved_ramps == NULL) {
+	state->monitor_count += 1;
+	return TRUE;
+}
+
+/* Open device contexts for the attached monitors, replacing the ones
+   that are open. Returns -1 if no monitor supports gamma ramps. */
+static int
+w32gdi_open_monitors(w32gdi_state_t *state)
+{
+	int previous_count = state->monitor_count;
+	w32gdi_monitor_t *previous = malloc(
+		(previous_count + 1)*sizeof(w32gdi_monitor_t));
+	if (previous == NULL) {
 		perror("malloc");
-		ReleaseDC(NULL, hDC);
 		return -1;
 	}
+	memcpy(previous, state->monitors,
+	       previous_count*sizeof(w32gdi_monitor_t));
+
+	w32gdi_enum_t e = { state, previous, previous_count };
+	state->monitor_count = 0;
+	EnumDisplayMonitors(NULL, NULL, w32gdi_enum_monitor, (LPARAM)&e);
+
+	for (int i = 0; i < previous_count; i++) {
+		DeleteDC(previous[i].hDC);
+	}
+	free(previous);
 
-	/* Save current gamma ramps so we can restore them at program exit */
-	r = GetDeviceGammaRamp(hDC, state->saved_ramps);
-	if (!r) {
-		fputs(_("Unable to save current gamma ramp.\n"), stderr);
-		ReleaseDC(NULL, hDC);
+	if (state->monitor_count == 0) {
+		fputs(_("No display device supports gamma ramps.\n"), stderr);
 		return -1;
 	}
 
-	/* Release device context */
-	ReleaseDC(NULL, hDC);
+	return 0;
+}
+
+static int
+w32gdi_start(w32gdi_state_t *state)
+{
+	int r = w32gdi_open_monitors(state);
+	if (r < 0) return -1;
+
+	/* Without the window display changes are not followed, but
+	   the adjustment still works. */
+	HINSTANCE instance = GetModuleHandle(NULL);
+	WNDCLASS wc;
+	memset(&wc, 0, sizeof(wc));
+	wc.lpfnWndProc = w32gdi_window_proc;
+	wc.hInstance = instance;
+	wc.lpszClassName = WINDOW_CLASS_NAME;
+	RegisterClass(&wc);
+
+	/* Message-only windows do not receive broadcasts like
+	   WM_DISPLAYCHANGE, so this is a top-level window that is
+	   never shown. */
+	state->window = CreateWindow(WINDOW_CLASS_NAME, "Redshift", 0,
+				     0, 0, 0, 0, NULL, NULL, instance, NULL);
+	if (state->window != NULL) {
+		SetWindowLongPtr(state->window, GWLP_USERDATA,
+				 (LONG_PTR)state);
+	}
 
 	return 0;
 }
@@ -106,8 +250,12 @@ w32gdi_start(w32gdi_state_t *state)
 static void
 w32gdi_free(w32gdi_state_t *state)
 {
-	/* Free saved ramps */
-	free(state->saved_ramps);
+	if (state->window != NULL) DestroyWindow(state->window);
+
+	/* Close device contexts */
+	for (int i = 0; i < state->monitor_count; i++) {
+		DeleteDC(state->monitors[i].hDC);
+	}
 
 	free(state);
 }
@@ -117,6 +265,8 @@ static void
 w32gdi_print_help(FILE *f)
 {
 	fputs(_("Adjust gamma ramps with the Windows GDI.\n"), f);
+	fputs(_("Outputs are named by their device, such as DISPLAY1.\n"),
+	      f);
 	fputs("\n", f);
 }
 
@@ -136,96 +286,156 @@ w32gdi_set_option(w32gdi_state_t *state, const char *key, const char *value)
 	return 0;
 }
 
-static void
-w32gdi_restore(w32gdi_state_t *state)
+/* Upload RAMPS to MONITOR. */
+static int
+w32gdi_set_ramps(w32gdi_monitor_t *monitor, WORD *ramps)
 {
-	/* Open device context */
-	HDC hDC = GetDC(NULL);
-	if (hDC == NULL) {
-		fputs(_("Unable to open device context.\n"), stderr);
-		return;
-	}
-
-	/* Restore gamma ramps */
 	BOOL r = FALSE;
 	for (int i = 0; i < MAX_ATTEMPTS && !r; i++) {
 		/* We retry a few times before giving up because some
 		   buggy drivers fail on the first invocation of
 		   SetDeviceGammaRamp just to succeed on the second. */
-		r = SetDeviceGammaRamp(hDC, state->saved_ramps);
+		r = SetDeviceGammaRamp(monitor->hDC, ramps);
 	}
-	if (!r) fputs(_("Unable to restore gamma ramps.\n"), stderr);
 
-	/* Release device context */
-	ReleaseDC(NULL, hDC);
+	return r ? 0 : -1;
 }
 
-static int
-w32gdi_set_temperature(
-	w32gdi_state_t *state, const color_setting_t *setting, int preserve)
+static void
+w32gdi_restore(w32gdi_state_t *state)
 {
-	BOOL r;
+	/* Restore gamma ramps */
+	for (int i = 0; i < state->monitor_count; i++) {
+		w32gdi_monitor_t *monitor = &state->monitors[i];
+		int r = w32gdi_set_ramps(monitor, monitor->saved_ramps);
+		if (r < 0) {
+			fprintf(stderr, _("Unable to restore gamma ramps"
+					  " for `%s'.\n"), monitor->device);
+		}
+		monitor->applied = 0;
+	}
+}
 
-	/* Open device context */
-	HDC hDC = GetDC(NULL);
-	if (hDC == NULL) {
-		fputs(_("Unable to open device context.\n"), stderr);
-		return -1;
+/* Follow display changes that were broadcast since the last update.
+   Device contexts of monitors that were removed are no longer valid,
+   and the ramps of the others may have been reset. Returns 1 if the
+   monitors were opened again, 0 if nothing changed, or -1 on error. */
+static int
+w32gdi_handle_display_change(w32gdi_state_t *state)
+{
+	MSG msg;
+	while (state->window != NULL &&
+	       PeekMessage(&msg, state->window, 0, 0, PM_REMOVE)) {
+		DispatchMessage(&msg);
 	}
 
-	/* Create new gamma ramps */
-	WORD *gamma_ramps = malloc(3*GAMMA_RAMP_SIZE*sizeof(WORD));
-	if (gamma_ramps == NULL) {
-		perror("malloc");
-		ReleaseDC(NULL, hDC);
-		return -1;
+	if (!state->display_changed) return 0;
+	state->display_changed = 0;
+
+	int r = w32gdi_open_monitors(state);
+	return r < 0 ? -1 : 1;
+}
+
+static const color_setting_t *
+w32gdi_setting_for_monitor(
+	const w32gdi_monitor_t *monitor, const color_setting_t *setting,
+	const gamma_output_setting_t *outputs, int count)
+{
+	/* Outputs are named without the \\.\ prefix. */
+	const char *name = monitor->device;
+	if (strncmp(name, "\\\\.\\", 4) == 0) name += 4;
+
+	for (int i = 0; i < count; i++) {
+		if (strcasecmp(name, outputs[i].name) == 0) {
+			return &outputs[i].setting;
+		}
 	}
 
-	WORD *gamma_r = &gamma_ramps[0*GAMMA_RAMP_SIZE];
-	WORD *gamma_g = &gamma_ramps[1*GAMMA_RAMP_SIZE];
-	WORD *gamma_b = &gamma_ramps[2*GAMMA_RAMP_SIZE];
+	return setting;
+}
 
-	if (preserve) {
-		/* Initialize gamma ramps from saved state */
-		memcpy(gamma_ramps, state->saved_ramps,
-		       3*GAMMA_RAMP_SIZE*sizeof(WORD));
-	} else {
-		/* Initialize gamma ramps to pure state */
-		for (int i = 0; i < GAMMA_RAMP_SIZE; i++) {
-			WORD value = (double)i/GAMMA_RAMP_SIZE *
-				(UINT16_MAX+1);
-			gamma_r[i] = value;
-			gamma_g[i] = value;
-			gamma_b[i] = value;
+/* Upload ramps for SETTING to the monitors whose ramps changed. If
+   none of them changed they are all uploaded again, since that is a
+   request to reapply the ramps in case another program changed them. */
+static int
+w32gdi_apply(w32gdi_state_t *state, const color_setting_t *setting,
+	     const gamma_output_setting_t *outputs, int count, int preserve)
+{
+	int changed = 0;
+	for (int i = 0; i < state->monitor_count; i++) {
+		w32gdi_monitor_t *monitor = &state->monitors[i];
+		WORD *gamma_ramps = monitor->ramps;
+		WORD *gamma_r = &gamma_ramps[0*GAMMA_RAMP_SIZE];
+		WORD *gamma_g = &gamma_ramps[1*GAMMA_RAMP_SIZE];
+		WORD *gamma_b = &gamma_ramps[2*GAMMA_RAMP_SIZE];
+
+		/* Initialize gamma ramps from saved or pure state */
+		memcpy(gamma_ramps, preserve ? monitor->saved_ramps :
+		       state->pure_ramps, sizeof(monitor->ramps));
+
+		colorramp_fill(gamma_r, gamma_g, gamma_b, GAMMA_RAMP_SIZE,
+			       w32gdi_setting_for_monitor(
+				       monitor, setting, outputs, count));
+
+		if (!monitor->applied ||
+		    memcmp(monitor->ramps, monitor->applied_ramps,
+			   sizeof(monitor->ramps)) != 0) {
+			monitor->applied = 0;
+			changed = 1;
 		}
 	}
 
-	colorramp_fill(gamma_r, gamma_g, gamma_b, GAMMA_RAMP_SIZE,
-		       setting);
+	for (int i = 0; i < state->monitor_count; i++) {
+		w32gdi_monitor_t *monitor = &state->monitors[i];
+		if (changed && monitor->applied) continue;
 
-	/* Set new gamma ramps */
-	r = FALSE;
-	for (int i = 0; i < MAX_ATTEMPTS && !r; i++) {
-		/* We retry a few times before giving up because some
-		   buggy drivers fail on the first invocation of
-		   SetDeviceGammaRamp just to succeed on the second. */
-		r = SetDeviceGammaRamp(hDC, gamma_ramps);
+		monitor->applied = 0;
+		int r = w32gdi_set_ramps(monitor, monitor->ramps);
+		if (r < 0) return -1;
+
+		memcpy(monitor->applied_ramps, monitor->ramps,
+		       sizeof(monitor->ramps));
+		monitor->applied = 1;
+	}
+
+	return 0;
+}
+
+static int
+w32gdi_set_output_temperatures(
+	w32gdi_state_t *state, const color_setting_t *setting,
+	const gamma_output_setting_t *outputs, int count, int preserve)
+{
+	int r = w32gdi_handle_display_change(state);
+	if (r < 0) return -1;
+
+	/* Set new gamma ramps. A monitor may have been removed before
+	   the display change was received, so on failure the monitors
+	   are opened again before giving up. */
+	r = w32gdi_apply(state, setting, outputs, count, preserve);
+	if (r < 0) {
+		r = w32gdi_open_monitors(state);
+		if (r == 0) {
+			r = w32gdi_apply(state, setting, outputs, count,
+					 preserve);
+		}
 	}
-	if (!r) {
+	if (r < 0) {
 		fputs(_("Unable to set gamma ramps.\n"), stderr);
-		free(gamma_ramps);
-		ReleaseDC(NULL, hDC);
 		return -1;
 	}
 
-	free(gamma_ramps);
-
-	/* Release device context */
-	ReleaseDC(NULL, hDC);
-
 	return 0;
 }
 
+static int
+w32gdi_set_temperature(
+	w32gdi_state_t *state, const color_setting_t *setting, int preserve)
+{
+	return w32gdi_set_output_temperatures(
+		state, setting, NULL, 0, preserve);
+}
+
 
 const gamma_method_t w32gdi_gamma_method = {
 	"wingdi", 1,
@@ -235,5 +445,11 @@ const gamma_method_t w32gdi_gamma_method = {
 	(gamma_method_print_help_func *)w32gdi_print_help,
 	(gamma_method_set_option_func *)w32gdi_set_option,
 	(gamma_method_restore_func *)w32gdi_restore,
-	(gamma_method_set_temperature_func *)w32gdi_set_temperature
+	(gamma_method_set_temperature_func *)w32gdi_set_temperature,
+	NULL,
+	NULL,
+	NULL,
+	(gamma_method_handle_func *)w32gdi_handle_display_change,
+	(gamma_method_set_output_temperatures_func *)
+	w32gdi_set_output_temperatures
 };
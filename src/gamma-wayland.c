@@ -0,0 +1,620 @@
+/* gamma-wayland.c -- Wayland gamma adjustment with wlr-gamma-control
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _GNU_SOURCE
+# define _GNU_SOURCE
+#endif
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <wayland-client.h>
+
+#ifdef ENABLE_NLS
+# include <libintl.h>
+# define _(s) gettext(s)
+#else
+# define _(s) s
+#endif
+
+#include "gamma-wayland.h"
+#include "colorramp.h"
+#include "wlr-gamma-control-unstable-v1-client-protocol.h"
+
+/* Highest wl_output version used, for the output name. */
+#ifdef WL_OUTPUT_NAME_SINCE_VERSION
+# define OUTPUT_VERSION  WL_OUTPUT_NAME_SINCE_VERSION
+#else
+# define OUTPUT_VERSION  1
+#endif
+
+
+typedef struct wayland_state wayland_state_t;
+
+typedef struct {
+	struct wl_list link;
+	wayland_state_t *state;
+	uint32_t global_name;
+	uint32_t version;
+	struct wl_output *output;
+	struct zwlr_gamma_control_v1 *gamma_control;
+	/* Name such as DP-1, or NULL if the compositor does not tell. */
+	char *name;
+	/* Number of entries in each ramp, 0 until it is known. */
+	uint32_t ramp_size;
+	/* Set when the compositor refused gamma control. */
+	int failed;
+	/* Ramps are written straight into shared memory that is passed
+	   to the compositor. The compositor reads a table when it gets
+	   the request, so two tables are used in turn and neither is
+	   rewritten while a request for it may still be in flight. */
+	int fds[2];
+	uint16_t *tables[2];
+	int next_table;
+} wayland_output_t;
+
+struct wayland_state {
+	char *display_name;
+	struct wl_display *display;
+	struct wl_registry *registry;
+	struct zwlr_gamma_control_manager_v1 *gamma_control_manager;
+	struct wl_list outputs;
+	/* Set when an output became ready to be adjusted. */
+	int outputs_changed;
+};
+
+
+static int
+wayland_init(wayland_state_t **state)
+{
+	*state = malloc(sizeof(wayland_state_t));
+	if (*state == NULL) return -1;
+
+	wayland_state_t *s = *state;
+	s->display_name = NULL;
+	s->display = NULL;
+	s->registry = NULL;
+	s->gamma_control_manager = NULL;
+	wl_list_init(&s->outputs);
+	s->outputs_changed = 0;
+
+	return 0;
+}
+
+/* Return a file descriptor for an anonymous file of SIZE bytes, or -1
+   on error. */
+static int
+create_table_fd(size_t size)
+{
+#ifdef HAVE_MEMFD_CREATE
+	int fd = memfd_create("redshift-gamma", MFD_CLOEXEC);
+	if (fd < 0) return -1;
+#else
+	const char *dir = getenv("XDG_RUNTIME_DIR");
+	if (dir == NULL || dir[0] == '\0') dir = "/tmp";
+
+	char path[4096];
+	snprintf(path, sizeof(path), "%s/redshift-gamma-XXXXXX", dir);
+	int fd = mkstemp(path);
+	if (fd < 0) return -1;
+	unlink(path);
+	fcntl(fd, F_SETFD, FD_CLOEXEC);
+#endif
+
+	if (ftruncate(fd, size) < 0) {
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+static void
+output_free_tables(wayland_output_t *output)
+{
+	size_t size = 3*output->ramp_size*sizeof(uint16_t);
+	for (int i = 0; i < 2; i++) {
+		if (output->tables[i] != NULL) {
+			munmap(output->tables[i], size);
+			output->tables[i] = NULL;
+		}
+		if (output->fds[i] >= 0) {
+			close(output->fds[i]);
+			output->fds[i] = -1;
+		}
+	}
+
+	output->ramp_size = 0;
+}
+
+static int
+output_alloc_tables(wayland_output_t *output, uint32_t ramp_size)
+{
+	output_free_tables(output);
+
+	size_t size = 3*ramp_size*sizeof(uint16_t);
+	for (int i = 0; i < 2; i++) {
+		output->fds[i] = create_table_fd(size);
+		if (output->fds[i] < 0) {
+			perror("memfd_create");
+			output_free_tables(output);
+			return -1;
+		}
+
+		void *table = mmap(NULL, size, PROT_READ | PROT_WRITE,
+				   MAP_SHARED, output->fds[i], 0);
+		if (table == MAP_FAILED) {
+			perror("mmap");
+			output_free_tables(output);
+			return -1;
+		}
+		output->tables[i] = table;
+	}
+
+	output->ramp_size = ramp_size;
+	output->next_table = 0;
+
+	return 0;
+}
+
+static void
+gamma_control_handle_gamma_size(
+	void *data, struct zwlr_gamma_control_v1 *gamma_control,
+	uint32_t size)
+{
+	wayland_output_t *output = data;
+	if (size == 0 || output_alloc_tables(output, size) < 0) return;
+
+	output->state->outputs_changed = 1;
+}
+
+static void
+gamma_control_handle_failed(
+	void *data, struct zwlr_gamma_control_v1 *gamma_control)
+{
+	wayland_output_t *output = data;
+	fprintf(stderr, _("Unable to adjust gamma ramps of output `%s';"
+			  " another program may be adjusting them.\n"),
+		output->name != NULL ? output->name : "?");
+
+	zwlr_gamma_control_v1_destroy(output->gamma_control);
+	output->gamma_control = NULL;
+	output->failed = 1;
+	output_free_tables(output);
+}
+
+static const struct zwlr_gamma_control_v1_listener gamma_control_listener = {
+	gamma_control_handle_gamma_size,
+	gamma_control_handle_failed
+};
+
+static void
+output_request_gamma_control(wayland_output_t *output)
+{
+	struct zwlr_gamma_control_manager_v1 *manager =
+		output->state->gamma_control_manager;
+	if (manager == NULL || output->gamma_control != NULL ||
+	    output->failed) {
+		return;
+	}
+
+	output->gamma_control =
+		zwlr_gamma_control_manager_v1_get_gamma_control(
+			manager, output->output);
+	zwlr_gamma_control_v1_add_listener(
+		output->gamma_control, &gamma_control_listener, output);
+}
+
+static void
+output_handle_geometry(
+	void *data, struct wl_output *wl_output, int32_t x, int32_t y,
+	int32_t physical_width, int32_t physical_height, int32_t subpixel,
+	const char *make, const char *model, int32_t transform)
+{
+}
+
+static void
+output_handle_mode(
+	void *data, struct wl_output *wl_output, uint32_t flags,
+	int32_t width, int32_t height, int32_t refresh)
+{
+}
+
+#if OUTPUT_VERSION >= 2
+static void
+output_handle_done(void *data, struct wl_output *wl_output)
+{
+}
+
+static void
+output_handle_scale(void *data, struct wl_output *wl_output, int32_t factor)
+{
+}
+#endif
+
+#if OUTPUT_VERSION >= 4
+static void
+output_handle_name(void *data, struct wl_output *wl_output, const char *name)
+{
+	wayland_output_t *output = data;
+	free(output->name);
+	output->name = strdup(name);
+}
+
+static void
+output_handle_description(
+	void *data, struct wl_output *wl_output, const char *description)
+{
+}
+#endif
+
+static const struct wl_output_listener output_listener = {
+	output_handle_geometry,
+	output_handle_mode,
+#if OUTPUT_VERSION >= 2
+	output_handle_done,
+	output_handle_scale,
+#endif
+#if OUTPUT_VERSION >= 4
+	output_handle_name,
+	output_handle_description
+#endif
+};
+
+static void
+output_add(wayland_state_t *state, uint32_t global_name, uint32_t version)
+{
+	wayland_output_t *output = malloc(sizeof(wayland_output_t));
+	if (output == NULL) {
+		perror("malloc");
+		return;
+	}
+
+	output->state = state;
+	output->global_name = global_name;
+	output->version = version < OUTPUT_VERSION ? version : OUTPUT_VERSION;
+	output->gamma_control = NULL;
+	output->name = NULL;
+	output->ramp_size = 0;
+	output->failed = 0;
+	output->fds[0] = output->fds[1] = -1;
+	output->tables[0] = output->tables[1] = NULL;
+	output->next_table = 0;
+
+	output->output = wl_registry_bind(
+		state->registry, global_name, &wl_output_interface,
+		output->version);
+	wl_output_add_listener(output->output, &output_listener, output);
+	wl_list_insert(state->outputs.prev, &output->link);
+
+	output_request_gamma_control(output);
+}
+
+static void
+output_destroy(wayland_output_t *output)
+{
+	if (output->gamma_control != NULL) {
+		zwlr_gamma_control_v1_destroy(output->gamma_control);
+	}
+	output_free_tables(output);
+
+#ifdef WL_OUTPUT_RELEASE_SINCE_VERSION
+	if (output->version >= WL_OUTPUT_RELEASE_SINCE_VERSION) {
+		wl_output_release(output->output);
+	} else {
+		wl_output_destroy(output->output);
+	}
+#else
+	wl_output_destroy(output->output);
+#endif
+
+	wl_list_remove(&output->link);
+	free(output->name);
+	free(output);
+}
+
+static void
+registry_handle_global(
+	void *data, struct wl_registry *registry, uint32_t name,
+	const char *interface, uint32_t version)
+{
+	wayland_state_t *state = data;
+
+	if (strcmp(interface, wl_output_interface.name) == 0) {
+		output_add(state, name, version);
+	} else if (strcmp(interface,
+			  zwlr_gamma_control_manager_v1_interface.name) == 0) {
+		state->gamma_control_manager = wl_registry_bind(
+			registry, name,
+			&zwlr_gamma_control_manager_v1_interface, 1);
+	}
+}
+
+static void
+registry_handle_global_remove(
+	void *data, struct wl_registry *registry, uint32_t name)
+{
+	wayland_state_t *state = data;
+
+	/* The compositor restores the ramps of removed outputs. */
+	wayland_output_t *output, *tmp;
+	wl_list_for_each_safe(output, tmp, &state->outputs, link) {
+		if (output->global_name == name) {
+			output_destroy(output);
+			break;
+		}
+	}
+}
+
+static const struct wl_registry_listener registry_listener = {
+	registry_handle_global,
+	registry_handle_global_remove
+};
+
+static int
+wayland_start(wayland_state_t *state)
+{
+	state->display = wl_display_connect(state->display_name);
+	if (state->display == NULL) {
+		fputs(_("Unable to connect to Wayland display.\n"), stderr);
+		return -1;
+	}
+
+	state->registry = wl_display_get_registry(state->display);
+	wl_registry_add_listener(state->registry, &registry_listener, state);
+
+	/* Receive globals, then the gamma sizes and output names. */
+	if (wl_display_roundtrip(state->display) < 0) {
+		fputs(_("Unable to get Wayland globals.\n"), stderr);
+		return -1;
+	}
+
+	if (state->gamma_control_manager == NULL) {
+		fputs(_("Wayland compositor does not support"
+			" wlr-gamma-control.\n"), stderr);
+		return -1;
+	}
+
+	wayland_output_t *output;
+	wl_list_for_each(output, &state->outputs, link) {
+		output_request_gamma_control(output);
+	}
+
+	if (wl_display_roundtrip(state->display) < 0) {
+		fputs(_("Unable to get Wayland gamma controls.\n"), stderr);
+		return -1;
+	}
+
+	int ready = 0;
+	wl_list_for_each(output, &state->outputs, link) {
+		if (output->ramp_size > 0) ready += 1;
+	}
+	if (ready == 0) {
+		fputs(_("No Wayland output supports gamma adjustment.\n"),
+		      stderr);
+		return -1;
+	}
+
+	state->outputs_changed = 0;
+
+	return 0;
+}
+
+static void
+wayland_free(wayland_state_t *state)
+{
+	wayland_output_t *output, *tmp;
+	wl_list_for_each_safe(output, tmp, &state->outputs, link) {
+		output_destroy(output);
+	}
+
+	if (state->gamma_control_manager != NULL) {
+		zwlr_gamma_control_manager_v1_destroy(
+			state->gamma_control_manager);
+	}
+	if (state->registry != NULL) wl_registry_destroy(state->registry);
+	if (state->display != NULL) wl_display_disconnect(state->display);
+
+	free(state->display_name);
+	free(state);
+}
+
+static void
+wayland_print_help(FILE *f)
+{
+	fputs(_("Adjust gamma ramps with the wlr-gamma-control Wayland"
+		" protocol.\n"), f);
+	fputs(_("The compositor restores the ramps when Redshift"
+		" exits.\n"), f);
+	fputs("\n", f);
+
+	/* TRANSLATORS: Wayland help output
+	   left column must not be translated */
+	fputs(_("  display=NAME\tWayland display to connect to"
+		" (default $WAYLAND_DISPLAY)\n"), f);
+	fputs("\n", f);
+}
+
+static int
+wayland_set_option(wayland_state_t *state, const char *key, const char *value)
+{
+	if (strcasecmp(key, "display") == 0) {
+		free(state->display_name);
+		state->display_name = strdup(value);
+		if (state->display_name == NULL) {
+			perror("strdup");
+			return -1;
+		}
+	} else {
+		fprintf(stderr, _("Unknown method parameter: `%s'.\n"), key);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int
+wayland_flush(wayland_state_t *state)
+{
+	int r = wl_display_flush(state->display);
+	if (r < 0 && errno != EAGAIN) {
+		perror("wl_display_flush");
+		return -1;
+	}
+
+	return 0;
+}
+
+static void
+wayland_restore(wayland_state_t *state)
+{
+	/* Destroying a gamma control restores the ramps. Controls are
+	   requested again if the temperature is set after this. */
+	wayland_output_t *output;
+	wl_list_for_each(output, &state->outputs, link) {
+		if (output->gamma_control != NULL) {
+			zwlr_gamma_control_v1_destroy(output->gamma_control);
+			output->gamma_control = NULL;
+		}
+		output_free_tables(output);
+	}
+
+	wayland_flush(state);
+}
+
+static const color_setting_t *
+wayland_setting_for_output(
+	const wayland_output_t *output, const color_setting_t *setting,
+	const gamma_output_setting_t *outputs, int count)
+{
+	if (output->name == NULL) return setting;
+
+	for (int i = 0; i < count; i++) {
+		if (strcmp(output->name, outputs[i].name) == 0) {
+			return &outputs[i].setting;
+		}
+	}
+
+	return setting;
+}
+
+static int
+wayland_set_output_temperatures(
+	wayland_state_t *state, const color_setting_t *setting,
+	const gamma_output_setting_t *outputs, int count, int preserve)
+{
+	/* The current ramps can not be read with this protocol, so
+	   they always start from the pure state. */
+	wayland_output_t *output;
+	wl_list_for_each(output, &state->outputs, link) {
+		output_request_gamma_control(output);
+		if (output->gamma_control == NULL ||
+		    output->ramp_size == 0) {
+			continue;
+		}
+
+		uint32_t ramp_size = output->ramp_size;
+		int index = output->next_table;
+		uint16_t *table = output->tables[index];
+		uint16_t *gamma_r = &table[0*ramp_size];
+		uint16_t *gamma_g = &table[1*ramp_size];
+		uint16_t *gamma_b = &table[2*ramp_size];
+
+		for (uint32_t i = 0; i < ramp_size; i++) {
+			uint16_t value = (double)i/ramp_size *
+				(UINT16_MAX+1);
+			gamma_r[i] = value;
+			gamma_g[i] = value;
+			gamma_b[i] = value;
+		}
+
+		colorramp_fill(gamma_r, gamma_g, gamma_b, ramp_size,
+			       wayland_setting_for_output(
+				       output, setting, outputs, count));
+
+		/* Older compositors read from the current offset of
+		   the file, which is shared with this process. */
+		lseek(output->fds[index], 0, SEEK_SET);
+		zwlr_gamma_control_v1_set_gamma(
+			output->gamma_control, output->fds[index]);
+		output->next_table = !index;
+	}
+
+	return wayland_flush(state);
+}
+
+static int
+wayland_set_temperature(
+	wayland_state_t *state, const color_setting_t *setting, int preserve)
+{
+	return wayland_set_output_temperatures(
+		state, setting, NULL, 0, preserve);
+}
+
+static int
+wayland_get_fd(wayland_state_t *state)
+{
+	return wl_display_get_fd(state->display);
+}
+
+/* Handle events from the compositor, such as outputs being added and
+   removed. Returns 1 if an output became ready to be adjusted. */
+static int
+wayland_handle(wayland_state_t *state)
+{
+	int r = wl_display_dispatch(state->display);
+	if (r < 0) {
+		fputs(_("Lost connection to Wayland display.\n"), stderr);
+		return -1;
+	}
+
+	r = wayland_flush(state);
+	if (r < 0) return -1;
+
+	int changed = state->outputs_changed;
+	state->outputs_changed = 0;
+
+	return changed;
+}
+
+
+const gamma_method_t wayland_gamma_method = {
+	"wayland", 1,
+	(gamma_method_init_func *)wayland_init,
+	(gamma_method_start_func *)wayland_start,
+	(gamma_method_free_func *)wayland_free,
+	(gamma_method_print_help_func *)wayland_print_help,
+	(gamma_method_set_option_func *)wayland_set_option,
+	(gamma_method_restore_func *)wayland_restore,
+	(gamma_method_set_temperature_func *)wayland_set_temperature,
+	NULL,
+	NULL,
+	(gamma_method_get_fd_func *)wayland_get_fd,
+	(gamma_method_handle_func *)wayland_handle,
+	(gamma_method_set_output_temperatures_func *)
+	wayland_set_output_temperatures
+};
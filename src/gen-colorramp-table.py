@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+# gen-colorramp-table.py -- Generate white point table for colorramp.c
+# This file is part of Redshift.
+#
+# Redshift is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# Redshift is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+
+"""Generate colorramp-table.h from the RGB columns of README-colorramp.
+
+The white points in README-colorramp are given at 100K intervals. They
+are resampled at a finer interval with monotone cubic interpolation
+(Fritsch-Carlson), which follows the smooth curve more closely than
+straight lines between the samples. Monotone interpolation does not
+overshoot, so the values stay between those of the samples around
+them and channels that are clamped at 0 or 1 stay there.
+
+Usage: gen-colorramp-table.py README-colorramp > colorramp-table.h
+"""
+
+import re
+import sys
+
+STEP = 10
+PER_SAMPLE = 100 // STEP
+
+
+def read_samples(path):
+    """Return list of (kelvins, (r, g, b)) from the README table."""
+    samples = []
+    row = re.compile(r'^\s*(\d+\.\d+)\s+\d+\.\d+\s+'
+                     r'(\d\.\d+)\s+(\d\.\d+)\s+(\d\.\d+)\s')
+    with open(path) as f:
+        for line in f:
+            m = row.match(line)
+            if m is not None:
+                rgb = tuple(float(v) for v in m.group(2, 3, 4))
+                samples.append((int(float(m.group(1))), rgb))
+
+    for i, (kelvins, _) in enumerate(samples):
+        if kelvins != samples[0][0] + 100*i:
+            raise ValueError('Samples are not at 100K intervals')
+
+    return samples
+
+
+def monotone_tangents(y):
+    """Return Fritsch-Carlson tangents for unit spaced values y."""
+    n = len(y)
+    d = [y[i+1] - y[i] for i in range(n - 1)]
+    m = [d[0]] + [(d[i-1] + d[i]) / 2 for i in range(1, n - 1)] + [d[-1]]
+
+    # A channel that is clamped at 0 or 1 stays flat up to a kink, where
+    # the curve continues with the slope on the other side. The curve is
+    # also flat at local extremes.
+    for i in range(1, n - 1):
+        if d[i-1] == 0 or d[i] == 0:
+            m[i] = d[i-1] + d[i]
+        elif d[i-1]*d[i] < 0:
+            m[i] = 0
+
+    for i in range(n - 1):
+        if d[i] == 0:
+            continue
+        a = m[i] / d[i]
+        b = m[i+1] / d[i]
+        s = a*a + b*b
+        if s > 9:
+            t = 3 / s**0.5
+            m[i] = t*a*d[i]
+            m[i+1] = t*b*d[i]
+
+    return m
+
+
+def hermite(y0, y1, m0, m1, t):
+    t2 = t*t
+    t3 = t2*t
+    return ((2*t3 - 3*t2 + 1)*y0 + (t3 - 2*t2 + t)*m0 +
+            (-2*t3 + 3*t2)*y1 + (t3 - t2)*m1)
+
+
+def resample(samples):
+    channels = [[rgb[c] for _, rgb in samples] for c in range(3)]
+    tangents = [monotone_tangents(y) for y in channels]
+
+    table = []
+    for i in range(len(samples) - 1):
+        for j in range(PER_SAMPLE):
+            t = j / PER_SAMPLE
+            rgb = []
+            for c in range(3):
+                y = channels[c]
+                if y[i] == y[i+1]:
+                    # Clamped; see monotone_tangents().
+                    rgb.append(y[i])
+                else:
+                    m = tangents[c]
+                    rgb.append(hermite(y[i], y[i+1], m[i], m[i+1], t))
+            table.append(tuple(rgb))
+    table.append(samples[-1][1])
+
+    return table
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.stderr.write(__doc__)
+        sys.exit(1)
+
+    samples = read_samples(sys.argv[1])
+    table = resample(samples)
+    first = samples[0][0]
+
+    print('/* colorramp-table.h -- White point table')
+    print('   Generated by gen-colorramp-table.py from README-colorramp.')
+    print('   Do not edit. */')
+    print()
+    print('#ifndef REDSHIFT_COLORRAMP_TABLE_H')
+    print('#define REDSHIFT_COLORRAMP_TABLE_H')
+    print()
+    print('/* Temperature of the first entry and interval between entries')
+    print('   (kelvins). */')
+    print('#define BLACKBODY_MIN   {}'.format(first))
+    print('#define BLACKBODY_STEP  {}'.format(STEP))
+    print()
+    print('static const float blackbody_color[] = {')
+    for i, rgb in enumerate(table):
+        kelvins = first + STEP*i
+        sep = ',' if i < len(table) - 1 else ' '
+        line = '\t{:.8f},  {:.8f},  {:.8f}{}'.format(
+            *(max(0.0, min(1.0, v)) for v in rgb), sep)
+        if kelvins % 1000 == 0 or i == len(table) - 1:
+            line += ' /* {}K */'.format(kelvins)
+        print(line)
+    print('};')
+    print()
+    print('#endif /* ! REDSHIFT_COLORRAMP_TABLE_H */')
+
+
+if __name__ == '__main__':
+    main()
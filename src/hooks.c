@@ -18,12 +18,18 @@
 */
 
 #include <stdlib.h>
+#include <string.h>
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <dirent.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <errno.h>
 #ifndef _WIN32
 # include <pwd.h>
+# include <signal.h>
+# include <spawn.h>
+# include <sys/wait.h>
 #endif
 
 #include "hooks.h"
@@ -31,6 +37,14 @@
 
 #define MAX_HOOK_PATH  4096
 
+/* Seconds between checks of the hooks directory for changes. */
+#define HOOKS_REFRESH_INTERVAL  60.0
+
+/* Seconds a hook may run before it is terminated, and after that
+   before it is killed. */
+#define HOOK_TIMEOUT       30.0
+#define HOOK_KILL_TIMEOUT   5.0
+
 
 /* Names of periods supplied to scripts. */
 static const char *period_names[] = {
@@ -40,74 +54,273 @@ static const char *period_names[] = {
 	"transition"
 };
 
+#ifndef _WIN32
+
+extern char **environ;
+
+/* Hook that is still running. */
+typedef struct {
+	pid_t pid;
+	double deadline;
+	int terminated;
+} hook_child_t;
 
-/* Try to open the directory containing hooks. HP is a string
-   of MAX_HOOK_PATH length that will be filled with the path
-   of the returned directory. */
-static DIR *
-open_hooks_dir(char *hp)
+/* Cached list of hooks. */
+static char **hook_paths = NULL;
+static int hook_count = 0;
+static int hook_list_valid = 0;
+static double hook_list_time = 0;
+static time_t hooks_dir_mtime = 0;
+
+static hook_child_t *children = NULL;
+static int child_count = 0;
+static int child_size = 0;
+
+#endif /* ! _WIN32 */
+
+
+/* Return path of the directory containing hooks in HP, a string
+   of MAX_HOOK_PATH length. Returns -1 if unknown. */
+static int
+get_hooks_dir(char *hp)
 {
 	char *env;
 
 	if ((env = getenv("XDG_CONFIG_HOME")) != NULL &&
 	    env[0] != '\0') {
 		snprintf(hp, MAX_HOOK_PATH, "%s/redshift/hooks", env);
-		return opendir(hp);
+		return 0;
 	}
 
 	if ((env = getenv("HOME")) != NULL &&
 	    env[0] != '\0') {
 		snprintf(hp, MAX_HOOK_PATH, "%s/.config/redshift/hooks", env);
-		return opendir(hp);
+		return 0;
 	}
 
 #ifndef _WIN32
 	struct passwd *pwd = getpwuid(getuid());
+	if (pwd == NULL) return -1;
 	snprintf(hp, MAX_HOOK_PATH, "%s/.config/redshift/hooks", pwd->pw_dir);
-	return opendir(hp);
+	return 0;
 #else
-	return NULL;
+	return -1;
 #endif
 }
 
-/* Run hooks with a signal that the period changed. */
-void
-hooks_signal_period_change(period_t prev_period, period_t period)
+#ifndef _WIN32
+
+static void
+free_hook_list(void)
 {
-	char hooksdir_path[MAX_HOOK_PATH];
-	DIR *hooks_dir = open_hooks_dir(hooksdir_path);
+	for (int i = 0; i < hook_count; i++) free(hook_paths[i]);
+	free(hook_paths);
+	hook_paths = NULL;
+	hook_count = 0;
+}
+
+/* Read the list of hooks from the hooks directory. */
+static void
+load_hook_list(const char *hooksdir_path)
+{
+	free_hook_list();
+
+	DIR *hooks_dir = opendir(hooksdir_path);
 	if (hooks_dir == NULL) return;
 
+	int size = 0;
 	struct dirent* ent;
 	while ((ent = readdir(hooks_dir)) != NULL) {
 		/* Skip hidden and special files (., ..) */
 		if (ent->d_name[0] == '\0' || ent->d_name[0] == '.') continue;
 
-		char *hook_name = ent->d_name;
 		char hook_path[MAX_HOOK_PATH];
-		snprintf(hook_path, sizeof(hook_path), "%s/%s",
-			 hooksdir_path, hook_name);
+		int r = snprintf(hook_path, sizeof(hook_path), "%s/%s",
+				 hooksdir_path, ent->d_name);
+		if (r < 0 || (size_t)r >= sizeof(hook_path)) continue;
+
+		/* Only executable files are run. */
+		if (access(hook_path, X_OK) != 0) continue;
+
+		if (hook_count == size) {
+			int new_size = size == 0 ? 8 : 2*size;
+			char **paths = realloc(hook_paths,
+					       new_size*sizeof(char *));
+			if (paths == NULL) {
+				perror("realloc");
+				break;
+			}
+			hook_paths = paths;
+			size = new_size;
+		}
+
+		hook_paths[hook_count] = strdup(hook_path);
+		if (hook_paths[hook_count] == NULL) {
+			perror("strdup");
+			break;
+		}
+		hook_count += 1;
+	}
+
+	closedir(hooks_dir);
+}
+
+/* Reload the cached list of hooks if the hooks directory changed. The
+   directory is checked at most once per refresh interval. */
+static void
+update_hook_list(double now)
+{
+	if (hook_list_valid && now >= hook_list_time &&
+	    now < hook_list_time + HOOKS_REFRESH_INTERVAL) {
+		return;
+	}
+	hook_list_time = now;
+
+	char hooksdir_path[MAX_HOOK_PATH];
+	struct stat st;
+	if (get_hooks_dir(hooksdir_path) < 0 ||
+	    stat(hooksdir_path, &st) < 0) {
+		free_hook_list();
+		hook_list_valid = 1;
+		hooks_dir_mtime = 0;
+		return;
+	}
+
+	if (hook_list_valid && st.st_mtime == hooks_dir_mtime) return;
+
+	load_hook_list(hooksdir_path);
+	hook_list_valid = 1;
+	hooks_dir_mtime = st.st_mtime;
+}
+
+/* Start hook without waiting for it. The output of the hook
+   is discarded so it cannot interfere with the normal output. */
+static void
+spawn_hook(const char *hook_path, char *const argv[], double now)
+{
+	if (child_count == child_size) {
+		int new_size = child_size == 0 ? 8 : 2*child_size;
+		hook_child_t *c = realloc(children,
+					  new_size*sizeof(hook_child_t));
+		if (c == NULL) {
+			perror("realloc");
+			return;
+		}
+		children = c;
+		child_size = new_size;
+	}
+
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO,
+					 "/dev/null", O_WRONLY, 0);
+
+	/* Restore default signal handling in the hook. */
+	posix_spawnattr_t attr;
+	posix_spawnattr_init(&attr);
+	sigset_t sigset;
+	sigemptyset(&sigset);
+	posix_spawnattr_setsigmask(&attr, &sigset);
+	sigaddset(&sigset, SIGCHLD);
+	sigaddset(&sigset, SIGPIPE);
+	posix_spawnattr_setsigdefault(&attr, &sigset);
+	posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK |
+				 POSIX_SPAWN_SETSIGDEF);
+
+	pid_t pid;
+	int r = posix_spawn(&pid, hook_path, &actions, &attr, argv,
+			    environ);
+	posix_spawnattr_destroy(&attr);
+	posix_spawn_file_actions_destroy(&actions);
+	if (r != 0) {
+		if (r != EACCES) {
+			fprintf(stderr, "posix_spawn: %s: %s\n",
+				hook_path, strerror(r));
+		}
+		return;
+	}
+
+	children[child_count].pid = pid;
+	children[child_count].deadline = now + HOOK_TIMEOUT;
+	children[child_count].terminated = 0;
+	child_count += 1;
+}
+
+#endif /* ! _WIN32 */
 
+/* Run hooks with a signal that the period changed. */
+void
+hooks_signal_period_change(period_t prev_period, period_t period,
+			   double now)
+{
 #ifndef _WIN32
-		/* Fork and exec the hook. We close stdout
-		   so the hook cannot interfere with the normal
-		   output. */
-		pid_t pid = fork();
-		if (pid == (pid_t)-1) {
-			perror("fork");
-			continue;
-		} else if (pid == 0) { /* Child */
-			close(STDOUT_FILENO);
+	update_hook_list(now);
 
-			int r = execl(hook_path, hook_name,
-				      "period-changed",
-				      period_names[prev_period],
-				      period_names[period], NULL);
-			if (r < 0 && errno != EACCES) perror("execl");
+	for (int i = 0; i < hook_count; i++) {
+		const char *hook_name = strrchr(hook_paths[i], '/') + 1;
+		char *const argv[] = {
+			(char *)hook_name, "period-changed",
+			(char *)period_names[prev_period],
+			(char *)period_names[period], NULL
+		};
+		spawn_hook(hook_paths[i], argv, now);
+	}
+#endif
+}
 
-			/* Only reached on error */
-			_exit(EXIT_FAILURE);
+/* Reap hooks that exited and stop hooks that ran past their
+   timeout. */
+void
+hooks_reap(double now)
+{
+#ifndef _WIN32
+	int i = 0;
+	while (i < child_count) {
+		hook_child_t *child = &children[i];
+
+		pid_t r = waitpid(child->pid, NULL, WNOHANG);
+		if (r == child->pid || (r < 0 && errno == ECHILD)) {
+			children[i] = children[--child_count];
+			continue;
+		}
+
+		if (now >= child->deadline) {
+			kill(child->pid, child->terminated ? SIGKILL : SIGTERM);
+			child->terminated = 1;
+			child->deadline = now + HOOK_KILL_TIMEOUT;
 		}
+		i += 1;
+	}
 #endif
+}
+
+/* Return time when a running hook must be stopped, or 0 if no hooks
+   are running. */
+double
+hooks_get_deadline(void)
+{
+	double deadline = 0;
+#ifndef _WIN32
+	for (int i = 0; i < child_count; i++) {
+		if (deadline == 0 || children[i].deadline < deadline) {
+			deadline = children[i].deadline;
+		}
 	}
+#endif
+	return deadline;
+}
+
+/* Free the cached list of hooks. Hooks that are still running are
+   left to finish on their own. */
+void
+hooks_free(void)
+{
+#ifndef _WIN32
+	free_hook_list();
+	hook_list_valid = 0;
+	free(children);
+	children = NULL;
+	child_count = 0;
+	child_size = 0;
+#endif
 }
@@ -23,7 +23,10 @@
 #include "redshift.h"
 
 void hooks_signal_period_change(period_t prev_period,
-				period_t period);
+				period_t period, double now);
+void hooks_reap(double now);
+double hooks_get_deadline(void);
+void hooks_free(void);
 
 
 #endif /* ! REDSHIFT_HOOKS_H */
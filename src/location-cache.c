@@ -0,0 +1,190 @@
+/* location-cache.c -- Cache of last known location source
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifndef _WIN32
+# include <pwd.h>
+#endif
+
+#ifdef ENABLE_NLS
+# include <libintl.h>
+# define _(s) gettext(s)
+#else
+# define _(s) s
+#endif
+
+#include "location-cache.h"
+#include "systemtime.h"
+
+#define MAX_CACHE_PATH  4096
+
+
+/* Location last read from or written to the cache, and the time it was
+   stored. */
+static location_t cached = { NAN, NAN };
+static double cached_time = 0;
+static int cache_read = 0;
+
+
+/* Write directory of the cache to PATH. The directory is created if
+   CREATE is non-zero. Returns -1 if it is unknown. */
+static int
+get_cache_dir(char *path, int create)
+{
+	char base[MAX_CACHE_PATH - 16];
+	const char *env;
+
+	if ((env = getenv("XDG_CACHE_HOME")) != NULL && env[0] != '\0') {
+		snprintf(base, sizeof(base), "%s", env);
+#ifdef _WIN32
+	} else if ((env = getenv("localappdata")) != NULL && env[0] != '\0') {
+		snprintf(base, sizeof(base), "%s", env);
+#endif
+	} else if ((env = getenv("HOME")) != NULL && env[0] != '\0') {
+		snprintf(base, sizeof(base), "%s/.cache", env);
+	} else {
+#ifndef _WIN32
+		struct passwd *pwd = getpwuid(getuid());
+		if (pwd == NULL) return -1;
+		snprintf(base, sizeof(base), "%s/.cache", pwd->pw_dir);
+#else
+		return -1;
+#endif
+	}
+
+	snprintf(path, MAX_CACHE_PATH, "%s/redshift", base);
+
+	if (create) {
+#ifndef _WIN32
+		int r = mkdir(base, 0700);
+		if (r < 0 && errno != EEXIST) return -1;
+		r = mkdir(path, 0700);
+#else
+		int r = mkdir(path);
+#endif
+		if (r < 0 && errno != EEXIST) return -1;
+	}
+
+	return 0;
+}
+
+/* Read the last known location. Returns -1 if there is none or it is
+   older than LOCATION_CACHE_MAX_AGE. */
+int
+location_cache_load(location_t *loc)
+{
+	char dir[MAX_CACHE_PATH];
+	char path[MAX_CACHE_PATH + 16];
+	cache_read = 1;
+
+	if (get_cache_dir(dir, 0) < 0) return -1;
+	snprintf(path, sizeof(path), "%s/location", dir);
+
+	FILE *f = fopen(path, "r");
+	if (f == NULL) return -1;
+
+	/* Coordinates are stored in millionths of a degree so the file
+	   does not depend on the locale. */
+	long lat, lon;
+	long long time;
+	int r = fscanf(f, "%ld %ld %lld", &lat, &lon, &time);
+	fclose(f);
+	if (r != 3) return -1;
+
+	/* The age can not be told on the virtual clock of a
+	   simulation. */
+	double now;
+	if (!systemtime_is_virtual() &&
+	    (systemtime_get_time(&now) < 0 ||
+	     now - time > LOCATION_CACHE_MAX_AGE)) {
+		return -1;
+	}
+
+	cached.lat = lat / 1000000.0;
+	cached.lon = lon / 1000000.0;
+	cached_time = time;
+	*loc = cached;
+
+	return 0;
+}
+
+/* Store LOC as the last known location if it moved past the threshold
+   from the stored one, or the stored one is due for a refresh. The
+   file is replaced so readers never see a partial write. Nothing is
+   stored on the virtual clock of a simulation. */
+int
+location_cache_save(const location_t *loc)
+{
+	if (systemtime_is_virtual()) return 0;
+
+	if (!cache_read) {
+		location_t old;
+		location_cache_load(&old);
+	}
+
+	double now;
+	if (systemtime_get_time(&now) < 0) return -1;
+
+	if (fabs(loc->lat - cached.lat) < LOCATION_CACHE_THRESHOLD &&
+	    fabs(loc->lon - cached.lon) < LOCATION_CACHE_THRESHOLD &&
+	    now - cached_time < LOCATION_CACHE_REFRESH) {
+		return 0;
+	}
+
+	char dir[MAX_CACHE_PATH];
+	char path[MAX_CACHE_PATH + 16];
+	char tmp_path[MAX_CACHE_PATH + 16];
+	if (get_cache_dir(dir, 1) < 0) return -1;
+	snprintf(path, sizeof(path), "%s/location", dir);
+	snprintf(tmp_path, sizeof(tmp_path), "%s/location.tmp", dir);
+
+	FILE *f = fopen(tmp_path, "w");
+	if (f == NULL) return -1;
+
+	fprintf(f, "%ld %ld %lld\n", lround(loc->lat * 1000000.0),
+		lround(loc->lon * 1000000.0), (long long)now);
+	int r = fclose(f);
+	if (r != 0) {
+		remove(tmp_path);
+		return -1;
+	}
+
+#ifdef _WIN32
+	remove(path);
+#endif
+	r = rename(tmp_path, path);
+	if (r < 0) {
+		remove(tmp_path);
+		return -1;
+	}
+
+	cached = *loc;
+	cached_time = now;
+
+	return 0;
+}
@@ -0,0 +1,37 @@
+/* location-cache.h -- Cache of last known location header
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REDSHIFT_LOCATION_CACHE_H
+#define REDSHIFT_LOCATION_CACHE_H
+
+#include "redshift.h"
+
+/* Degrees of latitude or longitude the location has to move before
+   the cache is written again. */
+#define LOCATION_CACHE_THRESHOLD  0.1
+
+/* Age in seconds after which the cached location is not used. */
+#define LOCATION_CACHE_MAX_AGE  (30*86400.0)
+
+/* Age in seconds after which the cache is written again even if the
+   location did not move, so that it does not expire while in use. */
+#define LOCATION_CACHE_REFRESH  86400.0
+
+int location_cache_load(location_t *loc);
+int location_cache_save(const location_t *loc);
+
+#endif /* ! REDSHIFT_LOCATION_CACHE_H */
@@ -0,0 +1,406 @@
+/* location-geoclue2-sdbus.c -- GeoClue2 location provider using sd-bus source
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/* Talks to GeoClue2 with asynchronous sd-bus calls that are processed
+   when the main loop finds the bus connection readable, so no thread
+   or GLib main context is needed. */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <systemd/sd-bus.h>
+
+#include "location-geoclue2-sdbus.h"
+#include "redshift.h"
+
+#ifdef ENABLE_NLS
+# include <libintl.h>
+# define _(s) gettext(s)
+#else
+# define _(s) s
+#endif
+
+#define GEOCLUE2_NAME  "org.freedesktop.GeoClue2"
+#define DBUS_ACCESS_ERROR  "org.freedesktop.DBus.Error.AccessDenied"
+
+
+typedef struct {
+	sd_bus *bus;
+	/* Matches for GeoClue appearing or vanishing on the bus and for
+	   location updates of the client. */
+	sd_bus_slot *name_slot;
+	sd_bus_slot *client_slot;
+	/* Whether a client has been requested but not received. */
+	int client_pending;
+	int available;
+	int error;
+	float latitude;
+	float longitude;
+} location_geoclue2_sdbus_state_t;
+
+
+/* Print the message explaining denial from GeoClue. */
+static void
+print_denial_message(void)
+{
+	fputs(_("Access to the current location was denied by GeoClue!\n"
+		"Make sure that location services are enabled and that"
+		" Redshift is permitted\nto use location services."
+		" See https://github.com/jonls/redshift#faq for more\n"
+		"information.\n"), stderr);
+}
+
+/* Print the error of a failed call. Returns -1 if M is an error
+   reply, otherwise 0. */
+static int
+check_reply(sd_bus_message *m, const char *message)
+{
+	if (!sd_bus_message_is_method_error(m, NULL)) return 0;
+
+	const sd_bus_error *error = sd_bus_message_get_error(m);
+	fprintf(stderr, message, error->message);
+	if (sd_bus_error_has_name(error, DBUS_ACCESS_ERROR)) {
+		print_denial_message();
+	}
+
+	return -1;
+}
+
+/* Reply to reading the properties of a location. */
+static int
+on_location_properties(sd_bus_message *m, void *userdata,
+		       sd_bus_error *ret_error)
+{
+	location_geoclue2_sdbus_state_t *state = userdata;
+
+	if (check_reply(m, _("Unable to obtain location: %s.\n")) < 0) {
+		state->error = 1;
+		return 0;
+	}
+
+	double latitude = NAN;
+	double longitude = NAN;
+
+	int r = sd_bus_message_enter_container(m, 'a', "{sv}");
+	while (r > 0 &&
+	       (r = sd_bus_message_enter_container(m, 'e', "sv")) > 0) {
+		const char *name;
+		r = sd_bus_message_read(m, "s", &name);
+		if (r < 0) break;
+
+		if (strcmp(name, "Latitude") == 0) {
+			r = sd_bus_message_read(m, "v", "d", &latitude);
+		} else if (strcmp(name, "Longitude") == 0) {
+			r = sd_bus_message_read(m, "v", "d", &longitude);
+		} else {
+			r = sd_bus_message_skip(m, "v");
+		}
+		if (r < 0) break;
+
+		r = sd_bus_message_exit_container(m);
+	}
+
+	if (r < 0 || isnan(latitude) || isnan(longitude)) {
+		fputs(_("Unable to read location from GeoClue.\n"), stderr);
+		state->error = 1;
+		return 0;
+	}
+
+	state->latitude = latitude;
+	state->longitude = longitude;
+	state->available = 1;
+
+	return 0;
+}
+
+/* Handle LocationUpdated signal of the client. */
+static int
+on_location_updated(sd_bus_message *m, void *userdata,
+		    sd_bus_error *ret_error)
+{
+	location_geoclue2_sdbus_state_t *state = userdata;
+
+	const char *old_path, *new_path;
+	int r = sd_bus_message_read(m, "oo", &old_path, &new_path);
+	if (r < 0) return 0;
+
+	r = sd_bus_call_method_async(
+		state->bus, NULL, GEOCLUE2_NAME, new_path,
+		"org.freedesktop.DBus.Properties", "GetAll",
+		on_location_properties, state,
+		"s", "org.freedesktop.GeoClue2.Location");
+	if (r < 0) state->error = 1;
+
+	return 0;
+}
+
+/* Reply to starting the client. */
+static int
+on_client_started(sd_bus_message *m, void *userdata,
+		  sd_bus_error *ret_error)
+{
+	location_geoclue2_sdbus_state_t *state = userdata;
+
+	if (check_reply(m, _("Unable to start GeoClue client: %s.\n")) < 0) {
+		state->error = 1;
+	}
+
+	return 0;
+}
+
+/* Reply to setting the distance threshold. */
+static int
+on_threshold_set(sd_bus_message *m, void *userdata,
+		 sd_bus_error *ret_error)
+{
+	location_geoclue2_sdbus_state_t *state = userdata;
+
+	if (check_reply(m, _("Unable to set distance threshold:"
+			     " %s.\n")) < 0) {
+		state->error = 1;
+	}
+
+	return 0;
+}
+
+/* Reply to creating the client. The client is set up with calls that
+   are answered in order, so it is started last. */
+static int
+on_client_created(sd_bus_message *m, void *userdata,
+		  sd_bus_error *ret_error)
+{
+	location_geoclue2_sdbus_state_t *state = userdata;
+	state->client_pending = 0;
+
+	if (check_reply(m, _("Unable to obtain GeoClue client path:"
+			     " %s.\n")) < 0) {
+		state->error = 1;
+		return 0;
+	}
+
+	const char *path;
+	int r = sd_bus_message_read(m, "o", &path);
+	if (r < 0) {
+		state->error = 1;
+		return 0;
+	}
+
+	state->client_slot = sd_bus_slot_unref(state->client_slot);
+	r = sd_bus_match_signal_async(
+		state->bus, &state->client_slot, GEOCLUE2_NAME, path,
+		"org.freedesktop.GeoClue2.Client", "LocationUpdated",
+		on_location_updated, NULL, state);
+	if (r < 0) {
+		state->error = 1;
+		return 0;
+	}
+
+	/* Set desktop id (basename of the .desktop file). Errors are
+	   ignored since early versions of GeoClue2 lack it. */
+	sd_bus_call_method_async(
+		state->bus, NULL, GEOCLUE2_NAME, path,
+		"org.freedesktop.DBus.Properties", "Set", NULL, NULL,
+		"ssv", "org.freedesktop.GeoClue2.Client", "DesktopId",
+		"s", "redshift");
+
+	r = sd_bus_call_method_async(
+		state->bus, NULL, GEOCLUE2_NAME, path,
+		"org.freedesktop.DBus.Properties", "Set",
+		on_threshold_set, state,
+		"ssv", "org.freedesktop.GeoClue2.Client", "DistanceThreshold",
+		"u", 50000);
+	if (r < 0) {
+		state->error = 1;
+		return 0;
+	}
+
+	r = sd_bus_call_method_async(
+		state->bus, NULL, GEOCLUE2_NAME, path,
+		"org.freedesktop.GeoClue2.Client", "Start",
+		on_client_started, state, "");
+	if (r < 0) state->error = 1;
+
+	return 0;
+}
+
+/* Ask the manager for a client. This starts GeoClue if needed. */
+static int
+request_client(location_geoclue2_sdbus_state_t *state)
+{
+	state->client_pending = 1;
+	return sd_bus_call_method_async(
+		state->bus, NULL, GEOCLUE2_NAME,
+		"/org/freedesktop/GeoClue2/Manager",
+		"org.freedesktop.GeoClue2.Manager", "GetClient",
+		on_client_created, state, "");
+}
+
+/* Handle GeoClue appearing on or vanishing from the bus. */
+static int
+on_name_owner_changed(sd_bus_message *m, void *userdata,
+		      sd_bus_error *ret_error)
+{
+	location_geoclue2_sdbus_state_t *state = userdata;
+
+	const char *name, *old_owner, *new_owner;
+	int r = sd_bus_message_read(m, "sss", &name, &old_owner,
+				    &new_owner);
+	if (r < 0 || strcmp(name, GEOCLUE2_NAME) != 0) return 0;
+
+	if (new_owner[0] == '\0') {
+		state->available = 0;
+		state->client_slot = sd_bus_slot_unref(state->client_slot);
+	} else if (old_owner[0] == '\0' && state->client_slot == NULL &&
+		   !state->client_pending) {
+		/* GeoClue was restarted; set up a new client. */
+		r = request_client(state);
+		if (r < 0) state->error = 1;
+	}
+
+	return 0;
+}
+
+
+static int
+location_geoclue2_sdbus_init(location_geoclue2_sdbus_state_t **state)
+{
+	*state = malloc(sizeof(location_geoclue2_sdbus_state_t));
+	if (*state == NULL) return -1;
+
+	location_geoclue2_sdbus_state_t *s = *state;
+	s->bus = NULL;
+	s->name_slot = NULL;
+	s->client_slot = NULL;
+	s->client_pending = 0;
+	s->available = 0;
+	s->error = 0;
+	s->latitude = 0;
+	s->longitude = 0;
+
+	return 0;
+}
+
+static int
+location_geoclue2_sdbus_start(location_geoclue2_sdbus_state_t *state)
+{
+	int r = sd_bus_open_system(&state->bus);
+	if (r < 0) {
+		fprintf(stderr, _("Unable to connect to the system bus:"
+				  " %s.\n"), strerror(-r));
+		return -1;
+	}
+
+	/* Only wake up for changes of the GeoClue name. */
+	r = sd_bus_add_match_async(
+		state->bus, &state->name_slot,
+		"type='signal',sender='org.freedesktop.DBus',"
+		"interface='org.freedesktop.DBus',"
+		"member='NameOwnerChanged',arg0='" GEOCLUE2_NAME "'",
+		on_name_owner_changed, NULL, state);
+	if (r >= 0) r = request_client(state);
+
+	/* Send the requests. This waits for the connection to be set
+	   up but not for the replies. */
+	if (r >= 0) r = sd_bus_flush(state->bus);
+	if (r < 0) {
+		fputs(_("Failed to start GeoClue2 provider!\n"), stderr);
+		return -1;
+	}
+
+	return 0;
+}
+
+static void
+location_geoclue2_sdbus_free(location_geoclue2_sdbus_state_t *state)
+{
+	sd_bus_slot_unref(state->client_slot);
+	sd_bus_slot_unref(state->name_slot);
+	if (state->bus != NULL) sd_bus_flush_close_unref(state->bus);
+
+	free(state);
+}
+
+static void
+location_geoclue2_sdbus_print_help(FILE *f)
+{
+	fputs(_("Use the location as discovered by a GeoClue2 provider,"
+		" talking to it\nwith sd-bus on the main loop.\n"), f);
+	fputs("\n", f);
+}
+
+static int
+location_geoclue2_sdbus_set_option(location_geoclue2_sdbus_state_t *state,
+				   const char *key, const char *value)
+{
+	fprintf(stderr, _("Unknown method parameter: `%s'.\n"), key);
+	return -1;
+}
+
+static int
+location_geoclue2_sdbus_get_fd(location_geoclue2_sdbus_state_t *state)
+{
+	return sd_bus_get_fd(state->bus);
+}
+
+static int
+location_geoclue2_sdbus_handle(
+	location_geoclue2_sdbus_state_t *state,
+	location_t *location, int *available)
+{
+	/* Dispatch everything that was received, then send the calls
+	   made by the callbacks. */
+	int r;
+	do {
+		r = sd_bus_process(state->bus, NULL);
+	} while (r > 0);
+	if (r < 0) {
+		fprintf(stderr, _("Lost connection to the system bus:"
+				  " %s.\n"), strerror(-r));
+		return -1;
+	}
+
+	r = sd_bus_flush(state->bus);
+	if (r < 0) return -1;
+
+	if (state->error) return -1;
+
+	location->lat = state->latitude;
+	location->lon = state->longitude;
+	*available = state->available;
+
+	return 0;
+}
+
+
+const location_provider_t geoclue2_sdbus_location_provider = {
+	"geoclue2-sdbus",
+	(location_provider_init_func *)location_geoclue2_sdbus_init,
+	(location_provider_start_func *)location_geoclue2_sdbus_start,
+	(location_provider_free_func *)location_geoclue2_sdbus_free,
+	(location_provider_print_help_func *)
+	location_geoclue2_sdbus_print_help,
+	(location_provider_set_option_func *)
+	location_geoclue2_sdbus_set_option,
+	(location_provider_get_fd_func *)location_geoclue2_sdbus_get_fd,
+	(location_provider_handle_func *)location_geoclue2_sdbus_handle
+};
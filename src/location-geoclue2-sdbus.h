@@ -0,0 +1,25 @@
+/* location-geoclue2-sdbus.h -- GeoClue2 location provider using sd-bus header
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REDSHIFT_LOCATION_GEOCLUE2_SDBUS_H
+#define REDSHIFT_LOCATION_GEOCLUE2_SDBUS_H
+
+#include "redshift.h"
+
+extern const location_provider_t geoclue2_sdbus_location_provider;
+
+#endif /* ! REDSHIFT_LOCATION_GEOCLUE2_SDBUS_H */
@@ -23,6 +23,12 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#ifdef HAVE_SYS_EVENTFD_H
+# include <sys/eventfd.h>
+#endif
 
 #include <glib.h>
 #include <glib/gprintf.h>
@@ -43,11 +49,21 @@
 
 
 typedef struct {
+	GMainContext *context;
 	GMainLoop *loop;
 	GThread *thread;
-	GMutex lock;
-	int pipe_fd_read;
-	int pipe_fd_write;
+	/* Wakes up the main loop. Both are the same eventfd if
+	   supported, otherwise the ends of a pipe. */
+	int wakeup_fd_read;
+	int wakeup_fd_write;
+	/* Non-zero while a wakeup has been sent but not handled, so a
+	   burst of updates wakes the main loop once. */
+	gint wakeup_pending;
+	/* Written by the provider thread only. The sequence number is
+	   odd while an update is in progress; the main thread retries
+	   reading until it sees the same even number before and
+	   after. */
+	gint sequence;
 	int available;
 	int error;
 	float latitude;
@@ -67,17 +83,45 @@ print_denial_message()
 		"information.\n"));
 }
 
-/* Indicate an unrecoverable error during GeoClue2 communication. */
+/* Wake up the main loop unless a wakeup is already pending. */
 static void
-mark_error(location_geoclue2_state_t *state)
+send_wakeup(location_geoclue2_state_t *state)
 {
-	g_mutex_lock(&state->lock);
+	if (!g_atomic_int_compare_and_exchange(
+		    &state->wakeup_pending, 0, 1)) {
+		return;
+	}
 
-	state->error = 1;
+#ifdef HAVE_SYS_EVENTFD_H
+	uint64_t value = 1;
+	write(state->wakeup_fd_write, &value, sizeof(value));
+#else
+	pipeutils_signal(state->wakeup_fd_write);
+#endif
+}
 
-	g_mutex_unlock(&state->lock);
+/* Start and end an update of the shared state. The atomic operations
+   are full barriers, ordering the plain stores in between. */
+static void
+begin_update(location_geoclue2_state_t *state)
+{
+	g_atomic_int_inc(&state->sequence);
+}
 
-	pipeutils_signal(state->pipe_fd_write);
+static void
+end_update(location_geoclue2_state_t *state)
+{
+	g_atomic_int_inc(&state->sequence);
+	send_wakeup(state);
+}
+
+/* Indicate an unrecoverable error during GeoClue2 communication. */
+static void
+mark_error(location_geoclue2_state_t *state)
+{
+	begin_update(state);
+	state->error = 1;
+	end_update(state);
 }
 
 /* Handle position change callbacks */
@@ -115,22 +159,22 @@ geoclue_client_signal_cb(GDBusProxy *client, gchar *sender_name,
 		return;
 	}
 
-	g_mutex_lock(&state->lock);
-
 	/* Read location properties */
 	GVariant *lat_v = g_dbus_proxy_get_cached_property(
 		location, "Latitude");
-	state->latitude = g_variant_get_double(lat_v);
-
 	GVariant *lon_v = g_dbus_proxy_get_cached_property(
 		location, "Longitude");
-	state->longitude = g_variant_get_double(lon_v);
-
+	double latitude = g_variant_get_double(lat_v);
+	double longitude = g_variant_get_double(lon_v);
+	g_variant_unref(lat_v);
+	g_variant_unref(lon_v);
+	g_object_unref(location);
+
+	begin_update(state);
+	state->latitude = latitude;
+	state->longitude = longitude;
 	state->available = 1;
-
-	g_mutex_unlock(&state->lock);
-
-	pipeutils_signal(state->pipe_fd_write);
+	end_update(state);
 }
 
 /* Callback when GeoClue name appears on the bus */
@@ -281,18 +325,14 @@ on_name_vanished(GDBusConnection *connection, const gchar *name,
 {
 	location_geoclue2_state_t *state = user_data;
 
-	g_mutex_lock(&state->lock);
-
+	begin_update(state);
 	state->available = 0;
-
-	g_mutex_unlock(&state->lock);
-
-	pipeutils_signal(state->pipe_fd_write);
+	end_update(state);
 }
 
-/* Callback when the pipe to the main thread is closed. */
+/* Callback in the provider thread when the provider is freed. */
 static gboolean
-on_pipe_closed(GIOChannel *channel, GIOCondition condition, gpointer user_data)
+on_quit(gpointer user_data)
 {
 	location_geoclue2_state_t *state = user_data;
 	g_main_loop_quit(state->loop);
@@ -307,9 +347,7 @@ run_geoclue2_loop(void *state_)
 {
 	location_geoclue2_state_t *state = state_;
 
-	GMainContext *context = g_main_context_new();
-	g_main_context_push_thread_default(context);
-	state->loop = g_main_loop_new(context, FALSE);
+	g_main_context_push_thread_default(state->context);
 
 	guint watcher_id = g_bus_watch_name(
 		G_BUS_TYPE_SYSTEM,
@@ -319,24 +357,11 @@ run_geoclue2_loop(void *state_)
 		on_name_vanished,
 		state, NULL);
 
-	/* Listen for closure of pipe */
-	GIOChannel *pipe_channel = g_io_channel_unix_new(state->pipe_fd_write);
-	GSource *pipe_source = g_io_create_watch(
-		pipe_channel, G_IO_IN | G_IO_HUP | G_IO_ERR);
-        g_source_set_callback(
-		pipe_source, (GSourceFunc)on_pipe_closed, state, NULL);
-        g_source_attach(pipe_source, context);
-
 	g_main_loop_run(state->loop);
 
-	g_source_unref(pipe_source);
-	g_io_channel_unref(pipe_channel);
-	close(state->pipe_fd_write);
-
 	g_bus_unwatch_name(watcher_id);
 
-	g_main_loop_unref(state->loop);
-	g_main_context_unref(context);
+	g_main_context_pop_thread_default(state->context);
 
 	return NULL;
 }
@@ -349,33 +374,53 @@ location_geoclue2_init(location_geoclue2_state_t **state)
 #endif
 	*state = malloc(sizeof(location_geoclue2_state_t));
 	if (*state == NULL) return -1;
+
+	location_geoclue2_state_t *s = *state;
+	s->thread = NULL;
+	s->wakeup_fd_read = -1;
+	s->wakeup_fd_write = -1;
+
 	return 0;
 }
 
 static int
 location_geoclue2_start(location_geoclue2_state_t *state)
 {
-	state->pipe_fd_read = -1;
-	state->pipe_fd_write = -1;
+	state->wakeup_pending = 0;
 
+	state->sequence = 0;
 	state->available = 0;
 	state->error = 0;
 	state->latitude = 0;
 	state->longitude = 0;
 
+#ifdef HAVE_SYS_EVENTFD_H
+	int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (fd < 0) {
+		perror("eventfd");
+		fputs(_("Failed to start GeoClue2 provider!\n"), stderr);
+		return -1;
+	}
+	state->wakeup_fd_read = fd;
+	state->wakeup_fd_write = fd;
+#else
 	int pipefds[2];
 	int r = pipeutils_create_nonblocking(pipefds);
 	if (r < 0) {
 		fputs(_("Failed to start GeoClue2 provider!\n"), stderr);
 		return -1;
 	}
+	state->wakeup_fd_read = pipefds[0];
+	state->wakeup_fd_write = pipefds[1];
+#endif
 
-	state->pipe_fd_read = pipefds[0];
-	state->pipe_fd_write = pipefds[1];
-
-	pipeutils_signal(state->pipe_fd_write);
+	/* Let the main loop read the initial state. */
+	send_wakeup(state);
 
-	g_mutex_init(&state->lock);
+	/* Created here so the loop can be told to quit even before the
+	   thread runs it. */
+	state->context = g_main_context_new();
+	state->loop = g_main_loop_new(state->context, FALSE);
 	state->thread = g_thread_new("geoclue2", run_geoclue2_loop, state);
 
 	return 0;
@@ -384,15 +429,24 @@ location_geoclue2_start(location_geoclue2_state_t *state)
 static void
 location_geoclue2_free(location_geoclue2_state_t *state)
 {
-	if (state->pipe_fd_read != -1) {
-		close(state->pipe_fd_read);
-	}
+	if (state->thread != NULL) {
+		GSource *source = g_idle_source_new();
+		g_source_set_callback(source, on_quit, state, NULL);
+		g_source_attach(source, state->context);
+		g_source_unref(source);
+
+		g_thread_join(state->thread);
+		state->thread = NULL;
 
-	/* Closing the pipe should cause the thread to exit. */
-	g_thread_join(state->thread);
-	state->thread = NULL;
+		g_main_loop_unref(state->loop);
+		g_main_context_unref(state->context);
+	}
 
-	g_mutex_clear(&state->lock);
+	if (state->wakeup_fd_read != -1) close(state->wakeup_fd_read);
+	if (state->wakeup_fd_write != -1 &&
+	    state->wakeup_fd_write != state->wakeup_fd_read) {
+		close(state->wakeup_fd_write);
+	}
 
 	free(state);
 }
@@ -416,7 +470,7 @@ location_geoclue2_set_option(location_geoclue2_state_t *state,
 static int
 location_geoclue2_get_fd(location_geoclue2_state_t *state)
 {
-	return state->pipe_fd_read;
+	return state->wakeup_fd_read;
 }
 
 static int
@@ -424,16 +478,29 @@ location_geoclue2_handle(
 	location_geoclue2_state_t *state,
 	location_t *location, int *available)
 {
-	pipeutils_handle_signal(state->pipe_fd_read);
-
-	g_mutex_lock(&state->lock);
-
-	int error = state->error;
-	location->lat = state->latitude;
-	location->lon = state->longitude;
-	*available = state->available;
+	/* No wakeup is sent while one is pending, so clear the flag
+	   after taking the wakeup and before reading. An update made
+	   after this point sends a new one. */
+#ifdef HAVE_SYS_EVENTFD_H
+	uint64_t value;
+	read(state->wakeup_fd_read, &value, sizeof(value));
+#else
+	pipeutils_handle_signal(state->wakeup_fd_read);
+#endif
+	g_atomic_int_set(&state->wakeup_pending, 0);
 
-	g_mutex_unlock(&state->lock);
+	/* Never blocks on the provider thread; an update only makes
+	   the copy be taken again. */
+	int error;
+	gint sequence;
+	do {
+		sequence = g_atomic_int_get(&state->sequence);
+		error = state->error;
+		location->lat = state->latitude;
+		location->lon = state->longitude;
+		*available = state->available;
+	} while ((sequence & 1) != 0 ||
+		 g_atomic_int_get(&state->sequence) != sequence);
 
 	if (error) return -1;
 
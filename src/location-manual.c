@@ -61,7 +61,7 @@ location_manual_start(location_manual_state_t *state)
 	/* Latitude and longitude must be set */
 	if (isnan(state->loc.lat) || isnan(state->loc.lon)) {
 		fputs(_("Latitude and longitude must be set.\n"), stderr);
-		exit(EXIT_FAILURE);
+		return -1;
 	}
 
 	return 0;
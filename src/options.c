@@ -23,9 +23,11 @@
 
 #include <stdlib.h>
 #include <unistd.h>
+#include <getopt.h>
 #include <string.h>
 #include <errno.h>
 #include <math.h>
+#include <time.h>
 
 #ifdef ENABLE_NLS
 # include <libintl.h>
@@ -52,6 +54,23 @@
 #define DEFAULT_BRIGHTNESS   1.0
 #define DEFAULT_GAMMA        1.0
 
+/* Values returned by getopt_long() for options without a short form. */
+#define OPTION_STATS            256
+#define OPTION_FORECAST         257
+#define OPTION_FORECAST_STEP    258
+#define OPTION_FORECAST_START   259
+#define OPTION_FORECAST_FORMAT  260
+#define OPTION_SITES            261
+#define OPTION_SIMULATE         262
+#define OPTION_SIMULATE_START   263
+#define OPTION_CONTROL_SOCKET   264
+
+/* Default seconds between rows in forecast mode, and bounds. */
+#define DEFAULT_FORECAST_STEP  600
+#define MAX_FORECAST_STEP      86400
+#define MAX_FORECAST_DAYS      36600
+#define MAX_SIMULATE_DAYS      36600
+
 
 /* A brightness string contains either one floating point value,
    or two values separated by a colon. */
@@ -170,7 +189,36 @@ print_help(const char *program_name)
 	   no-wrap */
 	fputs(_("  -h\t\tDisplay this help message\n"
 		"  -v\t\tVerbose output\n"
-		"  -V\t\tShow program version\n"), stdout);
+		"  -V\t\tShow program version\n"
+		"  --stats\tPrint timing statistics at exit\n"
+		"  --control-socket PATH\tListen for commands on a Unix"
+		" domain socket\n"), stdout);
+	fputs("\n", stdout);
+
+	/* TRANSLATORS: help output 3b
+	   `csv', `json' and `-' must not be translated
+	   no-wrap */
+	fputs(_("  --forecast DAYS\tPrint color settings for the next DAYS"
+		" days and exit\n"
+		"  --forecast-step SEC\tSeconds between rows, or 0 for"
+		" times of solar\n"
+		"  \t\t\tevents (default 600)\n"
+		"  --forecast-start DATE\tFirst day as YYYY-MM-DD or"
+		" seconds since epoch\n"
+		"  --forecast-format FMT\tOutput `csv' (default) or `json'\n"
+		"  --sites FILE\t\tForecast for each LAT:LON line of FILE"
+		" (`-' for stdin)\n"), stdout);
+	fputs("\n", stdout);
+
+	/* TRANSLATORS: help output 3c
+	   `record' must not be translated
+	   no-wrap */
+	fputs(_("  --simulate DAYS\tRun DAYS days on a virtual clock and exit"
+		" (method\n"
+		"  \t\t\t`record' unless given with -m)\n"
+		"  --simulate-start DATE\tStart of simulation as YYYY-MM-DD or"
+		" seconds\n"
+		"  \t\t\tsince epoch\n"), stdout);
 	fputs("\n", stdout);
 
 	/* TRANSLATORS: help output 4
@@ -184,7 +232,8 @@ print_help(const char *program_name)
 		" location updates\n"
 		"  \t\t(Type `list' to see available providers)\n"
 		"  -m METHOD\tMethod to use to set color temperature\n"
-		"  \t\t(Type `list' to see available methods)\n"
+		"  \t\t(Type `list' to see available methods,"
+		" repeat to adjust several)\n"
 		"  -o\t\tOne shot mode (do not continuously adjust"
 		" color temperature)\n"
 		"  -O TEMP\tOne shot manual mode (set color temperature)\n"
@@ -315,12 +364,33 @@ options_init(options_t *options)
 
 	options->method = NULL;
 	options->method_args = NULL;
+	options->target_count = 0;
 
 	options->provider = NULL;
 	options->provider_args = NULL;
 
+	options->output_count = 0;
+
 	options->use_fade = -1;
+	options->fade_vsync = -1;
 	options->preserve_gamma = 1;
+	options->reapply_interval = -1;
+	options->adaptive_steps = -1;
+	options->min_temp_step = -1;
+	options->min_brightness_step = NAN;
+	options->control_socket = NULL;
+	options->stats = 0;
+	options->parallel_probe = -1;
+	options->probe_timeout = NAN;
+	options->location_cache = -1;
+	options->status_page = -1;
+	options->forecast_days = 0;
+	options->forecast_step = DEFAULT_FORECAST_STEP;
+	options->forecast_start = NAN;
+	options->forecast_format = FORECAST_FORMAT_CSV;
+	options->sites_filepath = NULL;
+	options->simulate_days = 0;
+	options->simulate_start = NAN;
 	options->mode = PROGRAM_MODE_CONTINUAL;
 	options->verbose = 0;
 }
@@ -416,16 +486,25 @@ parse_command_line_option(
 			exit(EXIT_SUCCESS);
 		}
 
+		if (options->target_count == MAX_GAMMA_TARGETS) {
+			fprintf(stderr, _("At most %i adjustment targets can"
+					  " be used.\n"), MAX_GAMMA_TARGETS);
+			return -1;
+		}
+		gamma_target_t *target =
+			&options->targets[options->target_count];
+
 		/* Split off method arguments. */
+		target->args = NULL;
 		s = strchr(value, ':');
 		if (s != NULL) {
 			*(s++) = '\0';
-			options->method_args = s;
+			target->args = s;
 		}
 
 		/* Find adjustment method by name. */
-		options->method = find_gamma_method(gamma_methods, value);
-		if (options->method == NULL) {
+		target->method = find_gamma_method(gamma_methods, value);
+		if (target->method == NULL) {
 			/* TRANSLATORS: This refers to the method
 			   used to adjust colors e.g VidMode */
 			fprintf(stderr, _("Unknown adjustment method `%s'.\n"),
@@ -434,11 +513,18 @@ parse_command_line_option(
 		}
 
 		/* Print method help if arg is `help'. */
-		if (options->method_args != NULL &&
-		    strcasecmp(options->method_args, "help") == 0) {
-			options->method->print_help(stdout);
+		if (target->args != NULL &&
+		    strcasecmp(target->args, "help") == 0) {
+			target->method->print_help(stdout);
 			exit(EXIT_SUCCESS);
 		}
+
+		/* The first -m selects the method; with more than one
+		   all of them are adjusted. */
+		if (options->target_count++ == 0) {
+			options->method = target->method;
+			options->method_args = target->args;
+		}
 		break;
 	case 'o':
 		options->mode = PROGRAM_MODE_ONE_SHOT;
@@ -486,6 +572,124 @@ parse_command_line_option(
 	return 0;
 }
 
+/* Parse start of forecast or simulation, either a local date as
+   YYYY-MM-DD or seconds since epoch. Returns -1 if malformed. */
+static int
+parse_start_date(const char *str, double *start)
+{
+	int year, month, day;
+	char c;
+	if (sscanf(str, "%d-%d-%d%c", &year, &month, &day, &c) == 3) {
+		if (month < 1 || month > 12 || day < 1 || day > 31) return -1;
+
+		struct tm tm = { 0 };
+		tm.tm_year = year - 1900;
+		tm.tm_mon = month - 1;
+		tm.tm_mday = day;
+		tm.tm_isdst = -1;
+		time_t t = mktime(&tm);
+		if (t == (time_t)-1) return -1;
+
+		*start = t;
+		return 0;
+	}
+
+	errno = 0;
+	char *end;
+	double t = strtod(str, &end);
+	if (errno != 0 || end == str || end[0] != '\0') return -1;
+
+	*start = t;
+	return 0;
+}
+
+/* Parse a whole number between MIN and MAX. Returns -1 if malformed. */
+static int
+parse_bounded_int(const char *str, long min, long max, int *value)
+{
+	errno = 0;
+	char *end;
+	long v = strtol(str, &end, 10);
+	if (errno != 0 || end == str || end[0] != '\0' ||
+	    v < min || v > max) {
+		return -1;
+	}
+
+	*value = v;
+	return 0;
+}
+
+/* Parse a single option without a short form from the command-line. */
+static int
+parse_long_option(int option, char *value, options_t *options)
+{
+	int r = 0;
+
+	switch (option) {
+	case OPTION_STATS:
+		options->stats = 1;
+		break;
+	case OPTION_FORECAST:
+		options->mode = PROGRAM_MODE_FORECAST;
+		r = parse_bounded_int(value, 1, MAX_FORECAST_DAYS,
+				      &options->forecast_days);
+		if (r < 0) {
+			fprintf(stderr, _("Forecast must cover between 1 and"
+					  " %i days.\n"), MAX_FORECAST_DAYS);
+		}
+		break;
+	case OPTION_FORECAST_STEP:
+		r = parse_bounded_int(value, 0, MAX_FORECAST_STEP,
+				      &options->forecast_step);
+		if (r < 0) {
+			fprintf(stderr, _("Forecast step must be between 0 and"
+					  " %i seconds.\n"), MAX_FORECAST_STEP);
+		}
+		break;
+	case OPTION_FORECAST_START:
+		r = parse_start_date(value, &options->forecast_start);
+		if (r < 0) fputs(_("Malformed forecast start.\n"), stderr);
+		break;
+	case OPTION_FORECAST_FORMAT:
+		if (strcasecmp(value, "csv") == 0) {
+			options->forecast_format = FORECAST_FORMAT_CSV;
+		} else if (strcasecmp(value, "json") == 0) {
+			options->forecast_format = FORECAST_FORMAT_JSON;
+		} else {
+			fprintf(stderr, _("Unknown forecast format `%s'.\n"),
+				value);
+			r = -1;
+		}
+		break;
+	case OPTION_SITES:
+		free(options->sites_filepath);
+		options->sites_filepath = strdup(value);
+		break;
+	case OPTION_SIMULATE:
+		r = parse_bounded_int(value, 1, MAX_SIMULATE_DAYS,
+				      &options->simulate_days);
+		if (r < 0) {
+			fprintf(stderr, _("Simulation must cover between 1 and"
+					  " %i days.\n"), MAX_SIMULATE_DAYS);
+		}
+		break;
+	case OPTION_SIMULATE_START:
+		r = parse_start_date(value, &options->simulate_start);
+		if (r < 0) fputs(_("Malformed simulation start.\n"), stderr);
+		break;
+	case OPTION_CONTROL_SOCKET:
+		free(options->control_socket);
+		options->control_socket = strdup(value);
+		break;
+	}
+
+	if (r < 0) {
+		fputs(_("Try `-h' for more information.\n"), stderr);
+	}
+
+	return r;
+}
+
 /* Parse command line arguments. */
 void
 options_parse_args(
@@ -493,9 +697,34 @@ options_parse_args(
 	const gamma_method_t *gamma_methods,
 	const location_provider_t *location_providers)
 {
+	static const struct option long_options[] = {
+		{ "stats", no_argument, NULL, OPTION_STATS },
+		{ "forecast", required_argument, NULL, OPTION_FORECAST },
+		{ "forecast-step", required_argument, NULL,
+		  OPTION_FORECAST_STEP },
+		{ "forecast-start", required_argument, NULL,
+		  OPTION_FORECAST_START },
+		{ "forecast-format", required_argument, NULL,
+		  OPTION_FORECAST_FORMAT },
+		{ "sites", required_argument, NULL, OPTION_SITES },
+		{ "simulate", required_argument, NULL, OPTION_SIMULATE },
+		{ "simulate-start", required_argument, NULL,
+		  OPTION_SIMULATE_START },
+		{ "control-socket", required_argument, NULL,
+		  OPTION_CONTROL_SOCKET },
+		{ NULL, 0, NULL, 0 }
+	};
+
 	const char* program_name = argv[0];
 	int opt;
-	while ((opt = getopt(argc, argv, "b:c:g:hl:m:oO:pPrt:vVx")) != -1) {
+	while ((opt = getopt_long(argc, argv, "b:c:g:hl:m:oO:pPrt:vVx",
+				  long_options, NULL)) != -1) {
+		if (opt >= OPTION_STATS) {
+			int r = parse_long_option(opt, optarg, options);
+			if (r < 0) exit(EXIT_FAILURE);
+			continue;
+		}
+
 		char option = opt;
 		int r = parse_command_line_option(
 			option, optarg, options, program_name, gamma_methods,
@@ -526,6 +755,70 @@ parse_config_file_option(
 		if (options->use_fade < 0) {
 			options->use_fade = !!atoi(value);
 		}
+	} else if (strcasecmp(key, "fade-vsync") == 0) {
+		if (options->fade_vsync < 0) {
+			options->fade_vsync = !!atoi(value);
+		}
+	} else if (strcasecmp(key, "reapply-interval") == 0) {
+		if (options->reapply_interval < 0) {
+			options->reapply_interval = atoi(value);
+			if (options->reapply_interval < 0) {
+				fputs(_("Reapply interval must not be"
+					" negative.\n"), stderr);
+				return -1;
+			}
+		}
+	} else if (strcasecmp(key, "adaptive-steps") == 0) {
+		if (options->adaptive_steps < 0) {
+			options->adaptive_steps = !!atoi(value);
+		}
+	} else if (strcasecmp(key, "min-temp-step") == 0) {
+		if (options->min_temp_step < 0) {
+			options->min_temp_step = atoi(value);
+			if (options->min_temp_step < 1) {
+				fputs(_("Minimum temperature step must be"
+					" positive.\n"), stderr);
+				return -1;
+			}
+		}
+	} else if (strcasecmp(key, "min-brightness-step") == 0) {
+		if (isnan(options->min_brightness_step)) {
+			options->min_brightness_step = atof(value);
+			if (!(options->min_brightness_step > 0)) {
+				fputs(_("Minimum brightness step must be"
+					" positive.\n"), stderr);
+				return -1;
+			}
+		}
+	} else if (strcasecmp(key, "control-socket") == 0) {
+		if (options->control_socket == NULL) {
+			options->control_socket = strdup(value);
+			if (options->control_socket == NULL) {
+				perror("strdup");
+				return -1;
+			}
+		}
+	} else if (strcasecmp(key, "parallel-probe") == 0) {
+		if (options->parallel_probe < 0) {
+			options->parallel_probe = !!atoi(value);
+		}
+	} else if (strcasecmp(key, "location-cache") == 0) {
+		if (options->location_cache < 0) {
+			options->location_cache = !!atoi(value);
+		}
+	} else if (strcasecmp(key, "status-page") == 0) {
+		if (options->status_page < 0) {
+			options->status_page = !!atoi(value);
+		}
+	} else if (strcasecmp(key, "probe-timeout") == 0) {
+		if (isnan(options->probe_timeout)) {
+			options->probe_timeout = atof(value);
+			if (!(options->probe_timeout > 0)) {
+				fputs(_("Probe timeout must be positive.\n"),
+				      stderr);
+				return -1;
+			}
+		}
 	} else if (strcasecmp(key, "brightness") == 0) {
 		if (isnan(options->scheme.day.brightness)) {
 			options->scheme.day.brightness = atof(value);
@@ -623,8 +916,9 @@ parse_config_file_option(
 	return 0;
 }
 
-/* Parse options defined in the config file. */
-void
+/* Parse options defined in the config file. Returns -1 if a setting
+   is invalid. */
+int
 options_parse_config_file(
 	options_t *options, config_ini_state_t *config_state,
 	const gamma_method_t *gamma_methods,
@@ -633,17 +927,19 @@ options_parse_config_file(
 	/* Read global config settings. */
 	config_ini_section_t *section = config_ini_get_section(
 		config_state, "redshift");
-	if (section == NULL) return;
+	if (section == NULL) return 0;
 
 	config_ini_setting_t *setting = section->settings;
 	while (setting != NULL) {
 		int r = parse_config_file_option(
 			setting->name, setting->value, options,
 			gamma_methods, location_providers);
-		if (r < 0) exit(EXIT_FAILURE);
+		if (r < 0) return -1;
 
 		setting = setting->next;
 	}
+
+	return 0;
 }
 
 /* Replace unspecified options with default values. */
@@ -676,4 +972,119 @@ options_set_defaults(options_t *options)
 	}
 
 	if (options->use_fade < 0) options->use_fade = 1;
+	if (options->fade_vsync < 0) options->fade_vsync = 0;
+	if (options->reapply_interval < 0) options->reapply_interval = 0;
+	if (options->adaptive_steps < 0) options->adaptive_steps = 0;
+	if (options->min_temp_step < 0) options->min_temp_step = 10;
+	if (isnan(options->min_brightness_step)) {
+		options->min_brightness_step = 0.005;
+	}
+	if (options->parallel_probe < 0) options->parallel_probe = 0;
+	if (options->location_cache < 0) options->location_cache = 1;
+	if (options->status_page < 0) options->status_page = 1;
+	if (isnan(options->probe_timeout)) options->probe_timeout = 5.0;
+}
+
+/* Read color schemes of outputs from [output:NAME] sections. Settings
+   that are not given are taken from the main scheme, so defaults must
+   have been set. Returns -1 on error. */
+int
+options_parse_output_sections(
+	options_t *options, config_ini_state_t *config_state)
+{
+	static const char *keys[] = {
+		"temp-day", "temp-night", "brightness", "brightness-day",
+		"brightness-night", "gamma", "gamma-day", "gamma-night"
+	};
+
+	options->output_count = 0;
+
+	config_ini_section_t *section = config_state->sections;
+	for (; section != NULL; section = section->next) {
+		if (strncasecmp(section->name, "output:", 7) != 0) continue;
+
+		const char *name = &section->name[7];
+		if (name[0] == '\0' || strlen(name) >= OUTPUT_NAME_MAX) {
+			fprintf(stderr, _("Invalid output name in section"
+					  " `%s'.\n"), section->name);
+			return -1;
+		}
+
+		/* Only the last section of a name is used. */
+		if (config_ini_get_section(config_state, section->name) !=
+		    section) {
+			continue;
+		}
+
+		if (options->output_count == MAX_OUTPUT_SCHEMES) {
+			fprintf(stderr, _("At most %d output sections are"
+					  " supported.\n"),
+				MAX_OUTPUT_SCHEMES);
+			return -1;
+		}
+
+		config_ini_setting_t *setting = section->settings;
+		for (; setting != NULL; setting = setting->next) {
+			int known = 0;
+			for (int i = 0; i < sizeof(keys)/sizeof(keys[0]); i++) {
+				if (strcasecmp(setting->name, keys[i]) == 0) {
+					known = 1;
+				}
+			}
+			if (!known) {
+				fprintf(stderr, _("Unknown setting `%s' in"
+						  " section `%s'.\n"),
+					setting->name, section->name);
+				return -1;
+			}
+		}
+
+		output_scheme_t *output =
+			&options->outputs[options->output_count++];
+		strcpy(output->name, name);
+		output->scheme = options->scheme;
+		transition_scheme_t *scheme = &output->scheme;
+
+		/* Apply general settings before day and night ones. */
+		const char *n = section->name;
+		const char *value;
+		value = config_ini_get_value(config_state, n, "temp-day");
+		if (value != NULL) scheme->day.temperature = atoi(value);
+		value = config_ini_get_value(config_state, n, "temp-night");
+		if (value != NULL) scheme->night.temperature = atoi(value);
+
+		value = config_ini_get_value(config_state, n, "brightness");
+		if (value != NULL) {
+			scheme->day.brightness = atof(value);
+			scheme->night.brightness = atof(value);
+		}
+		value = config_ini_get_value(
+			config_state, n, "brightness-day");
+		if (value != NULL) scheme->day.brightness = atof(value);
+		value = config_ini_get_value(
+			config_state, n, "brightness-night");
+		if (value != NULL) scheme->night.brightness = atof(value);
+
+		int r = 0;
+		value = config_ini_get_value(config_state, n, "gamma");
+		if (value != NULL) {
+			r = parse_gamma_string(value, scheme->day.gamma);
+			memcpy(scheme->night.gamma, scheme->day.gamma,
+			       sizeof(scheme->night.gamma));
+		}
+		value = config_ini_get_value(config_state, n, "gamma-day");
+		if (value != NULL && r == 0) {
+			r = parse_gamma_string(value, scheme->day.gamma);
+		}
+		value = config_ini_get_value(config_state, n, "gamma-night");
+		if (value != NULL && r == 0) {
+			r = parse_gamma_string(value, scheme->night.gamma);
+		}
+		if (r < 0) {
+			fputs(_("Malformed gamma setting.\n"), stderr);
+			return -1;
+		}
+	}
+
+	return 0;
 }
@@ -21,6 +21,24 @@
 #define REDSHIFT_OPTIONS_H
 
 #include "redshift.h"
+#include "gamma-multi.h"
+#include "forecast.h"
+
+/* Most outputs with their own color scheme, and longest name. */
+#define MAX_OUTPUT_SCHEMES  8
+#define OUTPUT_NAME_MAX    64
+
+/* Color scheme of an output from an [output:NAME] config section. */
+typedef struct {
+	char name[OUTPUT_NAME_MAX];
+	transition_scheme_t scheme;
+} output_scheme_t;
+
+/* Gamma method with its arguments from a -m option. */
+typedef struct {
+	const gamma_method_t *method;
+	char *args;
+} gamma_target_t;
 
 typedef struct {
 	/* Path to config file */
@@ -34,13 +52,57 @@ typedef struct {
 	int temp_set;
 	/* Whether to fade between large skips in color temperature. */
 	int use_fade;
+	/* Whether to synchronize fade steps with vertical blank. */
+	int fade_vsync;
 	/* Whether to preserve gamma ramps if supported by gamma method. */
 	int preserve_gamma;
+	/* Seconds after which an unchanged color setting is applied
+	   again in continual mode, or 0 to never reapply it. */
+	int reapply_interval;
+	/* Whether to schedule updates based on how fast the color
+	   setting changes, and the smallest changes to step by. */
+	int adaptive_steps;
+	int min_temp_step;
+	float min_brightness_step;
+	/* Path of control socket in continual mode, or NULL. */
+	char *control_socket;
+	/* Whether to print timing statistics at exit. */
+	int stats;
+	/* Whether to probe gamma methods and location providers at the
+	   same time, and seconds to wait for them. */
+	int parallel_probe;
+	float probe_timeout;
+	/* Whether to start from the last known location while the
+	   location provider is not ready. */
+	int location_cache;
+	/* Whether to publish the status in $XDG_RUNTIME_DIR in
+	   continual mode. */
+	int status_page;
+
+	/* Days, seconds between rows, start and format of forecast
+	   mode. Start is NAN for the start of the current day. */
+	int forecast_days;
+	int forecast_step;
+	double forecast_start;
+	forecast_format_t forecast_format;
+	/* Path to list of locations for forecast mode, or NULL. */
+	char *sites_filepath;
+	/* Days to run continual mode on a virtual clock, or 0 to use
+	   the system clock. Start as for forecast mode. */
+	int simulate_days;
+	double simulate_start;
+
+	/* Outputs with their own color scheme. */
+	output_scheme_t outputs[MAX_OUTPUT_SCHEMES];
+	int output_count;
 
 	/* Selected gamma method. */
 	const gamma_method_t *method;
 	/* Arguments for gamma method. */
 	char *method_args;
+	/* Methods given with -m, are all adjusted if more than one. */
+	gamma_target_t targets[MAX_GAMMA_TARGETS];
+	int target_count;
 
 	/* Selected location provider. */
 	const location_provider_t *provider;
@@ -54,10 +116,12 @@ void options_parse_args(
 	options_t *options, int argc, char *argv[],
 	const gamma_method_t *gamma_methods,
 	const location_provider_t *location_providers);
-void options_parse_config_file(
+int options_parse_config_file(
 	options_t *options, config_ini_state_t *config_state,
 	const gamma_method_t *gamma_methods,
 	const location_provider_t *location_providers);
 void options_set_defaults(options_t *options);
+int options_parse_output_sections(
+	options_t *options, config_ini_state_t *config_state);
 
 #endif /* ! REDSHIFT_OPTIONS_H */
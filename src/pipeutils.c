@@ -24,7 +24,8 @@
 
 #ifndef _WIN32
 
-/* Create non-blocking set of pipe fds. */
+/* Create non-blocking set of pipe fds. Both ends are closed on exec
+   so that spawned programs do not keep the pipe open. */
 int
 pipeutils_create_nonblocking(int pipefds[2])
 {
@@ -34,36 +35,24 @@ pipeutils_create_nonblocking(int pipefds[2])
 		return -1;
 	}
 
-	int flags = fcntl(pipefds[0], F_GETFL);
-	if (flags == -1) {
-		perror("fcntl");
-		close(pipefds[0]);
-		close(pipefds[1]);
-		return -1;
-	}
-
-	r = fcntl(pipefds[0], F_SETFL, flags | O_NONBLOCK);
-	if (r == -1) {
-		perror("fcntl");
-		close(pipefds[0]);
-		close(pipefds[1]);
-		return -1;
-	}
-
-	flags = fcntl(pipefds[1], F_GETFL);
-	if (flags == -1) {
-		perror("fcntl");
-		close(pipefds[0]);
-		close(pipefds[1]);
-		return -1;
-	}
-
-	r = fcntl(pipefds[1], F_SETFL, flags | O_NONBLOCK);
-	if (r == -1) {
-		perror("fcntl");
-		close(pipefds[0]);
-		close(pipefds[1]);
-		return -1;
+	for (int i = 0; i < 2; i++) {
+		int flags = fcntl(pipefds[i], F_GETFL);
+		if (flags == -1 ||
+		    fcntl(pipefds[i], F_SETFL, flags | O_NONBLOCK) == -1) {
+			perror("fcntl");
+			close(pipefds[0]);
+			close(pipefds[1]);
+			return -1;
+		}
+
+		flags = fcntl(pipefds[i], F_GETFD);
+		if (flags == -1 ||
+		    fcntl(pipefds[i], F_SETFD, flags | FD_CLOEXEC) == -1) {
+			perror("fcntl");
+			close(pipefds[0]);
+			close(pipefds[1]);
+			return -1;
+		}
 	}
 
 	return 0;
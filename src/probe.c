@@ -0,0 +1,244 @@
+/* probe.c -- Parallel probing of methods and providers source
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+
+#ifdef HAVE_PTHREAD_H
+# include <pthread.h>
+#endif
+
+#include "probe.h"
+
+
+#ifdef HAVE_PTHREAD_H
+
+typedef enum {
+	PROBE_RUNNING,
+	PROBE_STARTED,
+	PROBE_FAILED
+} probe_result_t;
+
+typedef struct probe probe_t;
+
+typedef struct {
+	probe_t *probe;
+	const void *candidate;
+	void *state;
+	probe_result_t result;
+} probe_entry_t;
+
+/* Shared by the calling thread and the probing threads. It is freed
+   by whichever lets go of it last, since threads that miss the
+   deadline can not be stopped and keep running. */
+struct probe {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	probe_start_func *start;
+	probe_free_func *free_state;
+	void *data;
+	/* Set when a candidate has been chosen. Threads finishing
+	   after that free their own state. */
+	int done;
+	int refs;
+	int count;
+	probe_entry_t entries[];
+};
+
+/* Number of threads left running by previous calls. */
+static int pending = 0;
+static pthread_mutex_t pending_lock = PTHREAD_MUTEX_INITIALIZER;
+
+
+static void
+probe_unref(probe_t *probe)
+{
+	int refs = --probe->refs;
+	pthread_mutex_unlock(&probe->lock);
+	if (refs > 0) return;
+
+	pthread_cond_destroy(&probe->cond);
+	pthread_mutex_destroy(&probe->lock);
+	free(probe);
+}
+
+static void *
+probe_thread(void *data)
+{
+	probe_entry_t *entry = data;
+	probe_t *probe = entry->probe;
+
+	void *state = NULL;
+	int r = probe->start(entry->candidate, &state, probe->data);
+
+	pthread_mutex_lock(&probe->lock);
+	if (probe->done) {
+		if (r == 0) probe->free_state(entry->candidate, state);
+		pthread_mutex_lock(&pending_lock);
+		pending -= 1;
+		pthread_mutex_unlock(&pending_lock);
+	} else {
+		entry->state = state;
+		entry->result = r < 0 ? PROBE_FAILED : PROBE_STARTED;
+		pthread_cond_signal(&probe->cond);
+	}
+	probe_unref(probe);
+
+	return NULL;
+}
+
+/* Start all candidates at the same time and wait up to TIMEOUT
+   seconds. The first candidate in list order that started is chosen,
+   once all candidates before it have failed or the time is up. The
+   others are freed. Returns the index of the chosen candidate, or -1
+   if none started. */
+int
+probe_start(const void *const *candidates, int count,
+	    probe_start_func *start, probe_free_func *free_state,
+	    void *data, double timeout, void **state)
+{
+	probe_t *probe = malloc(sizeof(probe_t) +
+				count*sizeof(probe_entry_t));
+	if (probe == NULL) {
+		perror("malloc");
+		return -1;
+	}
+
+	pthread_mutex_init(&probe->lock, NULL);
+	pthread_cond_init(&probe->cond, NULL);
+	probe->start = start;
+	probe->free_state = free_state;
+	probe->data = data;
+	probe->done = 0;
+	probe->refs = 1;
+	probe->count = count;
+
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+	pthread_mutex_lock(&probe->lock);
+	for (int i = 0; i < count; i++) {
+		probe_entry_t *entry = &probe->entries[i];
+		entry->probe = probe;
+		entry->candidate = candidates[i];
+		entry->state = NULL;
+		entry->result = PROBE_RUNNING;
+
+		pthread_t thread;
+		int r = pthread_create(&thread, &attr, probe_thread, entry);
+		if (r != 0) {
+			entry->result = PROBE_FAILED;
+			continue;
+		}
+		probe->refs += 1;
+	}
+	pthread_attr_destroy(&attr);
+
+	struct timespec deadline;
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	double seconds = floor(timeout);
+	deadline.tv_sec += seconds;
+	deadline.tv_nsec += (timeout - seconds)*1000000000.0;
+	if (deadline.tv_nsec >= 1000000000) {
+		deadline.tv_sec += 1;
+		deadline.tv_nsec -= 1000000000;
+	}
+
+	int chosen = -1;
+	int timed_out = 0;
+	while (1) {
+		int i = 0;
+		while (i < count &&
+		       (probe->entries[i].result == PROBE_FAILED ||
+			(timed_out &&
+			 probe->entries[i].result == PROBE_RUNNING))) {
+			i += 1;
+		}
+		if (i == count) break;
+		if (probe->entries[i].result == PROBE_STARTED) {
+			chosen = i;
+			break;
+		}
+		if (timed_out) break;
+
+		int r = pthread_cond_timedwait(&probe->cond, &probe->lock,
+					       &deadline);
+		if (r == ETIMEDOUT) timed_out = 1;
+	}
+
+	/* Free the others. Those still running free themselves. */
+	probe->done = 1;
+	for (int i = 0; i < count; i++) {
+		probe_entry_t *entry = &probe->entries[i];
+		if (entry->result == PROBE_STARTED && i != chosen) {
+			free_state(entry->candidate, entry->state);
+		} else if (entry->result == PROBE_RUNNING) {
+			pthread_mutex_lock(&pending_lock);
+			pending += 1;
+			pthread_mutex_unlock(&pending_lock);
+		}
+	}
+
+	if (chosen >= 0) *state = probe->entries[chosen].state;
+	probe_unref(probe);
+
+	return chosen;
+}
+
+/* Return non-zero if threads of earlier probes are still running.
+   Data passed to them must not be freed in that case. */
+int
+probe_pending(void)
+{
+	pthread_mutex_lock(&pending_lock);
+	int r = pending;
+	pthread_mutex_unlock(&pending_lock);
+	return r;
+}
+
+#else /* ! HAVE_PTHREAD_H */
+
+/* Without threads the candidates are tried one at a time and the
+   timeout is not enforced. */
+int
+probe_start(const void *const *candidates, int count,
+	    probe_start_func *start, probe_free_func *free_state,
+	    void *data, double timeout, void **state)
+{
+	for (int i = 0; i < count; i++) {
+		int r = start(candidates[i], state, data);
+		if (r == 0) return i;
+	}
+
+	return -1;
+}
+
+int
+probe_pending(void)
+{
+	return 0;
+}
+
+#endif /* ! HAVE_PTHREAD_H */
@@ -0,0 +1,32 @@
+/* probe.h -- Parallel probing of methods and providers header
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REDSHIFT_PROBE_H
+#define REDSHIFT_PROBE_H
+
+/* Start CANDIDATE and store its state. Returns 0 on success or -1. */
+typedef int probe_start_func(const void *candidate, void **state,
+			     void *data);
+/* Free state of a started CANDIDATE. */
+typedef void probe_free_func(const void *candidate, void *state);
+
+int probe_start(const void *const *candidates, int count,
+		probe_start_func *start, probe_free_func *free_state,
+		void *data, double timeout, void **state);
+int probe_pending(void);
+
+#endif /* ! REDSHIFT_PROBE_H */
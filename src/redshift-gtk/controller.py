@@ -18,8 +18,13 @@
 
 import os
 import re
+import sys
+import json
 import fcntl
 import signal
+import socket
+import subprocess
+from collections import deque
 
 import gi
 gi.require_version('GLib', '2.0')
@@ -29,8 +34,44 @@ from gi.repository import GLib, GObject
 from . import defs
 
 
+# Milliseconds between attempts to connect to the control socket while the
+# child process is starting.
+CONNECT_INTERVAL = 200
+
+# Milliseconds to collect status updates before the interface is refreshed.
+# Updates arrive at every step of a fade.
+UPDATE_INTERVAL = 250
+
+# Period names reported on the control socket, as shown in verbose output.
+PERIOD_NAMES = {
+    'none': 'None',
+    'daytime': 'Daytime',
+    'night': 'Night',
+    'transition': 'Transition',
+}
+
+
+def supports_control_socket(program):
+    """Return True if program accepts the --control-socket option."""
+    env = os.environ.copy()
+    for key in ('LANG', 'LANGUAGE', 'LC_ALL', 'LC_MESSAGES'):
+        env[key] = 'C'
+    try:
+        output = subprocess.check_output(
+            [program, '-h'], env=env, stderr=subprocess.STDOUT)
+    except (OSError, subprocess.CalledProcessError):
+        return False
+    return b'--control-socket' in output
+
+
 class RedshiftController(GObject.GObject):
-    """GObject wrapper around the Redshift child process."""
+    """GObject wrapper around the Redshift child process.
+
+    The child process is controlled through its control socket, which
+    sends the status whenever it changes. With versions of Redshift that
+    have no control socket, the verbose output of the child is parsed
+    instead and it is toggled with SIGUSR1.
+    """
 
     __gsignals__ = {
         'inhibit-changed': (GObject.SIGNAL_RUN_FIRST, None, (bool,)),
@@ -45,7 +86,8 @@ class RedshiftController(GObject.GObject):
         """Initialize controller and start child process.
 
         The parameter args is a list of command line arguments to pass on to
-        the child process. The "-v" argument is automatically added.
+        the child process. The "--control-socket" argument is automatically
+        added, or "-v" if the control socket is not supported.
         """
         GObject.GObject.__init__(self)
 
@@ -55,9 +97,24 @@ class RedshiftController(GObject.GObject):
         self._period = 'Unknown'
         self._location = (0.0, 0.0)
 
+        # Control socket state
+        self._socket = None
+        self._socket_path = None
+        self._socket_buffer = b''
+        self._reply_callbacks = deque()
+        self._status = None
+        self._update_source = None
+        self._connect_source = None
+
         # Start redshift with arguments
         args.insert(0, os.path.join(defs.BINDIR, 'redshift'))
-        if '-v' not in args:
+        if ('--control-socket' not in args and
+                supports_control_socket(args[0])):
+            self._socket_path = os.path.join(
+                GLib.get_user_runtime_dir(),
+                'redshift-gtk-{}.sock'.format(os.getpid()))
+            args.extend(['--control-socket', self._socket_path])
+        elif '-v' not in args:
             args.insert(1, '-v')
 
         # Start child process with C locale so we can parse the output
@@ -97,9 +154,17 @@ class RedshiftController(GObject.GObject):
                 self._process[3], GLib.PRIORITY_DEFAULT, GLib.IO_IN,
                 self._child_data_cb, (False, self._error_buffer))
 
+            # Connect to the control socket once the child has created it
+            if self._socket_path is not None:
+                self._connect_source = GLib.timeout_add(
+                    CONNECT_INTERVAL, self._socket_connect_cb)
+
             # Signal handler to relay USR1 signal to redshift process
             def relay_signal_handler(signal):
-                os.kill(self._process[0], signal)
+                if self._socket is not None:
+                    self._send_command('toggle')
+                else:
+                    os.kill(self._process[0], signal)
                 return True
 
             GLib.unix_signal_add(GLib.PRIORITY_DEFAULT, signal.SIGUSR1,
@@ -131,7 +196,10 @@ class RedshiftController(GObject.GObject):
     def set_inhibit(self, inhibit):
         """Set inhibition state."""
         if inhibit != self._inhibited:
-            self._child_toggle_inhibit()
+            if self._socket is not None:
+                self._send_command('disable' if inhibit else 'enable')
+            else:
+                self._child_toggle_inhibit()
 
     def _child_signal(self, sg):
         """Send signal to child process."""
@@ -141,9 +209,157 @@ class RedshiftController(GObject.GObject):
         """Sends a request to the child process to toggle state."""
         self._child_signal(signal.SIGUSR1)
 
+    def _socket_connect_cb(self):
+        """Try to connect to the control socket of the child process."""
+        sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        try:
+            sock.connect(self._socket_path)
+        except OSError:
+            sock.close()
+            return True
+
+        sock.setblocking(False)
+        self._socket = sock
+        self._connect_source = None
+        GLib.io_add_watch(
+            sock.fileno(), GLib.PRIORITY_DEFAULT,
+            GLib.IO_IN | GLib.IO_HUP | GLib.IO_ERR, self._socket_data_cb)
+        self._send_command('subscribe')
+        return False
+
+    def _socket_close(self):
+        """Close the control socket and fail pending commands."""
+        if self._socket is not None:
+            self._socket.close()
+            self._socket = None
+        while self._reply_callbacks:
+            callback = self._reply_callbacks.popleft()
+            if callback is not None:
+                callback(False, 'connection closed')
+
+    def _send_command(self, command, callback=None):
+        """Send command to the control socket.
+
+        The callback is called with whether the command succeeded and an
+        error message when the reply arrives.
+        """
+        try:
+            self._socket.sendall((command + '\n').encode('utf-8'))
+        except OSError:
+            self._socket_close()
+            if callback is not None:
+                callback(False, 'connection closed')
+            return
+
+        # Status requests are answered with a status, not a reply.
+        if command not in ('status', 'subscribe'):
+            self._reply_callbacks.append(callback)
+
+    def _socket_reply_cb(self, message):
+        """Called when a reply to a command arrives."""
+        callback = None
+        if self._reply_callbacks:
+            callback = self._reply_callbacks.popleft()
+
+        ok = message.get('ok', False)
+        error = message.get('error', '')
+        if callback is not None:
+            callback(ok, error)
+        elif not ok:
+            print('Redshift command failed: {}'.format(error),
+                  file=sys.stderr)
+
+    def _socket_status_cb(self, message):
+        """Called when the child process reports its status.
+
+        The interface is refreshed after UPDATE_INTERVAL so that the
+        updates during a fade are combined.
+        """
+        self._status = message
+        if self._update_source is None:
+            self._update_source = GLib.timeout_add(
+                UPDATE_INTERVAL, self._update_status_cb)
+
+    def _update_status_cb(self):
+        """Apply the last status received from the child process."""
+        self._update_source = None
+        status = self._status
+        if status is None:
+            return False
+
+        new_inhibited = not status['enabled']
+        if new_inhibited != self._inhibited:
+            self._inhibited = new_inhibited
+            self.emit('inhibit-changed', new_inhibited)
+
+        new_temperature = status['temperature']
+        if new_temperature != self._temperature:
+            self._temperature = new_temperature
+            self.emit('temperature-changed', new_temperature)
+
+        new_period = PERIOD_NAMES.get(status['period'], 'Unknown')
+        if status['period'] == 'transition':
+            new_period = '{} ({:.2f}% day)'.format(
+                new_period, status['progress'] * 100)
+        if new_period != self._period:
+            self._period = new_period
+            self.emit('period-changed', new_period)
+
+        if status['location'] is not None:
+            new_location = tuple(status['location'])
+            if new_location != self._location:
+                self._location = new_location
+                self.emit('location-changed', *new_location)
+
+        return False
+
+    def _socket_data_cb(self, f, cond):
+        """Called when the control socket has new data or is closed."""
+        try:
+            data = self._socket.recv(4096)
+        except BlockingIOError:
+            return True
+        except OSError:
+            data = b''
+
+        if data == b'':
+            self._socket_close()
+            return False
+
+        self._socket_buffer += data
+        while True:
+            first, sep, last = self._socket_buffer.partition(b'\n')
+            if sep == b'':
+                break
+            self._socket_buffer = last
+            try:
+                message = json.loads(first.decode('utf-8'))
+            except ValueError:
+                continue
+            if message.get('type') == 'status':
+                self._socket_status_cb(message)
+            elif message.get('type') == 'reply':
+                self._socket_reply_cb(message)
+
+        return True
+
     def _child_cb(self, pid, status, data=None):
         """Called when the child process exists."""
 
+        # Stop using the control socket
+        if self._connect_source is not None:
+            GLib.source_remove(self._connect_source)
+            self._connect_source = None
+        self._socket_close()
+        if self._update_source is not None:
+            GLib.source_remove(self._update_source)
+            self._update_source = None
+        if self._socket_path is not None:
+            try:
+                os.unlink(self._socket_path)
+            except OSError:
+                pass
+
         # Empty stdout and stderr
         for f in (self._process[2], self._process[3]):
             while True:
@@ -211,7 +427,7 @@ class RedshiftController(GObject.GObject):
             if sep == '':
                 break
             ib.buf = last
-            if stdout:
+            if stdout and self._socket_path is None:
                 self._child_stdout_line_cb(first)
             else:
                 self._errors += first + '\n'
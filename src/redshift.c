@@ -59,12 +59,19 @@ int poll(struct pollfd *fds, int nfds, int timeout) { abort(); return -1; }
 #endif
 
 #include "redshift.h"
+#include "colorramp.h"
 #include "config-ini.h"
 #include "solar.h"
 #include "systemtime.h"
 #include "hooks.h"
 #include "signals.h"
 #include "options.h"
+#include "probe.h"
+#include "control.h"
+#include "stats.h"
+#include "statuspage.h"
+#include "transition.h"
+#include "forecast.h"
 
 /* pause() is not defined on windows platform but is not needed either.
    Use a noop macro instead. */
@@ -73,6 +80,12 @@ int poll(struct pollfd *fds, int nfds, int timeout) { abort(); return -1; }
 #endif
 
 #include "gamma-dummy.h"
+#include "gamma-multi.h"
+#include "location-cache.h"
+
+#ifdef ENABLE_WAYLAND
+# include "gamma-wayland.h"
+#endif
 
 #ifdef ENABLE_DRM
 # include "gamma-drm.h"
@@ -101,6 +114,10 @@ int poll(struct pollfd *fds, int nfds, int timeout) { abort(); return -1; }
 # include "location-geoclue2.h"
 #endif
 
+#ifdef ENABLE_GEOCLUE2_SDBUS
+# include "location-geoclue2-sdbus.h"
+#endif
+
 #ifdef ENABLE_CORELOCATION
 # include "location-corelocation.h"
 #endif
@@ -114,8 +131,6 @@ int poll(struct pollfd *fds, int nfds, int timeout) { abort(); return -1; }
 #define MAX_LAT    90.0
 #define MIN_LON  -180.0
 #define MAX_LON   180.0
-#define MIN_TEMP   1000
-#define MAX_TEMP  25000
 #define MIN_BRIGHTNESS  0.1
 #define MAX_BRIGHTNESS  1.0
 #define MIN_GAMMA   0.1
@@ -125,9 +140,26 @@ int poll(struct pollfd *fds, int nfds, int timeout) { abort(); return -1; }
 #define SLEEP_DURATION        5000
 #define SLEEP_DURATION_SHORT  100
 
+/* Longest sleep when nothing is expected to change (milliseconds).
+   Bounds the error after the system clock is changed, or after resume
+   from suspend where the wakeup clock does not count suspended time. */
+#define SLEEP_DURATION_MAX    300000
+
+/* Shortest sleep between adaptive fade steps (milliseconds). */
+#define SLEEP_DURATION_MIN    16
+
 /* Length of fade in numbers of short sleep durations. */
 #define FADE_LENGTH  40
 
+/* Duration of fade (seconds). */
+#define FADE_DURATION  (FADE_LENGTH*SLEEP_DURATION_SHORT/1000.0)
+
+/* Smallest visible change in gamma for adaptive steps. */
+#define ADAPTIVE_GAMMA_STEP  0.005
+
+/* Most methods or providers started at once by parallel probing. */
+#define MAX_PROBE_CANDIDATES  16
+
 
 /* Names of periods of day */
 static const char *period_names[] = {
@@ -139,81 +171,33 @@ static const char *period_names[] = {
 };
 
 
-/* Determine which period we are currently in based on time offset. */
-static period_t
-get_period_from_time(const transition_scheme_t *transition, int time_offset)
-{
-	if (time_offset < transition->dawn.start ||
-	    time_offset >= transition->dusk.end) {
-		return PERIOD_NIGHT;
-	} else if (time_offset >= transition->dawn.end &&
-		   time_offset < transition->dusk.start) {
-		return PERIOD_DAYTIME;
-	} else {
-		return PERIOD_TRANSITION;
-	}
-}
+/* Cached solar terms for the current day and location. Zero
+   initialization leaves it empty. */
+static solar_cache_t solar_cache;
 
-/* Determine which period we are currently in based on solar elevation. */
-static period_t
-get_period_from_elevation(
-	const transition_scheme_t *transition, double elevation)
+/* Determine period and transition progress at the given time. */
+static void
+get_period_and_progress(
+	const transition_scheme_t *scheme, const location_t *loc,
+	double timestamp, period_t *period, double *transition_prog)
 {
-	if (elevation < transition->low) {
-		return PERIOD_NIGHT;
-	} else if (elevation < transition->high) {
-		return PERIOD_TRANSITION;
-	} else {
-		return PERIOD_DAYTIME;
-	}
-}
+	if (scheme->use_time) {
+		int time_offset = get_seconds_since_midnight(timestamp);
 
-/* Determine how far through the transition we are based on time offset. */
-static double
-get_transition_progress_from_time(
-	const transition_scheme_t *transition, int time_offset)
-{
-	if (time_offset < transition->dawn.start ||
-	    time_offset >= transition->dusk.end) {
-		return 0.0;
-	} else if (time_offset < transition->dawn.end) {
-		return (transition->dawn.start - time_offset) /
-			(double)(transition->dawn.start -
-				transition->dawn.end);
-	} else if (time_offset > transition->dusk.start) {
-		return (transition->dusk.end - time_offset) /
-			(double)(transition->dusk.end -
-				transition->dusk.start);
+		*period = get_period_from_time(scheme, time_offset);
+		*transition_prog = get_transition_progress_from_time(
+			scheme, time_offset);
 	} else {
-		return 1.0;
-	}
-}
+		/* Current angular elevation of the sun */
+		double elevation = solar_cache_elevation(
+			&solar_cache, timestamp, loc->lat, loc->lon);
 
-/* Determine how far through the transition we are based on elevation. */
-static double
-get_transition_progress_from_elevation(
-	const transition_scheme_t *transition, double elevation)
-{
-	if (elevation < transition->low) {
-		return 0.0;
-	} else if (elevation < transition->high) {
-		return (transition->low - elevation) /
-			(transition->low - transition->high);
-	} else {
-		return 1.0;
+		*period = get_period_from_elevation(scheme, elevation);
+		*transition_prog = get_transition_progress_from_elevation(
+			scheme, elevation);
 	}
 }
 
-/* Return number of seconds since midnight from timestamp. */
-static int
-get_seconds_since_midnight(double timestamp)
-{
-	time_t t = (time_t)timestamp;
-	struct tm tm;
-	localtime_r(&t, &tm);
-	return tm.tm_sec + tm.tm_min * 60 + tm.tm_hour * 3600;
-}
-
 /* Print verbose description of the given period. */
 static void
 print_period(period_t period, double transition)
@@ -253,40 +237,6 @@ print_location(const location_t *location)
 	       fabs(location->lon), location->lon >= 0.f ? east : west);
 }
 
-/* Interpolate color setting structs given alpha. */
-static void
-interpolate_color_settings(
-	const color_setting_t *first,
-	const color_setting_t *second,
-	double alpha,
-	color_setting_t *result)
-{
-	alpha = CLAMP(0.0, alpha, 1.0);
-
-	result->temperature = (1.0-alpha)*first->temperature +
-		alpha*second->temperature;
-	result->brightness = (1.0-alpha)*first->brightness +
-		alpha*second->brightness;
-	for (int i = 0; i < 3; i++) {
-		result->gamma[i] = (1.0-alpha)*first->gamma[i] +
-			alpha*second->gamma[i];
-	}
-}
-
-/* Interpolate color setting structs transition scheme. */
-static void
-interpolate_transition_scheme(
-	const transition_scheme_t *transition,
-	double alpha,
-	color_setting_t *result)
-{
-	const color_setting_t *day = &transition->day;
-	const color_setting_t *night = &transition->night;
-
-	alpha = CLAMP(0.0, alpha, 1.0);
-	interpolate_color_settings(night, day, alpha, result);
-}
-
 /* Return 1 if color settings have major differences, otherwise 0.
    Used to determine if a fade should be applied in continual mode. */
 static int
@@ -301,6 +251,39 @@ color_setting_diff_is_major(
 		fabsf(first->gamma[2] - second->gamma[2]) > 0.1);
 }
 
+/* Return 1 if color settings are identical, otherwise 0. */
+static int
+color_setting_equal(
+	const color_setting_t *first,
+	const color_setting_t *second)
+{
+	return (first->temperature == second->temperature &&
+		first->brightness == second->brightness &&
+		first->gamma[0] == second->gamma[0] &&
+		first->gamma[1] == second->gamma[1] &&
+		first->gamma[2] == second->gamma[2]);
+}
+
+/* Return 1 if color settings differ by at least the given steps,
+   otherwise 0. Used to schedule the next update with adaptive steps. */
+static int
+color_setting_diff_is_visible(
+	const color_setting_t *first,
+	const color_setting_t *second,
+	int min_temp_step, double min_brightness_step)
+{
+	return (abs(first->temperature - second->temperature) >=
+		min_temp_step ||
+		fabsf(first->brightness - second->brightness) >=
+		min_brightness_step ||
+		fabsf(first->gamma[0] - second->gamma[0]) >=
+		ADAPTIVE_GAMMA_STEP ||
+		fabsf(first->gamma[1] - second->gamma[1]) >=
+		ADAPTIVE_GAMMA_STEP ||
+		fabsf(first->gamma[2] - second->gamma[2]) >=
+		ADAPTIVE_GAMMA_STEP);
+}
+
 /* Reset color setting to default values. */
 static void
 color_setting_reset(color_setting_t *color)
@@ -405,9 +388,12 @@ provider_try_start(const location_provider_t *provider,
 	return 0;
 }
 
+/* Start METHOD. The current adjustment is only saved if SAVE is
+   true. */
 static int
 method_try_start(const gamma_method_t *method,
-		 gamma_state_t **state, config_ini_state_t *config, char *args)
+		 gamma_state_t **state, config_ini_state_t *config, char *args,
+		 int save)
 {
 	int r;
 
@@ -418,6 +404,8 @@ method_try_start(const gamma_method_t *method,
 		return -1;
 	}
 
+	if (!save && method->skip_save != NULL) method->skip_save(*state);
+
 	/* Set method options from config file. */
 	config_ini_section_t *section =
 		config_ini_get_section(config, method->name);
@@ -483,6 +471,39 @@ method_try_start(const gamma_method_t *method,
 	return 0;
 }
 
+static int
+probe_provider_start(const void *candidate, void **state, void *data)
+{
+	return provider_try_start(candidate, (location_state_t **)state,
+				  data, NULL);
+}
+
+static void
+probe_provider_free(const void *candidate, void *state)
+{
+	((const location_provider_t *)candidate)->free(state);
+}
+
+static int
+probe_method_start(const void *candidate, void **state, void *data)
+{
+	return method_try_start(candidate, (gamma_state_t **)state,
+				data, NULL, 1);
+}
+
+static int
+probe_method_start_no_save(const void *candidate, void **state, void *data)
+{
+	return method_try_start(candidate, (gamma_state_t **)state,
+				data, NULL, 0);
+}
+
+static void
+probe_method_free(const void *candidate, void *state)
+{
+	((const gamma_method_t *)candidate)->free(state);
+}
+
 
 /* Check whether gamma is within allowed levels. */
 static int
@@ -537,10 +558,11 @@ provider_get_location(
 	while (!available) {
 		int loc_fd = provider->get_fd(state);
 		if (loc_fd >= 0) {
-			/* Provider is dynamic. */
-			/* TODO: This should use a monotonic time source. */
+			/* Provider is dynamic. The timeout is measured
+			   on the monotonic clock, which also keeps
+			   running in a simulation. */
 			double now;
-			int r = systemtime_get_time(&now);
+			int r = systemtime_get_monotonic_time(&now);
 			if (r < 0) {
 				fputs(_("Unable to read system time.\n"),
 				      stderr);
@@ -559,7 +581,7 @@ provider_get_location(
 			}
 
 			double later;
-			r = systemtime_get_time(&later);
+			r = systemtime_get_monotonic_time(&later);
 			if (r < 0) {
 				fputs(_("Unable to read system time.\n"),
 				      stderr);
@@ -581,209 +603,1241 @@ provider_get_location(
 	return 1;
 }
 
-/* Easing function for fade.
-   See https://github.com/mietek/ease-tween */
-static double
-ease_fade(double t)
+/* Get the location to start with. If the provider is not ready and
+   the location cache is enabled, the last known location is used and
+   the provider keeps looking in the background. Returns -1 on error,
+   0 if the location came from the cache, or 1 from the provider. */
+static int
+get_initial_location(
+	const options_t *options, const location_provider_t *provider,
+	location_state_t *state, location_t *loc)
 {
-	if (t <= 0) return 0;
-	if (t >= 1) return 1;
-	return 1.0042954579734844 * exp(
-		-6.4041738958415664 * exp(-7.2908241330981340 * t));
-}
+	int r;
 
+	if (options->location_cache) {
+		r = provider_get_location(provider, state, 0, loc);
+		if (r < 0) return -1;
+		if (r > 0) {
+			if (location_is_valid(loc)) location_cache_save(loc);
+			return 1;
+		}
 
-/* Run continual mode loop
-   This is the main loop of the continual mode which keeps track of the
-   current time and continuously updates the screen to the appropriate
-   color temperature. */
+		r = location_cache_load(loc);
+		if (r == 0 && location_is_valid(loc)) {
+			fputs(_("Using last known location until the"
+				" provider is ready.\n"), stderr);
+			return 0;
+		}
+	}
+
+	fputs(_("Waiting for initial location"
+		" to become available...\n"), stderr);
+
+	r = provider_get_location(provider, state, -1, loc);
+	if (r < 0) return -1;
+
+	if (options->location_cache && location_is_valid(loc)) {
+		location_cache_save(loc);
+	}
+
+	return 1;
+}
+
+/* Wait until the location provider has a valid location. Returns -1
+   if it fails. */
 static int
-run_continual_mode(const location_provider_t *provider,
-		   location_state_t *location_state,
-		   const transition_scheme_t *scheme,
-		   const gamma_method_t *method,
-		   gamma_state_t *method_state,
-		   int use_fade, int preserve_gamma, int verbose)
+wait_for_location(const options_t *options, location_state_t *state,
+		  location_t *loc)
 {
-	int r;
-
-	/* Short fade parameters */
-	int fade_length = 0;
-	int fade_time = 0;
-	color_setting_t fade_start_interp;
+	fputs(_("Waiting for current location"
+		" to become available...\n"), stderr);
 
-	r = signals_install_handlers();
+	int r = provider_get_location(options->provider, state, -1, loc);
 	if (r < 0) {
-		return r;
+		fputs(_("Unable to get location from provider.\n"), stderr);
+		return -1;
 	}
 
-	/* Save previous parameters so we can avoid printing status updates if
-	   the values did not change. */
-	period_t prev_period = PERIOD_NONE;
+	if (!location_is_valid(loc)) return -1;
 
-	/* Previous target color setting and current actual color setting.
-	   Actual color setting takes into account the current color fade. */
-	color_setting_t prev_target_interp;
-	color_setting_reset(&prev_target_interp);
+	if (options->location_cache) location_cache_save(loc);
 
-	color_setting_t interp;
-	color_setting_reset(&interp);
+	return 0;
+}
 
-	location_t loc = { NAN, NAN };
-	int need_location = !scheme->use_time;
-	if (need_location) {
-		fputs(_("Waiting for initial location"
-			" to become available...\n"), stderr);
+/* Return the start of the current local day in START. Returns -1 if
+   the time can not be read. */
+static int
+get_day_start(double *start)
+{
+	double now;
+	int r = systemtime_get_time(&now);
+	if (r < 0) {
+		fputs(_("Unable to read system time.\n"), stderr);
+		return -1;
+	}
 
-		/* Get initial location from provider */
-		r = provider_get_location(provider, location_state, -1, &loc);
-		if (r < 0) {
-			fputs(_("Unable to get location"
-				" from provider.\n"), stderr);
+	*start = floor(now) - get_seconds_since_midnight(now);
+	return 0;
+}
+
+/* Check options after defaults have been set. Prints error message
+   on stderr and returns -1 if invalid. */
+static int
+check_options(options_t *options)
+{
+	transition_scheme_t *scheme = &options->scheme;
+
+	if (scheme->dawn.start >= 0 || scheme->dawn.end >= 0 ||
+	    scheme->dusk.start >= 0 || scheme->dusk.end >= 0) {
+		if (scheme->dawn.start < 0 || scheme->dawn.end < 0 ||
+		    scheme->dusk.start < 0 || scheme->dusk.end < 0) {
+			fputs(_("Partitial time-configuration not"
+				" supported!\n"), stderr);
 			return -1;
 		}
 
-		if (!location_is_valid(&loc)) {
-			fputs(_("Invalid location returned from provider.\n"),
+		if (scheme->dawn.start > scheme->dawn.end ||
+		    scheme->dawn.end > scheme->dusk.start ||
+		    scheme->dusk.start > scheme->dusk.end) {
+			fputs(_("Invalid dawn/dusk time configuration!\n"),
 			      stderr);
 			return -1;
 		}
 
-		print_location(&loc);
-	}
-
-	if (verbose) {
-		printf(_("Color temperature: %uK\n"), interp.temperature);
-		printf(_("Brightness: %.2f\n"), interp.brightness);
+		scheme->use_time = 1;
 	}
 
-	/* Continuously adjust color temperature */
-	int done = 0;
-	int prev_disabled = 1;
-	int disabled = 0;
-	int location_available = 1;
-	while (1) {
-		/* Check to see if disable signal was caught */
-		if (disable && !done) {
-			disabled = !disabled;
-			disable = 0;
-		}
-
-		/* Check to see if exit signal was caught */
-		if (exiting) {
-			if (done) {
-				/* On second signal stop the ongoing fade. */
-				break;
-			} else {
-				done = 1;
-				disabled = 1;
-			}
-			exiting = 0;
+	if (options->mode != PROGRAM_MODE_RESET &&
+	    options->mode != PROGRAM_MODE_MANUAL) {
+		/* Solar elevations */
+		if (!scheme->use_time && scheme->high < scheme->low) {
+			fprintf(stderr,
+				_("High transition elevation cannot be lower than"
+				  " the low transition elevation.\n"));
+			return -1;
 		}
 
-		/* Print status change */
-		if (verbose && disabled != prev_disabled) {
-			printf(_("Status: %s\n"), disabled ?
-			       _("Disabled") : _("Enabled"));
+		/* Color temperature */
+		if (scheme->day.temperature < MIN_TEMP ||
+		    scheme->day.temperature > MAX_TEMP ||
+		    scheme->night.temperature < MIN_TEMP ||
+		    scheme->night.temperature > MAX_TEMP) {
+			fprintf(stderr,
+				_("Temperature must be between %uK and %uK.\n"),
+				MIN_TEMP, MAX_TEMP);
+			return -1;
 		}
+	}
 
-		prev_disabled = disabled;
+	if (options->simulate_days > 0 &&
+	    options->mode != PROGRAM_MODE_CONTINUAL) {
+		fputs(_("Simulation is only possible in continual mode.\n"),
+		      stderr);
+		return -1;
+	}
 
-		/* Read timestamp */
-		double now;
-		r = systemtime_get_time(&now);
-		if (r < 0) {
-			fputs(_("Unable to read system time.\n"), stderr);
+	if (options->mode == PROGRAM_MODE_MANUAL) {
+		/* Check color temperature to be set */
+		if (options->temp_set < MIN_TEMP ||
+		    options->temp_set > MAX_TEMP) {
+			fprintf(stderr,
+				_("Temperature must be between %uK and %uK.\n"),
+				MIN_TEMP, MAX_TEMP);
 			return -1;
 		}
+	}
 
-		period_t period;
-		double transition_prog;
-		if (scheme->use_time) {
-			int time_offset = get_seconds_since_midnight(now);
+	/* Brightness */
+	if (scheme->day.brightness < MIN_BRIGHTNESS ||
+	    scheme->day.brightness > MAX_BRIGHTNESS ||
+	    scheme->night.brightness < MIN_BRIGHTNESS ||
+	    scheme->night.brightness > MAX_BRIGHTNESS) {
+		fprintf(stderr,
+			_("Brightness values must be between %.1f and %.1f.\n"),
+			MIN_BRIGHTNESS, MAX_BRIGHTNESS);
+		return -1;
+	}
 
-			period = get_period_from_time(scheme, time_offset);
-			transition_prog = get_transition_progress_from_time(
-				scheme, time_offset);
-		} else {
-			/* Current angular elevation of the sun */
-			double elevation = solar_elevation(
-				now, loc.lat, loc.lon);
+	/* Gamma */
+	if (!gamma_is_valid(scheme->day.gamma) ||
+	    !gamma_is_valid(scheme->night.gamma)) {
+		fprintf(stderr,
+			_("Gamma value must be between %.1f and %.1f.\n"),
+			MIN_GAMMA, MAX_GAMMA);
+		return -1;
+	}
 
-			period = get_period_from_elevation(scheme, elevation);
-			transition_prog =
-				get_transition_progress_from_elevation(
-					scheme, elevation);
+	/* Color settings of outputs */
+	for (int i = 0; i < options->output_count; i++) {
+		const transition_scheme_t *s = &options->outputs[i].scheme;
+		if (s->day.temperature < MIN_TEMP ||
+		    s->day.temperature > MAX_TEMP ||
+		    s->night.temperature < MIN_TEMP ||
+		    s->night.temperature > MAX_TEMP ||
+		    s->day.brightness < MIN_BRIGHTNESS ||
+		    s->day.brightness > MAX_BRIGHTNESS ||
+		    s->night.brightness < MIN_BRIGHTNESS ||
+		    s->night.brightness > MAX_BRIGHTNESS ||
+		    !gamma_is_valid(s->day.gamma) ||
+		    !gamma_is_valid(s->night.gamma)) {
+			fprintf(stderr, _("Invalid color setting for"
+					  " output `%s'.\n"),
+				options->outputs[i].name);
+			return -1;
 		}
+	}
 
-		/* Use transition progress to get target color
-		   temperature. */
-		color_setting_t target_interp;
-		interpolate_transition_scheme(
-			scheme, transition_prog, &target_interp);
+	return 0;
+}
 
-		if (disabled) {
-			period = PERIOD_NONE;
-			color_setting_reset(&target_interp);
-		}
+/* Start the location provider selected in options, or if none is
+   selected try all providers and select the first that works. The
+   arguments in options are copied as parsing modifies them. */
+static int
+start_location_provider(options_t *options,
+			const location_provider_t *location_providers,
+			config_ini_state_t *config,
+			location_state_t **location_state)
+{
+	int r;
 
-		if (done) {
-			period = PERIOD_NONE;
+	if (options->provider != NULL) {
+		/* Use provider specified on command line. */
+		char *args = NULL;
+		if (options->provider_args != NULL) {
+			args = strdup(options->provider_args);
+			if (args == NULL) {
+				perror("strdup");
+				return -1;
+			}
 		}
 
-		/* Print period if it changed during this update,
-		   or if we are in the transition period. In transition we
-		   print the progress, so we always print it in
-		   that case. */
-		if (verbose && (period != prev_period ||
-				period == PERIOD_TRANSITION)) {
-			print_period(period, transition_prog);
+		r = provider_try_start(options->provider, location_state,
+				       config, args);
+		free(args);
+		return r;
+	} else if (options->parallel_probe) {
+		/* Start all providers at once, use the first in list
+		   order that works. */
+		const void *candidates[MAX_PROBE_CANDIDATES];
+		int count = 0;
+		for (int i = 0; location_providers[i].name != NULL &&
+			     count < MAX_PROBE_CANDIDATES;
+		     i++) {
+			fprintf(stderr,
+				_("Trying location provider `%s'...\n"),
+				location_providers[i].name);
+			candidates[count++] = &location_providers[i];
 		}
 
-		/* Activate hooks if period changed */
-		if (period != prev_period) {
-			hooks_signal_period_change(prev_period, period);
+		r = probe_start(candidates, count,
+				probe_provider_start, probe_provider_free,
+				config, options->probe_timeout,
+				(void **)location_state);
+		if (r >= 0) {
+			options->provider = candidates[r];
+			printf(_("Using provider `%s'.\n"),
+			       options->provider->name);
 		}
-
-		/* Start fade if the parameter differences are too big to apply
-		   instantly. */
-		if (use_fade) {
-			if ((fade_length == 0 &&
-			     color_setting_diff_is_major(
-				     &interp,
-				     &target_interp)) ||
-			    (fade_length != 0 &&
-			     color_setting_diff_is_major(
-				     &target_interp,
-				     &prev_target_interp))) {
-				fade_length = FADE_LENGTH;
-				fade_time = 0;
-				fade_start_interp = interp;
+	} else {
+		/* Try all providers, use the first that works. */
+		for (int i = 0; location_providers[i].name != NULL; i++) {
+			const location_provider_t *p =
+				&location_providers[i];
+			fprintf(stderr,
+				_("Trying location provider `%s'...\n"),
+				p->name);
+			r = provider_try_start(p, location_state,
+					       config, NULL);
+			if (r < 0) {
+				fputs(_("Trying next provider...\n"),
+				      stderr);
+				continue;
 			}
-		}
+
+			/* Found provider that works. */
+			printf(_("Using provider `%s'.\n"), p->name);
+			options->provider = p;
+			break;
+		}
+	}
+
+	/* Failure if no providers were successful at this point. */
+	if (options->provider == NULL) {
+		fputs(_("No more location providers to try.\n"), stderr);
+		return -1;
+	}
+
+	return 0;
+}
+
+/* Start all methods given with -m and adjust them together. They
+   share the location, the transition scheme and the main loop. */
+static int
+start_gamma_targets(options_t *options, config_ini_state_t *config,
+		    gamma_state_t **method_state, int save)
+{
+	int r = multi_gamma_method.init(method_state);
+	if (r < 0) {
+		fprintf(stderr, _("Initialization of %s failed.\n"),
+			multi_gamma_method.name);
+		return -1;
+	}
+
+	for (int i = 0; i < options->target_count; i++) {
+		const gamma_target_t *target = &options->targets[i];
+		char *args = NULL;
+		if (target->args != NULL) {
+			args = strdup(target->args);
+			if (args == NULL) {
+				perror("strdup");
+				multi_gamma_method.free(*method_state);
+				return -1;
+			}
+		}
+
+		gamma_state_t *target_state;
+		r = method_try_start(target->method, &target_state,
+				     config, args, save);
+		free(args);
+		if (r < 0) {
+			multi_gamma_method.free(*method_state);
+			return -1;
+		}
+
+		r = multi_gamma_add_target(*method_state, target->method,
+					   target_state);
+		if (r < 0) {
+			target->method->free(target_state);
+			multi_gamma_method.free(*method_state);
+			return -1;
+		}
+	}
+
+	r = multi_gamma_method.start(*method_state);
+	if (r < 0) {
+		multi_gamma_method.free(*method_state);
+		return -1;
+	}
+
+	options->method = &multi_gamma_method;
+
+	return 0;
+}
+
+/* Start the gamma method selected in options, or if none is selected
+   try all methods that are started automatically and select the first
+   that works. The current adjustment is only saved if SAVE is true. */
+static int
+start_gamma_method(options_t *options, const gamma_method_t *gamma_methods,
+		   config_ini_state_t *config, gamma_state_t **method_state,
+		   int save)
+{
+	int r;
+
+	if (options->target_count > 1) {
+		return start_gamma_targets(options, config, method_state,
+					   save);
+	} else if (options->method != NULL) {
+		/* Use method specified on command line. */
+		char *args = NULL;
+		if (options->method_args != NULL) {
+			args = strdup(options->method_args);
+			if (args == NULL) {
+				perror("strdup");
+				return -1;
+			}
+		}
+
+		r = method_try_start(options->method, method_state,
+				     config, args, save);
+		free(args);
+		return r;
+	} else if (options->parallel_probe) {
+		/* Start all methods at once, use the first in list
+		   order that works. */
+		const void *candidates[MAX_PROBE_CANDIDATES];
+		int count = 0;
+		for (int i = 0; gamma_methods[i].name != NULL &&
+			     count < MAX_PROBE_CANDIDATES;
+		     i++) {
+			if (!gamma_methods[i].autostart) continue;
+			candidates[count++] = &gamma_methods[i];
+		}
+
+		r = probe_start(candidates, count,
+				save ? probe_method_start :
+				probe_method_start_no_save,
+				probe_method_free,
+				config, options->probe_timeout,
+				(void **)method_state);
+		if (r >= 0) {
+			options->method = candidates[r];
+			printf(_("Using method `%s'.\n"),
+			       options->method->name);
+		}
+	} else {
+		/* Try all methods, use the first that works. */
+		for (int i = 0; gamma_methods[i].name != NULL; i++) {
+			const gamma_method_t *m = &gamma_methods[i];
+			if (!m->autostart) continue;
+
+			r = method_try_start(m, method_state, config, NULL,
+					     save);
+			if (r < 0) {
+				fputs(_("Trying next method...\n"), stderr);
+				continue;
+			}
+
+			/* Found method that works. */
+			printf(_("Using method `%s'.\n"), m->name);
+			options->method = m;
+			break;
+		}
+	}
+
+	/* Failure if no methods were successful at this point. */
+	if (options->method == NULL) {
+		fputs(_("No more methods to try.\n"), stderr);
+		return -1;
+	}
+
+	return 0;
+}
+
+/* Return non-zero if the command line options ARGS of a one-shot,
+   manual or reset request include settings that the control protocol
+   cannot carry. CONFIG_GIVEN tells whether a config file was given. */
+static int
+args_need_local(const options_t *options, const options_t *args,
+		int config_given)
+{
+	if (config_given || args->target_count > 0) return 1;
+	if (options->mode == PROGRAM_MODE_RESET) return 0;
+
+	if (!isnan(args->scheme.day.brightness) ||
+	    !isnan(args->scheme.night.brightness) ||
+	    !isnan(args->scheme.day.gamma[0])) {
+		return 1;
+	}
+
+	return options->mode == PROGRAM_MODE_ONE_SHOT &&
+		(args->scheme.day.temperature >= 0 ||
+		 args->provider != NULL);
+}
+
+/* Pass a one-shot, manual or reset request on to the instance
+   listening at the control socket. Requests with settings in ARGS that
+   the protocol cannot carry are left to the local path. Returns 1 if
+   it was handled there, 0 if it should be handled locally, or -1 on
+   error. */
+static int
+forward_to_instance(const options_t *options, const options_t *args,
+		    int config_given)
+{
+	char temperature[32];
+	const char *commands[2];
+
+	if (args_need_local(options, args, config_given)) return 0;
+
+	switch (options->mode) {
+	case PROGRAM_MODE_MANUAL:
+		snprintf(temperature, sizeof(temperature),
+			 "set-temperature %d", options->temp_set);
+		commands[0] = temperature;
+		commands[1] = "enable";
+		break;
+	case PROGRAM_MODE_ONE_SHOT:
+		commands[0] = "set-temperature 0";
+		commands[1] = "enable";
+		break;
+	case PROGRAM_MODE_RESET:
+		commands[0] = "set-temperature 0";
+		commands[1] = "disable";
+		break;
+	default:
+		return 0;
+	}
+
+	return control_send_commands(options->control_socket, commands, 2);
+}
+
+/* Easing function for fade.
+   See https://github.com/mietek/ease-tween */
+static double
+ease_fade(double t)
+{
+	if (t <= 0) return 0;
+	if (t >= 1) return 1;
+	return 1.0042954579734844 * exp(
+		-6.4041738958415664 * exp(-7.2908241330981340 * t));
+}
+
+/* Parameters for finding the time of the next change. */
+typedef struct {
+	const transition_scheme_t *scheme;
+	const location_t *loc;
+	/* Period and color setting at the start of the search. */
+	period_t period;
+	color_setting_t setting;
+	/* Temperature set over the control socket, or 0. */
+	int temperature;
+	/* Output schemes and their target settings at the start. */
+	const output_scheme_t *outputs;
+	int output_count;
+	color_setting_t output_settings[MAX_OUTPUT_SCHEMES];
+	/* Smallest changes that are considered visible. */
+	int min_temp_step;
+	double min_brightness_step;
+	/* Fade parameters. */
+	double fade_start_time;
+	color_setting_t fade_start;
+	color_setting_t fade_target;
+} change_search_t;
+
+typedef int change_search_func(const change_search_t *search,
+			       double timestamp);
+
+/* Return the earliest time in the interval from START to END at which
+   CHANGED returns non-zero, to within PRECISION seconds, or END if
+   nothing changes. CHANGED is only evaluated at the end in the
+   interval and in between when bisecting, so the interval must be
+   short compared to the time until a change could be reverted. */
+static double
+find_next_change(
+	change_search_func *changed, const change_search_t *search,
+	double start, double end, double precision)
+{
+	if (!changed(search, end)) return end;
+
+	while (end - start > precision) {
+		double mid = (start + end) / 2.0;
+		if (changed(search, mid)) {
+			end = mid;
+		} else {
+			start = mid;
+		}
+	}
+
+	return end;
+}
+
+/* Return non-zero if the period at timestamp differs. */
+static int
+period_changed(const change_search_t *search, double timestamp)
+{
+	period_t period;
+	double prog;
+	get_period_and_progress(
+		search->scheme, search->loc, timestamp, &period, &prog);
+	return period != search->period;
+}
+
+/* Return target color setting of SCHEME at transition progress PROG
+   as it will be applied. */
+static void
+get_target_setting(const change_search_t *search,
+		   const transition_scheme_t *scheme, double prog,
+		   color_setting_t *result)
+{
+	interpolate_transition_scheme(scheme, prog, result);
+	if (search->temperature > 0) {
+		result->temperature = search->temperature;
+	}
+}
+
+/* Return non-zero if the target color setting at timestamp differs
+   visibly, on the screen or on any output with its own scheme, or the
+   period differs. */
+static int
+target_changed_visibly(const change_search_t *search, double timestamp)
+{
+	period_t period;
+	double prog;
+	get_period_and_progress(
+		search->scheme, search->loc, timestamp, &period, &prog);
+	if (period != search->period) return 1;
+
+	color_setting_t setting;
+	get_target_setting(search, search->scheme, prog, &setting);
+	if (color_setting_diff_is_visible(
+		    &setting, &search->setting,
+		    search->min_temp_step, search->min_brightness_step)) {
+		return 1;
+	}
+
+	for (int i = 0; i < search->output_count; i++) {
+		get_target_setting(search, &search->outputs[i].scheme, prog,
+				   &setting);
+		if (color_setting_diff_is_visible(
+			    &setting, &search->output_settings[i],
+			    search->min_temp_step,
+			    search->min_brightness_step)) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/* Return color setting of fade at the given time. */
+static void
+get_fade_setting(
+	const color_setting_t *start, const color_setting_t *target,
+	double fade_start_time, double timestamp, color_setting_t *result)
+{
+	double frac = (timestamp - fade_start_time) / FADE_DURATION;
+	double alpha = CLAMP(0.0, ease_fade(frac), 1.0);
+	interpolate_color_settings(start, target, alpha, result);
+}
+
+/* Return non-zero if the fade setting at timestamp differs visibly,
+   or the fade is over. */
+static int
+fade_changed_visibly(const change_search_t *search, double timestamp)
+{
+	if (timestamp >= search->fade_start_time + FADE_DURATION) return 1;
+
+	color_setting_t setting;
+	get_fade_setting(&search->fade_start, &search->fade_target,
+			 search->fade_start_time, timestamp, &setting);
+	return color_setting_diff_is_visible(
+		&setting, &search->setting,
+		search->min_temp_step, search->min_brightness_step);
+}
+
+
+/* Set color temperature, with the settings of outputs that have their
+   own scheme if the method can tell outputs apart. */
+static int
+set_color_setting(const gamma_method_t *method, gamma_state_t *state,
+		  const color_setting_t *setting,
+		  const gamma_output_setting_t *outputs, int count,
+		  int preserve)
+{
+	if (count > 0 && method->set_output_temperatures != NULL) {
+		return method->set_output_temperatures(
+			state, setting, outputs, count, preserve);
+	}
+
+	return method->set_temperature(state, setting, preserve);
+}
+
+/* Let the method handle output changes. Returns 1 if the adjustment
+   must be applied again, 0 if not, or -1 on error. */
+static int
+handle_output_changes(const options_t *options, gamma_state_t *state)
+{
+	int r = options->method->handle(state);
+	if (r < 0) {
+		fputs(_("Unable to handle output changes.\n"), stderr);
+		return -1;
+	} else if (r > 0 && options->verbose) {
+		fputs(_("Outputs changed.\n"), stdout);
+	}
+
+	return r;
+}
+
+/* Fade state of an output with its own scheme in continual mode. */
+typedef struct {
+	char name[OUTPUT_NAME_MAX];
+	color_setting_t target;
+	color_setting_t prev_target;
+	color_setting_t interp;
+	color_setting_t fade_start;
+	color_setting_t applied;
+} output_state_t;
+
+/* Update OUTPUTS to match the output schemes in options. Outputs that
+   are kept keep their state; new ones start from CURRENT. */
+static void
+sync_output_states(const options_t *options, output_state_t *outputs,
+		   int *count, const color_setting_t *current)
+{
+	output_state_t prev[MAX_OUTPUT_SCHEMES];
+	int prev_count = *count;
+	memcpy(prev, outputs, prev_count*sizeof(output_state_t));
+
+	*count = 0;
+	if (options->output_count == 0) return;
+
+	if (options->method->set_output_temperatures == NULL) {
+		fprintf(stderr, _("Adjustment method `%s' can not set"
+				  " outputs separately; ignoring output"
+				  " sections.\n"), options->method->name);
+		return;
+	}
+
+	for (int i = 0; i < options->output_count; i++) {
+		output_state_t *output = &outputs[i];
+		int j = 0;
+		while (j < prev_count &&
+		       strcmp(prev[j].name, options->outputs[i].name) != 0) {
+			j += 1;
+		}
+
+		if (j < prev_count) {
+			*output = prev[j];
+		} else {
+			strcpy(output->name, options->outputs[i].name);
+			output->target = *current;
+			output->prev_target = *current;
+			output->interp = *current;
+			output->fade_start = *current;
+			output->applied = *current;
+		}
+	}
+	*count = options->output_count;
+}
+
+/* Return non-zero if the config section of METHOD, or of any target
+   if several are adjusted, differs between OLD and NEW. */
+static int
+method_config_changed(const options_t *options, const gamma_method_t *method,
+		      config_ini_state_t *old, config_ini_state_t *new)
+{
+	if (method != &multi_gamma_method) {
+		return !config_ini_section_equal(
+			config_ini_get_section(old, method->name),
+			config_ini_get_section(new, method->name));
+	}
+
+	for (int i = 0; i < options->target_count; i++) {
+		const char *name = options->targets[i].method->name;
+		if (!config_ini_section_equal(
+			    config_ini_get_section(old, name),
+			    config_ini_get_section(new, name))) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/* What is needed to reload the configuration in continual mode. */
+typedef struct {
+	/* Options given on the command line. */
+	const options_t *args;
+	const gamma_method_t *gamma_methods;
+	const location_provider_t *location_providers;
+	/* Configuration in effect. */
+	config_ini_state_t *config;
+} reload_t;
+
+/* Load the configuration file again and apply what changed. The gamma
+   method and location provider are only restarted if they or their
+   settings changed. Returns 1 if the configuration was reloaded, 0 if
+   it was invalid and the current one is kept, or -1 on failure. */
+static int
+reload_config(options_t *options, reload_t *reload,
+	      location_state_t **location_state,
+	      gamma_state_t **method_state, control_t **control,
+	      statuspage_t **status_page, location_t *loc)
+{
+	int r;
+
+	config_ini_state_t config;
+	r = config_ini_init(&config, reload->config->path);
+	if (r < 0) {
+		fputs(_("Unable to reload config file; keeping current"
+			" settings.\n"), stderr);
+		return 0;
+	}
+
+	options_t new_options = *reload->args;
+	if (new_options.control_socket != NULL) {
+		new_options.control_socket =
+			strdup(new_options.control_socket);
+	}
+	r = options_parse_config_file(
+		&new_options, &config, reload->gamma_methods,
+		reload->location_providers);
+	if (r == 0) {
+		options_set_defaults(&new_options);
+		r = options_parse_output_sections(&new_options, &config);
+	}
+	if (r == 0) r = check_options(&new_options);
+	if (r < 0) {
+		fputs(_("Unable to reload config file; keeping current"
+			" settings.\n"), stderr);
+		free(new_options.control_socket);
+		config_ini_free(&config);
+		return 0;
+	}
+
+	/* Restart gamma method if it or its settings changed. */
+	const gamma_method_t *method = new_options.method != NULL ?
+		new_options.method : options->method;
+	if (new_options.target_count > 1) method = &multi_gamma_method;
+	if (method != options->method ||
+	    method_config_changed(&new_options, method, reload->config,
+				  &config)) {
+		options->method->restore(*method_state);
+		options->method->free(*method_state);
+
+		new_options.method = method;
+		r = start_gamma_method(&new_options, reload->gamma_methods,
+				       &config, method_state, 1);
+		if (r < 0) {
+			fprintf(stderr, _("Restarting method `%s'...\n"),
+				options->method->name);
+			new_options.method = options->method;
+			r = start_gamma_method(
+				&new_options, reload->gamma_methods,
+				reload->config, method_state, 1);
+			if (r < 0) return -1;
+		} else {
+			printf(_("Using method `%s'.\n"), method->name);
+		}
+	} else {
+		new_options.method = method;
+	}
+
+	if (new_options.fade_vsync &&
+	    new_options.method->request_vblank == NULL) {
+		fprintf(stderr, _("Adjustment method `%s' can not wait for"
+				  " vertical blank; ignoring fade-vsync.\n"),
+			new_options.method->name);
+		new_options.fade_vsync = 0;
+	}
+
+	/* Restart location provider if it or its settings changed, or
+	   if location is now needed or no longer needed. */
+	int need_location = !options->scheme.use_time;
+	int new_need_location = !new_options.scheme.use_time;
+	const location_provider_t *provider = new_options.provider != NULL ?
+		new_options.provider : options->provider;
+	int restart_provider = need_location && new_need_location &&
+		(provider != options->provider ||
+		 !config_ini_section_equal(
+			 config_ini_get_section(reload->config,
+						options->provider->name),
+			 config_ini_get_section(&config, provider->name)));
+
+	if (need_location && (!new_need_location || restart_provider)) {
+		options->provider->free(*location_state);
+	}
+
+	if (new_need_location && (!need_location || restart_provider)) {
+		new_options.provider = provider;
+		r = start_location_provider(
+			&new_options, reload->location_providers, &config,
+			location_state);
+		if (r < 0 && options->provider != NULL) {
+			fprintf(stderr, _("Restarting provider `%s'...\n"),
+				options->provider->name);
+			new_options.provider = options->provider;
+			r = start_location_provider(
+				&new_options, reload->location_providers,
+				reload->config, location_state);
+		}
+		if (r < 0) return -1;
+
+		r = get_initial_location(&new_options, new_options.provider,
+					 *location_state, loc);
+		if (r < 0) {
+			fputs(_("Unable to get location"
+				" from provider.\n"), stderr);
+			return -1;
+		}
+
+		if (!location_is_valid(loc)) {
+			fputs(_("Invalid location returned from provider.\n"),
+			      stderr);
+			return -1;
+		}
+
+		print_location(loc);
+	} else if (new_need_location) {
+		new_options.provider = provider;
+	} else {
+		new_options.provider = NULL;
+	}
+
+	/* Move control socket if its path changed. */
+	const char *path = options->control_socket;
+	const char *new_path = new_options.control_socket;
+	if (path == NULL ? new_path != NULL :
+	    new_path == NULL || strcmp(path, new_path) != 0) {
+		control_free(*control);
+		*control = NULL;
+		if (new_path != NULL) *control = control_start(new_path);
+	}
+	free(options->control_socket);
+
+	int status_page_wanted = new_options.status_page &&
+		new_options.simulate_days == 0;
+	if (status_page_wanted && *status_page == NULL) {
+		*status_page = statuspage_open();
+	} else if (!status_page_wanted) {
+		statuspage_close(*status_page);
+		*status_page = NULL;
+	}
+
+	*options = new_options;
+
+	/* Probes that missed the deadline may still read the previous
+	   configuration. */
+	if (!probe_pending()) config_ini_free(reload->config);
+	*reload->config = config;
+
+	printf(_("Reloaded configuration.\n"));
+
+	return 1;
+}
+
+/* Run continual mode loop
+   This is the main loop of the continual mode which keeps track of the
+   current time and continuously updates the screen to the appropriate
+   color temperature. */
+static int
+run_continual_mode(options_t *options, reload_t *reload,
+		   location_state_t **location_state,
+		   gamma_state_t **method_state, control_t **control,
+		   statuspage_t **status_page)
+{
+	int r;
+
+	/* Short fade parameters */
+	int fading = 0;
+	double fade_start_time = 0;
+	color_setting_t fade_start_interp;
+
+	const transition_scheme_t *scheme = &options->scheme;
+
+	r = signals_install_handlers();
+	if (r < 0) {
+		return r;
+	}
+
+	stats_enable();
+
+	/* Reload when the config file is written or replaced. */
+	int watch_fd = -1;
+	if (reload->config->path != NULL) {
+		watch_fd = config_ini_watch(reload->config->path);
+	}
+
+	/* Wakeups are scheduled at absolute deadlines so the time spent
+	   in a tick does not add up. A timer also expires on resume when
+	   its deadline passed during suspend. */
+	int timer_fd = -1;
+	if (!systemtime_is_virtual()) timer_fd = systemtime_timer_open();
+	double prev_suspended = 0;
+	systemtime_get_suspended_time(&prev_suspended);
+
+	/* End of a simulation on the virtual clock. */
+	double simulate_end = 0;
+	if (options->simulate_days > 0) {
+		simulate_end = options->simulate_start +
+			options->simulate_days*86400.0;
+	}
+
+	if (options->fade_vsync && options->method->request_vblank == NULL) {
+		fprintf(stderr, _("Adjustment method `%s' can not wait for"
+				  " vertical blank; ignoring fade-vsync.\n"),
+			options->method->name);
+		options->fade_vsync = 0;
+	}
+
+	/* Save previous parameters so we can avoid printing status updates if
+	   the values did not change. */
+	period_t prev_period = PERIOD_NONE;
+
+	/* Previous target color setting and current actual color setting.
+	   Actual color setting takes into account the current color fade. */
+	color_setting_t prev_target_interp;
+	color_setting_reset(&prev_target_interp);
+
+	color_setting_t interp;
+	color_setting_reset(&interp);
+
+	/* Outputs with their own scheme. */
+	output_state_t outputs[MAX_OUTPUT_SCHEMES];
+	int output_count = 0;
+	sync_output_states(options, outputs, &output_count, &interp);
+
+	/* Color setting last applied by the adjustment method and the
+	   time it was applied. Used to skip redundant updates. */
+	color_setting_t applied_interp;
+	color_setting_reset(&applied_interp);
+	int applied = 0;
+	double applied_time = 0;
+
+	/* File descriptor of a requested vertical blank event, or -1,
+	   and the time when the fade step waiting for it is applied
+	   anyway. */
+	int vblank_fd = -1;
+	int vblank_passed = 0;
+	double vblank_deadline = 0;
+
+	location_t loc = { NAN, NAN };
+	int need_location = !scheme->use_time;
+	if (need_location) {
+		/* Get initial location from provider or cache */
+		r = get_initial_location(
+			options, options->provider, *location_state, &loc);
+		if (r < 0) {
+			fputs(_("Unable to get location"
+				" from provider.\n"), stderr);
+			return -1;
+		}
+
+		if (!location_is_valid(&loc)) {
+			fputs(_("Invalid location returned from provider.\n"),
+			      stderr);
+			return -1;
+		}
+
+		print_location(&loc);
+	}
+
+	if (options->verbose) {
+		printf(_("Color temperature: %uK\n"), interp.temperature);
+		printf(_("Brightness: %.2f\n"), interp.brightness);
+	}
+
+	/* State changed by and reported to control socket clients. */
+	control_status_t control_status = {
+		.disabled = 0,
+		.pause_until = 0,
+		.temperature = 0
+	};
+
+	/* Continuously adjust color temperature */
+	int done = 0;
+	int prev_disabled = 1;
+	int disabled = 0;
+	int location_available = 1;
+	while (1) {
+		double tick_start = stats_begin();
+
+		/* Check to see if disable signal was caught */
+		if (disable && !done) {
+			disabled = !disabled;
+			control_status.pause_until = 0;
+			disable = 0;
+		}
+
+		/* Check to see if exit signal was caught */
+		if (exiting) {
+			if (done) {
+				/* On second signal stop the ongoing fade. */
+				break;
+			} else {
+				done = 1;
+				disabled = 1;
+			}
+			exiting = 0;
+		}
+
+		/* Print statistics if requested by signal */
+		if (stats_requested) {
+			stats_print(stderr);
+			stats_requested = 0;
+		}
+
+		/* Reload configuration if requested by signal or if the
+		   config file changed. */
+		if (reload_requested) {
+			reload_requested = 0;
+			if (!done) {
+				r = reload_config(
+					options, reload, location_state,
+					method_state, control, status_page,
+					&loc);
+				if (r < 0) return -1;
+				if (r > 0) {
+					need_location = !scheme->use_time;
+					location_available = 1;
+					applied = 0;
+					vblank_fd = -1;
+					vblank_passed = 0;
+					sync_output_states(
+						options, outputs,
+						&output_count, &interp);
+				}
+			}
+		}
+
+		/* Read timestamp */
+		double now;
+		r = systemtime_get_time(&now);
+		if (r < 0) {
+			fputs(_("Unable to read system time.\n"), stderr);
+			return -1;
+		}
+
+		double tick_wakeup;
+		r = systemtime_get_wakeup_time(&tick_wakeup);
+		if (r < 0) {
+			fputs(_("Unable to read system time.\n"), stderr);
+			return -1;
+		}
+
+		/* After resume the setting is applied at once without a
+		   fade, in case the gamma ramps were reset. */
+		int resumed = 0;
+		double suspended;
+		if (systemtime_get_suspended_time(&suspended) == 0) {
+			resumed = suspended - prev_suspended > 1.0;
+			prev_suspended = suspended;
+		}
+		if (resumed) {
+			if (options->verbose) {
+				fputs(_("Resumed from suspend.\n"), stdout);
+			}
+			fading = 0;
+			applied = 0;
+		}
+
+		/* A simulation ends as if an exit signal was caught. */
+		if (simulate_end > 0 && now >= simulate_end && !done) {
+			exiting = 1;
+		}
+
+		/* Reap hooks that exited or ran too long */
+		double hooks_start = stats_begin();
+		hooks_reap(now);
+		stats_end(STATS_HOOKS, hooks_start);
+
+		/* Resume when a pause requested through the control
+		   socket is over. */
+		if (control_status.pause_until > 0 &&
+		    now >= control_status.pause_until) {
+			control_status.pause_until = 0;
+			if (!done) disabled = 0;
+		}
+
+		/* Print status change */
+		if (options->verbose && disabled != prev_disabled) {
+			printf(_("Status: %s\n"), disabled ?
+			       _("Disabled") : _("Enabled"));
+		}
+
+		prev_disabled = disabled;
+
+		double period_start = stats_begin();
+		period_t period;
+		double transition_prog;
+		get_period_and_progress(
+			scheme, &loc, now, &period, &transition_prog);
+
+		/* Use transition progress to get target color
+		   temperature. */
+		color_setting_t target_interp;
+		interpolate_transition_scheme(
+			scheme, transition_prog, &target_interp);
+		stats_end(STATS_PERIOD, period_start);
+
+		for (int i = 0; i < output_count; i++) {
+			interpolate_transition_scheme(
+				&options->outputs[i].scheme, transition_prog,
+				&outputs[i].target);
+		}
+
+		if (control_status.temperature > 0) {
+			target_interp.temperature = control_status.temperature;
+			for (int i = 0; i < output_count; i++) {
+				outputs[i].target.temperature =
+					control_status.temperature;
+			}
+		}
+
+		if (disabled) {
+			period = PERIOD_NONE;
+			color_setting_reset(&target_interp);
+			for (int i = 0; i < output_count; i++) {
+				color_setting_reset(&outputs[i].target);
+			}
+		}
+
+		if (done) {
+			period = PERIOD_NONE;
+		}
+
+		/* Print period if it changed during this update,
+		   or if we are in the transition period. In transition we
+		   print the progress, so we always print it in
+		   that case. */
+		if (options->verbose && (period != prev_period ||
+					 period == PERIOD_TRANSITION)) {
+			print_period(period, transition_prog);
+		}
+
+		/* Activate hooks if period changed. Hooks would not get
+		   to run on the virtual clock, so a simulation logs the
+		   change instead. */
+		if (period != prev_period && simulate_end > 0) {
+			printf("%.3f\tperiod\t%s\t%s\n", now,
+			       period_names[prev_period],
+			       period_names[period]);
+		} else if (period != prev_period) {
+			hooks_start = stats_begin();
+			hooks_signal_period_change(prev_period, period, now);
+			stats_end(STATS_HOOKS, hooks_start);
+		}
+
+		/* Start fade if the parameter differences are too big to apply
+		   instantly. */
+		if (options->use_fade && !resumed) {
+			int major = fading ?
+				color_setting_diff_is_major(
+					&target_interp, &prev_target_interp) :
+				color_setting_diff_is_major(
+					&interp, &target_interp);
+			for (int i = 0; i < output_count; i++) {
+				output_state_t *output = &outputs[i];
+				major = major || (fading ?
+					color_setting_diff_is_major(
+						&output->target,
+						&output->prev_target) :
+					color_setting_diff_is_major(
+						&output->interp,
+						&output->target));
+			}
+
+			if (major) {
+				fading = 1;
+				fade_start_time = now;
+				fade_start_interp = interp;
+				for (int i = 0; i < output_count; i++) {
+					outputs[i].fade_start =
+						outputs[i].interp;
+				}
+			}
+		}
 
 		/* Handle ongoing fade */
-		if (fade_length != 0) {
-			fade_time += 1;
-			double frac = fade_time / (double)fade_length;
-			double alpha = CLAMP(0.0, ease_fade(frac), 1.0);
-
-			interpolate_color_settings(
-				&fade_start_interp, &target_interp, alpha,
-				&interp);
-
-			if (fade_time > fade_length) {
-				fade_time = 0;
-				fade_length = 0;
+		if (fading) {
+			get_fade_setting(&fade_start_interp, &target_interp,
+					 fade_start_time, now, &interp);
+			for (int i = 0; i < output_count; i++) {
+				get_fade_setting(&outputs[i].fade_start,
+						 &outputs[i].target,
+						 fade_start_time, now,
+						 &outputs[i].interp);
+			}
+
+			/* Stop after the final step, or if the clock
+			   was set back. */
+			if (now >= fade_start_time + FADE_DURATION ||
+			    now < fade_start_time) {
+				fading = 0;
 			}
 		} else {
 			interp = target_interp;
+			for (int i = 0; i < output_count; i++) {
+				outputs[i].interp = outputs[i].target;
+			}
 		}
 
 		/* Break loop when done and final fade is over */
-		if (done && fade_length == 0) break;
+		if (done && !fading) break;
 
-		if (verbose) {
+		if (options->verbose) {
 			if (prev_target_interp.temperature !=
 			    target_interp.temperature) {
 				printf(_("Color temperature: %uK\n"),
@@ -796,54 +1850,352 @@ run_continual_mode(const location_provider_t *provider,
 			}
 		}
 
-		/* Adjust temperature */
-		r = method->set_temperature(
-			method_state, &interp, preserve_gamma);
-		if (r < 0) {
-			fputs(_("Temperature adjustment failed.\n"),
-			      stderr);
-			return -1;
+		/* Adjust temperature unless the same setting was
+		   already applied. It is reapplied at the configured
+		   interval in case another program changed the gamma
+		   ramps. */
+		int reapply = options->reapply_interval > 0 &&
+			now - applied_time >= options->reapply_interval;
+		int outputs_changed = 0;
+		for (int i = 0; i < output_count; i++) {
+			if (!color_setting_equal(&outputs[i].interp,
+						 &outputs[i].applied)) {
+				outputs_changed = 1;
+			}
+		}
+		if (!fading) {
+			vblank_fd = -1;
+			vblank_passed = 0;
+		}
+		if (!applied || reapply || outputs_changed ||
+		    !color_setting_equal(&interp, &applied_interp)) {
+			/* Line up fade steps with the display refresh.
+			   The step is applied when the vertical blank
+			   event arrives, or after the step delay if it
+			   does not. */
+			int wait_vblank = fading && options->fade_vsync &&
+				!vblank_passed &&
+				(vblank_fd < 0 || now < vblank_deadline);
+			if (wait_vblank && vblank_fd < 0) {
+				vblank_fd = options->method->request_vblank(
+					*method_state);
+				if (vblank_fd < 0) {
+					fputs(_("Unable to wait for vertical"
+						" blank; ignoring"
+						" fade-vsync.\n"), stderr);
+					options->fade_vsync = 0;
+					wait_vblank = 0;
+				}
+				vblank_deadline = now +
+					SLEEP_DURATION_SHORT/1000.0;
+			}
+			if (!wait_vblank) {
+				vblank_fd = -1;
+				vblank_passed = 0;
+			}
+		}
+
+		if (vblank_fd < 0 &&
+		    (!applied || reapply || outputs_changed ||
+		     !color_setting_equal(&interp, &applied_interp))) {
+			gamma_output_setting_t settings[MAX_OUTPUT_SCHEMES];
+			for (int i = 0; i < output_count; i++) {
+				settings[i].name = outputs[i].name;
+				settings[i].setting = outputs[i].interp;
+				outputs[i].applied = outputs[i].interp;
+			}
+
+			double set_start = stats_begin();
+			r = set_color_setting(
+				options->method, *method_state, &interp,
+				settings, output_count,
+				options->preserve_gamma);
+			stats_end(STATS_SET_TEMPERATURE, set_start);
+			if (r < 0) {
+				fputs(_("Temperature adjustment failed.\n"),
+				      stderr);
+				return -1;
+			}
+
+			applied_interp = interp;
+			applied_time = now;
+			applied = 1;
 		}
 
+		/* Report new state to subscribed clients */
+		control_status.disabled = disabled;
+		control_status.period = period;
+		control_status.transition_prog = transition_prog;
+		control_status.setting = interp;
+		control_status.location = loc;
+		control_notify(*control, &control_status);
+		statuspage_update(*status_page, &control_status);
+
 		/* Save period and target color setting as previous */
 		prev_period = period;
 		prev_target_interp = target_interp;
+		for (int i = 0; i < output_count; i++) {
+			outputs[i].prev_target = outputs[i].target;
+		}
+
+		/* Sleep length depends on whether a fade is ongoing.
+		   Outside of transitions sleep until the period changes
+		   since the color setting stays the same until then. */
+		change_search_t search = {
+			.scheme = scheme,
+			.loc = &loc,
+			.period = period,
+			.temperature = control_status.temperature,
+			.outputs = options->outputs,
+			.output_count = output_count,
+			.min_temp_step = options->min_temp_step,
+			.min_brightness_step = options->min_brightness_step
+		};
 
-		/* Sleep length depends on whether a fade is ongoing. */
 		int delay = SLEEP_DURATION;
-		if (fade_length != 0) {
+		double next = now;
+		if (fading) {
 			delay = SLEEP_DURATION_SHORT;
+			if (options->adaptive_steps) {
+				/* Step when the fade has changed
+				   visibly. */
+				search.setting = interp;
+				search.fade_start_time = fade_start_time;
+				search.fade_start = fade_start_interp;
+				search.fade_target = target_interp;
+				next = find_next_change(
+					fade_changed_visibly, &search, now,
+					fade_start_time + FADE_DURATION,
+					SLEEP_DURATION_MIN/1000.0);
+				delay = (int)ceil((next - now)*1000.0);
+				if (delay < SLEEP_DURATION_MIN) {
+					delay = SLEEP_DURATION_MIN;
+				}
+			}
+		} else if (period == PERIOD_NONE) {
+			delay = SLEEP_DURATION_MAX;
+		} else if (period != PERIOD_TRANSITION) {
+			next = find_next_change(
+				period_changed, &search, now,
+				now + SLEEP_DURATION_MAX/1000.0, 1.0);
+			delay = (int)ceil((next - now)*1000.0);
+		} else if (options->adaptive_steps) {
+			/* Step when the target has changed visibly. */
+			search.setting = target_interp;
+			for (int i = 0; i < output_count; i++) {
+				search.output_settings[i] = outputs[i].target;
+			}
+			next = find_next_change(
+				target_changed_visibly, &search, now,
+				now + SLEEP_DURATION_MAX/1000.0, 1.0);
+			delay = (int)ceil((next - now)*1000.0);
+		}
+
+		if (options->reapply_interval > 0) {
+			double remaining = applied_time +
+				options->reapply_interval - now;
+			if (remaining*1000.0 < delay) {
+				delay = remaining > 0 ?
+					(int)ceil(remaining*1000.0) : 0;
+			}
+		}
+
+		double hooks_deadline = hooks_get_deadline();
+		if (hooks_deadline > 0) {
+			double remaining = hooks_deadline - now;
+			if (remaining*1000.0 < delay) {
+				delay = remaining > 0 ?
+					(int)ceil(remaining*1000.0) : 0;
+			}
 		}
 
-		/* Update location. */
-		int loc_fd = -1;
+		if (simulate_end > 0 && !done) {
+			double remaining = simulate_end - now;
+			if (remaining*1000.0 < delay) {
+				delay = remaining > 0 ?
+					(int)ceil(remaining*1000.0) : 0;
+			}
+		}
+
+		if (control_status.pause_until > 0) {
+			double remaining = control_status.pause_until - now;
+			if (remaining*1000.0 < delay) {
+				delay = remaining > 0 ?
+					(int)ceil(remaining*1000.0) : 0;
+			}
+		}
+
+		if (vblank_fd >= 0) {
+			double remaining = vblank_deadline - now;
+			if (remaining*1000.0 < delay) {
+				delay = remaining > 0 ?
+					(int)ceil(remaining*1000.0) : 0;
+			}
+		}
+
+		/* Wait for signals, location updates, output changes,
+		   vertical blank, config file changes and control socket
+		   clients. */
+		struct pollfd pollfds[6 + CONTROL_MAX_POLLFDS];
+		int nfds = 0;
+		double deadline = tick_wakeup + delay/1000.0;
+
+		int timer_index = -1;
+		if (timer_fd >= 0 && systemtime_timer_set(
+			    timer_fd, deadline) == 0) {
+			pollfds[nfds].fd = timer_fd;
+			pollfds[nfds].events = POLLIN;
+			timer_index = nfds++;
+		}
+
+		int signal_fd = signals_get_fd();
+		int signal_index = -1;
+		if (signal_fd >= 0) {
+			pollfds[nfds].fd = signal_fd;
+			pollfds[nfds].events = POLLIN;
+			signal_index = nfds++;
+		}
+
+		int loc_index = -1;
 		if (need_location) {
-			loc_fd = provider->get_fd(location_state);
+			int loc_fd = options->provider->get_fd(
+				*location_state);
+			if (loc_fd >= 0) {
+				/* Provider is dynamic. */
+				pollfds[nfds].fd = loc_fd;
+				pollfds[nfds].events = POLLIN;
+				loc_index = nfds++;
+			}
 		}
 
-		if (loc_fd >= 0) {
-			/* Provider is dynamic. */
-			struct pollfd pollfds[1];
-			pollfds[0].fd = loc_fd;
-			pollfds[0].events = POLLIN;
-			int r = poll(pollfds, 1, delay);
+		int method_index = -1;
+		if (options->method->get_fd != NULL) {
+			int method_fd = options->method->get_fd(
+				*method_state);
+			if (method_fd >= 0) {
+				pollfds[nfds].fd = method_fd;
+				pollfds[nfds].events = POLLIN;
+				method_index = nfds++;
+			}
+		}
+
+		if (vblank_fd >= 0) {
+			pollfds[nfds].fd = vblank_fd;
+			pollfds[nfds].events = POLLIN;
+			nfds++;
+		}
+
+		int watch_index = -1;
+		if (watch_fd >= 0) {
+			pollfds[nfds].fd = watch_fd;
+			pollfds[nfds].events = POLLIN;
+			watch_index = nfds++;
+		}
+
+		int control_index = nfds;
+		int control_count = control_add_pollfds(
+			*control, &pollfds[nfds]);
+		nfds += control_count;
+
+		stats_end(STATS_TICK, tick_start);
+
+		/* On the virtual clock only events that are already
+		   pending are handled before moving on to the next
+		   wakeup. */
+		int virtual_clock = systemtime_is_virtual();
+		if (nfds == 0) {
+			if (virtual_clock) {
+				systemtime_msleep(delay);
+			} else if (systemtime_sleep_until(deadline) &&
+				   options->method->handle != NULL) {
+				/* Woken by a window message, which may
+				   be a display change. */
+				r = handle_output_changes(
+					options, *method_state);
+				if (r < 0) return -1;
+				if (r > 0) applied = 0;
+			}
+			continue;
+		}
+
+		int timeout = 0;
+		if (timer_index >= 0) {
+			timeout = -1;
+		} else if (!virtual_clock) {
+			double wakeup_now;
+			if (systemtime_get_wakeup_time(&wakeup_now) == 0 &&
+			    deadline > wakeup_now) {
+				timeout = (int)ceil(
+					(deadline - wakeup_now)*1000.0);
+			}
+		}
+
+		r = poll(pollfds, nfds, timeout);
+		if (r < 0) {
+			if (errno == EINTR) continue;
+			perror("poll");
+			return -1;
+		} else if (r == 0) {
+			if (virtual_clock) systemtime_msleep(delay);
+			continue;
+		}
+
+		if (timer_index >= 0 && pollfds[timer_index].revents != 0) {
+			systemtime_timer_clear(timer_fd);
+		}
+
+		if (signal_index >= 0 && pollfds[signal_index].revents != 0) {
+			signals_handle_fd();
+		}
+
+		if (watch_index >= 0 && pollfds[watch_index].revents != 0) {
+			if (config_ini_watch_handle(
+				    watch_fd, reload->config->path)) {
+				reload_requested = 1;
+			}
+		}
+
+		if (control_count > 0) {
+			control_status.disabled = disabled;
+			control_handle(*control, &pollfds[control_index],
+				       control_count, &control_status);
+			if (!done) disabled = control_status.disabled;
+		}
+
+		if (method_index >= 0 &&
+		    pollfds[method_index].revents != 0) {
+			r = handle_output_changes(options, *method_state);
+			if (r < 0) return -1;
+			/* Apply to the changed outputs. */
+			if (r > 0) applied = 0;
+		}
+
+		/* Events may have been read along with others on the
+		   same connection, so check even if the descriptor is
+		   not readable. */
+		if (vblank_fd >= 0) {
+			r = options->method->handle_vblank(*method_state);
 			if (r < 0) {
-				if (errno == EINTR) continue;
-				perror("poll");
-				fputs(_("Unable to get location"
-					" from provider.\n"), stderr);
-				return -1;
-			} else if (r == 0) {
-				continue;
+				fputs(_("Unable to wait for vertical"
+					" blank; ignoring fade-vsync.\n"),
+				      stderr);
+				options->fade_vsync = 0;
+				vblank_fd = -1;
+			} else if (r > 0) {
+				vblank_passed = 1;
 			}
+		}
 
+		if (loc_index >= 0 && pollfds[loc_index].revents != 0) {
 			/* Get new location and availability
 			   information. */
 			location_t new_loc;
 			int new_available;
-			r = provider->handle(
-				location_state, &new_loc,
+			double location_start = stats_begin();
+			r = options->provider->handle(
+				*location_state, &new_loc,
 				&new_available);
+			stats_end(STATS_LOCATION, location_start);
 			if (r < 0) {
 				fputs(_("Unable to get location"
 					" from provider.\n"), stderr);
@@ -873,13 +2225,18 @@ run_continual_mode(const location_provider_t *provider,
 					" from provider.\n"), stderr);
 				return -1;
 			}
-		} else {
-			systemtime_msleep(delay);
+
+			if (new_available && options->location_cache) {
+				location_cache_save(&loc);
+			}
 		}
 	}
 
+	if (watch_fd >= 0) close(watch_fd);
+	if (timer_fd >= 0) close(timer_fd);
+
 	/* Restore saved gamma ramps */
-	method->restore(method_state);
+	options->method->restore(*method_state);
 
 	return 0;
 }
@@ -902,6 +2259,9 @@ main(int argc, char *argv[])
 
 	/* List of gamma methods. */
 	const gamma_method_t gamma_methods[] = {
+#ifdef ENABLE_WAYLAND
+		wayland_gamma_method,
+#endif
 #ifdef ENABLE_DRM
 		drm_gamma_method,
 #endif
@@ -918,6 +2278,7 @@ main(int argc, char *argv[])
 		w32gdi_gamma_method,
 #endif
 		dummy_gamma_method,
+		record_gamma_method,
 		{ NULL }
 	};
 
@@ -926,6 +2287,9 @@ main(int argc, char *argv[])
 #ifdef ENABLE_GEOCLUE2
 		geoclue2_location_provider,
 #endif
+#ifdef ENABLE_GEOCLUE2_SDBUS
+		geoclue2_sdbus_location_provider,
+#endif
 #ifdef ENABLE_CORELOCATION
 		corelocation_location_provider,
 #endif
@@ -944,6 +2308,21 @@ main(int argc, char *argv[])
 	options_parse_args(
 		&options, argc, argv, gamma_methods, location_providers);
 
+	/* A simulation leaves the display alone unless a method is
+	   given. */
+	if (options.simulate_days > 0 && options.method == NULL) {
+		options.method = &record_gamma_method;
+	}
+
+	/* Keep the options from the command line for reloading the
+	   configuration. */
+	options_t args_options = options;
+	args_options.config_filepath = NULL;
+	int args_config = options.config_filepath != NULL;
+	if (options.control_socket != NULL) {
+		args_options.control_socket = strdup(options.control_socket);
+	}
+
 	/* Load settings from config file. */
 	config_ini_state_t config_state;
 	r = config_ini_init(&config_state, options.config_filepath);
@@ -953,89 +2332,70 @@ main(int argc, char *argv[])
 	}
 
 	free(options.config_filepath);
+	options.config_filepath = NULL;
 
-	options_parse_config_file(
+	r = options_parse_config_file(
 		&options, &config_state, gamma_methods, location_providers);
+	if (r < 0) exit(EXIT_FAILURE);
 
 	options_set_defaults(&options);
 
-	if (options.scheme.dawn.start >= 0 || options.scheme.dawn.end >= 0 ||
-	    options.scheme.dusk.start >= 0 || options.scheme.dusk.end >= 0) {
-		if (options.scheme.dawn.start < 0 ||
-		    options.scheme.dawn.end < 0 ||
-		    options.scheme.dusk.start < 0 ||
-		    options.scheme.dusk.end < 0) {
-			fputs(_("Partitial time-configuration not"
-				" supported!\n"), stderr);
-			exit(EXIT_FAILURE);
-		}
+	/* Modes that set the adjustment once and exit. */
+	int oneshot = options.mode == PROGRAM_MODE_ONE_SHOT ||
+		options.mode == PROGRAM_MODE_MANUAL ||
+		options.mode == PROGRAM_MODE_RESET;
 
-		if (options.scheme.dawn.start > options.scheme.dawn.end ||
-		    options.scheme.dawn.end > options.scheme.dusk.start ||
-		    options.scheme.dusk.start > options.scheme.dusk.end) {
-			fputs(_("Invalid dawn/dusk time configuration!\n"),
-			      stderr);
-			exit(EXIT_FAILURE);
-		}
+	/* Manual and reset mode do not use separate settings for
+	   outputs. */
+	if (options.mode != PROGRAM_MODE_MANUAL &&
+	    options.mode != PROGRAM_MODE_RESET) {
+		r = options_parse_output_sections(&options, &config_state);
+		if (r < 0) exit(EXIT_FAILURE);
+	}
+
+	r = check_options(&options);
+	if (r < 0) exit(EXIT_FAILURE);
 
-		options.scheme.use_time = 1;
+	/* A running instance would undo a change made behind its back,
+	   so let it make the change instead. */
+	if (oneshot && options.control_socket != NULL) {
+		r = forward_to_instance(&options, &args_options,
+					args_config);
+		if (r < 0) exit(EXIT_FAILURE);
+		if (r > 0) {
+			if (options.verbose) {
+				printf(_("Sent to the instance listening at"
+					 " `%s'.\n"), options.control_socket);
+			}
+			config_ini_free(&config_state);
+			free(options.control_socket);
+			free(args_options.control_socket);
+			free(options.sites_filepath);
+			return EXIT_SUCCESS;
+		}
 	}
 
 	/* Initialize location provider if needed. If provider is NULL
 	   try all providers until one that works is found. */
 	location_state_t *location_state;
 
-	/* Location is not needed for reset mode and manual mode. */
+	/* Location is not needed for reset mode and manual mode, or
+	   for a forecast of a list of sites. Times of solar events
+	   need it even with a time-based scheme. */
 	int need_location =
 		options.mode != PROGRAM_MODE_RESET &&
 		options.mode != PROGRAM_MODE_MANUAL &&
 		!options.scheme.use_time;
+	if (options.mode == PROGRAM_MODE_FORECAST) {
+		need_location = options.sites_filepath == NULL &&
+			(!options.scheme.use_time ||
+			 options.forecast_step == 0);
+	}
 	if (need_location) {
-		if (options.provider != NULL) {
-			/* Use provider specified on command line. */
-			r = provider_try_start(
-				options.provider, &location_state,
-				&config_state, options.provider_args);
-			if (r < 0) exit(EXIT_FAILURE);
-		} else {
-			/* Try all providers, use the first that works. */
-			for (int i = 0;
-			     location_providers[i].name != NULL; i++) {
-				const location_provider_t *p =
-					&location_providers[i];
-				fprintf(stderr,
-					_("Trying location provider `%s'...\n"),
-					p->name);
-				r = provider_try_start(p, &location_state,
-						       &config_state, NULL);
-				if (r < 0) {
-					fputs(_("Trying next provider...\n"),
-					      stderr);
-					continue;
-				}
-
-				/* Found provider that works. */
-				printf(_("Using provider `%s'.\n"), p->name);
-				options.provider = p;
-				break;
-			}
-
-			/* Failure if no providers were successful at this
-			   point. */
-			if (options.provider == NULL) {
-				fputs(_("No more location providers"
-					" to try.\n"), stderr);
-				exit(EXIT_FAILURE);
-			}
-		}
-
-		/* Solar elevations */
-		if (options.scheme.high < options.scheme.low) {
-			fprintf(stderr,
-				_("High transition elevation cannot be lower than"
-				  " the low transition elevation.\n"));
-			exit(EXIT_FAILURE);
-		}
+		r = start_location_provider(
+			&options, location_providers, &config_state,
+			&location_state);
+		if (r < 0) exit(EXIT_FAILURE);
 
 		if (options.verbose) {
 			/* TRANSLATORS: Append degree symbols if possible. */
@@ -1051,39 +2411,6 @@ main(int argc, char *argv[])
 			       options.scheme.day.temperature,
 			       options.scheme.night.temperature);
 		}
-
-		/* Color temperature */
-		if (options.scheme.day.temperature < MIN_TEMP ||
-		    options.scheme.day.temperature > MAX_TEMP ||
-		    options.scheme.night.temperature < MIN_TEMP ||
-		    options.scheme.night.temperature > MAX_TEMP) {
-			fprintf(stderr,
-				_("Temperature must be between %uK and %uK.\n"),
-				MIN_TEMP, MAX_TEMP);
-			exit(EXIT_FAILURE);
-		}
-	}
-
-	if (options.mode == PROGRAM_MODE_MANUAL) {
-		/* Check color temperature to be set */
-		if (options.temp_set < MIN_TEMP ||
-		    options.temp_set > MAX_TEMP) {
-			fprintf(stderr,
-				_("Temperature must be between %uK and %uK.\n"),
-				MIN_TEMP, MAX_TEMP);
-			exit(EXIT_FAILURE);
-		}
-	}
-
-	/* Brightness */
-	if (options.scheme.day.brightness < MIN_BRIGHTNESS ||
-	    options.scheme.day.brightness > MAX_BRIGHTNESS ||
-	    options.scheme.night.brightness < MIN_BRIGHTNESS ||
-	    options.scheme.night.brightness > MAX_BRIGHTNESS) {
-		fprintf(stderr,
-			_("Brightness values must be between %.1f and %.1f.\n"),
-			MIN_BRIGHTNESS, MAX_BRIGHTNESS);
-		exit(EXIT_FAILURE);
 	}
 
 	if (options.verbose) {
@@ -1092,15 +2419,6 @@ main(int argc, char *argv[])
 		       options.scheme.night.brightness);
 	}
 
-	/* Gamma */
-	if (!gamma_is_valid(options.scheme.day.gamma) ||
-	    !gamma_is_valid(options.scheme.night.gamma)) {
-		fprintf(stderr,
-			_("Gamma value must be between %.1f and %.1f.\n"),
-			MIN_GAMMA, MAX_GAMMA);
-		exit(EXIT_FAILURE);
-	}
-
 	if (options.verbose) {
 		/* TRANSLATORS: The string in parenthesis is either
 		   Daytime or Night (translated). */
@@ -1120,64 +2438,28 @@ main(int argc, char *argv[])
 	   try all methods until one that works is found. */
 	gamma_state_t *method_state;
 
-	/* Gamma adjustment not needed for print mode */
-	if (options.mode != PROGRAM_MODE_PRINT) {
-		if (options.method != NULL) {
-			/* Use method specified on command line. */
-			r = method_try_start(
-				options.method, &method_state, &config_state,
-				options.method_args);
-			if (r < 0) exit(EXIT_FAILURE);
-		} else {
-			/* Try all methods, use the first that works. */
-			for (int i = 0; gamma_methods[i].name != NULL; i++) {
-				const gamma_method_t *m = &gamma_methods[i];
-				if (!m->autostart) continue;
-
-				r = method_try_start(
-					m, &method_state, &config_state, NULL);
-				if (r < 0) {
-					fputs(_("Trying next method...\n"), stderr);
-					continue;
-				}
-
-				/* Found method that works. */
-				printf(_("Using method `%s'.\n"), m->name);
-				options.method = m;
-				break;
-			}
-
-			/* Failure if no methods were successful at this point. */
-			if (options.method == NULL) {
-				fputs(_("No more methods to try.\n"), stderr);
-				exit(EXIT_FAILURE);
-			}
-		}
+	/* Gamma adjustment not needed for print and forecast mode */
+	int need_method = options.mode != PROGRAM_MODE_PRINT &&
+		options.mode != PROGRAM_MODE_FORECAST;
+	if (need_method) {
+		/* The adjustment is never restored when setting it once,
+		   so it is only saved for preserving it. */
+		int save = !oneshot || (options.preserve_gamma &&
+					options.mode != PROGRAM_MODE_RESET);
+		r = start_gamma_method(
+			&options, gamma_methods, &config_state,
+			&method_state, save);
+		if (r < 0) exit(EXIT_FAILURE);
 	}
 
-	config_ini_free(&config_state);
-
 	switch (options.mode) {
 	case PROGRAM_MODE_ONE_SHOT:
 	case PROGRAM_MODE_PRINT:
 	{
 		location_t loc = { NAN, NAN };
 		if (need_location) {
-			fputs(_("Waiting for current location"
-				" to become available...\n"), stderr);
-
-			/* Wait for location provider. */
-			int r = provider_get_location(
-				options.provider, location_state, -1, &loc);
-			if (r < 0) {
-				fputs(_("Unable to get location"
-					" from provider.\n"), stderr);
-				exit(EXIT_FAILURE);
-			}
-
-			if (!location_is_valid(&loc)) {
-				exit(EXIT_FAILURE);
-			}
+			r = wait_for_location(&options, location_state, &loc);
+			if (r < 0) exit(EXIT_FAILURE);
 
 			print_location(&loc);
 		}
@@ -1199,8 +2481,8 @@ main(int argc, char *argv[])
 				scheme, time_offset);
 		} else {
 			/* Current angular elevation of the sun */
-			double elevation = solar_elevation(
-				now, loc.lat, loc.lon);
+			double elevation = solar_cache_elevation(
+				&solar_cache, now, loc.lat, loc.lon);
 			if (options.verbose) {
 				/* TRANSLATORS: Append degree symbol if
 				   possible. */
@@ -1218,18 +2500,43 @@ main(int argc, char *argv[])
 		interpolate_transition_scheme(
 			scheme, transition_prog, &interp);
 
+		gamma_output_setting_t outputs[MAX_OUTPUT_SCHEMES];
+		for (int i = 0; i < options.output_count; i++) {
+			outputs[i].name = options.outputs[i].name;
+			interpolate_transition_scheme(
+				&options.outputs[i].scheme, transition_prog,
+				&outputs[i].setting);
+		}
+
 		if (options.verbose || options.mode == PROGRAM_MODE_PRINT) {
 			print_period(period, transition_prog);
 			printf(_("Color temperature: %uK\n"),
 			       interp.temperature);
 			printf(_("Brightness: %.2f\n"),
 			       interp.brightness);
+			for (int i = 0; i < options.output_count; i++) {
+				printf(_("Output %s: %uK, brightness %.2f\n"),
+				       outputs[i].name,
+				       outputs[i].setting.temperature,
+				       outputs[i].setting.brightness);
+			}
 		}
 
 		if (options.mode != PROGRAM_MODE_PRINT) {
+			if (options.output_count > 0 &&
+			    options.method->set_output_temperatures == NULL) {
+				fprintf(stderr, _("Adjustment method `%s' can"
+						  " not set outputs"
+						  " separately; ignoring"
+						  " output sections.\n"),
+					options.method->name);
+			}
+
 			/* Adjust temperature */
-			r = options.method->set_temperature(
-				method_state, &interp, options.preserve_gamma);
+			r = set_color_setting(
+				options.method, method_state, &interp,
+				outputs, options.output_count,
+				options.preserve_gamma);
 			if (r < 0) {
 				fputs(_("Temperature adjustment failed.\n"),
 				      stderr);
@@ -1297,27 +2604,102 @@ main(int argc, char *argv[])
 		}
 	}
 	break;
+	case PROGRAM_MODE_FORECAST:
+	{
+		location_t loc;
+		location_t *sites = NULL;
+		int site_count = 0;
+		if (options.sites_filepath != NULL) {
+			r = forecast_load_sites(options.sites_filepath,
+						&sites, &site_count);
+			if (r < 0) exit(EXIT_FAILURE);
+		} else if (need_location) {
+			r = wait_for_location(&options, location_state, &loc);
+			if (r < 0) exit(EXIT_FAILURE);
+			sites = &loc;
+			site_count = 1;
+		}
+
+		/* Start at local midnight unless given. */
+		double start = options.forecast_start;
+		if (isnan(start)) {
+			r = get_day_start(&start);
+			if (r < 0) exit(EXIT_FAILURE);
+		}
+
+		forecast_t forecast = {
+			.scheme = scheme,
+			.sites = sites,
+			.site_count = site_count,
+			.start = start,
+			.days = options.forecast_days,
+			.step = options.forecast_step,
+			.format = options.forecast_format
+		};
+		r = forecast_run(&forecast, stdout);
+		if (sites != &loc) free(sites);
+		if (r < 0) exit(EXIT_FAILURE);
+	}
+	break;
 	case PROGRAM_MODE_CONTINUAL:
 	{
+		control_t *control = NULL;
+		if (options.control_socket != NULL) {
+			control = control_start(options.control_socket);
+			if (control == NULL) exit(EXIT_FAILURE);
+		}
+
+		if (options.simulate_days > 0) {
+			if (isnan(options.simulate_start)) {
+				r = get_day_start(&options.simulate_start);
+				if (r < 0) exit(EXIT_FAILURE);
+			}
+			systemtime_set_virtual(options.simulate_start);
+		}
+
+		/* Simulations do not publish their status. */
+		statuspage_t *status_page = NULL;
+		if (options.status_page && options.simulate_days == 0) {
+			status_page = statuspage_open();
+		}
+
+		reload_t reload = {
+			.args = &args_options,
+			.gamma_methods = gamma_methods,
+			.location_providers = location_providers,
+			.config = &config_state
+		};
+
 		r = run_continual_mode(
-			options.provider, location_state, scheme,
-			options.method, method_state,
-			options.use_fade, options.preserve_gamma,
-			options.verbose);
+			&options, &reload, &location_state, &method_state,
+			&control, &status_page);
+		statuspage_close(status_page);
+		control_free(control);
+		hooks_free();
+		if (options.stats) stats_print(stderr);
 		if (r < 0) exit(EXIT_FAILURE);
 	}
 	break;
 	}
 
 	/* Clean up gamma adjustment state */
-	if (options.mode != PROGRAM_MODE_PRINT) {
+	if (need_method) {
 		options.method->free(method_state);
 	}
 
 	/* Clean up location provider state */
-	if (need_location) {
+	if (need_location && options.provider != NULL) {
 		options.provider->free(location_state);
 	}
 
+	/* Probes that missed the deadline may still read the
+	   configuration. */
+	if (!probe_pending()) config_ini_free(&config_state);
+
+	free(options.control_socket);
+	free(args_options.control_socket);
+	free(options.sites_filepath);
+	colorramp_cache_free();
+
 	return EXIT_SUCCESS;
 }
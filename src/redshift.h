@@ -26,6 +26,10 @@
 /* The color temperature when no adjustment is applied. */
 #define NEUTRAL_TEMP  6500
 
+/* Bounds for color temperature. */
+#define MIN_TEMP   1000
+#define MAX_TEMP  25000
+
 
 /* Location */
 typedef struct {
@@ -54,7 +58,8 @@ typedef enum {
 	PROGRAM_MODE_ONE_SHOT,
 	PROGRAM_MODE_PRINT,
 	PROGRAM_MODE_RESET,
-	PROGRAM_MODE_MANUAL
+	PROGRAM_MODE_MANUAL,
+	PROGRAM_MODE_FORECAST
 } program_mode_t;
 
 /* Time range.
@@ -78,6 +83,13 @@ typedef struct {
 } transition_scheme_t;
 
 
+/* Color setting for the outputs with a given name. */
+typedef struct {
+	const char *name;
+	color_setting_t setting;
+} gamma_output_setting_t;
+
+
 /* Gamma adjustment method */
 typedef struct gamma_state gamma_state_t;
 
@@ -90,6 +102,14 @@ typedef int gamma_method_set_option_func(gamma_state_t *state, const char *key,
 typedef void gamma_method_restore_func(gamma_state_t *state);
 typedef int gamma_method_set_temperature_func(
 	gamma_state_t *state, const color_setting_t *setting, int preserve);
+typedef int gamma_method_request_vblank_func(gamma_state_t *state);
+typedef int gamma_method_handle_vblank_func(gamma_state_t *state);
+typedef int gamma_method_get_fd_func(gamma_state_t *state);
+typedef int gamma_method_handle_func(gamma_state_t *state);
+typedef int gamma_method_set_output_temperatures_func(
+	gamma_state_t *state, const color_setting_t *setting,
+	const gamma_output_setting_t *outputs, int count, int preserve);
+typedef void gamma_method_skip_save_func(gamma_state_t *state);
 
 typedef struct {
 	char *name;
@@ -113,6 +133,34 @@ typedef struct {
 	gamma_method_restore_func *restore;
 	/* Set a specific color temperature. */
 	gamma_method_set_temperature_func *set_temperature;
+
+	/* Ask for an event at the next vertical blank of the display.
+	   Returns a file descriptor that becomes readable when the event
+	   arrives, or -1 on error. Optional, NULL if not supported. */
+	gamma_method_request_vblank_func *request_vblank;
+	/* Read pending events without blocking. Returns 1 if the
+	   requested vertical blank has passed, 0 if not, or -1 on
+	   error. */
+	gamma_method_handle_vblank_func *handle_vblank;
+
+	/* Return file descriptor that becomes readable when outputs are
+	   added or removed, or -1. Optional, NULL if not supported. */
+	gamma_method_get_fd_func *get_fd;
+	/* Handle output changes signaled on the file descriptor, or on
+	   Windows by a window message when there is none. Returns 1 if
+	   the adjustment must be applied again, 0 if not, or -1 on
+	   error. */
+	gamma_method_handle_func *handle;
+
+	/* Set color temperature with separate settings for the named
+	   outputs. Outputs not listed use SETTING. Optional, NULL if
+	   outputs can not be told apart. */
+	gamma_method_set_output_temperatures_func *set_output_temperatures;
+
+	/* Called between init and start when neither restore nor
+	   preserve will be used, so start does not need to read the
+	   current adjustment. Optional, NULL if not supported. */
+	gamma_method_skip_save_func *skip_save;
 } gamma_method_t;
 
 
@@ -23,24 +23,45 @@
 #endif
 
 #include <stdio.h>
+#include <errno.h>
 #if defined(HAVE_SIGNAL_H) && !defined(__WIN32__)
 # include <signal.h>
+# include <unistd.h>
 #endif
 
 #include "signals.h"
+#include "pipeutils.h"
 
 
 #if defined(HAVE_SIGNAL_H) && !defined(__WIN32__)
 
 volatile sig_atomic_t exiting = 0;
 volatile sig_atomic_t disable = 0;
+volatile sig_atomic_t stats_requested = 0;
+volatile sig_atomic_t reload_requested = 0;
 
+/* Pipe written to when a signal is caught so that poll() in the
+   main loop wakes up even if the signal arrived before the call. */
+static int signal_pipe_fds[2] = { -1, -1 };
+
+
+/* Wake up the main loop from a signal handler */
+static void
+signal_wakeup(void)
+{
+	if (signal_pipe_fds[1] >= 0) {
+		int saved_errno = errno;
+		pipeutils_signal(signal_pipe_fds[1]);
+		errno = saved_errno;
+	}
+}
 
 /* Signal handler for exit signals */
 static void
 sigexit(int signo)
 {
 	exiting = 1;
+	signal_wakeup();
 }
 
 /* Signal handler for disable signal */
@@ -48,12 +69,39 @@ static void
 sigdisable(int signo)
 {
 	disable = 1;
+	signal_wakeup();
+}
+
+/* Signal handler for statistics signal */
+static void
+sigstats(int signo)
+{
+	stats_requested = 1;
+	signal_wakeup();
+}
+
+/* Signal handler for reload signal */
+static void
+sigreload(int signo)
+{
+	reload_requested = 1;
+	signal_wakeup();
+}
+
+/* Signal handler for child signal. Hooks that exited are reaped
+   by the main loop. */
+static void
+sigchld(int signo)
+{
+	signal_wakeup();
 }
 
 #else /* ! HAVE_SIGNAL_H || __WIN32__ */
 
 int disable = 0;
 int exiting = 0;
+int stats_requested = 0;
+int reload_requested = 0;
 
 #endif /* ! HAVE_SIGNAL_H || __WIN32__ */
 
@@ -67,6 +115,11 @@ signals_install_handlers(void)
 	int r;
 	sigemptyset(&sigset);
 
+	if (signal_pipe_fds[0] < 0) {
+		r = pipeutils_create_nonblocking(signal_pipe_fds);
+		if (r < 0) return -1;
+	}
+
 	/* Install signal handler for INT and TERM signals */
 	sigact.sa_handler = sigexit;
 	sigact.sa_mask = sigset;
@@ -95,12 +148,33 @@ signals_install_handlers(void)
 		return -1;
 	}
 
-	/* Ignore CHLD signal. This causes child processes
-	   (hooks) to be reaped automatically. */
-	sigact.sa_handler = SIG_IGN;
+	/* Install signal handler for USR2 signal */
+	sigact.sa_handler = sigstats;
+	sigact.sa_mask = sigset;
+	sigact.sa_flags = 0;
+
+	r = sigaction(SIGUSR2, &sigact, NULL);
+	if (r < 0) {
+		perror("sigaction");
+		return -1;
+	}
+
+	/* Install signal handler for HUP signal */
+	sigact.sa_handler = sigreload;
 	sigact.sa_mask = sigset;
 	sigact.sa_flags = 0;
 
+	r = sigaction(SIGHUP, &sigact, NULL);
+	if (r < 0) {
+		perror("sigaction");
+		return -1;
+	}
+
+	/* Install signal handler for CHLD signal */
+	sigact.sa_handler = sigchld;
+	sigact.sa_mask = sigset;
+	sigact.sa_flags = SA_NOCLDSTOP;
+
 	r = sigaction(SIGCHLD, &sigact, NULL);
 	if (r < 0) {
 		perror("sigaction");
@@ -110,3 +184,25 @@ signals_install_handlers(void)
 
 	return 0;
 }
+
+/* Return file descriptor that becomes readable when a signal has been
+   caught, or -1 if not supported. */
+int
+signals_get_fd(void)
+{
+#if defined(HAVE_SIGNAL_H) && !defined(__WIN32__)
+	return signal_pipe_fds[0];
+#else
+	return -1;
+#endif
+}
+
+/* Clear pending wakeups on the signal file descriptor. */
+void
+signals_handle_fd(void)
+{
+#if defined(HAVE_SIGNAL_H) && !defined(__WIN32__)
+	char buffer[16];
+	while (read(signal_pipe_fds[0], buffer, sizeof(buffer)) > 0);
+#endif
+}
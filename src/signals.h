@@ -25,14 +25,20 @@
 
 extern volatile sig_atomic_t exiting;
 extern volatile sig_atomic_t disable;
+extern volatile sig_atomic_t stats_requested;
+extern volatile sig_atomic_t reload_requested;
 
 #else /* ! HAVE_SIGNAL_H || __WIN32__ */
 extern int exiting;
 extern int disable;
+extern int stats_requested;
+extern int reload_requested;
 #endif /* ! HAVE_SIGNAL_H || __WIN32__ */
 
 
 int signals_install_handlers(void);
+int signals_get_fd(void);
+void signals_handle_fd(void);
 
 
 #endif /* REDSHIFT_SIGNALS_H */
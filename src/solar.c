@@ -323,3 +323,208 @@ solar_table_fill(double date, double lat, double lon, double *table)
 		table[i] = epoch_from_jd(jdn - 0.5 + offset/1440.0);
 	}
 }
+
+
+/* Initialize empty cache. */
+void
+solar_cache_init(solar_cache_t *cache)
+{
+	cache->valid = 0;
+	cache->table_valid = 0;
+}
+
+/* Refresh cache if date is outside the cached day or the location
+   changed. Moving on to the next day only computes the terms at its
+   end. */
+static void
+solar_cache_update(solar_cache_t *cache, double jd, double lat, double lon)
+{
+	int same_location = cache->valid &&
+		cache->lat == lat && cache->lon == lon;
+	if (same_location &&
+	    jd >= cache->jd_start && jd < cache->jd_start + 1.0) {
+		return;
+	}
+
+	double jd_start = floor(jd + 0.5) - 0.5;
+	int first = 0;
+	if (same_location && jd_start == cache->jd_start + 1.0) {
+		/* Terms at the end of the cached day are those at the
+		   start of the next. */
+		cache->decl[0] = cache->decl[1];
+		cache->eq_time[0] = cache->eq_time[1];
+		first = 1;
+	} else {
+		cache->lat = lat;
+		cache->lon = lon;
+		cache->sin_lat = sin(RAD(lat));
+		cache->cos_lat = cos(RAD(lat));
+	}
+
+	cache->jd_start = jd_start;
+	for (int i = first; i < 2; i++) {
+		double t = jcent_from_jd(cache->jd_start + i);
+		cache->decl[i] = solar_declination(t);
+		cache->eq_time[i] = equation_of_time(t);
+	}
+
+	cache->valid = 1;
+	cache->table_valid = 0;
+}
+
+/* Declination (radians) and equation of time (minutes) at Julian day
+   JD, interpolated linearly from the terms of the cached day. */
+static void
+solar_cache_terms(
+	const solar_cache_t *cache, double jd, double *decl, double *eq_time)
+{
+	double frac = jd - cache->jd_start;
+	*decl = cache->decl[0] + frac*(cache->decl[1] - cache->decl[0]);
+	*eq_time = cache->eq_time[0] +
+		frac*(cache->eq_time[1] - cache->eq_time[0]);
+}
+
+/* Solar angular elevation at the given location and time using the
+   cache. The declination and equation of time are interpolated
+   linearly over the day which is accurate to about 0.001 degrees.
+   date: Seconds since unix epoch
+   lat: Latitude of location
+   lon: Longitude of location
+   Return: Solar angular elevation in degrees */
+double
+solar_cache_elevation(
+	solar_cache_t *cache, double date, double lat, double lon)
+{
+	double jd = jd_from_epoch(date);
+	solar_cache_update(cache, jd, lat, lon);
+
+	double decl, eq_time;
+	solar_cache_terms(cache, jd, &decl, &eq_time);
+
+	/* Minutes from midnight */
+	double offset = (jd - round(jd) - 0.5)*1440.0;
+	double ha = RAD((720 - offset - eq_time)/4 - lon);
+
+	return DEG(asin(cos(ha)*cache->cos_lat*cos(decl) +
+			cache->sin_lat*sin(decl)));
+}
+
+/* Return table of solar event times for the day of the given date, as
+   filled by solar_table_fill(). The table is valid until the next call
+   with a different day or location. */
+const double *
+solar_cache_table(solar_cache_t *cache, double date, double lat, double lon)
+{
+	double jd = jd_from_epoch(date);
+	solar_cache_update(cache, jd, lat, lon);
+
+	if (!cache->table_valid) {
+		solar_table_fill(date, lat, lon, cache->table);
+		cache->table_valid = 1;
+	}
+
+	return cache->table;
+}
+
+/* Absolute elevation in degrees above which solar_elevation_many()
+   stops interpolating. */
+#define SOLAR_MANY_EXACT_ELEVATION  85.0
+
+/* Solar angular elevations at COUNT times STEP seconds apart, starting
+   at DATE. The terms that change slowly are computed once a day, and
+   their products with the latitude are interpolated over the day as
+   well, so each time costs one cosine and one arcsine. The arcsine
+   magnifies the interpolation error close to the zenith and nadir, so
+   elevations beyond SOLAR_MANY_EXACT_ELEVATION either way are computed
+   exactly; elsewhere the error stays below about 0.004 degrees. Safe
+   to call from several threads.
+   lat: Latitude of location
+   lon: Longitude of location
+   elevations: Filled with COUNT elevations in degrees */
+void
+solar_elevation_many(double date, double step, int count,
+		     double lat, double lon, double *elevations)
+{
+	solar_cache_t cache;
+	solar_cache_init(&cache);
+
+	const double exact_sin = sin(RAD(SOLAR_MANY_EXACT_ELEVATION));
+	double day_start = NAN;
+	double a[2], b[2];
+	for (int i = 0; i < count; i++) {
+		double jd = jd_from_epoch(date + i*step);
+		solar_cache_update(&cache, jd, lat, lon);
+		if (cache.jd_start != day_start) {
+			day_start = cache.jd_start;
+			for (int k = 0; k < 2; k++) {
+				a[k] = cache.cos_lat*cos(cache.decl[k]);
+				b[k] = cache.sin_lat*sin(cache.decl[k]);
+			}
+		}
+
+		double frac = jd - day_start;
+		double eq_time = cache.eq_time[0] +
+			frac*(cache.eq_time[1] - cache.eq_time[0]);
+
+		/* The hour angle is only needed modulo a full turn, so
+		   minutes since the start of the day will do. */
+		double ha = RAD((720 - frac*1440.0 - eq_time)/4 - lon);
+		double sin_elevation = cos(ha)*(a[0] + frac*(a[1] - a[0])) +
+			b[0] + frac*(b[1] - b[0]);
+		if (fabs(sin_elevation) > exact_sin) {
+			elevations[i] = solar_elevation(date + i*step,
+							lat, lon);
+		} else {
+			elevations[i] = DEG(asin(sin_elevation));
+		}
+	}
+}
+
+/* Fill tables of solar event times like solar_table_fill() for DAYS
+   consecutive days starting with the day of DATE. TABLES holds
+   SOLAR_TIME_MAX entries for each day. The slowly changing terms are
+   computed once a day and interpolated to the time of each event.
+   Safe to call from several threads. */
+void
+solar_table_fill_many(double date, int days, double lat, double lon,
+		      double *tables)
+{
+	solar_cache_t cache;
+	solar_cache_init(&cache);
+
+	double jdn = round(jd_from_epoch(date));
+	for (int d = 0; d < days; d++, jdn += 1.0) {
+		double *table = &tables[d*SOLAR_TIME_MAX];
+		solar_cache_update(&cache, jdn, lat, lon);
+
+		/* Apparent solar noon. First pass uses approximate
+		   solar noon to calculate equation of time. */
+		double decl, eq_time;
+		solar_cache_terms(&cache, jdn - lon/360.0, &decl, &eq_time);
+		double sol_noon = 720 - 4*lon - eq_time;
+		solar_cache_terms(&cache, jdn - 0.5 + sol_noon/1440.0,
+				  &decl, &eq_time);
+		sol_noon = 720 - 4*lon - eq_time;
+
+		double j_noon = jdn - 0.5 + sol_noon/1440.0;
+		table[SOLAR_TIME_NOON] = epoch_from_jd(j_noon);
+		table[SOLAR_TIME_MIDNIGHT] = epoch_from_jd(j_noon + 0.5);
+
+		double noon_decl, noon_eq_time;
+		solar_cache_terms(&cache, j_noon, &noon_decl, &noon_eq_time);
+		for (int i = 2; i < SOLAR_TIME_MAX; i++) {
+			/* First pass uses the terms at noon, the second
+			   those at the estimated time. */
+			double angle = time_angle[i];
+			double ha = hour_angle_from_elevation(
+				lat, noon_decl, angle);
+			double offset = 720 - 4*(lon + DEG(ha)) - noon_eq_time;
+
+			solar_cache_terms(&cache, jdn - 0.5 + offset/1440.0,
+					  &decl, &eq_time);
+			ha = hour_angle_from_elevation(lat, decl, angle);
+			offset = 720 - 4*(lon + DEG(ha)) - eq_time;
+			table[i] = epoch_from_jd(jdn - 0.5 + offset/1440.0);
+		}
+	}
+}
@@ -45,7 +45,37 @@ typedef enum {
 } solar_time_t;
 
 
+/* Terms of the solar position that change slowly, cached for the
+   current day and location. */
+typedef struct {
+	int valid;
+	double lat;
+	double lon;
+	/* Julian day at the start of the cached day (midnight UTC). */
+	double jd_start;
+	/* Declination (radians) and equation of time (minutes) at the
+	   start and end of the day. */
+	double decl[2];
+	double eq_time[2];
+	double sin_lat;
+	double cos_lat;
+	/* Times of solar events for the day, filled on request. */
+	int table_valid;
+	double table[SOLAR_TIME_MAX];
+} solar_cache_t;
+
+
 double solar_elevation(double date, double lat, double lon);
 void solar_table_fill(double date, double lat, double lon, double *table);
+void solar_elevation_many(double date, double step, int count,
+			  double lat, double lon, double *elevations);
+void solar_table_fill_many(double date, int days, double lat, double lon,
+			   double *tables);
+
+void solar_cache_init(solar_cache_t *cache);
+double solar_cache_elevation(
+	solar_cache_t *cache, double date, double lat, double lon);
+const double *solar_cache_table(
+	solar_cache_t *cache, double date, double lat, double lon);
 
 #endif /* ! REDSHIFT_SOLAR_H */
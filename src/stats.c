@@ -0,0 +1,178 @@
+/* stats.c -- Timing statistics source
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ENABLE_NLS
+# include <libintl.h>
+# define _(s) gettext(s)
+#else
+# define _(s) s
+#endif
+
+#include "stats.h"
+#include "systemtime.h"
+
+/* Number of most recent samples kept for each stage. */
+#define STATS_SAMPLES  1024
+
+
+/* Names of stages in reports. */
+static const char *stage_names[] = {
+	"tick",
+	"period",
+	"ramp",
+	"set-temperature",
+	"location",
+	"hooks"
+};
+
+/* Durations of a stage in microseconds. Totals cover all samples,
+   percentiles the ones in the ring buffer. */
+typedef struct {
+	float samples[STATS_SAMPLES];
+	unsigned long count;
+	double sum;
+	double min;
+	double max;
+} stats_stage_state_t;
+
+static int stats_enabled = 0;
+static stats_stage_state_t stages[STATS_MAX];
+
+/* Summary of a stage. */
+typedef struct {
+	unsigned long count;
+	double min;
+	double mean;
+	double p99;
+	double max;
+} stats_summary_t;
+
+
+/* Start recording statistics. */
+void
+stats_enable(void)
+{
+	stats_enabled = 1;
+}
+
+/* Return start time of a timed part, or 0 if statistics are not
+   recorded. */
+double
+stats_begin(void)
+{
+	if (!stats_enabled) return 0;
+
+	double now;
+	if (systemtime_get_monotonic_time(&now) < 0) return 0;
+	return now;
+}
+
+/* Record duration of stage that started at START. */
+void
+stats_end(stats_stage_t stage, double start)
+{
+	if (!stats_enabled || start == 0) return;
+
+	double now;
+	if (systemtime_get_monotonic_time(&now) < 0) return;
+
+	double duration = (now - start)*1000000.0;
+	stats_stage_state_t *s = &stages[stage];
+	s->samples[s->count % STATS_SAMPLES] = duration;
+	if (s->count == 0 || duration < s->min) s->min = duration;
+	if (s->count == 0 || duration > s->max) s->max = duration;
+	s->sum += duration;
+	s->count += 1;
+}
+
+static int
+compare_float(const void *a, const void *b)
+{
+	float x = *(const float *)a;
+	float y = *(const float *)b;
+	return (x > y) - (x < y);
+}
+
+static void
+get_summary(stats_stage_t stage, stats_summary_t *summary)
+{
+	const stats_stage_state_t *s = &stages[stage];
+	summary->count = s->count;
+	if (s->count == 0) {
+		summary->min = 0;
+		summary->mean = 0;
+		summary->p99 = 0;
+		summary->max = 0;
+		return;
+	}
+
+	summary->min = s->min;
+	summary->mean = s->sum / s->count;
+	summary->max = s->max;
+
+	float sorted[STATS_SAMPLES];
+	int n = s->count < STATS_SAMPLES ? s->count : STATS_SAMPLES;
+	memcpy(sorted, s->samples, n*sizeof(float));
+	qsort(sorted, n, sizeof(float), compare_float);
+	summary->p99 = sorted[(n*99)/100];
+}
+
+/* Print table of statistics to F. */
+void
+stats_print(FILE *f)
+{
+	fputs(_("Timing statistics (microseconds):\n"), f);
+	fprintf(f, "%-16s %10s %10s %10s %10s %10s\n", _("Stage"),
+		_("Count"), _("Min"), _("Mean"), _("P99"), _("Max"));
+	for (int i = 0; i < STATS_MAX; i++) {
+		stats_summary_t summary;
+		get_summary(i, &summary);
+		fprintf(f, "%-16s %10lu %10.1f %10.1f %10.1f %10.1f\n",
+			stage_names[i], summary.count, summary.min,
+			summary.mean, summary.p99, summary.max);
+	}
+}
+
+/* Write statistics as a line of JSON to BUFFER. Returns -1 if the
+   buffer is too small. */
+int
+stats_format_json(char *buffer, size_t size)
+{
+	size_t length = snprintf(buffer, size, "{\"type\":\"stats\"");
+	for (int i = 0; i < STATS_MAX && length < size; i++) {
+		stats_summary_t summary;
+		get_summary(i, &summary);
+		length += snprintf(&buffer[length], size - length,
+				   ",\"%s\":{\"count\":%lu,\"min\":%.1f,"
+				   "\"mean\":%.1f,\"p99\":%.1f,\"max\":%.1f}",
+				   stage_names[i], summary.count, summary.min,
+				   summary.mean, summary.p99, summary.max);
+	}
+	if (length < size) {
+		length += snprintf(&buffer[length], size - length, "}\n");
+	}
+
+	return length < size ? 0 : -1;
+}
@@ -0,0 +1,41 @@
+/* stats.h -- Timing statistics header
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REDSHIFT_STATS_H
+#define REDSHIFT_STATS_H
+
+#include <stdio.h>
+
+/* Parts of an update that are timed. */
+typedef enum {
+	STATS_TICK = 0,
+	STATS_PERIOD,
+	STATS_RAMP,
+	STATS_SET_TEMPERATURE,
+	STATS_LOCATION,
+	STATS_HOOKS,
+	STATS_MAX
+} stats_stage_t;
+
+void stats_enable(void);
+double stats_begin(void);
+void stats_end(stats_stage_t stage, double start);
+
+void stats_print(FILE *f);
+int stats_format_json(char *buffer, size_t size);
+
+#endif /* ! REDSHIFT_STATS_H */
@@ -0,0 +1,305 @@
+/* statuspage.c -- Shared memory status page source
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/* The status page lets panels and widgets show the state of the
+   continual mode without connecting to the control socket. It is a
+   small file in $XDG_RUNTIME_DIR that readers map and read without
+   further system calls. The layout is described in statuspage.h. */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef _WIN32
+# include <unistd.h>
+# include <fcntl.h>
+# include <sys/types.h>
+# include <sys/stat.h>
+# include <sys/mman.h>
+# include <sys/file.h>
+# include <errno.h>
+#endif
+
+#ifdef ENABLE_NLS
+# include <libintl.h>
+# define _(s) gettext(s)
+#else
+# define _(s) s
+#endif
+
+#include "statuspage.h"
+
+#define MAX_STATUSPAGE_PATH  4096
+
+#ifndef O_CLOEXEC
+# define O_CLOEXEC  0
+#endif
+
+
+#ifndef _WIN32
+
+struct statuspage {
+	int fd;
+	char *path;
+	volatile statuspage_data_t *data;
+	/* Status last written, to skip unchanged updates. */
+	control_status_t last;
+	int written;
+};
+
+
+/* Begin writing the page. Readers retry until it is finished. */
+static void
+statuspage_begin(statuspage_t *page)
+{
+	page->data->sequence += 1;
+	__sync_synchronize();
+}
+
+static void
+statuspage_end(statuspage_t *page)
+{
+	__sync_synchronize();
+	page->data->sequence += 1;
+}
+
+/* Open the page at PATH and lock it for writing. Returns the file
+   descriptor, or -1 with IN_USE set if another instance has it locked
+   and cleared on other errors. */
+static int
+statuspage_lock(const char *path, int *in_use)
+{
+	*in_use = 0;
+
+	/* An instance that exits removes the page before releasing the
+	   lock, so a page that was locked after it was removed is
+	   opened again. */
+	for (int i = 0; i < 3; i++) {
+		int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+		if (fd < 0) {
+			perror("open");
+			return -1;
+		}
+
+		if (flock(fd, LOCK_EX | LOCK_NB) < 0) {
+			int lock_errno = errno;
+			close(fd);
+			if (lock_errno == EWOULDBLOCK) {
+				*in_use = 1;
+				return -1;
+			}
+			errno = lock_errno;
+			perror("flock");
+			return -1;
+		}
+
+		struct stat fd_stat, path_stat;
+		if (fstat(fd, &fd_stat) == 0 &&
+		    stat(path, &path_stat) == 0 &&
+		    fd_stat.st_dev == path_stat.st_dev &&
+		    fd_stat.st_ino == path_stat.st_ino) {
+			return fd;
+		}
+		close(fd);
+	}
+
+	fputs(_("Status page was replaced while opening it.\n"), stderr);
+	return -1;
+}
+
+/* Create the status page in $XDG_RUNTIME_DIR. Returns NULL if there
+   is no runtime directory, another instance owns the page, or the
+   page can not be created. */
+statuspage_t *
+statuspage_open(void)
+{
+	const char *dir = getenv("XDG_RUNTIME_DIR");
+	if (dir == NULL || dir[0] == '\0') return NULL;
+
+	char path[MAX_STATUSPAGE_PATH];
+	int r = snprintf(path, sizeof(path), "%s/%s", dir, STATUSPAGE_NAME);
+	if (r < 0 || (size_t)r >= sizeof(path)) return NULL;
+
+	statuspage_t *page = malloc(sizeof(statuspage_t));
+	if (page == NULL) {
+		perror("malloc");
+		return NULL;
+	}
+
+	page->path = strdup(path);
+	page->written = 0;
+	page->data = NULL;
+	page->fd = -1;
+	if (page->path == NULL) {
+		perror("strdup");
+		goto fail;
+	}
+
+	int in_use;
+	page->fd = statuspage_lock(path, &in_use);
+	if (page->fd < 0 && in_use) {
+		fprintf(stderr, _("Status page `%s' is in use by another"
+				  " instance; not publishing status.\n"),
+			path);
+		free(page->path);
+		free(page);
+		return NULL;
+	} else if (page->fd < 0) {
+		goto fail;
+	}
+
+	r = ftruncate(page->fd, sizeof(statuspage_data_t));
+	if (r < 0) {
+		perror("ftruncate");
+		goto fail;
+	}
+
+	void *data = mmap(NULL, sizeof(statuspage_data_t),
+			  PROT_READ | PROT_WRITE, MAP_SHARED, page->fd, 0);
+	if (data == MAP_FAILED) {
+		perror("mmap");
+		goto fail;
+	}
+	page->data = data;
+
+	/* Keep the sequence of a page left behind by an earlier
+	   instance, so readers never see it go back while mapped. */
+	uint32_t sequence = page->data->sequence & ~(uint32_t)1;
+	page->data->sequence = sequence + 1;
+	__sync_synchronize();
+	page->data->magic = STATUSPAGE_MAGIC;
+	page->data->version = STATUSPAGE_VERSION;
+	page->data->size = sizeof(statuspage_data_t);
+	page->data->pid = getpid();
+	page->data->enabled = 0;
+	page->data->period = PERIOD_NONE;
+	page->data->temperature = 0;
+	page->data->override_temperature = 0;
+	page->data->brightness = 0;
+	for (int c = 0; c < 3; c++) page->data->gamma[c] = 0;
+	page->data->reserved = 0;
+	page->data->transition_prog = 0;
+	page->data->latitude = NAN;
+	page->data->longitude = NAN;
+	page->data->pause_until = 0;
+	statuspage_end(page);
+
+	return page;
+
+fail:
+	fprintf(stderr, _("Unable to create status page `%s'.\n"), path);
+	if (page->fd >= 0) {
+		close(page->fd);
+		unlink(path);
+	}
+	free(page->path);
+	free(page);
+	return NULL;
+}
+
+/* Remove the status page. Readers that still have it mapped see that
+   the writer has exited. */
+void
+statuspage_close(statuspage_t *page)
+{
+	if (page == NULL) return;
+
+	statuspage_begin(page);
+	page->data->pid = 0;
+	page->data->enabled = 0;
+	statuspage_end(page);
+
+	unlink(page->path);
+	munmap((void *)page->data, sizeof(statuspage_data_t));
+	close(page->fd);
+	free(page->path);
+	free(page);
+}
+
+static int
+coordinate_equal(double a, double b)
+{
+	return a == b || (isnan(a) && isnan(b));
+}
+
+static int
+status_equal(const control_status_t *a, const control_status_t *b)
+{
+	return a->disabled == b->disabled &&
+		a->pause_until == b->pause_until &&
+		a->temperature == b->temperature &&
+		a->period == b->period &&
+		a->transition_prog == b->transition_prog &&
+		a->setting.temperature == b->setting.temperature &&
+		a->setting.brightness == b->setting.brightness &&
+		memcmp(a->setting.gamma, b->setting.gamma,
+		       sizeof(a->setting.gamma)) == 0 &&
+		coordinate_equal(a->location.lat, b->location.lat) &&
+		coordinate_equal(a->location.lon, b->location.lon);
+}
+
+/* Write STATUS to the page if it changed since the last update. */
+void
+statuspage_update(statuspage_t *page, const control_status_t *status)
+{
+	if (page == NULL) return;
+	if (page->written && status_equal(status, &page->last)) return;
+
+	statuspage_begin(page);
+	page->data->enabled = !status->disabled;
+	page->data->period = status->period;
+	page->data->temperature = status->setting.temperature;
+	page->data->override_temperature = status->temperature;
+	page->data->brightness = status->setting.brightness;
+	for (int c = 0; c < 3; c++) {
+		page->data->gamma[c] = status->setting.gamma[c];
+	}
+	page->data->transition_prog = status->transition_prog;
+	page->data->latitude = status->location.lat;
+	page->data->longitude = status->location.lon;
+	page->data->pause_until = status->pause_until;
+	statuspage_end(page);
+
+	page->last = *status;
+	page->written = 1;
+}
+
+#else /* _WIN32 */
+
+/* Not supported on Windows. */
+statuspage_t *
+statuspage_open(void)
+{
+	return NULL;
+}
+
+void
+statuspage_close(statuspage_t *page)
+{
+}
+
+void
+statuspage_update(statuspage_t *page, const control_status_t *status)
+{
+}
+
+#endif /* _WIN32 */
@@ -0,0 +1,70 @@
+/* statuspage.h -- Shared memory status page header
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REDSHIFT_STATUSPAGE_H
+#define REDSHIFT_STATUSPAGE_H
+
+#include <stdint.h>
+
+#include "redshift.h"
+#include "control.h"
+
+/* Name of the status page file in $XDG_RUNTIME_DIR. */
+#define STATUSPAGE_NAME  "redshift-status"
+
+#define STATUSPAGE_MAGIC    0x74736472  /* "rdst" in little endian */
+#define STATUSPAGE_VERSION  1
+
+/* Layout of the status page file, in host byte order. Fields are only
+   added at the end, with SIZE telling how many bytes are valid.
+
+   The page is protected by a sequence lock. To read it, map the file
+   and read SEQUENCE, copy the fields, then read SEQUENCE again. The
+   copy is consistent if both reads gave the same even number;
+   otherwise try again. PID is 0 once the writer has exited. */
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t size;
+	uint32_t sequence;
+	uint32_t pid;
+	/* 1 if adjustment is enabled, 0 if disabled or paused. */
+	int32_t enabled;
+	/* Value of period_t: 0 none, 1 daytime, 2 night,
+	   3 transition. */
+	int32_t period;
+	int32_t temperature;
+	/* Temperature set through the control socket, or 0. */
+	int32_t override_temperature;
+	float brightness;
+	float gamma[3];
+	uint32_t reserved;
+	double transition_prog;
+	/* NaN if the location is not known. */
+	double latitude;
+	double longitude;
+	/* Time when a pause ends in seconds since the epoch, or 0. */
+	double pause_until;
+} statuspage_data_t;
+
+typedef struct statuspage statuspage_t;
+
+statuspage_t *statuspage_open(void);
+void statuspage_close(statuspage_t *page);
+void statuspage_update(statuspage_t *page, const control_status_t *status);
+
+#endif /* ! REDSHIFT_STATUSPAGE_H */
@@ -17,7 +17,12 @@
    Copyright (c) 2010-2014  Jon Lund Steffensen <jonlst@gmail.com>
 */
 
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
 #include <stdio.h>
+#include <math.h>
 #include <unistd.h>
 
 #ifndef _WIN32
@@ -31,13 +36,35 @@
 # include <windows.h>
 #endif
 
+#ifdef HAVE_SYS_TIMERFD_H
+# include <sys/timerfd.h>
+#endif
+
+/* Wakeups are scheduled on a clock that keeps running while the system
+   is suspended where there is one, so deadlines that pass during
+   suspend expire at once on resume. */
+#if !defined(_WIN32) && _POSIX_TIMERS > 0 && defined(CLOCK_BOOTTIME)
+# define WAKEUP_CLOCK  CLOCK_BOOTTIME
+#endif
+
 #include "systemtime.h"
 
 
+/* Virtual clock read instead of the system clock when enabled.
+   Sleeping moves it forward at once. */
+static int virtual_enabled = 0;
+static double virtual_now = 0;
+
+
 /* Return current time in T as the number of seconds since the epoch. */
 int
 systemtime_get_time(double *t)
 {
+	if (virtual_enabled) {
+		*t = virtual_now;
+		return 0;
+	}
+
 #if defined(_WIN32) /* Windows */
 	FILETIME now;
 	ULARGE_INTEGER i;
@@ -70,10 +97,42 @@ systemtime_get_time(double *t)
 	return 0;
 }
 
+/* Return time in T as seconds from an unspecified starting point. The
+   time is not affected by changes to the system clock, nor by the
+   virtual clock, so it can time the work done in a simulation. */
+int
+systemtime_get_monotonic_time(double *t)
+{
+#if defined(_WIN32) /* Windows */
+	LARGE_INTEGER now, frequency;
+	QueryPerformanceCounter(&now);
+	QueryPerformanceFrequency(&frequency);
+	*t = (double)now.QuadPart / frequency.QuadPart;
+#elif _POSIX_TIMERS > 0 && defined(CLOCK_MONOTONIC) /* POSIX timers */
+	struct timespec now;
+	int r = clock_gettime(CLOCK_MONOTONIC, &now);
+	if (r < 0) {
+		perror("clock_gettime");
+		return -1;
+	}
+
+	*t = now.tv_sec + (now.tv_nsec / 1000000000.0);
+#else /* other platforms */
+	return systemtime_get_time(t);
+#endif
+
+	return 0;
+}
+
 /* Sleep for a number of milliseconds. */
 void
 systemtime_msleep(unsigned int msecs)
 {
+	if (virtual_enabled) {
+		virtual_now += msecs / 1000.0;
+		return;
+	}
+
 #ifndef _WIN32
 	struct timespec sleep;
 	sleep.tv_sec = msecs / 1000;
@@ -83,3 +142,151 @@ systemtime_msleep(unsigned int msecs)
 	Sleep(msecs);
 #endif
 }
+
+/* Replace the system clock with a virtual clock starting at START
+   seconds since the epoch. */
+void
+systemtime_set_virtual(double start)
+{
+	virtual_enabled = 1;
+	virtual_now = start;
+}
+
+/* Return 1 if the virtual clock is used. */
+int
+systemtime_is_virtual(void)
+{
+	return virtual_enabled;
+}
+
+/* Return time in T as seconds on the clock that wakeups are scheduled
+   on. It is monotonic, and also counts time the system was suspended
+   where supported. */
+int
+systemtime_get_wakeup_time(double *t)
+{
+#ifdef WAKEUP_CLOCK
+	struct timespec now;
+	int r = clock_gettime(WAKEUP_CLOCK, &now);
+	if (r < 0) {
+		perror("clock_gettime");
+		return -1;
+	}
+
+	*t = now.tv_sec + (now.tv_nsec / 1000000000.0);
+	return 0;
+#else
+	return systemtime_get_monotonic_time(t);
+#endif
+}
+
+/* Return in T the seconds the wakeup clock is ahead of the monotonic
+   clock. It grows by the time spent in suspend, or stays 0 where that
+   is unknown. */
+int
+systemtime_get_suspended_time(double *t)
+{
+#ifdef WAKEUP_CLOCK
+	double wakeup, monotonic;
+	if (systemtime_get_wakeup_time(&wakeup) < 0 ||
+	    systemtime_get_monotonic_time(&monotonic) < 0) {
+		return -1;
+	}
+
+	*t = wakeup - monotonic;
+#else
+	*t = 0;
+#endif
+	return 0;
+}
+
+/* Open a timer that becomes readable when a deadline set with
+   systemtime_timer_set() passes. Returns a file descriptor, or -1 if
+   timers are not supported and timeouts must be used instead. */
+int
+systemtime_timer_open(void)
+{
+#if defined(HAVE_SYS_TIMERFD_H) && defined(WAKEUP_CLOCK)
+	/* Fails on kernels without timers on the boot time clock. */
+	return timerfd_create(WAKEUP_CLOCK, TFD_NONBLOCK | TFD_CLOEXEC);
+#else
+	return -1;
+#endif
+}
+
+/* Arm timer FD to expire at DEADLINE on the wakeup clock. A deadline
+   that already passed expires at once. */
+int
+systemtime_timer_set(int fd, double deadline)
+{
+#if defined(HAVE_SYS_TIMERFD_H) && defined(WAKEUP_CLOCK)
+	/* A zero expiry would disarm the timer. */
+	if (deadline < 1e-9) deadline = 1e-9;
+
+	struct itimerspec spec = { { 0, 0 }, { 0, 0 } };
+	spec.it_value.tv_sec = (time_t)deadline;
+	spec.it_value.tv_nsec = (long)((deadline - spec.it_value.tv_sec) *
+				       1000000000.0);
+	int r = timerfd_settime(fd, TFD_TIMER_ABSTIME, &spec, NULL);
+	if (r < 0) {
+		perror("timerfd_settime");
+		return -1;
+	}
+#endif
+	return 0;
+}
+
+/* Acknowledge expiry of timer FD so it is no longer readable. */
+void
+systemtime_timer_clear(int fd)
+{
+#ifdef HAVE_SYS_TIMERFD_H
+	unsigned long long expirations;
+	ssize_t r = read(fd, &expirations, sizeof(expirations));
+	(void)r;
+#endif
+}
+
+/* Sleep until DEADLINE on the wakeup clock. On Windows a waitable
+   timer with a due time on the system clock is used, as it expires
+   at once when the deadline passed while the system was asleep, and
+   the sleep also ends when a window message arrives for the thread.
+   Returns 1 if it ended for a message, 0 otherwise. */
+int
+systemtime_sleep_until(double deadline)
+{
+	double now;
+	if (systemtime_get_wakeup_time(&now) < 0) return 0;
+
+	double remaining = deadline - now;
+	if (remaining <= 0) return 0;
+
+#ifndef _WIN32
+	/* Returns early when interrupted so signals are handled. */
+	struct timespec sleep;
+	sleep.tv_sec = (time_t)remaining;
+	sleep.tv_nsec = (long)((remaining - sleep.tv_sec)*1000000000.0);
+	nanosleep(&sleep, NULL);
+	return 0;
+#else
+	static HANDLE timer = NULL;
+	if (timer == NULL) timer = CreateWaitableTimer(NULL, TRUE, NULL);
+
+	double wall;
+	if (timer != NULL && systemtime_get_time(&wall) == 0) {
+		/* Due time is in 100 ns units since 1601-01-01 UTC. */
+		LARGE_INTEGER due;
+		due.QuadPart = (LONGLONG)((wall + remaining + 11644473600.0) *
+					  10000000.0);
+		if (SetWaitableTimer(timer, &due, 0, NULL, NULL, FALSE)) {
+			DWORD r = MsgWaitForMultipleObjects(
+				1, &timer, FALSE, INFINITE, QS_ALLINPUT);
+			return r == WAIT_OBJECT_0 + 1;
+		}
+	}
+
+	DWORD r = MsgWaitForMultipleObjects(
+		0, NULL, FALSE, (DWORD)ceil(remaining*1000.0), QS_ALLINPUT);
+	return r == WAIT_OBJECT_0;
+#endif
+}
@@ -22,6 +22,17 @@
 
 
 int systemtime_get_time(double *now);
+int systemtime_get_monotonic_time(double *now);
 void systemtime_msleep(unsigned int msecs);
 
+int systemtime_get_wakeup_time(double *now);
+int systemtime_get_suspended_time(double *t);
+int systemtime_timer_open(void);
+int systemtime_timer_set(int fd, double deadline);
+void systemtime_timer_clear(int fd);
+int systemtime_sleep_until(double deadline);
+
+void systemtime_set_virtual(double start);
+int systemtime_is_virtual(void);
+
 #endif /* ! REDSHIFT_SYSTEMTIME_H */
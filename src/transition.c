@@ -0,0 +1,138 @@
+/* transition.c -- Color transitions over the day source
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <time.h>
+
+#include "redshift.h"
+#include "transition.h"
+
+#undef CLAMP
+#define CLAMP(lo,mid,up)  (((lo) > (mid)) ? (lo) : (((mid) < (up)) ? (mid) : (up)))
+
+
+/* Determine which period we are currently in based on time offset. */
+period_t
+get_period_from_time(const transition_scheme_t *transition, int time_offset)
+{
+	if (time_offset < transition->dawn.start ||
+	    time_offset >= transition->dusk.end) {
+		return PERIOD_NIGHT;
+	} else if (time_offset >= transition->dawn.end &&
+		   time_offset < transition->dusk.start) {
+		return PERIOD_DAYTIME;
+	} else {
+		return PERIOD_TRANSITION;
+	}
+}
+
+/* Determine which period we are currently in based on solar elevation. */
+period_t
+get_period_from_elevation(
+	const transition_scheme_t *transition, double elevation)
+{
+	if (elevation < transition->low) {
+		return PERIOD_NIGHT;
+	} else if (elevation < transition->high) {
+		return PERIOD_TRANSITION;
+	} else {
+		return PERIOD_DAYTIME;
+	}
+}
+
+/* Determine how far through the transition we are based on time offset. */
+double
+get_transition_progress_from_time(
+	const transition_scheme_t *transition, int time_offset)
+{
+	if (time_offset < transition->dawn.start ||
+	    time_offset >= transition->dusk.end) {
+		return 0.0;
+	} else if (time_offset < transition->dawn.end) {
+		return (transition->dawn.start - time_offset) /
+			(double)(transition->dawn.start -
+				transition->dawn.end);
+	} else if (time_offset > transition->dusk.start) {
+		return (transition->dusk.end - time_offset) /
+			(double)(transition->dusk.end -
+				transition->dusk.start);
+	} else {
+		return 1.0;
+	}
+}
+
+/* Determine how far through the transition we are based on elevation. */
+double
+get_transition_progress_from_elevation(
+	const transition_scheme_t *transition, double elevation)
+{
+	if (elevation < transition->low) {
+		return 0.0;
+	} else if (elevation < transition->high) {
+		return (transition->low - elevation) /
+			(transition->low - transition->high);
+	} else {
+		return 1.0;
+	}
+}
+
+/* Return number of seconds since midnight from timestamp. */
+int
+get_seconds_since_midnight(double timestamp)
+{
+	time_t t = (time_t)timestamp;
+	struct tm tm;
+	localtime_r(&t, &tm);
+	return tm.tm_sec + tm.tm_min * 60 + tm.tm_hour * 3600;
+}
+
+/* Interpolate color setting structs given alpha. */
+void
+interpolate_color_settings(
+	const color_setting_t *first,
+	const color_setting_t *second,
+	double alpha,
+	color_setting_t *result)
+{
+	alpha = CLAMP(0.0, alpha, 1.0);
+
+	result->temperature = (1.0-alpha)*first->temperature +
+		alpha*second->temperature;
+	result->brightness = (1.0-alpha)*first->brightness +
+		alpha*second->brightness;
+	for (int i = 0; i < 3; i++) {
+		result->gamma[i] = (1.0-alpha)*first->gamma[i] +
+			alpha*second->gamma[i];
+	}
+}
+
+/* Interpolate color setting structs transition scheme. */
+void
+interpolate_transition_scheme(
+	const transition_scheme_t *transition,
+	double alpha,
+	color_setting_t *result)
+{
+	const color_setting_t *day = &transition->day;
+	const color_setting_t *night = &transition->night;
+
+	alpha = CLAMP(0.0, alpha, 1.0);
+	interpolate_color_settings(night, day, alpha, result);
+}
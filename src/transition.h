@@ -0,0 +1,40 @@
+/* transition.h -- Color transitions over the day header
+   This file is part of Redshift.
+
+   Redshift is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Redshift is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Redshift.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef REDSHIFT_TRANSITION_H
+#define REDSHIFT_TRANSITION_H
+
+#include "redshift.h"
+
+period_t get_period_from_time(
+	const transition_scheme_t *transition, int time_offset);
+period_t get_period_from_elevation(
+	const transition_scheme_t *transition, double elevation);
+double get_transition_progress_from_time(
+	const transition_scheme_t *transition, int time_offset);
+double get_transition_progress_from_elevation(
+	const transition_scheme_t *transition, double elevation);
+int get_seconds_since_midnight(double timestamp);
+
+void interpolate_color_settings(
+	const color_setting_t *first, const color_setting_t *second,
+	double alpha, color_setting_t *result);
+void interpolate_transition_scheme(
+	const transition_scheme_t *transition, double alpha,
+	color_setting_t *result);
+
+#endif /* ! REDSHIFT_TRANSITION_H */